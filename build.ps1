@@ -131,6 +131,7 @@ if ($BuildEngine -eq "ON") {
 }
 if ($BuildOffline -eq "ON") {
     Write-Host "  spatialroot_spatial_render : $BuildDir\source\spatial_engine\spatialRender\Release\spatialroot_spatial_render.exe"
+    Write-Host "  spatialroot_trace_convert  : $BuildDir\source\spatial_engine\spatialRender\Release\spatialroot_trace_convert.exe"
 }
 if ($BuildCult -eq "ON") {
     Write-Host "  cult-transcoder            : $BuildDir\internal\cult_transcoder\Release\cult-transcoder.exe"
@@ -135,6 +135,7 @@ if [ "${BUILD_ENGINE}" = "ON" ]; then
 fi
 if [ "${BUILD_OFFLINE}" = "ON" ]; then
     echo "  spatialroot_spatial_render : ${BUILD_DIR}/source/spatial_engine/spatialRender/spatialroot_spatial_render"
+    echo "  spatialroot_trace_convert  : ${BUILD_DIR}/source/spatial_engine/spatialRender/spatialroot_trace_convert"
 fi
 if [ "${BUILD_CULT}" = "ON" ]; then
     echo "  cult-transcoder            : ${BUILD_DIR}/internal/cult_transcoder/cult-transcoder"
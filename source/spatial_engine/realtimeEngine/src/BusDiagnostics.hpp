@@ -0,0 +1,148 @@
+// BusDiagnostics.hpp — Phase 14 per-bus channel analysis kernels
+//
+// Spatializer::renderBlock() analyzes two buses per diagnostic block: the
+// internal render bus (after the NaN clamp) and the device bus (after the
+// OutputRemap routing). For each bus it needs, per channel (first 64 only —
+// the masks are uint64_t):
+//
+//   mean-square          → active mask   (ms > kRmsThresh, ≈ −80 dBFS)
+//                        → dominant mask (ms ≥ 1% of the loudest main)
+//                        → top-4 mains cluster
+//                        → main / sub power totals (RMS meters)
+//
+// analyzeBus() computes all of that in ONE pass over the channels' mean
+// squares — the masks and the top-4 insertion from the same per-channel
+// value — instead of one scan for the masks plus four more for the cluster.
+// The mean squares themselves come out of the fused output finalize
+// (finalizeChannel() in GainMix.hpp), which already touches every sample;
+// sumSquares() below covers channels it does not write.
+//
+// SIMD DISPATCH: same compile-time selection as GainMix.hpp (AVX / SSE2 /
+// NEON / scalar). Lanes are summed in a fixed order, so a given build is
+// deterministic; results differ from the old scalar loop only by float
+// summation order, far below the −80 dBFS activity threshold.
+//
+// REAL-TIME SAFETY: pure functions on caller-owned memory. No allocation,
+// no locks, no I/O. Safe on the audio thread.
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SR_BUSDIAG_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#endif
+
+// sum of x[f]^2 for f in [0, n)
+inline float sumSquares(const float* x, unsigned int n) {
+    unsigned int f = 0;
+    float acc = 0.0f;
+#if defined(__AVX__)
+    __m256 v0 = _mm256_setzero_ps(), v1 = _mm256_setzero_ps();
+    for (; f + 16 <= n; f += 16) {
+        __m256 a = _mm256_loadu_ps(x + f);
+        __m256 b = _mm256_loadu_ps(x + f + 8);
+        v0 = _mm256_add_ps(v0, _mm256_mul_ps(a, a));
+        v1 = _mm256_add_ps(v1, _mm256_mul_ps(b, b));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(v0, v1));
+    for (float l : lanes) acc += l;
+#elif defined(SR_BUSDIAG_SSE2)
+    __m128 v0 = _mm_setzero_ps(), v1 = _mm_setzero_ps();
+    for (; f + 8 <= n; f += 8) {
+        __m128 a = _mm_loadu_ps(x + f);
+        __m128 b = _mm_loadu_ps(x + f + 4);
+        v0 = _mm_add_ps(v0, _mm_mul_ps(a, a));
+        v1 = _mm_add_ps(v1, _mm_mul_ps(b, b));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(v0, v1));
+    for (float l : lanes) acc += l;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t v0 = vdupq_n_f32(0.0f), v1 = vdupq_n_f32(0.0f);
+    for (; f + 8 <= n; f += 8) {
+        float32x4_t a = vld1q_f32(x + f);
+        float32x4_t b = vld1q_f32(x + f + 4);
+        v0 = vmlaq_f32(v0, a, a);
+        v1 = vmlaq_f32(v1, b, b);
+    }
+    float lanes[4];
+    vst1q_f32(lanes, vaddq_f32(v0, v1));
+    for (float l : lanes) acc += l;
+#endif
+    for (; f < n; ++f) acc += x[f] * x[f];
+    return acc;
+}
+
+// Per-bus result of one diagnostic block.
+struct BusDiagReport {
+    uint64_t activeMask  = 0;   // ms > kRmsThresh
+    uint64_t domMask     = 0;   // mains with ms ≥ kDomRelThresh × loudest main
+    uint64_t clusterMask = 0;   // top-4 mains by ms (each > kRmsThresh)
+    float    mainMs      = 0.0f; // Σ ms of active mains
+    float    subMs       = 0.0f; // Σ ms of active subs
+};
+
+// Analyze channels [0, min(numChannels, 64)).
+//   meanSquare(ch) → that channel's block mean square
+//   isSub(ch)      → true for subwoofer channels (excluded from dom / cluster)
+template <typename MeanSquareFn, typename IsSubFn>
+inline BusDiagReport analyzeBus(unsigned int numChannels,
+                                MeanSquareFn meanSquare, IsSubFn isSub) {
+    constexpr float kRmsThresh    = 1e-8f;
+    constexpr float kDomRelThresh = 0.01f;  // 1% of max power = −20 dBFS
+    constexpr int   kClusterSize  = 4;
+
+    BusDiagReport r;
+    const unsigned int nCh = numChannels < 64u ? numChannels : 64u;
+
+    float chMs[64];
+    float maxMainMs = 0.0f;
+
+    // Top-K kept sorted descending. Strict '>' keeps the lower channel on
+    // ties — the same pick order as the former K-pass ascending scans.
+    float topMs[kClusterSize];
+    int   topCh[kClusterSize];
+    int   topN = 0;
+
+    for (unsigned int ch = 0; ch < nCh; ++ch) {
+        const float ms = meanSquare(ch);
+        chMs[ch] = ms;
+        const bool sub = isSub(ch);
+        if (ms > kRmsThresh) {
+            r.activeMask |= (1ULL << ch);
+            if (sub) r.subMs += ms; else r.mainMs += ms;
+        }
+        if (sub) continue;
+        if (ms > maxMainMs) maxMainMs = ms;
+
+        if (ms > kRmsThresh && (topN < kClusterSize || ms > topMs[topN - 1])) {
+            int pos = (topN < kClusterSize) ? topN++ : kClusterSize - 1;
+            while (pos > 0 && ms > topMs[pos - 1]) {
+                topMs[pos] = topMs[pos - 1];
+                topCh[pos] = topCh[pos - 1];
+                --pos;
+            }
+            topMs[pos] = ms;
+            topCh[pos] = static_cast<int>(ch);
+        }
+    }
+    for (int k = 0; k < topN; ++k) r.clusterMask |= (1ULL << topCh[k]);
+
+    // Dominant mask: relative to the loudest MAIN (subs never rescale it).
+    // Guard: only with meaningful signal, so silence does not mark every
+    // channel as equally dominant.
+    const float domThresh = maxMainMs * kDomRelThresh;
+    if (domThresh > kRmsThresh) {
+        for (unsigned int ch = 0; ch < nCh; ++ch) {
+            if (!isSub(ch) && chMs[ch] >= domThresh) r.domMask |= (1ULL << ch);
+        }
+    }
+    return r;
+}
@@ -0,0 +1,124 @@
+// ChunkPlanner.hpp — Memory-budgeted per-source chunk sizing for Streaming
+//
+// With a fixed kDefaultChunkFrames every source costs two 10 s buffers, so
+// the streaming footprint grows with the source count whether a stem is a
+// constant bed or a 2 s spot effect. With --stream_budget_mb set, Streaming
+// asks planChunkFrames() for one chunk length per source instead, such that
+// both double-buffer slots of every source fit the budget:
+//
+//   1. DESIRE per source. Dense content gets the default chunk; sparse
+//      content (few probed windows with signal) shrinks toward a quarter of
+//      it. A source whose measured refill time leaves less than `margin` ×
+//      itself of runway at the preload point grows — a longer chunk
+//      amortizes per-read latency (slow storage, network mounts).
+//   2. CLAMP to [kMinChunkSec, kMaxChunkSec] and to the file length: a
+//      source shorter than its chunk is held in one chunk whole and never
+//      refilled.
+//   3. FIT the budget by scaling every desire down by one factor; a source
+//      that would drop below the floor is pinned there and the factor is
+//      recomputed over the rest (water-filling). If even the floors do not
+//      fit, the floors are returned and the caller reports the overrun.
+//
+// Pure function of its inputs — no I/O, no state. Streaming calls it at
+// load time and from the loader thread when a refill misses its margin.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct ChunkDemand {
+    uint64_t totalFrames   = 0;    // file length; no chunk is planned past it
+    float    density       = 1.0f; // fraction of probed windows with signal, 0–1
+    double   refillSec     = 0.0;  // slowest recent refill of this source (0 = none yet)
+    uint64_t currentFrames = 0;    // chunk in use (0 = not planned yet)
+};
+
+namespace ChunkPlanner {
+
+static constexpr double kMinChunkSec = 2.0;   // floor: 0.5 s runway at the 75% point
+static constexpr double kMaxChunkSec = 30.0;  // ceiling for slow-storage growth
+static constexpr double kMaxGrowStep = 2.0;   // per replan, so one slow read cannot take the budget
+
+/// One chunk length per demand. defaultFrames is the fixed-size chunk used
+/// without a budget; runwayFraction the part of a chunk left when its
+/// refill starts (1 - kPreloadThreshold). budgetBytes covers both slots of
+/// every source. margin = required runway / refill time (>= 1).
+inline std::vector<uint64_t> planChunkFrames(const std::vector<ChunkDemand>& demands,
+                                             size_t budgetBytes, int sampleRate,
+                                             uint64_t defaultFrames, double runwayFraction,
+                                             double margin) {
+    const size_t n = demands.size();
+    std::vector<uint64_t> plan(n, 0);
+    if (n == 0) return plan;
+
+    const uint64_t minFrames = static_cast<uint64_t>(kMinChunkSec * sampleRate);
+    const uint64_t maxFrames = static_cast<uint64_t>(kMaxChunkSec * sampleRate);
+
+    // 1 + 2: desire and per-source floor / cap
+    std::vector<double>   desire(n);
+    std::vector<uint64_t> floor(n);
+    for (size_t i = 0; i < n; ++i) {
+        const ChunkDemand& d = demands[i];
+        const float density = std::max(0.0f, std::min(1.0f, d.density));
+        double want = defaultFrames * (0.25 + 0.75 * density);
+        if (d.refillSec > 0.0 && d.currentFrames > 0) {
+            const double runwaySec = runwayFraction * d.currentFrames / sampleRate;
+            const double needSec   = margin * d.refillSec;
+            if (needSec > runwaySec) {
+                const double grow = std::min(kMaxGrowStep, needSec / runwaySec);
+                want = std::max(want, d.currentFrames * grow);
+            } else {
+                // Hold a chunk that already meets the margin: shrinking it
+                // back would only re-trigger the growth on the next refill.
+                want = std::max(want, static_cast<double>(d.currentFrames));
+            }
+        }
+        const uint64_t cap = std::max<uint64_t>(1, std::min(maxFrames, d.totalFrames));
+        desire[i] = std::min<double>(cap, std::max<double>(minFrames, want));
+        floor[i]  = std::min(minFrames, cap);
+    }
+
+    // 3: fit the budget (frames per slot, two slots per source)
+    const double budgetFrames = static_cast<double>(budgetBytes) / (2.0 * sizeof(float));
+    double want = 0.0;
+    for (double w : desire) want += w;
+    if (want <= budgetFrames) {
+        for (size_t i = 0; i < n; ++i) plan[i] = static_cast<uint64_t>(desire[i]);
+        return plan;
+    }
+
+    std::vector<bool> pinned(n, false);
+    for (;;) {
+        double pinnedFrames = 0.0, freeDesire = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            if (pinned[i]) pinnedFrames += floor[i];
+            else           freeDesire   += desire[i];
+        }
+        const double scale = (freeDesire > 0.0)
+            ? std::max(0.0, budgetFrames - pinnedFrames) / freeDesire : 0.0;
+        bool newlyPinned = false;
+        for (size_t i = 0; i < n; ++i) {
+            if (!pinned[i] && desire[i] * scale < floor[i]) {
+                pinned[i] = true;
+                newlyPinned = true;
+            }
+        }
+        if (newlyPinned) continue;
+        for (size_t i = 0; i < n; ++i) {
+            plan[i] = pinned[i] ? floor[i] : static_cast<uint64_t>(desire[i] * scale);
+        }
+        return plan;
+    }
+}
+
+/// Bytes the plan keeps resident (both slots of every source).
+inline size_t planBytes(const std::vector<uint64_t>& plan) {
+    size_t frames = 0;
+    for (uint64_t f : plan) frames += static_cast<size_t>(f);
+    return frames * 2 * sizeof(float);
+}
+
+} // namespace ChunkPlanner
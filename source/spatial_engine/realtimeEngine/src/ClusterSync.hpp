@@ -0,0 +1,342 @@
+// ClusterSync.hpp — Leader / follower transport clock for multi-node playback
+//
+// A cluster is N spatialroot_realtime nodes playing the same scene and layout,
+// each rendering its own slice of the speakers (RealtimeConfig::
+// clusterSpeakers / clusterSubwoofers, see Spatializer::init()). Playback only
+// lines up if every node's frame counter follows one transport, so the leader
+// sends its clock and the followers lock to it.
+//
+// WIRE FORMAT (OSC over UDP, leader → every follower):
+//   /cluster/clock  frame(double)  flags(int)  seekSeq(int)  seekFrame(double)
+//     frame      leader playhead at send time, extrapolated between blocks
+//                from the backend clock stamp (RealtimeBackend::clockStamp())
+//     flags      kFlagPaused | kFlagSeeking (leader's seek still in flight)
+//     seekSeq    bumped by every EngineSession::seek() on the leader
+//     seekFrame  that seek's target frame
+//   Sent every kSendPeriodMs, and within kPollMs of a pause toggle or a seek.
+//
+// FOLLOWER (on the OSC receive thread, per packet):
+//   - New seekSeq → requestSeek(seekFrame): both nodes jump together.
+//   - Pause flag → mConfig.paused, so the pause / resume fades line up.
+//   - Error sample e = leader frame − local frame (both extrapolated to now).
+//     Network delay only ever makes a packet's frame older, so the estimate
+//     E is the max over the last kWindow samples — the least-delayed one.
+//     Samples taken before drift trim was applied are corrected by it.
+//   - |E| > kResyncSec → seek to where the leader will be when the seek
+//     lands (local + E + measured seek latency, learned from the previous
+//     resync's residual). Otherwise |E| > kDeadbandFrames → requestSlew(E):
+//     the backend moves the playhead by one frame per block until it is
+//     trimmed out (≈ 94 frames/s at 512 / 48 kHz, far above crystal drift).
+//   - Paused on both sides: once E is stable, a silent seek to the leader
+//     frame makes the resume sample-aligned.
+//   - Nothing is measured while either side is seeking.
+//
+// What is NOT compensated: the one-way network latency of the fastest packet
+// (sub-millisecond on a wired LAN) and differences in device output latency
+// between nodes — run every node with the same interface model, sample rate
+// and --buffersize.
+//
+// THREADING:
+//   start*() / stop() on the MAIN thread (EngineSession). The leader runs
+//   one sender thread; the follower runs inside al::osc::Recv's thread.
+//   noteSeek() from any thread; status accessors as marked.
+//   Never touches the audio thread: requestSeek(), requestSlew() and
+//   clockStamp() are the backend's lock-free entry points.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "al/protocol/al_OSC.hpp"
+
+#include "RealtimeTypes.hpp"
+#include "RealtimeBackend.hpp"
+
+class ClusterSync : public al::osc::PacketHandler {
+public:
+    static constexpr int     kSendPeriodMs   = 20;     // leader heartbeat
+    static constexpr int     kPollMs         = 1;      // leader pause / seek edge poll
+    static constexpr int     kWindow         = 16;     // error samples in the max filter
+    static constexpr int     kMinSamples     = 4;      // before the first correction
+    static constexpr double  kResyncSec      = 0.050;  // |error| above this → seek
+    static constexpr int64_t kDeadbandFrames = 2;      // |error| at or below → no trim
+    static constexpr double  kInitialSeekLeadSec = 0.25; // first resync's latency guess
+    static constexpr double  kMaxSeekLeadSec     = 2.0;
+    static constexpr float   kRecvTimeoutSec     = 0.05f;
+
+    static constexpr int kFlagPaused  = 1;
+    static constexpr int kFlagSeeking = 2;
+
+    ClusterSync(RealtimeConfig& config, EngineState& state, RealtimeBackend& backend)
+        : mConfig(config), mState(state), mBackend(backend) {}
+
+    ~ClusterSync() override { stop(); }
+
+    ClusterSync(const ClusterSync&) = delete;
+    ClusterSync& operator=(const ClusterSync&) = delete;
+
+    // ── Leader ───────────────────────────────────────────────────────────
+    // peers: followers as "host:port". MAIN thread, after
+    // RealtimeBackend::init(). Returns false (err set) on a malformed peer.
+    bool startLeader(const std::vector<std::string>& peers, std::string& err) {
+        stop();
+        if (peers.empty()) {
+            err = "Cluster leader needs at least one follower (--cluster_peers host:port,...).";
+            return false;
+        }
+        for (const std::string& peer : peers) {
+            const size_t colon = peer.rfind(':');
+            int port = 0;
+            if (colon != std::string::npos && colon > 0) {
+                try { port = std::stoi(peer.substr(colon + 1)); } catch (...) { port = 0; }
+            }
+            if (port <= 0 || port > 65535) {
+                err = "Malformed cluster peer '" + peer + "' (expected host:port).";
+                mSenders.clear();
+                return false;
+            }
+            mSenders.push_back(std::make_unique<al::osc::Send>(
+                static_cast<uint16_t>(port), peer.substr(0, colon).c_str()));
+        }
+        mRole = ClusterRole::Leader;
+        mRunning.store(true, std::memory_order_relaxed);
+        mSenderThread = std::thread(&ClusterSync::leaderLoop, this);
+        std::cout << "[ClusterSync] Leader: sending /cluster/clock to " << peers.size()
+                  << " follower(s) every " << kSendPeriodMs << " ms." << std::endl;
+        return true;
+    }
+
+    /// Leader: a seek was requested (EngineSession::seek()); forwarded to
+    /// the followers within kPollMs. Any thread.
+    void noteSeek(uint64_t frame) {
+        mSeekFrame.store(frame, std::memory_order_relaxed);
+        mSeekSeq.fetch_add(1, std::memory_order_release);
+    }
+
+    // ── Follower ─────────────────────────────────────────────────────────
+    // Listens for the leader on UDP port. MAIN thread, after
+    // RealtimeBackend::init(). Returns false (err set) if the port cannot be
+    // opened.
+    bool startFollower(int port, std::string& err) {
+        stop();
+        mRecv = std::make_unique<al::osc::Recv>();
+        if (!mRecv->open(static_cast<uint16_t>(port), "", kRecvTimeoutSec)) {
+            err = "Cluster follower could not open UDP port " + std::to_string(port) + ".";
+            mRecv.reset();
+            return false;
+        }
+        mRole = ClusterRole::Follower;
+        mSeekLeadFrames = kInitialSeekLeadSec * mConfig.sampleRate;
+        mRecv->handler(*this);
+        if (!mRecv->start()) {
+            err = "Cluster follower could not start its OSC receiver.";
+            mRecv.reset();
+            mRole = ClusterRole::Off;
+            return false;
+        }
+        std::cout << "[ClusterSync] Follower: waiting for the leader clock on UDP port "
+                  << port << "." << std::endl;
+        return true;
+    }
+
+    void stop() {
+        mRunning.store(false, std::memory_order_relaxed);
+        if (mSenderThread.joinable()) mSenderThread.join();
+        mSenders.clear();
+        if (mRecv) {
+            mRecv->stop();
+            mRecv.reset();
+        }
+        mRole = ClusterRole::Off;
+    }
+
+    // ── Status ───────────────────────────────────────────────────────────
+    ClusterRole role() const { return mRole; }   // MAIN thread
+
+    // The rest: any thread.
+
+    /// Follower: filtered leader − local error in ms (positive = behind).
+    double offsetMs() const {
+        return 1000.0 * static_cast<double>(mOffsetFrames.load(std::memory_order_relaxed))
+             / static_cast<double>(mConfig.sampleRate);
+    }
+
+    /// Follower: resync seeks since start.
+    uint64_t resyncCount() const { return mResyncs.load(std::memory_order_relaxed); }
+
+    /// Follower: ms since the last leader packet (-1 = none yet).
+    double linkAgeMs() const {
+        const int64_t last = mLastPacketNs.load(std::memory_order_relaxed);
+        if (last == 0) return -1.0;
+        return static_cast<double>(nowNs() - last) / 1e6;
+    }
+
+    // ── al::osc::PacketHandler (follower, OSC receive thread) ────────────
+    void onMessage(al::osc::Message& m) override {
+        if (m.addressPattern() != "/cluster/clock") return;
+        double leaderFrame = 0.0, seekFrame = 0.0;
+        int flags = 0, seekSeq = 0;
+        m >> leaderFrame >> flags >> seekSeq >> seekFrame;
+
+        const int64_t now = nowNs();
+        mLastPacketNs.store(now, std::memory_order_relaxed);
+
+        // Leader seek: follow it (the first packet only records the count).
+        if (!mHaveSeekSeq || seekSeq != mLastSeekSeq) {
+            const bool first = !mHaveSeekSeq;
+            mHaveSeekSeq = true;
+            mLastSeekSeq = seekSeq;
+            if (!first) {
+                mBackend.requestSeek(static_cast<uint64_t>(std::max(0.0, seekFrame)));
+                resetWindow();
+                return;
+            }
+        }
+
+        const bool leaderPaused = (flags & kFlagPaused) != 0;
+        if (mConfig.paused.load(std::memory_order_relaxed) != leaderPaused) {
+            mConfig.paused.store(leaderPaused, std::memory_order_relaxed);
+            resetWindow();
+            return;
+        }
+        if ((flags & kFlagSeeking) || mBackend.seekPending()) {
+            resetWindow();
+            return;
+        }
+
+        const int64_t local   = static_cast<int64_t>(localFrameNow(now));
+        const int64_t applied = mBackend.slewApplied();
+        mSamples[mNext] = Sample{static_cast<int64_t>(std::llround(leaderFrame)) - local, applied};
+        mNext = (mNext + 1) % kWindow;
+        mCount = std::min(mCount + 1, kWindow);
+        if (mCount < kMinSamples) return;
+
+        int64_t err = INT64_MIN;
+        bool stable = true;
+        for (int i = 0; i < mCount; ++i) {
+            const int64_t e = mSamples[i].err - (applied - mSamples[i].applied);
+            stable &= (e == mSamples[0].err - (applied - mSamples[0].applied));
+            err = std::max(err, e);
+        }
+        mOffsetFrames.store(err, std::memory_order_relaxed);
+
+        // First estimate after a resync landed: its residual is how far the
+        // seek-latency guess was off.
+        if (mMeasureLead) {
+            mMeasureLead = false;
+            mSeekLeadFrames = std::clamp(mSeekLeadFrames + static_cast<double>(err),
+                                         0.0, kMaxSeekLeadSec * mConfig.sampleRate);
+        }
+
+        if (leaderPaused) {
+            // Both frozen: align exactly, silently, before the resume.
+            if (stable && err != 0) {
+                mBackend.requestSeek(static_cast<uint64_t>(std::max<int64_t>(0, local + err)));
+                resetWindow();
+            }
+            return;
+        }
+
+        const int64_t resyncFrames = static_cast<int64_t>(kResyncSec * mConfig.sampleRate);
+        if (std::llabs(err) > resyncFrames) {
+            const int64_t target = local + err + static_cast<int64_t>(mSeekLeadFrames);
+            mBackend.requestSlew(0);
+            mBackend.requestSeek(static_cast<uint64_t>(std::max<int64_t>(0, target)));
+            mResyncs.fetch_add(1, std::memory_order_relaxed);
+            mMeasureLead = true;
+            resetWindow();
+            return;
+        }
+        mBackend.requestSlew(std::llabs(err) > kDeadbandFrames ? err : 0);
+    }
+
+private:
+    struct Sample {
+        int64_t err;        // leader − local, frames
+        int64_t applied;    // RealtimeBackend::slewApplied() when taken
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Playhead at time now: the last block's start frame plus the time since
+    // its callback began, capped at two blocks; once the stamp is older than
+    // that (paused, seeking, stopped) the frame counter itself.
+    uint64_t localFrameNow(int64_t now) const {
+        uint64_t frame = 0;
+        int64_t  stampNs = 0;
+        mBackend.clockStamp(frame, stampNs);
+        const double sr       = static_cast<double>(mConfig.sampleRate);
+        const double maxAhead = 2.0 * mConfig.bufferSize;
+        const double ahead    = static_cast<double>(now - stampNs) * 1e-9 * sr;
+        if (stampNs == 0 || ahead < 0.0 || ahead > maxAhead)
+            return mState.frameCounter.load(std::memory_order_relaxed);
+        return frame + static_cast<uint64_t>(ahead);
+    }
+
+    void resetWindow() {
+        mCount = 0;
+        mNext  = 0;
+    }
+
+    void leaderLoop() {
+        using clock = std::chrono::steady_clock;
+        auto nextSend = clock::now();
+        bool lastPaused = mConfig.paused.load(std::memory_order_relaxed);
+        uint32_t lastSeekSeq = mSeekSeq.load(std::memory_order_acquire);
+        while (mRunning.load(std::memory_order_relaxed)) {
+            const auto now = clock::now();
+            const bool paused = mConfig.paused.load(std::memory_order_relaxed);
+            const uint32_t seekSeq = mSeekSeq.load(std::memory_order_acquire);
+            if (now >= nextSend || paused != lastPaused || seekSeq != lastSeekSeq) {
+                const int flags = (paused ? kFlagPaused : 0)
+                                | (mBackend.seekPending() ? kFlagSeeking : 0);
+                const double frame = static_cast<double>(localFrameNow(nowNs()));
+                const double seekFrame = static_cast<double>(mSeekFrame.load(std::memory_order_relaxed));
+                for (auto& sender : mSenders)
+                    sender->send("/cluster/clock", frame, flags, static_cast<int>(seekSeq), seekFrame);
+                lastPaused  = paused;
+                lastSeekSeq = seekSeq;
+                nextSend    = now + std::chrono::milliseconds(kSendPeriodMs);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPollMs));
+        }
+    }
+
+    RealtimeConfig&  mConfig;
+    EngineState&     mState;
+    RealtimeBackend& mBackend;
+    ClusterRole      mRole = ClusterRole::Off;   // MAIN thread (start / stop)
+
+    // Leader
+    std::vector<std::unique_ptr<al::osc::Send>> mSenders;
+    std::thread           mSenderThread;
+    std::atomic<bool>     mRunning{false};
+    std::atomic<uint32_t> mSeekSeq{0};
+    std::atomic<uint64_t> mSeekFrame{0};
+
+    // Follower — OSC receive thread only, except the status atomics
+    std::unique_ptr<al::osc::Recv> mRecv;
+    Sample  mSamples[kWindow] = {};
+    int     mCount = 0;
+    int     mNext  = 0;
+    bool    mHaveSeekSeq = false;
+    int     mLastSeekSeq = 0;
+    bool    mMeasureLead = false;
+    double  mSeekLeadFrames = 0.0;
+    std::atomic<int64_t>  mOffsetFrames{0};
+    std::atomic<uint64_t> mResyncs{0};
+    std::atomic<int64_t>  mLastPacketNs{0};
+};
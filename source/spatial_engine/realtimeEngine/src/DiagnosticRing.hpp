@@ -0,0 +1,142 @@
+// DiagnosticRing.hpp — Lossless audio-thread → main-thread diagnostic events
+//
+// Phase 14 used one-shot latches (bool event + prev/next masks per kind) that
+// the main thread exchange()d every poll: two relocations between polls
+// collapsed into one, and each event cost three scattered atomic stores.
+// This is a single-producer / single-consumer ring of fixed-size records
+// instead:
+//
+//   producer (AUDIO thread): push() — one 64-byte record written into its own
+//     cache-line slot, then one release store of the head index. No lock, no
+//     allocation; when the ring is full the event is counted in dropped()
+//     and discarded (the audio thread never waits).
+//   consumer (MAIN thread, EngineSession::consumeDiagnostics()): drain() —
+//     copies every published record out in one batch, then one release store
+//     of the tail index.
+//
+// Every record carries the playhead frame of the block that produced it and
+// a steady_clock timestamp, so the consumer can order and time events even
+// when it polls late.
+//
+// THREADING: exactly one producer thread and one consumer thread. Events
+// detected on render helper lanes (guard fires, stream underruns) are
+// aggregated into counters and pushed by the audio thread after the join.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+enum class DiagEventType : uint32_t {
+    RenderReloc,      // render-bus active mask changed        (prev → next mask)
+    DeviceReloc,      // device-bus active mask changed        (prev → next mask)
+    RenderDomReloc,   // render-bus dominant mask changed      (prev → next mask)
+    DeviceDomReloc,   // device-bus dominant mask changed      (prev → next mask)
+    RenderCluster,    // render-bus top-4 shifted by 2+ ch     (prev → next mask)
+    DeviceCluster,    // device-bus top-4 shifted by 2+ ch     (prev → next mask)
+    GuardFire,        // speaker proximity guard fired         (count = sources this block)
+    NanClamp,         // post-render NaN / Inf / extreme clamp (count = 1 per block)
+    Underrun,         // streaming buffer miss                 (count = samples this block)
+    CpuOverrun,       // callback exceeded its block budget    (value = load, 1.0 = budget)
+    RtViolation,      // RT-safety build: alloc / lock / I/O   (count = calls this block,
+                      //   next = RtViolationKind bitmask, see RtSafety.hpp)
+    Count
+};
+
+inline const char* diagEventName(DiagEventType t) {
+    switch (t) {
+        case DiagEventType::RenderReloc:    return "RELOC-RENDER";
+        case DiagEventType::DeviceReloc:    return "RELOC-DEVICE";
+        case DiagEventType::RenderDomReloc: return "DOM-RENDER";
+        case DiagEventType::DeviceDomReloc: return "DOM-DEVICE";
+        case DiagEventType::RenderCluster:  return "CLUSTER-RENDER";
+        case DiagEventType::DeviceCluster:  return "CLUSTER-DEVICE";
+        case DiagEventType::GuardFire:      return "GUARD";
+        case DiagEventType::NanClamp:       return "NAN-CLAMP";
+        case DiagEventType::Underrun:       return "UNDERRUN";
+        case DiagEventType::CpuOverrun:     return "CPU-OVERRUN";
+        case DiagEventType::RtViolation:    return "RT-VIOLATION";
+        default:                            return "?";
+    }
+}
+
+// One record per cache line.
+struct alignas(64) DiagEvent {
+    uint64_t      frame  = 0;     // playhead frame at the start of the block
+    int64_t       timeNs = 0;     // steady_clock, nanoseconds since its epoch
+    uint64_t      prev   = 0;     // mask before (relocation / cluster kinds)
+    uint64_t      next   = 0;     // mask after
+    uint64_t      count  = 0;     // occurrences this block (guard / NaN / underrun)
+    float         value  = 0.0f;  // CpuOverrun: callback load
+    DiagEventType type   = DiagEventType::Count;
+};
+static_assert(sizeof(DiagEvent) == 64, "DiagEvent must fill exactly one cache line");
+
+class DiagnosticRing {
+public:
+
+    static constexpr size_t kCapacity = 1024;   // power of two; 64 KB
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+
+    DiagnosticRing() = default;
+    DiagnosticRing(const DiagnosticRing&) = delete;
+    DiagnosticRing& operator=(const DiagnosticRing&) = delete;
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // ── Producer (AUDIO thread) ──────────────────────────────────────────
+
+    /// Publish one event (timeNs is stamped here). Returns false if the ring was full.
+    bool push(DiagEventType type, uint64_t frame,
+              uint64_t prev = 0, uint64_t next = 0, uint64_t count = 0, float value = 0.0f) {
+        const uint64_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTailCache >= kCapacity) {
+            mTailCache = mTail.load(std::memory_order_acquire);
+            if (head - mTailCache >= kCapacity) {
+                mDropped.store(mDropped.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+                return false;
+            }
+        }
+        DiagEvent ev;
+        ev.frame  = frame;
+        ev.timeNs = nowNs();
+        ev.prev   = prev;
+        ev.next   = next;
+        ev.count  = count;
+        ev.value  = value;
+        ev.type   = type;
+        mSlots[head & (kCapacity - 1)] = ev;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ── Consumer (MAIN thread) ───────────────────────────────────────────
+
+    /// Call fn(const DiagEvent&) for every published event, oldest first.
+    /// Returns the number drained.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        const uint64_t tail = mTail.load(std::memory_order_relaxed);
+        const uint64_t head = mHead.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i != head; ++i) fn(mSlots[i & (kCapacity - 1)]);
+        mTail.store(head, std::memory_order_release);
+        return static_cast<size_t>(head - tail);
+    }
+
+    /// Events discarded because the consumer fell kCapacity behind.
+    uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    DiagEvent mSlots[kCapacity];
+
+    alignas(64) std::atomic<uint64_t> mHead{0};     // producer-written
+    uint64_t                          mTailCache = 0; // producer-private copy of mTail
+    std::atomic<uint64_t>             mDropped{0};  // producer-written
+    alignas(64) std::atomic<uint64_t> mTail{0};     // consumer-written
+};
@@ -4,14 +4,21 @@
 #include "Spatializer.hpp"
 #include "RealtimeBackend.hpp"
 #include "OutputRemap.hpp"
+#include "ClusterSync.hpp"
+#include "RtSafety.hpp"
 #include "JSONLoader.hpp"
+#include "SceneCache.hpp"
 #include "LayoutLoader.hpp"
+#include "WavUtils.hpp"
 
 #include "al/ui/al_Parameter.hpp"
 #include "al/ui/al_ParameterServer.hpp"
+#include "al/protocol/al_OSC.hpp"
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 struct EngineSession::OscParams {
     al::Parameter gainDb{"gain_db", "realtime", 0.0f, -60.0f, 12.0f};
@@ -20,6 +27,8 @@ struct EngineSession::OscParams {
     al::Parameter subMixDb{"sub_mix_db", "realtime", 0.0f, -60.0f, 12.0f};
     al::ParameterBool paused{"paused", "realtime", 0.0f};
     al::Parameter elevMode{"elevation_mode", "realtime", 0.0f, 0.0f, 2.0f};
+    al::Parameter seekSec{"seek_sec", "realtime", 0.0f, 0.0f, 86400.0f};
+    al::ParameterString layoutPath{"layout_path", "realtime", ""};
 };
 
 EngineSession::EngineSession()
@@ -48,25 +57,76 @@ bool EngineSession::configureEngine(const EngineOptions& opts)
     mConfig.outputDeviceName = opts.outputDeviceName;
     mOscPort = opts.oscPort;
     mConfig.elevationMode.store(static_cast<int>(opts.elevationMode), std::memory_order_relaxed);
+    mConfig.renderThreads = std::max(1, opts.renderThreads);
+    mConfig.loaderThreads = std::max(1, opts.loaderThreads);
+    mConfig.sourceCacheMB = std::max(0, opts.sourceCacheMB);
+    mConfig.streamBudgetMB = std::max(0, opts.streamBudgetMB);
+    mConfig.streamMargin = std::max(1.0f, opts.streamMargin);
+    mConfig.silenceIndexThreads = std::max(0, opts.silenceIndexThreads);
+    mConfig.poseBakeFrames = std::max(0, opts.poseBakeFrames);
+    mConfig.sparseTopK = std::max(0, opts.sparseTopK);
+    mMinOutputChannels = std::max(0, opts.outputChannels);
+    mProfileOscPort = std::max(0, opts.profileOscPort);
+    setDiagnosticsTier(opts.diagnosticsTier, opts.diagnosticsEvery);
+
+    mClusterRole = opts.clusterRole;
+    mClusterPort = opts.clusterPort;
+    mClusterPeers = opts.clusterPeers;
+    mConfig.clusterPartition = opts.clusterRole != ClusterRole::Off
+        && (!opts.clusterSpeakers.empty() || !opts.clusterSubwoofers.empty());
+    mConfig.clusterSpeakers = opts.clusterSpeakers;
+    mConfig.clusterSubwoofers = opts.clusterSubwoofers;
+    if (mClusterRole == ClusterRole::Leader && mClusterPeers.empty()) {
+        setLastError("Cluster leader needs at least one follower (clusterPeers).");
+        return false;
+    }
     
     return true;
 }
 
 bool EngineSession::loadScene(const SceneInput& sceneIn)
 {
-    mConfig.scenePath = sceneIn.scenePath;
-    mConfig.sourcesFolder = sceneIn.sourcesFolder;
-    mConfig.admFile = sceneIn.admFile;
-
-    std::cout << "[EngineSession] Loading LUSID scene: " << mConfig.scenePath << std::endl;
-    mSceneData = std::make_unique<SpatialData>();
+    std::cout << "[EngineSession] Loading LUSID scene: " << sceneIn.scenePath << std::endl;
+    SpatialData scene;
     try {
-        *mSceneData = JSONLoader::loadLusidScene(mConfig.scenePath);
+        scene = SceneCache::loadLusidScene(sceneIn.scenePath);
     } catch (const std::exception& e) {
         setLastError(std::string("Failed to load LUSID scene: ") + e.what());
         return false;
     }
-    
+    return adoptScene(sceneIn, std::move(scene));
+}
+
+bool EngineSession::loadScene(const SceneInput& sceneIn, SpatialData scene)
+{
+    std::cout << "[EngineSession] Taking in-memory scene (no JSON parse)." << std::endl;
+    // Pose and findKeyframeSegment() rely on the invariants JSONLoader
+    // establishes; apply the same cleanup rather than trust the producer.
+    if (scene.timeUnit != TimeUnit::Seconds) {
+        setLastError("In-memory scene must have keyframe times in seconds.");
+        return false;
+    }
+    int dropped = 0;
+    for (auto& [name, frames] : scene.sources) {
+        if (name == "LFE") continue;  // LFE is not spatialized
+        dropped += JSONLoader::sanitizeKeyframes(name, frames);
+    }
+    if (dropped > 0) {
+        std::cerr << "[EngineSession] In-memory scene: " << dropped
+                  << " invalid keyframe(s) dropped." << std::endl;
+    }
+    return adoptScene(sceneIn, std::move(scene));
+}
+
+// Shared tail of both loadScene() overloads: keep the parsed scene and open
+// its audio (mono stems or one ADM file).
+bool EngineSession::adoptScene(const SceneInput& sceneIn, SpatialData&& scene)
+{
+    mConfig.scenePath = sceneIn.scenePath;
+    mConfig.sourcesFolder = sceneIn.sourcesFolder;
+    mConfig.admFile = sceneIn.admFile;
+    mSceneData = std::make_unique<SpatialData>(std::move(scene));
+
     std::cout << "[EngineSession] Scene loaded: " << mSceneData->sources.size() << " sources";
     if (mSceneData->duration > 0) {
         std::cout << ", duration: " << mSceneData->duration << "s";
@@ -102,36 +162,59 @@ bool EngineSession::applyLayout(const LayoutInput& layoutIn)
     mConfig.layoutPath = layoutIn.layoutPath;
     mRemapCsv = layoutIn.remapCsvPath;
 
-    std::cout << "[EngineSession] Loading speaker layout: " << mConfig.layoutPath << std::endl;
+    std::string err;
+    if (!buildLayout(mConfig.layoutPath, 0, mPose, mSpatializer, err)) {
+        setLastError(err);
+        return false;
+    }
+    if (mConfig.outputChannels < mMinOutputChannels) {
+        std::cout << "[EngineSession] Opening " << mMinOutputChannels << " output channels (layout uses "
+                  << mConfig.outputChannels << ") — headroom for switchLayout()." << std::endl;
+        mConfig.outputChannels = mMinOutputChannels;
+    }
+    std::cout << "[EngineSession] Output channels (from layout): " << mConfig.outputChannels << std::endl;
+
+    return true;
+}
+
+// Load a layout and build the Pose + Spatializer pair for it. Used by
+// applyLayout() (main thread, fixedOutputChannels = 0: the layout sets the
+// device width) and by the switchLayout() build thread (fixedOutputChannels
+// = the open device width). Touches no session state except reading
+// mSceneData, which is immutable after loadScene().
+bool EngineSession::buildLayout(const std::string& layoutPath, int fixedOutputChannels,
+                                std::unique_ptr<Pose>& pose,
+                                std::unique_ptr<Spatializer>& spatializer,
+                                std::string& err)
+{
+    std::cout << "[EngineSession] Loading speaker layout: " << layoutPath << std::endl;
     SpeakerLayoutData layout;
     try {
-        layout = LayoutLoader::loadLayout(mConfig.layoutPath);
+        layout = LayoutLoader::loadLayout(layoutPath);
     } catch (const std::exception& e) {
-        setLastError(std::string("Failed to load speaker layout: ") + e.what());
+        err = std::string("Failed to load speaker layout: ") + e.what();
         return false;
     }
     std::cout << "[EngineSession] Layout loaded: " << layout.speakers.size()
               << " speakers, " << layout.subwoofers.size() << " subwoofers." << std::endl;
 
-    mPose = std::make_unique<Pose>(mConfig, mState);
-    if (!mPose->loadScene(*mSceneData, layout)) {
-        setLastError("Pose agent failed to initialize.");
+    pose = std::make_unique<Pose>(mConfig, mState);
+    if (!pose->loadScene(*mSceneData, layout)) {
+        err = "Pose agent failed to initialize.";
         return false;
     }
-    std::cout << "[EngineSession] Pose agent ready: " << mPose->numSources()
+    std::cout << "[EngineSession] Pose agent ready: " << pose->numSources()
               << " source positions will be computed per block." << std::endl;
-              
-    mSpatializer = std::make_unique<Spatializer>(mConfig, mState);
-    if (!mSpatializer->init(layout)) {
-        setLastError("Spatializer initialization failed.");
+
+    spatializer = std::make_unique<Spatializer>(mConfig, mState);
+    if (!spatializer->init(layout, fixedOutputChannels)) {
+        err = "Spatializer initialization failed.";
         return false;
     }
-    std::cout << "[EngineSession] Spatializer ready: DBAP with " << mSpatializer->numSpeakers()
+    std::cout << "[EngineSession] Spatializer ready: DBAP with " << spatializer->numSpeakers()
               << " speakers, focus=" << mConfig.dbapFocus.load() << "." << std::endl;
-    std::cout << "[EngineSession] Output channels (from layout): " << mConfig.outputChannels << std::endl;
-
-    mSpatializer->prepareForSources(mPose->numSources());
 
+    spatializer->prepareForSources(pose->numSources());
     return true;
 }
 
@@ -214,9 +297,20 @@ bool EngineSession::start()
             this->mConfig.elevationMode.store(mode, std::memory_order_relaxed);
         });
 
+        mOscParams->seekSec.registerChangeCallback([this](float sec) {
+            this->seek(static_cast<double>(sec));
+        });
+
+        // OSC listener thread → update(): switchLayout() owns main-thread state.
+        mOscParams->layoutPath.registerChangeCallback([this](std::string path) {
+            std::lock_guard<std::mutex> lk(this->mRequestedLayoutMutex);
+            this->mRequestedLayout = std::move(path);
+        });
+
         *mParamServer << mOscParams->gainDb << mOscParams->focus << mOscParams->spkMixDb
                       << mOscParams->subMixDb << mOscParams->paused
-                      << mOscParams->elevMode;
+                      << mOscParams->elevMode << mOscParams->seekSec
+                      << mOscParams->layoutPath;
 
         if (!mParamServer->serverRunning()) {
             setLastError("ParameterServer failed to start.");
@@ -235,19 +329,182 @@ bool EngineSession::start()
     mBackend->setSpatializer(mSpatializer.get());
     mBackend->cacheSourceNames(mStreaming->sourceNames());
 
+    // Cluster clock before the first block, so a follower's first
+    // correction is queued by the time audio starts.
+    if (mClusterRole != ClusterRole::Off) {
+        mCluster = std::make_unique<ClusterSync>(mConfig, mState, *mBackend);
+        std::string err;
+        const bool ok = (mClusterRole == ClusterRole::Leader)
+            ? mCluster->startLeader(mClusterPeers, err)
+            : mCluster->startFollower(mClusterPort, err);
+        if (!ok) {
+            setLastError(err);
+            mCluster.reset();
+            return false;
+        }
+    }
+
     mStreaming->startLoader();
+    mSpatializer->startWorkers();
 
     if (!mBackend->start()) {
         setLastError("Backend failed to start.");
+        mCluster.reset();
+        mSpatializer->stopWorkers();
         mStreaming->shutdown();
         return false;
     }
 
+    if (mProfileOscPort > 0) {
+        mProfileSender = std::make_unique<al::osc::Send>(
+            static_cast<uint16_t>(mProfileOscPort), "127.0.0.1");
+        mLastProfileSend = std::chrono::steady_clock::now();
+        std::cout << "[EngineSession] Streaming stage timings to OSC 127.0.0.1:"
+                  << mProfileOscPort << " (/realtime/profile/<stage> p50 p99 max, µs)." << std::endl;
+    }
+
+    return true;
+}
+
+bool EngineSession::bounce(const BounceOptions& opts)
+{
+    if (!mStreaming || !mPose || !mSpatializer) {
+        setLastError("loadScene, applyLayout and configureRuntime must succeed before bounce.");
+        return false;
+    }
+    if (mBackend) {
+        setLastError("bounce cannot run while the engine is started.");
+        return false;
+    }
+    if (opts.outputPath.empty()) {
+        setLastError("bounce needs an output path.");
+        return false;
+    }
+
+    // Length: explicit, else the scene's, else the longest source.
+    const double sr = static_cast<double>(mConfig.sampleRate);
+    uint64_t totalFrames = 0;
+    if (opts.durationSec > 0.0) {
+        totalFrames = static_cast<uint64_t>(opts.durationSec * sr);
+    } else if (mSceneData && mSceneData->duration > 0.0) {
+        totalFrames = static_cast<uint64_t>(mSceneData->duration * sr);
+    } else {
+        for (const auto& name : mStreaming->sourceNames())
+            totalFrames = std::max(totalFrames, mStreaming->totalFrames(name));
+    }
+    if (totalFrames == 0) {
+        setLastError("bounce: nothing to render (zero duration).");
+        return false;
+    }
+
+    mBackend = std::make_unique<RealtimeBackend>(mConfig, mState);
+    if (!mBackend->initFreewheel()) {
+        mBackend.reset();
+        setLastError("Backend freewheel initialization failed.");
+        return false;
+    }
+    mBackend->setStreaming(mStreaming.get());
+    mBackend->setPose(mPose.get());
+    mBackend->setSpatializer(mSpatializer.get());
+    mBackend->cacheSourceNames(mStreaming->sourceNames());
+
+    mStreaming->startLoader();
+    mSpatializer->startWorkers();
+
+    // Output is gathered into ~1 s planar chunks for the writer thread.
+    constexpr size_t kBounceQueueSlabs = 8;
+    const int      numChannels = mConfig.outputChannels;
+    const unsigned blockFrames = static_cast<unsigned>(mConfig.bufferSize);
+    const size_t   chunkFrames = std::max<size_t>(blockFrames,
+                                     (static_cast<size_t>(sr) / blockFrames) * blockFrames);
+    MultiWavData chunk;
+    chunk.sampleRate = mConfig.sampleRate;
+    chunk.channels   = numChannels;
+    chunk.samples.assign(numChannels, std::vector<float>(chunkFrames, 0.0f));
+
+    std::cout << "[EngineSession] Freewheel bounce: " << (totalFrames / sr) << " s, "
+              << numChannels << " channels → " << opts.outputPath << std::endl;
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    uint64_t loaderWaits = 0;
+    uint64_t frame = 0;
+    int lastPercent = -1;
+    const auto cancelled = [&opts]() {
+        return opts.cancel && opts.cancel->load(std::memory_order_relaxed);
+    };
+    try {
+        MultichannelWavWriter writer;
+        writer.open(opts.outputPath, numChannels, mConfig.sampleRate,
+                    static_cast<size_t>(totalFrames), kBounceQueueSlabs);
+        size_t filled = 0;
+        while (frame < totalFrames) {
+            if (cancelled()) {
+                std::cout << "[EngineSession] Bounce cancelled at "
+                          << (frame / sr) << " s." << std::endl;
+                break;
+            }
+            // Virtual clock: never outrun the loader (see Streaming::framesReady()).
+            if (!mStreaming->framesReady(frame, blockFrames)) {
+                ++loaderWaits;
+                do {
+                    mStreaming->notifyPlayhead(frame);
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                } while (!mStreaming->framesReady(frame, blockFrames) && !cancelled());
+                if (cancelled()) continue;   // reported at the top of the loop
+            }
+
+            const al::AudioIOData& io = mBackend->freewheelBlock();
+            const size_t n = static_cast<size_t>(std::min<uint64_t>(blockFrames, totalFrames - frame));
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memcpy(chunk.samples[ch].data() + filled, io.outBuffer(ch), n * sizeof(float));
+            filled += n;
+            frame  += n;
+            if (filled == chunkFrames) {
+                writer.append(chunk, filled);
+                filled = 0;
+            }
+
+            const int percent = static_cast<int>(100 * frame / totalFrames);
+            if (percent / 10 != lastPercent / 10) {
+                std::cout << "[EngineSession] Bounce " << percent << "%" << std::endl;
+                lastPercent = percent;
+            }
+        }
+        if (filled > 0) writer.append(chunk, filled);
+        writer.close();
+    } catch (const std::exception& e) {
+        endBounce();
+        setLastError(std::string("Bounce failed: ") + e.what());
+        return false;
+    }
+    endBounce();
+
+    const double wallSec = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wallStart).count();
+    std::cout << "[EngineSession] Bounce complete: " << (frame / sr) << " s in "
+              << wallSec << " s (" << ((wallSec > 0.0) ? (frame / sr) / wallSec : 0.0)
+              << "× realtime, " << loaderWaits << " loader wait(s), "
+              << mStreaming->totalUnderruns() << " underrun sample(s))." << std::endl;
     return true;
 }
 
+// Undo bounce()'s start-up: the render workers and loader stop, the
+// streams are rewound to frame 0 and the freewheel backend is released, so
+// the session can start() or bounce() again.
+void EngineSession::endBounce()
+{
+    mSpatializer->stopWorkers();
+    mStreaming->stopLoader();
+    mBackend->shutdown();
+    mBackend.reset();
+    mState.frameCounter.store(0, std::memory_order_relaxed);
+    mState.playbackTimeSec.store(0.0, std::memory_order_relaxed);
+}
+
 void EngineSession::shutdown()
 {
+    mProfileSender.reset();
+    mCluster.reset();
     if (mParamServer) {
         mParamServer->stopServer();
         mParamServer.reset();
@@ -255,14 +512,27 @@ void EngineSession::shutdown()
     if (mOscParams) {
         mOscParams.reset();
     }
+    // The build thread may be about to publish to the backend.
+    if (mLayoutThread.joinable()) {
+        mLayoutThread.join();
+    }
     if (mBackend) {
         mBackend->shutdown();
         mBackend.reset();
     }
+    // Stream stopped: an in-flight switch's pair is no longer referenced.
+    mNextSpatializer.reset();
+    mNextPose.reset();
+    if (mSpatializer) {
+        mSpatializer->stopWorkers();
+    }
     if (mStreaming) {
         mStreaming->shutdown();
         mStreaming.reset();
     }
+    if (mPose) {
+        mPose->stopBaking();
+    }
 }
 
 void EngineSession::setPaused(bool isPaused)
@@ -270,6 +540,15 @@ void EngineSession::setPaused(bool isPaused)
     mConfig.paused.store(isPaused, std::memory_order_relaxed);
 }
 
+void EngineSession::seek(double timeSec)
+{
+    if (!mBackend) return;
+    const double frame = std::max(0.0, timeSec) * static_cast<double>(mConfig.sampleRate);
+    mBackend->requestSeek(static_cast<uint64_t>(std::llround(frame)));
+    if (mCluster && mCluster->role() == ClusterRole::Leader)
+        mCluster->noteSeek(static_cast<uint64_t>(std::llround(frame)));
+}
+
 void EngineSession::setMasterGainDb(float dB)
 {
     mConfig.masterGain.store(std::pow(10.0f, dB / 20.0f), std::memory_order_relaxed);
@@ -295,9 +574,117 @@ void EngineSession::setElevationMode(ElevationMode mode)
     mConfig.elevationMode.store(static_cast<int>(mode), std::memory_order_relaxed);
 }
 
+void EngineSession::setDiagnosticsTier(DiagnosticsTier tier, int everyNBlocks)
+{
+    mConfig.diagnosticsEvery.store(std::max(1, everyNBlocks), std::memory_order_relaxed);
+    mConfig.diagnosticsTier.store(static_cast<int>(tier), std::memory_order_relaxed);
+}
+
+bool EngineSession::switchLayout(const LayoutInput& layoutIn)
+{
+    if (!mBackend || !mBackend->isRunning()) {
+        setLastError("switchLayout requires a started engine.");
+        return false;
+    }
+    if (mLayoutThread.joinable()) {
+        setLastError("A layout switch is already in progress.");
+        return false;
+    }
+    if (!layoutIn.remapCsvPath.empty()) {
+        std::cerr << "[EngineSession] WARNING: --remap CSV is ignored by switchLayout(); "
+                  << "routing comes from the new layout." << std::endl;
+    }
+    mLayoutBuildDone.store(false, std::memory_order_relaxed);
+    mLayoutBuildOk = false;
+    mLayoutBuildError.clear();
+    mNextLayoutPath = layoutIn.layoutPath;
+    mLayoutThread = std::thread(&EngineSession::layoutBuildThread, this, layoutIn.layoutPath);
+    return true;
+}
+
+bool EngineSession::layoutSwitchPending() const
+{
+    return mLayoutThread.joinable();
+}
+
+// Layout build thread: everything allocating or slow (JSON parse, Pose
+// tracks, DBAP tables, routing, render worker spawn) happens here while the
+// audio thread keeps rendering the current layout. The finished pair is
+// published lock-free; the backend crossfades to it at a block boundary.
+void EngineSession::layoutBuildThread(std::string layoutPath)
+{
+    std::unique_ptr<Pose> pose;
+    std::unique_ptr<Spatializer> spatializer;
+    std::string err;
+    bool ok = buildLayout(layoutPath, mConfig.outputChannels, pose, spatializer, err);
+    if (ok) {
+        spatializer->startWorkers();
+        if (!mBackend->requestLayoutSwap(pose.get(), spatializer.get())) {
+            err = "Backend refused the layout swap (previous swap still in flight).";
+            ok = false;
+        }
+    }
+    if (ok) {
+        mNextPose = std::move(pose);
+        mNextSpatializer = std::move(spatializer);
+    }
+    mLayoutBuildOk = ok;
+    mLayoutBuildError = err;
+    mLayoutBuildDone.store(true, std::memory_order_release);
+}
+
+// MAIN thread (update()). Completes a switch once the build thread is done
+// and the backend has stopped rendering the outgoing pair; destroying that
+// pair here joins its render workers and bake thread off the audio thread.
+void EngineSession::finishLayoutSwitch()
+{
+    if (!mLayoutThread.joinable() || !mLayoutBuildDone.load(std::memory_order_acquire)) return;
+    if (mLayoutBuildOk && mBackend && mBackend->layoutSwapPending()) return;   // still crossfading
+    mLayoutThread.join();
+
+    if (!mLayoutBuildOk) {
+        setLastError("Layout switch failed: " + mLayoutBuildError);
+        std::cerr << "[EngineSession] " << mLastError << " Keeping the current layout." << std::endl;
+        return;
+    }
+    mSpatializer = std::move(mNextSpatializer);
+    mPose = std::move(mNextPose);
+    mConfig.layoutPath = mNextLayoutPath;
+    std::cout << "[EngineSession] Layout switched to " << mConfig.layoutPath << " ("
+              << mSpatializer->numSpeakers() << " speakers, "
+              << mSpatializer->numInternalChannels() << " internal channels)." << std::endl;
+}
+
 void EngineSession::update()
 {
-    // No deferred work currently. Retained for API stability.
+    std::string requestedLayout;
+    {
+        std::lock_guard<std::mutex> lk(mRequestedLayoutMutex);
+        requestedLayout.swap(mRequestedLayout);
+    }
+    if (!requestedLayout.empty()) {
+        LayoutInput layoutIn;
+        layoutIn.layoutPath = requestedLayout;
+        if (!switchLayout(layoutIn)) {
+            std::cerr << "[EngineSession] Layout request ignored: " << mLastError << std::endl;
+        }
+    }
+    finishLayoutSwitch();
+
+    // Stage-timing OSC stream, throttled to 1 Hz regardless of call rate.
+    if (mProfileSender && mBackend) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - mLastProfileSend >= std::chrono::seconds(1)) {
+            mLastProfileSend = now;
+            StageTiming timing[kNumProfileStages];
+            mBackend->profiler().snapshot(timing);
+            for (int i = 0; i < kNumProfileStages; ++i) {
+                const std::string addr = std::string("/realtime/profile/")
+                    + profileStageName(static_cast<ProfileStage>(i));
+                mProfileSender->send(addr, timing[i].p50Us, timing[i].p99Us, timing[i].maxUs);
+            }
+        }
+    }
 }
 
 EngineStatus EngineSession::queryStatus() const
@@ -315,37 +702,60 @@ EngineStatus EngineSession::queryStatus() const
     st.nanGuardCount = mState.nanGuardCount.load(std::memory_order_relaxed);
     st.speakerProximityCount = mState.speakerProximityCount.load(std::memory_order_relaxed);
     st.paused = mConfig.paused.load(std::memory_order_relaxed);
+    st.seeking = mBackend && mBackend->seekPending();
     st.isExitRequested = (mBackend && !mBackend->isRunning()); 
+    if (mBackend) {
+        mBackend->profiler().snapshot(st.stageTiming);
+    } else {
+        for (auto& t : st.stageTiming) t = StageTiming{};
+    }
+    st.clusterRole = mCluster ? mCluster->role() : ClusterRole::Off;
+    st.clusterOffsetMs = mCluster ? mCluster->offsetMs() : 0.0;
+    st.clusterLinkAgeMs = mCluster ? mCluster->linkAgeMs() : -1.0;
+    st.clusterResyncs = mCluster ? mCluster->resyncCount() : 0;
     return st;
 }
 
 DiagnosticEvents EngineSession::consumeDiagnostics()
 {
-    DiagnosticEvents ev;
-    
-    ev.renderRelocEvent = mState.renderRelocEvent.exchange(false, std::memory_order_relaxed);
-    ev.renderRelocPrev = mState.renderRelocPrev.load(std::memory_order_relaxed);
-    ev.renderRelocNext = mState.renderRelocNext.load(std::memory_order_relaxed);
-
-    ev.deviceRelocEvent = mState.deviceRelocEvent.exchange(false, std::memory_order_relaxed);
-    ev.deviceRelocPrev = mState.deviceRelocPrev.load(std::memory_order_relaxed);
-    ev.deviceRelocNext = mState.deviceRelocNext.load(std::memory_order_relaxed);
-
-    ev.renderDomRelocEvent = mState.renderDomRelocEvent.exchange(false, std::memory_order_relaxed);
-    ev.renderDomRelocPrev = mState.renderDomRelocPrev.load(std::memory_order_relaxed);
-    ev.renderDomRelocNext = mState.renderDomRelocNext.load(std::memory_order_relaxed);
-
-    ev.deviceDomRelocEvent = mState.deviceDomRelocEvent.exchange(false, std::memory_order_relaxed);
-    ev.deviceDomRelocPrev = mState.deviceDomRelocPrev.load(std::memory_order_relaxed);
-    ev.deviceDomRelocNext = mState.deviceDomRelocNext.load(std::memory_order_relaxed);
-
-    ev.renderClusterEvent = mState.renderClusterEvent.exchange(false, std::memory_order_relaxed);
-    ev.renderClusterPrev = mState.renderClusterPrev.load(std::memory_order_relaxed);
-    ev.renderClusterNext = mState.renderClusterNext.load(std::memory_order_relaxed);
+    DiagnosticEvents ev{};
+
+    mState.diagEvents.drain([&ev](const DiagEvent& e) { ev.events.push_back(e); });
+    ev.dropped = mState.diagEvents.dropped();
+
+    auto summarize = [](const DiagEvent& e, bool& flag, uint64_t& prev, uint64_t& next) {
+        if (!flag) prev = e.prev;
+        next = e.next;
+        flag = true;
+    };
+    for (const DiagEvent& e : ev.events) {
+        switch (e.type) {
+            case DiagEventType::RenderReloc:
+                summarize(e, ev.renderRelocEvent, ev.renderRelocPrev, ev.renderRelocNext); break;
+            case DiagEventType::DeviceReloc:
+                summarize(e, ev.deviceRelocEvent, ev.deviceRelocPrev, ev.deviceRelocNext); break;
+            case DiagEventType::RenderDomReloc:
+                summarize(e, ev.renderDomRelocEvent, ev.renderDomRelocPrev, ev.renderDomRelocNext); break;
+            case DiagEventType::DeviceDomReloc:
+                summarize(e, ev.deviceDomRelocEvent, ev.deviceDomRelocPrev, ev.deviceDomRelocNext); break;
+            case DiagEventType::RenderCluster:
+                summarize(e, ev.renderClusterEvent, ev.renderClusterPrev, ev.renderClusterNext); break;
+            case DiagEventType::DeviceCluster:
+                summarize(e, ev.deviceClusterEvent, ev.deviceClusterPrev, ev.deviceClusterNext); break;
+            case DiagEventType::RtViolation:
+                ev.rtViolations += e.count; break;
+            default: break;
+        }
+    }
 
-    ev.deviceClusterEvent = mState.deviceClusterEvent.exchange(false, std::memory_order_relaxed);
-    ev.deviceClusterPrev = mState.deviceClusterPrev.load(std::memory_order_relaxed);
-    ev.deviceClusterNext = mState.deviceClusterNext.load(std::memory_order_relaxed);
+    if (RtSafety::kEnabled) {
+        RtViolationSample samples[RtSafety::kSampleSlots];
+        const size_t n = RtSafety::takeSamples(samples, RtSafety::kSampleSlots);
+        for (size_t i = 0; i < n; ++i) {
+            ev.rtViolationSamples.push_back({rtViolationName(samples[i].kind), samples[i].frame,
+                                             RtSafety::symbolize(samples[i])});
+        }
+    }
 
     return ev;
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "RealtimeTypes.hpp"
+#include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 #include <atomic>
+#include <mutex>
+#include <thread>
 
 // Forward declarations
 class Streaming;
@@ -11,8 +15,10 @@ class Pose;
 class Spatializer;
 class RealtimeBackend;
 class OutputRemap;
+class ClusterSync;
 struct SpatialData; // Forward declare Scene data container
 namespace al { class ParameterServer; }
+namespace al { namespace osc { class Send; } }
 
 struct EngineStatus {
     double timeSec;
@@ -27,10 +33,31 @@ struct EngineStatus {
     uint64_t nanGuardCount;
     uint64_t speakerProximityCount;
     bool paused;
+    bool seeking; // A seek() is fading out or waiting for the streaming loader
     bool isExitRequested; // Added for main thread polling
+    StageTiming stageTiming[kNumProfileStages]; // Rolling per-stage callback timing, index = ProfileStage
+    ClusterRole clusterRole;     // Off unless EngineOptions::clusterRole was set
+    double clusterOffsetMs;      // Follower: leader − local playhead after filtering (positive = behind)
+    double clusterLinkAgeMs;     // Follower: time since the last leader clock packet (-1 = none yet)
+    uint64_t clusterResyncs;     // Follower: corrective seeks since start
+};
+
+// One stack-sampled real-time contract violation (RT-safety builds, see
+// RtSafety.hpp), symbolized on the consuming thread.
+struct RtViolationReport {
+    std::string kind;                 // "alloc", "free", "lock" or "file-io"
+    uint64_t frame;                   // playhead frame of the offending block
+    std::vector<std::string> stack;   // innermost caller first, "module(symbol+off) [pc]"
 };
 
 struct DiagnosticEvents {
+    // Every event since the previous consumeDiagnostics() call, oldest first
+    // (lossless unless `dropped` grew — the ring holds DiagnosticRing::kCapacity).
+    std::vector<DiagEvent> events;
+    uint64_t dropped; // Total events lost to a full ring since start
+
+    // Per-kind summary of `events`: flag set if any occurred; Prev is the
+    // first such event's before-mask, Next the last one's after-mask.
     bool renderRelocEvent;
     uint64_t renderRelocPrev;
     uint64_t renderRelocNext;
@@ -54,6 +81,13 @@ struct DiagnosticEvents {
     bool deviceClusterEvent;
     uint64_t deviceClusterPrev;
     uint64_t deviceClusterNext;
+
+    // Built with -DSPATIALROOT_RT_SAFETY=ON: allocation / lock / file calls
+    // made inside processBlock() (or a render lane's share of it) since the
+    // previous call, and stack samples of the first few per block (at most
+    // RtSafety::kSampleSlots pending). Always 0 / empty in normal builds.
+    uint64_t rtViolations;
+    std::vector<RtViolationReport> rtViolationSamples;
 };
 
 // --- New Core API Typed Structs (per Design Doc) ---
@@ -63,6 +97,26 @@ struct EngineOptions {
     std::string outputDeviceName;
     int oscPort = 9009;
     ElevationMode elevationMode = ElevationMode::RescaleAtmosUp;
+    int renderThreads = 1;       // Spatializer render lanes (1 = audio thread only)
+    int loaderThreads = 2;       // Streaming refill threads (1 = loader thread only)
+    int sourceCacheMB = 0;       // MB of released source chunks kept for other sessions / re-reads
+    int streamBudgetMB = 0;      // >0 = size per-source chunks to fit N MB of stream buffers (0 = fixed 10 s)
+    float streamMargin = 4.0f;   // Stream budget: required runway / measured refill time per source
+    int silenceIndexThreads = 2; // Background silence-map indexers (0 = read and render every frame)
+    int poseBakeFrames = 0;      // >0 = bake source trajectories on an N-frame grid (0 = live)
+    int sparseTopK = 0;          // >0 = mix each source into its K strongest speakers only (0 = all)
+    int outputChannels = 0;      // >0 = open at least this many device channels (room for switchLayout())
+    int profileOscPort = 0;      // >0 = send stage timings once per second to 127.0.0.1:port
+    DiagnosticsTier diagnosticsTier = DiagnosticsTier::Full; // Phase 14 bus analysis rate
+    int diagnosticsEvery = 8;    // Decimated tier: analyse one block in N
+
+    // Cluster playback (ClusterSync.hpp): every node runs the same scene and layout.
+    ClusterRole clusterRole = ClusterRole::Off;
+    int clusterPort = 9110;                  // Follower: UDP port the leader's clock arrives on
+    std::vector<std::string> clusterPeers;   // Leader: followers as "host:port"
+    std::vector<int> clusterSpeakers;        // Layout speaker indices this node renders
+    std::vector<int> clusterSubwoofers;      // Layout subwoofer indices this node renders
+                                             // (both empty = the whole layout)
 };
 
 struct SceneInput {
@@ -80,6 +134,12 @@ struct LayoutInput {
     std::string remapCsvPath;
 };
 
+struct BounceOptions {
+    std::string outputPath;      // Multichannel WAV (RF64 past 4 GB), one channel per output bus channel
+    double durationSec = 0.0;    // >0 = bounce this many seconds (0 = scene duration, else longest source)
+    const std::atomic<bool>* cancel = nullptr; // Optional: polled once per block; true stops early (file stays valid)
+};
+
 struct RuntimeParams {
     float masterGainDb = 0.0f;   // Master gain in dB. Range: -60–+12 dB. 0 dB = unity.
     float dbapFocus = 1.5f;
@@ -94,12 +154,33 @@ public:
 
     bool configureEngine(const EngineOptions& opts);
     bool loadScene(const SceneInput& sceneIn);
+
+    // In-process scene handoff — loadScene() for a scene that is already in
+    // memory (e.g. produced by a transcoder linked into the host), skipping
+    // the LUSID JSON write/parse round trip. sceneIn.scenePath is not read;
+    // sourcesFolder / admFile select the audio exactly as above, so an ADM
+    // master streams straight from its BW64 through MultichannelReader.
+    // The scene must be in loadLusidScene() form: times in seconds, each
+    // source's keyframes sorted by time (violations fail with an error).
+    bool loadScene(const SceneInput& sceneIn, SpatialData scene);
     bool applyLayout(const LayoutInput& layoutIn);
     bool configureRuntime(const RuntimeParams& params);
     bool start();
     void shutdown();
 
+    // Freewheel bounce — use instead of start(), after configureRuntime().
+    // Runs the realtime render path (Pose → Spatializer → backend fades) on
+    // the calling thread as fast as the CPU allows, with the streaming
+    // loader synchronized to the virtual playhead, and streams the output
+    // bus to a WAV file. Blocks until the file is closed; the result is what
+    // an unstarved realtime run would have sent to the device. No audio
+    // device or OSC server is opened. On return (success, cancel or error)
+    // the session is back in its configured state: start() or another
+    // bounce() may follow, or shutdown().
+    bool bounce(const BounceOptions& opts);
+
     void setPaused(bool isPaused); // Transport control API
+    void seek(double timeSec);     // Jump playback (lock-free; lands within a few buffer periods). No effect before start().
 
     // V1.1 runtime setter surface — safe to call after start(), before shutdown().
     // All writes use std::memory_order_relaxed, identical to the OSC callback implementations.
@@ -109,6 +190,19 @@ public:
     void setSpeakerMixDb(float dB);
     void setSubMixDb(float dB);
     void setElevationMode(ElevationMode mode);
+    void setDiagnosticsTier(DiagnosticsTier tier, int everyNBlocks = 8);
+
+    // Layout hot-swap — safe to call after start(), before shutdown().
+    // Loads the layout and builds its Pose + Spatializer on a background
+    // thread while playback continues, then the audio thread crossfades to
+    // it at a block boundary. Streams are not reloaded and the device stays
+    // open, so the layout must fit the open output bus (see
+    // EngineOptions::outputChannels). Returns false if the engine is not
+    // running or a switch is already in flight; a layout that fails to load
+    // is reported through getLastError() from update(). remapCsvPath is
+    // ignored (routing comes from the new layout).
+    bool switchLayout(const LayoutInput& layoutIn);
+    bool layoutSwitchPending() const;
 
     void update();
 
@@ -118,6 +212,13 @@ public:
 
 private:
     void setLastError(const std::string& err);
+    bool adoptScene(const SceneInput& sceneIn, SpatialData&& scene);
+    bool buildLayout(const std::string& layoutPath, int fixedOutputChannels,
+                     std::unique_ptr<Pose>& pose, std::unique_ptr<Spatializer>& spatializer,
+                     std::string& err);
+    void layoutBuildThread(std::string layoutPath);
+    void finishLayoutSwitch();
+    void endBounce();
 
     RealtimeConfig mConfig;
     EngineState mState;
@@ -130,10 +231,35 @@ private:
     std::unique_ptr<Spatializer> mSpatializer;
     std::unique_ptr<RealtimeBackend> mBackend;
     std::unique_ptr<OutputRemap> mOutputRemap;
+    std::unique_ptr<ClusterSync> mCluster;
     std::unique_ptr<al::ParameterServer> mParamServer;
     struct OscParams;
     std::unique_ptr<OscParams> mOscParams;
 
     int mOscPort = 9009;
     std::string mRemapCsv;
+    int mMinOutputChannels = 0;
+    ClusterRole mClusterRole = ClusterRole::Off;
+    int mClusterPort = 9110;
+    std::vector<std::string> mClusterPeers;
+
+    // Layout hot-swap (switchLayout()). The build thread owns mNext* and
+    // mLayoutBuild* until it sets mLayoutBuildDone (release); update() then
+    // joins it and, once the backend has retired the old pair, moves mNext*
+    // into mPose / mSpatializer. mRequestedLayout carries an OSC
+    // /realtime/layout_path request (OSC listener thread) to update().
+    std::thread mLayoutThread;
+    std::atomic<bool> mLayoutBuildDone{false};
+    bool mLayoutBuildOk = false;
+    std::string mLayoutBuildError;
+    std::string mNextLayoutPath;
+    std::unique_ptr<Pose> mNextPose;
+    std::unique_ptr<Spatializer> mNextSpatializer;
+    std::mutex mRequestedLayoutMutex;
+    std::string mRequestedLayout;
+
+    // Stage-timing OSC stream (update(), main thread). Off when port is 0.
+    int mProfileOscPort = 0;
+    std::unique_ptr<al::osc::Send> mProfileSender;
+    std::chrono::steady_clock::time_point mLastProfileSend;
 };
@@ -0,0 +1,231 @@
+// GainMix.hpp — Vectorized gain-apply kernels for the Spatializer mix stage
+//
+// The Spatializer computes one normalized DBAP gain vector per source per
+// segment (see Spatializer::computeDbapGains()). These kernels apply one
+// entry of that vector to the source's mono block and accumulate the result
+// into a single render-bus channel:
+//
+//   mixGainConstant():  dst[f] += src[f] * g
+//   mixGainRamp():      dst[f] += src[f] * (g0 + (g1 - g0) * f / n)
+//
+// The ramp form replaces the old fast-mover / guard-blend sub-step scratch
+// renders: instead of rendering 4 sub-chunks through al::Dbap::renderBuffer()
+// into a scratch AudioIOData and copying each back, the gain vector is
+// evaluated at the segment boundaries and linearly interpolated per frame.
+//
+// The output-finalize kernel turns one accumulated render-bus channel into
+// one device channel in a single read + write:
+//
+//   finalizeChannel():  y = scrub(src[f] * g);  dst[f] = y * ramp[f]
+//
+// where scrub() maps NaN / ±Inf to 0 and clamps to ±limit (Phase 11 Fix 3),
+// g is the channel's mix trim (loudspeakerMix / subMix) and ramp is the
+// backend's per-frame pause / seek fade (nullptr = unity). It optionally
+// returns Σ y² (pre-ramp) for the Phase 14 diagnostics, so neither the
+// trims, the clamp scan, the remap copy, the pause fade nor the bus analysis
+// needs its own sweep over the bus.
+//
+// SIMD DISPATCH (compile-time, no runtime CPU detection):
+//   __AVX__             → 8-wide AVX     (x86-64 built with -mavx / -mavx2)
+//   __SSE2__ / _M_X64   → 4-wide SSE2    (x86-64 baseline — always available)
+//   __ARM_NEON          → 4-wide NEON    (Apple Silicon / aarch64 baseline)
+//   otherwise           → scalar loop
+// Every path handles the numFrames % width tail with the scalar loop, so
+// callers may pass any block length (no alignment or multiple-of requirement).
+//
+// The ramp gain at frame f is computed as g0 + step * f (not accumulated
+// step-by-step), so SIMD and scalar paths agree to within one rounding of the
+// multiply-add and there is no drift across long blocks.
+//
+// REAL-TIME SAFETY: pure functions on caller-owned memory. No allocation,
+// no locks, no I/O. Safe on the audio thread.
+
+#pragma once
+
+#include <cmath>    // std::isfinite (finalizeChannel() tail)
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SR_GAINMIX_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#endif
+
+// dst[f] += src[f] * g   for f in [0, n)
+inline void mixGainConstant(float* dst, const float* src, float g, unsigned int n) {
+    unsigned int f = 0;
+#if defined(__AVX__)
+    const __m256 vg = _mm256_set1_ps(g);
+    for (; f + 8 <= n; f += 8) {
+        __m256 d = _mm256_loadu_ps(dst + f);
+        __m256 s = _mm256_loadu_ps(src + f);
+        _mm256_storeu_ps(dst + f, _mm256_add_ps(d, _mm256_mul_ps(s, vg)));
+    }
+#elif defined(SR_GAINMIX_SSE2)
+    const __m128 vg = _mm_set1_ps(g);
+    for (; f + 4 <= n; f += 4) {
+        __m128 d = _mm_loadu_ps(dst + f);
+        __m128 s = _mm_loadu_ps(src + f);
+        _mm_storeu_ps(dst + f, _mm_add_ps(d, _mm_mul_ps(s, vg)));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t vg = vdupq_n_f32(g);
+    for (; f + 4 <= n; f += 4) {
+        float32x4_t d = vld1q_f32(dst + f);
+        float32x4_t s = vld1q_f32(src + f);
+        vst1q_f32(dst + f, vmlaq_f32(d, s, vg));
+    }
+#endif
+    for (; f < n; ++f) dst[f] += src[f] * g;
+}
+
+// dst[f] += src[f] * (g0 + (g1 - g0) * f / n)   for f in [0, n)
+// The gain reaches g1 at frame n, i.e. the first frame of the NEXT segment,
+// so consecutive segments chained as (a→b), (b→c) are continuous.
+inline void mixGainRamp(float* dst, const float* src, float g0, float g1, unsigned int n) {
+    if (n == 0) return;
+    if (g0 == g1) { mixGainConstant(dst, src, g0, n); return; }
+    const float step = (g1 - g0) / static_cast<float>(n);
+    unsigned int f = 0;
+#if defined(__AVX__)
+    const __m256 vg0   = _mm256_set1_ps(g0);
+    const __m256 vstep = _mm256_set1_ps(step);
+    const __m256 lane  = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+    for (; f + 8 <= n; f += 8) {
+        __m256 idx = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(f)), lane);
+        __m256 g   = _mm256_add_ps(vg0, _mm256_mul_ps(vstep, idx));
+        __m256 d   = _mm256_loadu_ps(dst + f);
+        __m256 s   = _mm256_loadu_ps(src + f);
+        _mm256_storeu_ps(dst + f, _mm256_add_ps(d, _mm256_mul_ps(s, g)));
+    }
+#elif defined(SR_GAINMIX_SSE2)
+    const __m128 vg0   = _mm_set1_ps(g0);
+    const __m128 vstep = _mm_set1_ps(step);
+    const __m128 lane  = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+    for (; f + 4 <= n; f += 4) {
+        __m128 idx = _mm_add_ps(_mm_set1_ps(static_cast<float>(f)), lane);
+        __m128 g   = _mm_add_ps(vg0, _mm_mul_ps(vstep, idx));
+        __m128 d   = _mm_loadu_ps(dst + f);
+        __m128 s   = _mm_loadu_ps(src + f);
+        _mm_storeu_ps(dst + f, _mm_add_ps(d, _mm_mul_ps(s, g)));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t vg0   = vdupq_n_f32(g0);
+    const float32x4_t vstep = vdupq_n_f32(step);
+    const float       laneInit[4] = {0.f, 1.f, 2.f, 3.f};
+    const float32x4_t lane  = vld1q_f32(laneInit);
+    for (; f + 4 <= n; f += 4) {
+        float32x4_t idx = vaddq_f32(vdupq_n_f32(static_cast<float>(f)), lane);
+        float32x4_t g   = vmlaq_f32(vg0, vstep, idx);
+        float32x4_t d   = vld1q_f32(dst + f);
+        float32x4_t s   = vld1q_f32(src + f);
+        vst1q_f32(dst + f, vmlaq_f32(d, s, g));
+    }
+#endif
+    for (; f < n; ++f)
+        dst[f] += src[f] * (g0 + step * static_cast<float>(f));
+}
+
+// Output finalize for one channel, f in [0, n):
+//   y = src[f] * g;  y = isfinite(y) ? clamp(y, -limit, limit) : 0
+//   dst[f] = ramp ? y * ramp[f] : y;   *sumSq += y * y (when sumSq != nullptr)
+// Returns true if any sample was scrubbed or clamped. dst may not alias src
+// unless dst == src.
+inline bool finalizeChannel(float* dst, const float* src, float g, const float* ramp,
+                            float limit, unsigned int n, float* sumSq) {
+    unsigned int f = 0;
+    bool fired = false;
+    float acc = 0.0f;
+#if defined(__AVX__)
+    const __m256 vg  = _mm256_set1_ps(g);
+    const __m256 vhi = _mm256_set1_ps(limit);
+    const __m256 vlo = _mm256_set1_ps(-limit);
+    const __m256 vabs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 vacc = _mm256_setzero_ps();
+    int bad = 0;
+    for (; f + 8 <= n; f += 8) {
+        __m256 y = _mm256_mul_ps(_mm256_loadu_ps(src + f), vg);
+        // y - y is 0 for finite y and NaN for NaN / ±Inf
+        const __m256 d      = _mm256_sub_ps(y, y);
+        const __m256 finite = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        const __m256 over   = _mm256_cmp_ps(_mm256_and_ps(y, vabs), vhi, _CMP_GT_OQ);
+        bad |= _mm256_movemask_ps(_mm256_or_ps(
+            _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_NEQ_UQ), over));
+        y = _mm256_min_ps(_mm256_max_ps(_mm256_and_ps(y, finite), vlo), vhi);
+        vacc = _mm256_add_ps(vacc, _mm256_mul_ps(y, y));
+        if (ramp) y = _mm256_mul_ps(y, _mm256_loadu_ps(ramp + f));
+        _mm256_storeu_ps(dst + f, y);
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, vacc);
+    for (float l : lanes) acc += l;
+    fired = bad != 0;
+#elif defined(SR_GAINMIX_SSE2)
+    const __m128 vg  = _mm_set1_ps(g);
+    const __m128 vhi = _mm_set1_ps(limit);
+    const __m128 vlo = _mm_set1_ps(-limit);
+    const __m128 vabs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 vacc = _mm_setzero_ps();
+    int bad = 0;
+    for (; f + 4 <= n; f += 4) {
+        __m128 y = _mm_mul_ps(_mm_loadu_ps(src + f), vg);
+        // y - y is 0 for finite y and NaN for NaN / ±Inf
+        const __m128 d      = _mm_sub_ps(y, y);
+        const __m128 finite = _mm_cmpeq_ps(d, _mm_setzero_ps());
+        const __m128 over   = _mm_cmpgt_ps(_mm_and_ps(y, vabs), vhi);
+        bad |= _mm_movemask_ps(_mm_or_ps(_mm_cmpneq_ps(d, _mm_setzero_ps()), over));
+        y = _mm_min_ps(_mm_max_ps(_mm_and_ps(y, finite), vlo), vhi);
+        vacc = _mm_add_ps(vacc, _mm_mul_ps(y, y));
+        if (ramp) y = _mm_mul_ps(y, _mm_loadu_ps(ramp + f));
+        _mm_storeu_ps(dst + f, y);
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, vacc);
+    for (float l : lanes) acc += l;
+    fired = bad != 0;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t vg  = vdupq_n_f32(g);
+    const float32x4_t vhi = vdupq_n_f32(limit);
+    const float32x4_t vlo = vdupq_n_f32(-limit);
+    float32x4_t vacc = vdupq_n_f32(0.0f);
+    uint32x4_t  bad  = vdupq_n_u32(0);
+    for (; f + 4 <= n; f += 4) {
+        float32x4_t y = vmulq_f32(vld1q_f32(src + f), vg);
+        // y - y is 0 for finite y and NaN for NaN / ±Inf
+        const uint32x4_t finite = vceqq_f32(vsubq_f32(y, y), vdupq_n_f32(0.0f));
+        const uint32x4_t over   = vcgtq_f32(vabsq_f32(y), vhi);
+        bad = vorrq_u32(bad, vorrq_u32(vmvnq_u32(finite), over));
+        y = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), finite));
+        y = vminq_f32(vmaxq_f32(y, vlo), vhi);
+        vacc = vmlaq_f32(vacc, y, y);
+        if (ramp) y = vmulq_f32(y, vld1q_f32(ramp + f));
+        vst1q_f32(dst + f, y);
+    }
+    float lanes[4];
+    vst1q_f32(lanes, vacc);
+    for (float l : lanes) acc += l;
+    uint32_t badLanes[4];
+    vst1q_u32(badLanes, bad);
+    fired = (badLanes[0] | badLanes[1] | badLanes[2] | badLanes[3]) != 0;
+#endif
+    for (; f < n; ++f) {
+        float y = src[f] * g;
+        if (!std::isfinite(y)) {
+            y = 0.0f;
+            fired = true;
+        } else if (y > limit) {
+            y = limit;
+            fired = true;
+        } else if (y < -limit) {
+            y = -limit;
+            fired = true;
+        }
+        acc += y * y;
+        dst[f] = ramp ? y * ramp[f] : y;
+    }
+    if (sumSq) *sumSq = acc;
+    return fired;
+}
+
@@ -0,0 +1,113 @@
+// LoaderSignal.hpp — Real-time-safe wakeup from the audio thread to the loader
+//
+// A binary semaphore: post() marks the signal pending and wakes a sleeping
+// waiter; waitFor() consumes a pending signal or sleeps until one arrives or
+// the timeout expires. Used by Streaming so the loader thread sleeps until the
+// audio thread reports that playback crossed a refill deadline, instead of
+// waking every 2 ms to poll.
+//
+// REAL-TIME SAFETY of post() (the audio-thread side):
+//   - One atomic exchange when the signal is already pending or nobody is
+//     sleeping (the common case) — no syscall, no lock, no allocation.
+//   - Otherwise one wake syscall: futex(FUTEX_WAKE) on Linux,
+//     dispatch_semaphore_signal() on macOS. Neither blocks.
+//   - Other platforms fall back to std::condition_variable::notify_one()
+//     without taking the mutex. A wake that races the waiter's predicate
+//     check can be lost there; waitFor()'s timeout bounds the delay.
+//
+// Lost-wakeup freedom (futex / dispatch paths): the waiter registers in
+// mWaiters before re-checking mPending, and post() sets mPending before
+// reading mWaiters (both seq_cst), so either post() sees the waiter and
+// wakes it, or the waiter sees the pending flag and does not sleep.
+//
+// THREADING: post() from any thread (normally AUDIO). waitFor() from ONE
+// consumer thread (the loader).
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <time.h>
+#  include <unistd.h>
+#elif defined(__APPLE__)
+#  include <dispatch/dispatch.h>
+#else
+#  include <condition_variable>
+#  include <mutex>
+#endif
+
+class LoaderSignal {
+public:
+
+#if defined(__APPLE__)
+    LoaderSignal() : mSem(dispatch_semaphore_create(0)) {}
+    ~LoaderSignal() { dispatch_release(mSem); }
+#else
+    LoaderSignal() = default;
+#endif
+
+    LoaderSignal(const LoaderSignal&) = delete;
+    LoaderSignal& operator=(const LoaderSignal&) = delete;
+
+    /// Mark the signal pending and wake the waiter if it is asleep.
+    void post() {
+        if (mPending.exchange(1, std::memory_order_seq_cst) != 0) return;  // already pending
+        if (mWaiters.load(std::memory_order_seq_cst) == 0) return;         // nobody asleep
+        osWake();
+    }
+
+    /// Consume a pending signal, sleeping up to timeout for one.
+    /// Returns true if signaled, false on timeout.
+    bool waitFor(std::chrono::microseconds timeout) {
+        if (mPending.exchange(0, std::memory_order_acq_rel) != 0) return true;
+        mWaiters.fetch_add(1, std::memory_order_seq_cst);
+        if (mPending.load(std::memory_order_seq_cst) == 0) osWait(timeout);
+        mWaiters.fetch_sub(1, std::memory_order_relaxed);
+        return mPending.exchange(0, std::memory_order_acq_rel) != 0;
+    }
+
+private:
+
+#if defined(__linux__)
+    void osWake() {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mPending),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+    void osWait(std::chrono::microseconds timeout) {
+        timespec ts;
+        ts.tv_sec  = static_cast<time_t>(timeout.count() / 1000000);
+        ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+        // Sleeps only if mPending is still 0 (checked atomically by the kernel)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mPending),
+                FUTEX_WAIT_PRIVATE, 0u, &ts, nullptr, 0);
+    }
+#elif defined(__APPLE__)
+    void osWake() { dispatch_semaphore_signal(mSem); }
+    void osWait(std::chrono::microseconds timeout) {
+        // A stale count from a post() that raced a timeout only causes one
+        // early (spurious) return later — harmless for a polling consumer.
+        dispatch_semaphore_wait(mSem, dispatch_time(DISPATCH_TIME_NOW,
+                                static_cast<int64_t>(timeout.count()) * 1000));
+    }
+    dispatch_semaphore_t mSem;
+#else
+    void osWake() { mCv.notify_one(); }
+    void osWait(std::chrono::microseconds timeout) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCv.wait_for(lock, timeout, [this] { return mPending.load() != 0; });
+    }
+    std::mutex              mMutex;
+    std::condition_variable mCv;
+#endif
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "futex word must be a plain 32-bit integer");
+
+    alignas(64) std::atomic<uint32_t> mPending{0};
+    std::atomic<int>                  mWaiters{0};
+};
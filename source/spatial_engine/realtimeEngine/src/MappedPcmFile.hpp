@@ -0,0 +1,268 @@
+// MappedPcmFile.hpp — Memory-mapped reader for uncompressed WAV / RF64 / BW64
+//
+// Maps the whole file read-only and reads sample data straight out of the
+// mapping, bypassing libsndfile's sf_seek / sf_readf_float (one syscall + one
+// internal copy per read, serialized under a mutex) and, in multichannel
+// mode, the chunkFrames × numChannels interleaved float scratch buffer.
+//
+// SUPPORTED FORMATS (anything else → open() returns false and the caller
+// keeps using libsndfile):
+//   - RIFF/WAVE, RF64/WAVE and BW64/WAVE (ds64 64-bit sizes)
+//   - WAVE_FORMAT_PCM 16 / 24 / 32-bit, WAVE_FORMAT_IEEE_FLOAT 32-bit,
+//     and WAVE_FORMAT_EXTENSIBLE with either of those sub-formats
+//   - little-endian hosts with POSIX mmap (Linux, macOS)
+//
+// CONVERSION: integer PCM is scaled exactly as libsndfile's normalized float
+// reads (int16 / 32768, int24 / 8388608, int32 / 2147483648), so the output
+// is sample-identical to the sf_readf_float path. float32 data is copied
+// unchanged (a plain memcpy for mono files). Conversion happens only for the
+// window actually requested — nothing is decoded ahead of time.
+//
+// PAGE CACHE HINTS (madvise):
+//   open()      → MADV_SEQUENTIAL (aggressive kernel readahead)
+//   prefetch()  → MADV_WILLNEED on the byte range of the next chunk, so the
+//                 following readChannel() does not stall on page faults
+//   release()   → MADV_DONTNEED on a range already copied out; drops the
+//                 pages from this process's RSS (they stay in the page cache)
+//
+// THREADING: read-only after open(). readChannel() / prefetch() / release()
+// may be called from any thread without locking. Used by the loader thread
+// only — the audio thread never touches the mapping (a page fault there
+// would be an unbounded stall), it keeps reading SourceStream's buffers.
+//
+// PROVENANCE:
+// - RF64 / ds64 layout: EBU Tech 3306; BW64: ITU-R BS.2088.
+// - Normalization constants: libsndfile pcm.c (normalized float reads).
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define SR_HAVE_MMAP 1
+#endif
+
+class MappedPcmFile {
+public:
+
+    enum class SampleFormat { Int16, Int24, Int32, Float32 };
+
+    MappedPcmFile() = default;
+    ~MappedPcmFile() { close(); }
+
+    MappedPcmFile(const MappedPcmFile&) = delete;
+    MappedPcmFile& operator=(const MappedPcmFile&) = delete;
+
+    /// Map path and parse its header. Returns false (silently — the caller
+    /// falls back to libsndfile) for unsupported formats or platforms.
+    bool open(const std::string& path) {
+        close();
+#if defined(SR_HAVE_MMAP) && \
+    (!defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size < 44) { ::close(fd); return false; }
+        mMapSize = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, mMapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // the mapping keeps the file referenced
+        if (p == MAP_FAILED) { mMapSize = 0; return false; }
+        mBase = static_cast<const uint8_t*>(p);
+
+        if (!parseHeader()) { close(); return false; }
+        ::madvise(const_cast<uint8_t*>(mBase), mMapSize, MADV_SEQUENTIAL);
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    void close() {
+#if defined(SR_HAVE_MMAP)
+        if (mBase) ::munmap(const_cast<uint8_t*>(mBase), mMapSize);
+#endif
+        mBase = nullptr;
+        mMapSize = 0;
+        mData = nullptr;
+        mTotalFrames = 0;
+    }
+
+    bool         isOpen()      const { return mData != nullptr; }
+    int          numChannels() const { return mChannels; }
+    int          sampleRate()  const { return mSampleRate; }
+    uint64_t     totalFrames() const { return mTotalFrames; }
+    SampleFormat format()      const { return mFormat; }
+
+    /// Direct pointer to the interleaved float32 frames starting at frame
+    /// (zero-copy access). nullptr unless the file is float32.
+    const float* floatFrames(uint64_t frame) const {
+        if (mFormat != SampleFormat::Float32 || frame >= mTotalFrames) return nullptr;
+        return reinterpret_cast<const float*>(mData + frame * mFrameBytes);
+    }
+
+    /// Convert numFrames of one channel starting at frame into dst (mono
+    /// float). Clamped to the end of the data; returns frames written.
+    uint64_t readChannel(int channel, uint64_t frame, uint64_t numFrames, float* dst) const {
+        if (!mData || channel < 0 || channel >= mChannels || frame >= mTotalFrames) return 0;
+        if (numFrames > mTotalFrames - frame) numFrames = mTotalFrames - frame;
+
+        const uint8_t* src = mData + frame * mFrameBytes
+                           + static_cast<size_t>(channel) * mSampleBytes;
+        const size_t stride = mFrameBytes;
+
+        switch (mFormat) {
+            case SampleFormat::Float32:
+                if (mChannels == 1) {
+                    std::memcpy(dst, src, numFrames * sizeof(float));
+                } else {
+                    for (uint64_t i = 0; i < numFrames; ++i, src += stride)
+                        std::memcpy(dst + i, src, sizeof(float));
+                }
+                break;
+            case SampleFormat::Int16:
+                for (uint64_t i = 0; i < numFrames; ++i, src += stride) {
+                    int16_t s;
+                    std::memcpy(&s, src, sizeof(s));
+                    dst[i] = static_cast<float>(s) * (1.0f / 32768.0f);
+                }
+                break;
+            case SampleFormat::Int24:
+                for (uint64_t i = 0; i < numFrames; ++i, src += stride) {
+                    // Place the 3 bytes in the top of an int32 so the sign extends
+                    int32_t s = static_cast<int32_t>(
+                        (static_cast<uint32_t>(src[0]) << 8) |
+                        (static_cast<uint32_t>(src[1]) << 16) |
+                        (static_cast<uint32_t>(src[2]) << 24));
+                    dst[i] = static_cast<float>(s) * (1.0f / 2147483648.0f);
+                }
+                break;
+            case SampleFormat::Int32:
+                for (uint64_t i = 0; i < numFrames; ++i, src += stride) {
+                    int32_t s;
+                    std::memcpy(&s, src, sizeof(s));
+                    dst[i] = static_cast<float>(s) * (1.0f / 2147483648.0f);
+                }
+                break;
+        }
+        return numFrames;
+    }
+
+    /// Ask the kernel to start reading [frame, frame + numFrames) now.
+    void prefetch(uint64_t frame, uint64_t numFrames) const {
+        advise(frame, numFrames, kAdviseWillNeed);
+    }
+
+    /// Drop [frame, frame + numFrames) from this process's resident set.
+    void release(uint64_t frame, uint64_t numFrames) const {
+        advise(frame, numFrames, kAdviseDontNeed);
+    }
+
+private:
+
+    static uint16_t rd16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+    static uint32_t rd32(const uint8_t* p) {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+    static uint64_t rd64(const uint8_t* p) { return uint64_t(rd32(p)) | (uint64_t(rd32(p + 4)) << 32); }
+
+    bool parseHeader() {
+        const uint8_t* p = mBase;
+        const bool riff = std::memcmp(p, "RIFF", 4) == 0;
+        const bool rf64 = std::memcmp(p, "RF64", 4) == 0 || std::memcmp(p, "BW64", 4) == 0;
+        if ((!riff && !rf64) || std::memcmp(p + 8, "WAVE", 4) != 0) return false;
+
+        uint64_t ds64DataSize = 0;
+        bool haveFmt = false;
+        uint16_t formatTag = 0, bits = 0, blockAlign = 0;
+        size_t pos = 12;
+
+        while (pos + 8 <= mMapSize) {
+            const uint8_t* ck = mBase + pos;
+            uint64_t size = rd32(ck + 4);
+            const size_t body = pos + 8;
+
+            if (std::memcmp(ck, "ds64", 4) == 0 && size >= 16 && body + 16 <= mMapSize) {
+                ds64DataSize = rd64(mBase + body + 8);   // riffSize, dataSize, sampleCount
+            } else if (std::memcmp(ck, "fmt ", 4) == 0 && size >= 16 && body + 16 <= mMapSize) {
+                const uint8_t* f = mBase + body;
+                formatTag   = rd16(f);
+                mChannels   = rd16(f + 2);
+                mSampleRate = static_cast<int>(rd32(f + 4));
+                blockAlign  = rd16(f + 12);
+                bits        = rd16(f + 14);
+                if (formatTag == 0xFFFE && size >= 40 && body + 40 <= mMapSize) {
+                    formatTag = rd16(f + 24);            // SubFormat GUID, first two bytes
+                }
+                haveFmt = true;
+            } else if (std::memcmp(ck, "data", 4) == 0) {
+                if (!haveFmt) return false;
+                if (rf64 && size == 0xFFFFFFFFull) size = ds64DataSize;
+                if (body + size > mMapSize) size = mMapSize - body;  // truncated file
+                return setFormat(formatTag, bits, blockAlign, body, size);
+            }
+            pos = body + static_cast<size_t>(size) + (size & 1);  // chunks are word-aligned
+        }
+        return false;
+    }
+
+    bool setFormat(uint16_t formatTag, uint16_t bits, uint16_t blockAlign,
+                   size_t dataOffset, uint64_t dataSize) {
+        if (mChannels <= 0) return false;
+        if (formatTag == 3 && bits == 32)      mFormat = SampleFormat::Float32;
+        else if (formatTag == 1 && bits == 16) mFormat = SampleFormat::Int16;
+        else if (formatTag == 1 && bits == 24) mFormat = SampleFormat::Int24;
+        else if (formatTag == 1 && bits == 32) mFormat = SampleFormat::Int32;
+        else return false;
+
+        mSampleBytes = bits / 8;
+        mFrameBytes  = mSampleBytes * static_cast<size_t>(mChannels);
+        if (blockAlign != mFrameBytes) return false;
+
+        mData = mBase + dataOffset;
+        mTotalFrames = dataSize / mFrameBytes;
+        return true;
+    }
+
+    enum AdviseKind { kAdviseWillNeed, kAdviseDontNeed };
+
+    void advise(uint64_t frame, uint64_t numFrames, AdviseKind kind) const {
+#if defined(SR_HAVE_MMAP)
+        if (!mData || frame >= mTotalFrames || numFrames == 0) return;
+        if (numFrames > mTotalFrames - frame) numFrames = mTotalFrames - frame;
+        static const size_t kPage = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t begin = static_cast<size_t>(mData - mBase) + frame * mFrameBytes;
+        size_t end   = begin + numFrames * mFrameBytes;
+        // WILLNEED rounds outward (cover every byte), DONTNEED inward (never
+        // drop a page still holding frames outside the range).
+        if (kind == kAdviseWillNeed) {
+            begin = begin / kPage * kPage;
+        } else {
+            begin = (begin + kPage - 1) / kPage * kPage;
+            end   = end / kPage * kPage;
+        }
+        if (end <= begin) return;
+        ::madvise(const_cast<uint8_t*>(mBase) + begin, end - begin,
+                  kind == kAdviseWillNeed ? MADV_WILLNEED : MADV_DONTNEED);
+#else
+        (void)frame; (void)numFrames; (void)kind;
+#endif
+    }
+
+    const uint8_t* mBase    = nullptr;   // start of the mapping
+    size_t         mMapSize = 0;
+    const uint8_t* mData    = nullptr;   // first byte of the 'data' chunk
+    int            mChannels   = 0;
+    int            mSampleRate = 0;
+    uint64_t       mTotalFrames = 0;
+    size_t         mSampleBytes = 0;
+    size_t         mFrameBytes  = 0;
+    SampleFormat   mFormat = SampleFormat::Float32;
+};
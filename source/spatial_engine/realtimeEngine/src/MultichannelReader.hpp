@@ -12,24 +12,32 @@
 // - ONE interleaved temp buffer (chunkFrames × numChannels floats).
 // - A channel→SourceStream* map to route de-interleaved data.
 // - readAndDistribute() is called by the Streaming loader thread.
+// - Per-channel chunks come from the shared SourceIOService cache: another
+//   session streaming the same ADM file shares them, and only the channels
+//   no one has loaded yet are de-interleaved.
 //
 // MEMORY:
 // - Interleaved buffer: 240,000 frames × 48 ch × 4 bytes = ~44 MB
 //   (allocated once, reused every chunk cycle).
+// - Memory-mapped path (uncompressed PCM / float WAV, RF64, BW64 — see
+//   MappedPcmFile.hpp): no interleaved buffer at all. Channels are
+//   de-interleaved straight from the mapped pages in cache-sized frame tiles,
+//   and each chunk's pages are released from RSS once copied out.
 //
 // REAL-TIME SAFETY:
 // - This class is ONLY used by the loader thread (never the audio thread).
-// - The audio thread reads from the same SourceStream double-buffers as
-//   in mono mode — completely unchanged and lock-free.
+// - The audio thread reads from the same SourceStream chunk slots as in
+//   mono mode — completely unchanged and lock-free.
 //
 // PROVENANCE:
 // - Factored out of Streaming.hpp to keep the mono path untouched.
-// - De-interleave pattern is standard libsndfile usage.
+// - De-interleave kernel shared with the offline ADM loader (Deinterleave.hpp).
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
-#include <cstring>    // memset
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <mutex>
@@ -38,6 +46,10 @@
 
 #include <sndfile.h>  // via Gamma (AlloLib external)
 
+#include "Deinterleave.hpp"   // deinterleaveTargets() — shared with WavUtils
+#include "MappedPcmFile.hpp"
+#include "SourceIOService.hpp"    // shared chunk cache
+
 // Forward declaration — full definition in Streaming.hpp
 struct SourceStream;
 
@@ -55,11 +67,17 @@ public:
     MultichannelReader(const MultichannelReader&) = delete;
     MultichannelReader& operator=(const MultichannelReader&) = delete;
 
-    /// Open the multichannel WAV file. Call once at load time.
+    /// Open the multichannel WAV file. Call once at load time. Chunks are
+    /// acquired through io, which must outlive the reader.
     /// Returns true on success.
-    bool open(const std::string& path, int expectedSR, uint64_t chunkFrames) {
+    bool open(const std::string& path, int expectedSR, uint64_t chunkFrames,
+              SourceIOService* io) {
         mFilePath = path;
         mChunkFrames = chunkFrames;
+        mIO = io;
+        std::error_code ec;
+        const std::filesystem::path canon = std::filesystem::weakly_canonical(path, ec);
+        mCacheFile = ec ? path : canon.string();
 
         // Open file
         mSfInfo = {};
@@ -73,6 +91,7 @@ public:
         mNumChannels = mSfInfo.channels;
         mTotalFrames = static_cast<uint64_t>(mSfInfo.frames);
         mSampleRate  = mSfInfo.samplerate;
+        mSfPos       = 0;
 
         if (mNumChannels < 2) {
             std::cerr << "[MultichannelReader] WARNING: File has only "
@@ -92,18 +111,29 @@ public:
             return false;
         }
 
-        // Pre-allocate the interleaved read buffer (one chunk's worth)
-        // Size = chunkFrames × numChannels floats
-        mInterleavedBuffer.resize(mChunkFrames * mNumChannels, 0.0f);
+        // Prefer the memory-mapped path; the header parse must agree with
+        // libsndfile on the channel and frame count or we fall back.
+        if (!(mMapped.open(path) && mMapped.numChannels() == mNumChannels &&
+              mMapped.totalFrames() == mTotalFrames)) {
+            mMapped.close();
+            // Pre-allocate the interleaved read buffer (one chunk's worth)
+            // Size = chunkFrames × numChannels floats
+            mInterleavedBuffer.resize(mChunkFrames * mNumChannels, 0.0f);
+        }
 
         std::cout << "[MultichannelReader] Opened: " << path << std::endl;
         std::cout << "  Channels:     " << mNumChannels << std::endl;
         std::cout << "  Total frames: " << mTotalFrames
                   << " (" << (double)mTotalFrames / mSampleRate << "s)"
                   << std::endl;
-        std::cout << "  Interleaved buffer: "
-                  << (mInterleavedBuffer.size() * sizeof(float) / (1024*1024))
-                  << " MB" << std::endl;
+        if (mMapped.isOpen()) {
+            std::cout << "  Memory-mapped (no interleaved buffer)" << std::endl;
+            mMapped.prefetch(0, mChunkFrames);
+        } else {
+            std::cout << "  Interleaved buffer: "
+                      << (mInterleavedBuffer.size() * sizeof(float) / (1024*1024))
+                      << " MB" << std::endl;
+        }
 
         return true;
     }
@@ -120,52 +150,51 @@ public:
         mChannelMap[channelIndex] = stream;
     }
 
-    /// Read an interleaved chunk starting at fileFrame and de-interleave
-    /// into each mapped SourceStream's specified buffer.
+    /// Resolve the chunk starting at fileFrame for every mapped channel
+    /// (shared from the cache, or one interleaved read + de-interleave of the
+    /// missing channels) and publish it in each SourceStream's slot bufIdx.
     ///
-    /// bufIdx: which buffer (0=A, 1=B) to write into on each SourceStream.
+    /// bufIdx: which buffer (0=A, 1=B) to fill on each SourceStream.
     /// Called ONLY by the Streaming loader thread.
     ///
+    /// maxFrames < chunkFrames reads a short window (seek landing burst).
+    ///
     /// Returns the number of frames actually read (may be < chunkFrames at EOF).
-    uint64_t readAndDistribute(uint64_t fileFrame, int bufIdx) {
+    uint64_t readAndDistribute(uint64_t fileFrame, int bufIdx,
+                               uint64_t maxFrames = ~uint64_t(0)) {
         if (!mSndFile) return 0;
 
-        // Clamp to file end
-        uint64_t framesToRead = mChunkFrames;
+        // Clamp to the requested window and the file end
+        uint64_t framesToRead = std::min(mChunkFrames, maxFrames);
         if (fileFrame + framesToRead > mTotalFrames) {
             framesToRead = (fileFrame < mTotalFrames) ? (mTotalFrames - fileFrame) : 0;
         }
 
+        markLoading(bufIdx);
         if (framesToRead == 0) {
-            // Past end of file — zero-fill all mapped streams' buffers
-            for (auto& [ch, stream] : mChannelMap) {
-                zeroFillBuffer(stream, bufIdx, fileFrame);
-            }
+            // Past end of file — every mapped stream gets an empty slot
+            publishAll(bufIdx, fileFrame);
             return 0;
         }
 
-        sf_count_t framesRead = 0;
-        {
-            std::lock_guard<std::mutex> lock(mFileMutex);
-            sf_seek(mSndFile, static_cast<sf_count_t>(fileFrame), SEEK_SET);
-            framesRead = sf_readf_float(mSndFile, mInterleavedBuffer.data(),
-                                         static_cast<sf_count_t>(framesToRead));
-        }
-
-        if (framesRead <= 0) {
-            for (auto& [ch, stream] : mChannelMap) {
-                zeroFillBuffer(stream, bufIdx, fileFrame);
+        // Silence-mapped channels get the shared zero chunk; only the rest
+        // are keyed — and read / de-interleaved on a miss. A chunk that is
+        // silent on every mapped channel is not read at all.
+        keyAudibleChannels(fileFrame, framesToRead);
+        uint64_t framesRead = framesToRead;
+        if (!mKeys.empty()) {
+            mIO->acquire(mKeys, mChunkFrames,
+                         [&](const SourceIOService::FillTargets& targets) {
+                             return fillTargets(targets, fileFrame, framesToRead);
+                         },
+                         mAudibleRefs);
+            framesRead = mAudibleRefs.front()->validFrames;
+            for (size_t k = 0; k < mKeys.size(); ++k) {
+                mChunkRefs[mKeySlot[k]] = std::move(mAudibleRefs[k]);
             }
-            return 0;
         }
-
-        // De-interleave: extract each mapped channel into its SourceStream buffer
-        for (auto& [chIdx, stream] : mChannelMap) {
-            deinterleaveInto(stream, bufIdx, chIdx,
-                             static_cast<uint64_t>(framesRead), fileFrame);
-        }
-
-        return static_cast<uint64_t>(framesRead);
+        publishAll(bufIdx, fileFrame);
+        return framesRead;
     }
 
     /// Read the first chunk (frame 0) into buffer A of all mapped streams.
@@ -187,38 +216,58 @@ public:
     /// Get the chunk size in frames.
     uint64_t chunkFrames() const { return mChunkFrames; }
 
+    /// True when reading through the memory-mapped path.
+    bool isMapped() const { return mMapped.isOpen(); }
+
     /// Close the file handle.
     void close() {
         if (mSndFile) {
             sf_close(mSndFile);
             mSndFile = nullptr;
         }
+        mMapped.close();
         mChannelMap.clear();
         mInterleavedBuffer.clear();
     }
 
 private:
 
-    /// De-interleave one channel from the interleaved buffer into a
-    /// SourceStream's double buffer (A or B).
-    /// This writes directly into the SourceStream's buffer and updates its
-    /// atomic state flags — matching the contract of SourceStream::loadChunkInto().
-    ///
+    /// Mark slot bufIdx of every mapped stream LOADING and drop its chunk.
     /// NOTE: Implementation is provided AFTER SourceStream is fully defined
     ///       (see bottom of Streaming.hpp). This is standard C++ practice for
     ///       breaking circular header dependencies.
-    inline void deinterleaveInto(SourceStream* stream, int bufIdx, int channelIndex,
-                                 uint64_t framesRead, uint64_t fileFrame);
+    inline void markLoading(int bufIdx);
 
-    /// Zero-fill a SourceStream's buffer and mark it ready (past EOF).
+    /// Hand mChunkRefs (one per mapped channel, in mChannelMap order; empty
+    /// → past EOF) to the streams' slot bufIdx and mark them READY —
+    /// matching the contract of SourceStream::loadChunkInto().
     /// Implementation in Streaming.hpp (same reason as above).
-    inline void zeroFillBuffer(SourceStream* stream, int bufIdx, uint64_t fileFrame);
+    inline void publishAll(int bufIdx, uint64_t fileFrame);
+
+    /// Size mChunkRefs to the mapped channels, give every channel whose
+    /// published silence map covers the range a zero chunk, and key the
+    /// others in mKeys (their mChunkRefs index in mKeySlot).
+    /// Implementation in Streaming.hpp (same reason as above).
+    inline void keyAudibleChannels(uint64_t fileFrame, uint64_t frames);
+
+    /// SourceIOService fill callback: write channel mKeys[i].channel of
+    /// [fileFrame, fileFrame + frames) into each target. Memory-mapped files
+    /// are copied straight from the mapping one frame tile (all channels) at
+    /// a time, so each tile is pulled through cache once; otherwise one
+    /// interleaved read and one pass of the shared deinterleaveTargets()
+    /// kernel (cache-blocked, SIMD 4×4 transposes for runs of consecutive
+    /// channels — see Deinterleave.hpp). Only missing channels are targets.
+    /// Implementation in Streaming.hpp (same reason as above).
+    inline uint64_t fillTargets(const SourceIOService::FillTargets& targets,
+                                uint64_t fileFrame, uint64_t frames);
 
     // ── Member data ──────────────────────────────────────────────────────
 
     SNDFILE*    mSndFile = nullptr;
     SF_INFO     mSfInfo  = {};
     std::mutex  mFileMutex;      // Protects sf_seek/sf_readf_float
+    sf_count_t  mSfPos = 0;      // mSndFile read position (under mFileMutex; -1 = unknown)
+    MappedPcmFile mMapped;       // open → used instead of mSndFile reads
 
     std::string mFilePath;
     int         mNumChannels = 0;
@@ -233,5 +282,18 @@ private:
     // Map: 0-based channel index → SourceStream that receives that channel's data.
     // Not all channels need to be mapped (empty channels are skipped).
     std::map<int, SourceStream*> mChannelMap;
+
+    // Shared chunk cache (owned by Streaming / the caller) and the cache
+    // identity of this file.
+    SourceIOService* mIO = nullptr;
+    std::string      mCacheFile;
+
+    // readAndDistribute() scratch, in mChannelMap order (loader thread only;
+    // capacity reused across chunks).
+    std::vector<SourceChunkKey>     mKeys;         // audible channels only
+    std::vector<size_t>             mKeySlot;      // mKeys[k] → mChunkRefs index
+    std::vector<SourceChunkRef>     mChunkRefs;
+    std::vector<SourceChunkRef>     mAudibleRefs;  // acquire() output for mKeys
+    std::vector<DeinterleaveTarget> mTargets;
 };
 
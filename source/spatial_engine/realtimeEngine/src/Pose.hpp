@@ -25,12 +25,23 @@
 //  AUDIO thread:
 //    - Calls computePositions() once per audio block (from processBlock()).
 //    - Calls getPoses() immediately after to read the updated positions.
-//    - EXCLUSIVELY owns mPoses and mLastGoodDir during playback.
+//    - EXCLUSIVELY owns mPoses, mLastGoodDir and mKeyframeCursor during playback.
 //      No other thread touches these after loadScene().
 //
 //  LOADER thread:
 //    - Does NOT interact with Pose at all.
 //
+//  BAKE thread (only when RealtimeConfig::poseBakeFrames > 0):
+//    - Started at the end of loadScene(), joined by stopBaking() / ~Pose().
+//    - Bakes one BakedPoseTracks per elevation mode actually used, on demand:
+//      the mode current at load time first, then any mode the OSC listener
+//      switches to (polled every kBakePollMs). A baked set is never modified
+//      after it is published, so nothing is reclaimed while audio runs.
+//    - Reads only the READ-ONLY-after-loadScene() members below.
+//    - A layout change builds a new Pose (EngineSession::applyLayout(), or
+//      switchLayout() on its layout build thread while the current Pose
+//      keeps playing), so a bake is always for exactly one layout.
+//
 //  READ-ONLY after loadScene() (safe to read from any thread without sync):
 //    mSources, mSourceOrder, mLayoutRadius, mLayoutMinElRad,
 //    mLayoutMaxElRad, mLayoutIs2D, mState
@@ -45,10 +56,15 @@
 //  AUDIO-THREAD-OWNED (must not be read or written from any other thread
 //  while audio is streaming):
 //    mPoses        — written by computePositions(), read by getPoses()
-//    mLastGoodDir  — cache of per-source last-good direction, updated lazily
-//                    by safeDirForSource(); a std::map allocation can occur
-//                    the first time a new source is inserted, but after the
-//                    first audio block all insertions are already done.
+//    mLastGoodDir  — per-source last-good direction, indexed by source
+//                    handle and sized in loadScene(); safeDirForSource()
+//                    overwrites slots in place (mHasLastGoodDir marks which
+//                    slots hold a direction yet). Never allocates.
+//
+//  PUBLISHED (BAKE thread → AUDIO thread):
+//    mBaked[mode]  — atomic pointer, stored once with release ordering after
+//                    the tracks are complete; loaded with acquire once per
+//                    block. nullptr = not baked (yet) → live path.
 //
 // ─────────────────────────────────────────────────────────────────────────────
 //
@@ -64,11 +80,24 @@
 // - computePositions() is called once per audio block at the start of
 //   processBlock(). It uses only pre-allocated data structures and never
 //   allocates, locks, or does I/O.
-// - All per-source data (keyframes, last-good directions) is loaded once
-//   at scene load time and never modified during playback.
-//   (Exception: mLastGoodDir can insert new entries during the FIRST block
-//   per source — this is a one-time std::map allocation that happens before
-//   steady-state audio is reached and is acceptable.)
+// - All per-source data (keyframes, last-good directions) is allocated once
+//   at scene load time and addressed by source handle during playback —
+//   no string keys or map lookups on the audio thread.
+//
+// TRAJECTORY BAKING (optional, --pose_bake <frames>):
+// - The whole pipeline (SLERP → fallback → elevation sanitize → DBAP
+//   transform) is deterministic given scene, layout and elevation mode, so
+//   the bake thread evaluates it once per source on a fixed grid of
+//   poseBakeFrames frames between the source's first and last keyframe.
+//   computePositions() then does three lerps per source instead of three
+//   full evaluations. Before the bake for the current mode is published
+//   (and for any mode whose bake was skipped) the live path runs unchanged.
+// - The bake runs the fallback logic forward in time with its own
+//   last-good state — exactly what uninterrupted playback from the start
+//   would produce. Chord lerp between grid points sits at most
+//   1 − cos(Δθ/2) inside the speaker radius; at 64 frames even a
+//   360°/s source moves < 0.5° per step.
+// - Tracks larger than kMaxBakeBytes are not baked (logged; live path).
 
 #pragma once
 
@@ -77,16 +106,25 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "al/math/al_Vec.hpp"       // al::Vec3f
 #include "JSONLoader.hpp"            // Keyframe, SpatialData
 #include "LayoutLoader.hpp"          // SpeakerLayoutData, SpeakerData
 #include "RealtimeTypes.hpp"         // RealtimeConfig, ElevationMode
+#include "SourceTable.hpp"           // SourceHandle
 
 // ─────────────────────────────────────────────────────────────────────────────
 // SourcePose — Per-source position snapshot for one audio block
@@ -94,12 +132,50 @@
 // Computed by Pose, consumed by the Spatializer (Phase 4).
 
 struct SourcePose {
-    std::string name;                // Source key (e.g., "1.1", "LFE")
+    std::string name;                // Source key (e.g., "1.1", "LFE") — display / logging only
+    SourceHandle handle = kInvalidSource;  // Dense index (SourceTable contract) — use on the audio thread
     al::Vec3f   position;            // DBAP position at block center (coord-transformed)
     al::Vec3f   positionStart;       // DBAP position at block start  (Fix 2 — fast-mover)
     al::Vec3f   positionEnd;         // DBAP position at block end    (Fix 2 — fast-mover)
     bool        isLFE     = false;   // True → route to subwoofer, skip DBAP
     bool        isValid   = true;    // False → source had no usable position
+    bool        isSilent  = false;   // True → block is silence-mapped; position not computed, skip
+};
+
+
+// ─────────────────────────────────────────────────────────────────────────────
+// BakedPoseTracks — Precomputed DBAP positions for one elevation mode
+// ─────────────────────────────────────────────────────────────────────────────
+// Structure-of-arrays: source h owns samples [offset[h], offset[h] + count[h])
+// of x / y / z, sample k at time t0[h] + k * stepSec. count 0 = not baked
+// (LFE, no keyframes). Immutable once published.
+
+struct BakedPoseTracks {
+    double stepSec    = 0.0;
+    double invStepSec = 0.0;
+    std::vector<double>   t0;       // per handle: time of sample 0 (first keyframe)
+    std::vector<uint32_t> offset;   // per handle: first sample index in x / y / z
+    std::vector<uint32_t> count;    // per handle: number of samples
+    std::vector<float>    x, y, z;  // DBAP-space positions, all sources back to back
+
+    /// Linear interpolation between the two grid samples around t; clamps
+    /// to the first / last sample outside the keyframe span. count[h] > 0.
+    al::Vec3f sample(size_t h, double t) const {
+        const size_t   base = offset[h];
+        const uint32_t n    = count[h];
+        const double   u    = (t - t0[h]) * invStepSec;
+        if (!(u > 0.0) || n == 1) return al::Vec3f(x[base], y[base], z[base]);
+        if (u >= static_cast<double>(n - 1)) {
+            const size_t l = base + n - 1;
+            return al::Vec3f(x[l], y[l], z[l]);
+        }
+        const size_t k = static_cast<size_t>(u);
+        const float  f = static_cast<float>(u - static_cast<double>(k));
+        const size_t a = base + k;
+        return al::Vec3f(x[a] + f * (x[a + 1] - x[a]),
+                         y[a] + f * (y[a + 1] - y[a]),
+                         z[a] + f * (z[a + 1] - z[a]));
+    }
 };
 
 
@@ -110,15 +186,30 @@ struct SourcePose {
 class Pose {
 public:
 
+    static constexpr size_t kMaxBakeBytes = size_t(256) << 20;  // per elevation mode
+    static constexpr int    kBakePollMs   = 100;   // bake thread: elevation mode poll
+
     Pose(RealtimeConfig& config, EngineState& state)
         : mConfig(config), mState(state) {}
 
+    ~Pose() { stopBaking(); }
+
+    Pose(const Pose&) = delete;
+    Pose& operator=(const Pose&) = delete;
+
     // ── Load scene and layout ────────────────────────────────────────────
     // Must be called BEFORE the audio stream starts.
     // Stores keyframes and analyzes the speaker layout for elevation bounds.
 
     bool loadScene(const SpatialData& scene, const SpeakerLayoutData& layout) {
 
+        // A bake from a previous load reads the members rebuilt below.
+        stopBaking();
+        for (size_t m = 0; m < mBaked.size(); ++m) {
+            mBaked[m].store(nullptr, std::memory_order_relaxed);
+            mBakeOwned[m].reset();
+        }
+
         // ── Store keyframes per source ───────────────────────────────────
         mSources = scene.sources;
         std::cout << "[Pose] Loaded keyframes for " << mSources.size()
@@ -169,24 +260,56 @@ public:
         mPoses.reserve(mSources.size());
         mSourceOrder.clear();
         mSourceOrder.reserve(mSources.size());
+        mSourceKeyframes.clear();
+        mSourceKeyframes.reserve(mSources.size());
 
+        // Handles follow the SourceTable contract: rank in scene.sources,
+        // which is also the index into mPoses.
         for (const auto& [name, kfs] : mSources) {
             SourcePose pose;
-            pose.name  = name;
-            pose.isLFE = (name == "LFE");
+            pose.name   = name;
+            pose.handle = static_cast<SourceHandle>(mPoses.size());
+            pose.isLFE  = (name == "LFE");
             mPoses.push_back(pose);
             mSourceOrder.push_back(name);
+            mSourceKeyframes.push_back(&kfs);
         }
 
-        // Pre-allocate fallback direction cache
-        mLastGoodDir.clear();
+        // Per-source keyframe segment cursors (see findKeyframeSegment()).
+        mKeyframeCursor.assign(mSources.size(), 0);
+
+        // Pre-allocate fallback direction cache (one slot per handle)
+        mLastGoodDir.assign(mSources.size(), al::Vec3f(0.0f, 1.0f, 0.0f));
+        mHasLastGoodDir.assign(mSources.size(), 0u);
 
         mState.numSpeakers.store(static_cast<int>(layout.speakers.size()),
                                  std::memory_order_relaxed);
 
+        // ── Trajectory bake (background) ─────────────────────────────────
+        if (mConfig.poseBakeFrames > 0 && !mSources.empty()) {
+            startBaking();
+        }
+
         return true;
     }
 
+    // ── Stop the bake thread ─────────────────────────────────────────────
+    // Main thread. Idempotent. Already-published tracks stay valid until
+    // the Pose is destroyed; an unfinished bake is abandoned.
+    void stopBaking() {
+        {
+            std::lock_guard<std::mutex> lk(mBakeMutex);
+            mBakeStop.store(true);
+        }
+        mBakeCv.notify_all();
+        if (mBakeThread.joinable()) mBakeThread.join();
+    }
+
+    /// True once the tracks for the current elevation mode are in use.
+    bool bakeReady() const {
+        return bakedFor(mConfig.elevationMode.load(std::memory_order_relaxed)) != nullptr;
+    }
+
     // ── Compute positions for all sources at a given time ────────────────
     // Called once at the start of each audio block from processBlock().
     // blockCenterTimeSec = playback time at the center of the current block.
@@ -196,11 +319,10 @@ public:
     //
     // THREADING: AUDIO THREAD ONLY. Must not be called from any other thread.
     //   - Writes mPoses[i].position and mPoses[i].isValid.
-    //   - May lazily insert into mLastGoodDir on the first pass per source.
-    //     After the first complete block, all map keys exist and no further
-    //     allocation occurs.
+    //   - Advances mKeyframeCursor[i] (per-source keyframe segment hint).
+    //   - Overwrites mLastGoodDir[i] / mHasLastGoodDir[i] in place.
     //
-    // REAL-TIME SAFE: no allocation (after first block), no I/O, no locks.
+    // REAL-TIME SAFE: no allocation, no I/O, no locks, no string lookups.
 
     // Fix 2 — signature extended to carry block start and end times so that
     // positionStart / positionEnd can be computed for fast-mover sub-stepping.
@@ -213,16 +335,27 @@ public:
     //      which reads mLastGoodDir but never writes it.
     // This guarantees that mLastGoodDir reflects the center-time direction and is
     // not overwritten by start/end evaluations that are only ~5 ms away.
-    void computePositions(double blockStartTimeSec, double blockEndTimeSec) {
+    //
+    // silentBlocks (Streaming::markSilentBlocks(), indexed by handle; may be
+    // nullptr): a flagged source gets isSilent = true and no position — the
+    // Spatializer skips it. Its cursor and mLastGoodDir simply resume on the
+    // next audible block (the cursor re-seeks forward from where it stopped).
+    void computePositions(double blockStartTimeSec, double blockEndTimeSec,
+                          const uint8_t* silentBlocks = nullptr) {
         const double blockCenterTimeSec = (blockStartTimeSec + blockEndTimeSec) * 0.5;
 
         // Read elevation mode once per block (relaxed — stale-by-one-block is fine).
-        ElevationMode elMode = static_cast<ElevationMode>(
-            mConfig.elevationMode.load(std::memory_order_relaxed));
+        const int elModeInt = mConfig.elevationMode.load(std::memory_order_relaxed);
+        ElevationMode elMode = static_cast<ElevationMode>(elModeInt);
+
+        // Baked tracks for this mode, if published (acquire pairs with the
+        // bake thread's release store — the arrays are complete when seen).
+        const BakedPoseTracks* bake = bakedFor(elModeInt);
 
         for (size_t i = 0; i < mSourceOrder.size(); ++i) {
-            const std::string& name = mSourceOrder[i];
             SourcePose& pose = mPoses[i];
+            pose.isSilent = silentBlocks && pose.handle != kInvalidSource
+                         && silentBlocks[static_cast<size_t>(pose.handle)];
 
             // LFE doesn't need a spatial position — it goes straight to subs
             if (pose.isLFE) {
@@ -232,18 +365,42 @@ public:
                 continue;
             }
 
-            // Look up this source's keyframes
-            auto it = mSources.find(name);
-            if (it == mSources.end() || it->second.empty()) {
+            // This source's keyframes (resolved once in loadScene())
+            const std::vector<Keyframe>& kfs = *mSourceKeyframes[i];
+            if (kfs.empty()) {
                 pose.isValid = false;
                 continue;
             }
+            if (pose.isSilent) continue;
+
+            // ── Baked path: three lerps, no per-block trig ───────────────────
+            // mKeyframeCursor / mLastGoodDir are left alone; if the live path
+            // resumes (mode switch to an unbaked mode) the cursor re-seeks
+            // and the last-good direction only matters for degenerate keyframes.
+            if (bake && bake->count[i] > 0) {
+                pose.positionStart = bake->sample(i, blockStartTimeSec);
+                pose.position      = bake->sample(i, blockCenterTimeSec);
+                pose.positionEnd   = bake->sample(i, blockEndTimeSec);
+                pose.isValid = true;
+                continue;
+            }
+
+            // ── Keyframe cursor ──────────────────────────────────────────────
+            // Anchor the persistent cursor at the block START (the earliest of
+            // the three evaluation times) so it only ever moves forward during
+            // playback; center and end then walk forward from a local copy.
+            size_t& cursor = mKeyframeCursor[i];
+            if (kfs.size() >= 2 && blockStartTimeSec > kfs.front().time
+                                && blockStartTimeSec < kfs.back().time) {
+                findKeyframeSegment(kfs, blockStartTimeSec, cursor);
+            }
+            size_t seg = cursor;
 
             // ── Center position (mutating path — updates mLastGoodDir) ───────
             // Step 1: Interpolate raw direction from keyframes (SLERP)
-            al::Vec3f rawDir = interpolateDirRaw(it->second, blockCenterTimeSec);
+            al::Vec3f rawDir = interpolateDirRaw(kfs, blockCenterTimeSec, seg);
             // Step 2: Validate and apply fallback if degenerate (writes mLastGoodDir)
-            al::Vec3f safeDir = safeDirForSource(name, it->second,
+            al::Vec3f safeDir = safeDirForSource(i, kfs,
                                                   rawDir, blockCenterTimeSec);
             // Step 3: Sanitize elevation for speaker layout
             al::Vec3f sanitized = sanitizeDirForLayout(safeDir, elMode);
@@ -253,10 +410,11 @@ public:
 
             // ── Start / End positions (read-only path — mLastGoodDir untouched) ─
             // Uses mLastGoodDir (set just above) as the fallback but never writes it.
+            size_t segStart = cursor;
             pose.positionStart = computePositionAtTimeReadOnly(
-                name, it->second, blockStartTimeSec, elMode);
+                i, kfs, blockStartTimeSec, elMode, segStart);
             pose.positionEnd   = computePositionAtTimeReadOnly(
-                name, it->second, blockEndTimeSec, elMode);
+                i, kfs, blockEndTimeSec, elMode, seg);
         }
     }
 
@@ -321,7 +479,9 @@ private:
 
     // ── Raw keyframe interpolation (may return degenerate vectors) ───────
     // Adapted from SpatialRenderer::interpolateDirRaw()
-    al::Vec3f interpolateDirRaw(const std::vector<Keyframe>& kfs, double t) const {
+    // cursor: per-source segment hint, updated in place (findKeyframeSegment()).
+    al::Vec3f interpolateDirRaw(const std::vector<Keyframe>& kfs, double t,
+                                size_t& cursor) const {
         if (kfs.empty()) return al::Vec3f(0.0f, 0.0f, 0.0f);
 
         if (kfs.size() == 1) {
@@ -336,16 +496,10 @@ private:
             return safeNormalize(al::Vec3f(kfs.back().x, kfs.back().y, kfs.back().z));
         }
 
-        // Find the keyframe segment containing time t
-        const Keyframe* k1 = &kfs[0];
-        const Keyframe* k2 = &kfs[1];
-        for (size_t i = 0; i < kfs.size() - 1; ++i) {
-            if (t >= kfs[i].time && t <= kfs[i + 1].time) {
-                k1 = &kfs[i];
-                k2 = &kfs[i + 1];
-                break;
-            }
-        }
+        // Find the keyframe segment containing time t (cursor hint, O(1) amortized)
+        const size_t seg = findKeyframeSegment(kfs, t, cursor);
+        const Keyframe* k1 = &kfs[seg];
+        const Keyframe* k2 = &kfs[seg + 1];
 
         // Handle degenerate time segment
         double dt = k2->time - k1->time;
@@ -361,24 +515,34 @@ private:
     }
 
     // ── Safe direction with fallback logic ───────────────────────────────
-    // Adapted from SpatialRenderer::safeDirForSource()
-    al::Vec3f safeDirForSource(const std::string& name,
+    // Adapted from SpatialRenderer::safeDirForSource(); si is the source handle.
+    al::Vec3f safeDirForSource(size_t si,
                                 const std::vector<Keyframe>& kfs,
                                 const al::Vec3f& rawDir,
                                 double t) {
+        return safeDirWithState(kfs, rawDir, t, mLastGoodDir[si], mHasLastGoodDir[si]);
+    }
+
+    // Fallback logic on caller-owned last-good state: the audio thread
+    // passes its mLastGoodDir slot, the bake thread a local per source.
+    static al::Vec3f safeDirWithState(const std::vector<Keyframe>& kfs,
+                                      const al::Vec3f& rawDir,
+                                      double t,
+                                      al::Vec3f& lastGoodDir,
+                                      uint8_t& hasLastGoodDir) {
         float m2 = rawDir.magSqr();
 
         // Valid direction → normalize and store as last-good
         if (finite3(rawDir) && std::isfinite(m2) && m2 >= 1e-8f) {
             al::Vec3f normalized = rawDir.normalized();
-            mLastGoodDir[name] = normalized;
+            lastGoodDir = normalized;
+            hasLastGoodDir = 1u;
             return normalized;
         }
 
         // Degenerate → try last-good direction
-        auto it = mLastGoodDir.find(name);
-        if (it != mLastGoodDir.end()) {
-            return it->second;
+        if (hasLastGoodDir) {
+            return lastGoodDir;
         }
 
         // No last-good → use nearest keyframe direction
@@ -403,7 +567,8 @@ private:
                                                     kfs[nearestIdx].y,
                                                     kfs[nearestIdx].z));
             }
-            mLastGoodDir[name] = fallback;
+            lastGoodDir = fallback;
+            hasLastGoodDir = 1u;
             return fallback;
         }
 
@@ -494,25 +659,25 @@ private:
     //
     // Fallback priority (same as safeDirForSource, read-only version):
     //   1. rawDir is valid → normalize → sanitize → convert
-    //   2. rawDir is degenerate → read mLastGoodDir (const find, no insert)
+    //   2. rawDir is degenerate → read mLastGoodDir[si] (no write)
     //   3. Not in cache → use safeNormalize(rawDir) or front direction
     //
     // THREADING: audio thread only (reads mLastGoodDir which is audio-thread-owned).
     // This method is const so the compiler enforces no writes to member state.
-    al::Vec3f computePositionAtTimeReadOnly(const std::string& name,
+    al::Vec3f computePositionAtTimeReadOnly(size_t si,
                                              const std::vector<Keyframe>& kfs,
                                              double t,
-                                             ElevationMode elMode) const {
-        al::Vec3f rawDir = interpolateDirRaw(kfs, t);
+                                             ElevationMode elMode,
+                                             size_t& cursor) const {
+        al::Vec3f rawDir = interpolateDirRaw(kfs, t, cursor);
         al::Vec3f dir;
         float m2 = rawDir.magSqr();
         if (finite3(rawDir) && std::isfinite(m2) && m2 >= 1e-8f) {
             dir = rawDir.normalized();
         } else {
             // Read-only fallback: use whatever mLastGoodDir has (set by center pass)
-            auto it = mLastGoodDir.find(name);
-            if (it != mLastGoodDir.end()) {
-                dir = it->second;
+            if (mHasLastGoodDir[si]) {
+                dir = mLastGoodDir[si];
             } else {
                 dir = al::Vec3f(0.0f, 1.0f, 0.0f);  // absolute last resort: front
             }
@@ -520,6 +685,116 @@ private:
         return directionToDBAPPosition(sanitizeDirForLayout(dir, elMode));
     }
 
+    // ═════════════════════════════════════════════════════════════════════
+    // TRAJECTORY BAKING — BAKE thread
+    // ═════════════════════════════════════════════════════════════════════
+
+    // 2D layouts flatten every mode identically, so they share slot 0.
+    int bakeSlot(int mode) const {
+        return mLayoutIs2D ? 0 : std::max(0, std::min(2, mode));
+    }
+
+    const BakedPoseTracks* bakedFor(int mode) const {
+        return mBaked[static_cast<size_t>(bakeSlot(mode))].load(std::memory_order_acquire);
+    }
+
+    void startBaking() {
+        stopBaking();
+        mBakeStop.store(false);
+        mBakeThread = std::thread([this] { bakeWorker(); });
+    }
+
+    // Bake the current elevation mode, then keep polling for mode switches.
+    // Exits on stop, or for good after a bake exceeds kMaxBakeBytes (the
+    // size does not depend on the mode).
+    void bakeWorker() {
+        std::unique_lock<std::mutex> lk(mBakeMutex);
+        while (!mBakeStop) {
+            const int mode = mConfig.elevationMode.load(std::memory_order_relaxed);
+            const size_t slot = static_cast<size_t>(bakeSlot(mode));
+            if (!mBakeOwned[slot]) {
+                lk.unlock();
+                bool overBudget = false;
+                std::unique_ptr<BakedPoseTracks> tracks =
+                    bakeTracks(static_cast<ElevationMode>(bakeSlot(mode)), overBudget);
+                lk.lock();
+                if (overBudget || mBakeStop) return;
+                mBakeOwned[slot] = std::move(tracks);
+                mBaked[slot].store(mBakeOwned[slot].get(), std::memory_order_release);
+            }
+            mBakeCv.wait_for(lk, std::chrono::milliseconds(kBakePollMs),
+                             [this] { return mBakeStop.load(); });
+        }
+    }
+
+    // Evaluate the full pipeline for every source on the bake grid.
+    // Returns nullptr if stopped or over budget (overBudget set).
+    std::unique_ptr<BakedPoseTracks> bakeTracks(ElevationMode mode, bool& overBudget) const {
+        const auto tStart = std::chrono::steady_clock::now();
+        const size_t nSrc = mSourceKeyframes.size();
+
+        auto tracks = std::make_unique<BakedPoseTracks>();
+        tracks->stepSec    = static_cast<double>(mConfig.poseBakeFrames)
+                           / static_cast<double>(std::max(1, mConfig.sampleRate));
+        tracks->invStepSec = 1.0 / tracks->stepSec;
+        tracks->t0.assign(nSrc, 0.0);
+        tracks->offset.assign(nSrc, 0u);
+        tracks->count.assign(nSrc, 0u);
+
+        // ── Size the grid ────────────────────────────────────────────────
+        size_t total = 0;
+        for (size_t i = 0; i < nSrc; ++i) {
+            const std::vector<Keyframe>& kfs = *mSourceKeyframes[i];
+            if (mSourceOrder[i] == "LFE" || kfs.empty()) continue;
+            const double span = std::max(0.0, kfs.back().time - kfs.front().time);
+            const size_t n = static_cast<size_t>(std::ceil(span * tracks->invStepSec)) + 1;
+            tracks->t0[i]     = kfs.front().time;
+            tracks->offset[i] = static_cast<uint32_t>(total);
+            tracks->count[i]  = static_cast<uint32_t>(n);
+            total += n;
+        }
+        const size_t bytes = total * 3 * sizeof(float);
+        if (bytes > kMaxBakeBytes || total > UINT32_MAX) {
+            std::cerr << "[Pose] Trajectory bake skipped: " << (bytes >> 20)
+                      << " MB exceeds the " << (kMaxBakeBytes >> 20)
+                      << " MB budget — positions stay live." << std::endl;
+            overBudget = true;
+            return nullptr;
+        }
+        tracks->x.resize(total);
+        tracks->y.resize(total);
+        tracks->z.resize(total);
+
+        // ── Evaluate, forward in time per source ─────────────────────────
+        for (size_t i = 0; i < nSrc; ++i) {
+            if (mBakeStop.load(std::memory_order_relaxed)) return nullptr;
+            const uint32_t n = tracks->count[i];
+            if (n == 0) continue;
+            const std::vector<Keyframe>& kfs = *mSourceKeyframes[i];
+            size_t    cursor = 0;
+            al::Vec3f lastGood(0.0f, 1.0f, 0.0f);
+            uint8_t   hasLastGood = 0u;
+            for (uint32_t k = 0; k < n; ++k) {
+                const double t = tracks->t0[i] + static_cast<double>(k) * tracks->stepSec;
+                const al::Vec3f raw  = interpolateDirRaw(kfs, t, cursor);
+                const al::Vec3f safe = safeDirWithState(kfs, raw, t, lastGood, hasLastGood);
+                const al::Vec3f p    = directionToDBAPPosition(sanitizeDirForLayout(safe, mode));
+                const size_t j = tracks->offset[i] + k;
+                tracks->x[j] = p.x;
+                tracks->y[j] = p.y;
+                tracks->z[j] = p.z;
+            }
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - tStart).count();
+        std::cout << "[Pose] Baked " << total << " trajectory samples ("
+                  << (bytes >> 10) << " KB, every " << mConfig.poseBakeFrames
+                  << " frames) for elevation mode " << static_cast<int>(mode)
+                  << " in " << static_cast<int>(ms) << " ms." << std::endl;
+        return tracks;
+    }
+
     // ── Member data ──────────────────────────────────────────────────────
 
     RealtimeConfig& mConfig;
@@ -532,12 +807,30 @@ private:
     std::vector<std::string> mSourceOrder;
     std::vector<SourcePose>  mPoses;
 
+    // Parallel to mSourceOrder: pointer into mSources (no map lookup per
+    // block) and the keyframe segment cursor. mSources is never modified
+    // after loadScene(), so the pointers stay valid. Cursors are
+    // AUDIO-THREAD-OWNED after start().
+    std::vector<const std::vector<Keyframe>*> mSourceKeyframes;
+    std::vector<size_t>                       mKeyframeCursor;
+
     // Layout parameters (computed once at load time)
     float mLayoutRadius     = 5.0f;  // Median speaker distance
     float mLayoutMinElRad   = 0.0f;  // Minimum speaker elevation (radians)
     float mLayoutMaxElRad   = 0.0f;  // Maximum speaker elevation (radians)
     bool  mLayoutIs2D       = false;  // True if layout is effectively 2D
 
-    // Direction fallback cache (per-source last-good direction)
-    std::map<std::string, al::Vec3f> mLastGoodDir;
+    // Direction fallback cache (per-source last-good direction, by handle)
+    std::vector<al::Vec3f> mLastGoodDir;
+    std::vector<uint8_t>   mHasLastGoodDir;
+
+    // Trajectory bake: one slot per ElevationMode. mBakeOwned is touched by
+    // the bake thread only (under mBakeMutex); mBaked is what the audio
+    // thread reads.
+    std::array<std::unique_ptr<BakedPoseTracks>, 3>       mBakeOwned;
+    std::array<std::atomic<const BakedPoseTracks*>, 3>    mBaked{};
+    std::thread             mBakeThread;
+    std::mutex              mBakeMutex;
+    std::condition_variable mBakeCv;
+    std::atomic<bool>       mBakeStop{false};   // stored under mBakeMutex
 };
@@ -18,7 +18,22 @@
 // 6. Exponentially smooth toward snapshot targets using tau ≈ 50 ms.
 //    Smoothed values are used for all rendering — never the raw snapshots.
 // 7. Pause/resume uses a per-sample linear fade (kPauseFadeMs = 8 ms) to
-//    avoid hard-mute click transients.
+//    avoid hard-mute click transients. The block's ramp is handed to the
+//    Spatializer (ControlsSnapshot::outputRamp) and applied in its fused
+//    output finalize, not as another pass over the device bus.
+// 7b. Seek (requestSeek()) reuses the same ramp: fade out, park silent while
+//    the loader refills every stream at the target, land, fade back in.
+// 7c. Layout hot-swap (requestLayoutSwap()): a Pose + Spatializer pair built
+//    off the audio thread is adopted at a block boundary and equal-power
+//    crossfaded against the outgoing pair over kLayoutFadeMs; the outgoing
+//    pair is then handed back to the main thread for destruction.
+// 7d. Freewheel (initFreewheel() / freewheelBlock()): no device is opened;
+//    an offline bounce loop calls processBlock() on its own bus as fast as
+//    the CPU allows, so the file matches what the room hears.
+// 7e. Cluster transport (ClusterSync.hpp): each played block publishes a
+//    (frame, wall time) clock stamp, and a follower's drift trim
+//    (requestSlew()) is applied at most kMaxSlewFrames per block when the
+//    frame counter advances.
 // 8. Per-channel gain anchors (mPrevChannelGains / mNextChannelGains) are
 //    reserved for future block-boundary gain interpolation to prevent
 //    speaker-switch clicks. Currently identity (placeholder).
@@ -41,7 +56,9 @@
 
 #pragma once
 
-#include <cmath>    // std::exp (used for per-block smoothing in processBlock)
+#include <atomic>
+#include <cassert>  // processBlock() step D size check
+#include <cmath>    // std::exp (per-block smoothing), std::cos / std::sin (layout crossfade)
 #include <chrono>   // std::chrono::steady_clock (wall-clock CPU meter)
 #include <thread>   // std::this_thread::sleep_for (stop fade drain)
 #include <iostream>
@@ -58,6 +75,8 @@
 #include "Streaming.hpp"      // Streaming — needed for inline processBlock()
 #include "Pose.hpp"           // Pose — needed for inline processBlock()
 #include "Spatializer.hpp"    // Spatializer — needed for inline processBlock()
+#include "StageProfiler.hpp"  // per-stage callback timing histograms
+#include "RtSafety.hpp"       // opt-in real-time contract checks (BlockScope)
 
 // ─────────────────────────────────────────────────────────────────────────────
 // RealtimeBackend — AlloLib AudioIO wrapper for the real-time engine
@@ -229,10 +248,42 @@ public:
                       << ". Extra hardware channels will be unused." << std::endl;
         }
 
+        allocateBlockBuses();
         mInitialized = true;
         return true;
     }
 
+    /// Initialize for a freewheel bounce instead of a device: no AudioIO is
+    /// opened, and the caller drives processBlock() through freewheelBlock().
+    /// Use instead of init() / start(); shutdown() applies as usual.
+    bool initFreewheel() {
+        if (mConfig.outputChannels <= 0 || mConfig.bufferSize <= 0) {
+            std::cerr << "[Backend] ERROR: Freewheel needs outputChannels and bufferSize > 0."
+                      << std::endl;
+            return false;
+        }
+        std::cout << "[Backend] Freewheel mode: " << mConfig.outputChannels << " channels, "
+                  << mConfig.bufferSize << "-frame blocks, no audio device." << std::endl;
+        mFreewheelIO.framesPerBuffer(mConfig.bufferSize);
+        mFreewheelIO.framesPerSecond(mConfig.sampleRate);
+        mFreewheelIO.channelsIn(0);
+        mFreewheelIO.channelsOut(mConfig.outputChannels);
+        allocateBlockBuses();
+        mFreewheel   = true;
+        mInitialized = true;
+        mConfig.playing.store(true);
+        return true;
+    }
+
+    /// Render the next block of a freewheel bounce and return its output bus.
+    /// The calling thread takes the audio thread's role for the whole bounce
+    /// (same real-time contract, nothing else may call this concurrently);
+    /// the bus is valid until the next call.
+    const al::AudioIOData& freewheelBlock() {
+        processBlock(mFreewheelIO);
+        return mFreewheelIO;
+    }
+
     /// Start audio streaming. Returns true on success.
     bool start() {
         if (!mInitialized) {
@@ -275,17 +326,96 @@ public:
     /// Full shutdown: stop stream and close device.
     void shutdown() {
         stop();
-        if (mInitialized) {
+        if (mInitialized && mFreewheel) {
+            mConfig.playing.store(false);
+            mFreewheel   = false;
+            mInitialized = false;
+        } else if (mInitialized) {
             mAudioIO.close();
             mInitialized = false;
             std::cout << "[Backend] Audio device closed." << std::endl;
         }
     }
 
+    // ── Transport ────────────────────────────────────────────────────────
+
+    /// Jump playback to frame. Any thread; lock-free (two atomic stores).
+    /// The audio thread fades out, hands the jump to the Streaming loader,
+    /// outputs silence until the landing burst is loaded (typically a few
+    /// buffer periods) and fades back in at frame. A request made while an
+    /// earlier one is still in flight retargets it. Paused playback stays
+    /// paused — the position still moves.
+    void requestSeek(uint64_t frame) {
+        mSeekRequestFrame.store(frame, std::memory_order_relaxed);
+        mSeekRequestSeq.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Whether a seek is still fading out or waiting for the loader.
+    bool seekPending() const {
+        return mSeekRequestSeq.load(std::memory_order_acquire)
+            != mSeekLandedSeq.load(std::memory_order_acquire);
+    }
+
+    /// Cluster drift trim: move the playhead by frames (positive = ahead)
+    /// on top of normal playback, at most kMaxSlewFrames per block — a
+    /// one-frame skip or repeat at a block boundary, inaudible (a seek
+    /// fade is not). Replaces any trim still outstanding. Any thread;
+    /// lock-free.
+    void requestSlew(int64_t frames) {
+        mSlewPending.store(frames, std::memory_order_relaxed);
+    }
+
+    /// Total trim applied since start (frames; ClusterSync corrects
+    /// older error samples by the trim applied since). Any thread.
+    int64_t slewApplied() const {
+        return mSlewApplied.load(std::memory_order_relaxed);
+    }
+
+    /// The frame the last played block started at and steady_clock time
+    /// (ns since epoch) its callback began, published together. Stale while
+    /// paused or seeking (no block advances the counter). Any thread;
+    /// lock-free (seqlock, the audio thread never waits).
+    void clockStamp(uint64_t& frame, int64_t& timeNs) const {
+        for (;;) {
+            const uint32_t seq = mClockSeq.load(std::memory_order_acquire);
+            frame  = mClockFrame.load(std::memory_order_relaxed);
+            timeNs = mClockTimeNs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!(seq & 1u) && mClockSeq.load(std::memory_order_relaxed) == seq) return;
+            std::this_thread::yield();
+        }
+    }
+
+    // ── Layout hot-swap ──────────────────────────────────────────────────
+
+    /// Hand a new Pose + Spatializer pair to the audio thread. Any thread;
+    /// lock-free (two pointer stores and a release bump). Both must be fully
+    /// initialised (Pose::loadScene(), Spatializer::init() with the open
+    /// output width, prepareForSources(), startWorkers()). The audio thread
+    /// adopts them at its next block boundary and crossfades from the
+    /// current pair over kLayoutFadeMs (immediately when the output is
+    /// silent). Returns false while a previous swap is still in flight —
+    /// the caller keeps ownership either way.
+    bool requestLayoutSwap(Pose* pose, Spatializer* spatializer) {
+        if (!pose || !spatializer || layoutSwapPending()) return false;
+        mPendingPose.store(pose, std::memory_order_relaxed);
+        mPendingSpatializer.store(spatializer, std::memory_order_relaxed);
+        mLayoutRequestSeq.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    /// Whether a requested swap has not finished yet. Once this returns
+    /// false the audio thread no longer touches the previous pair, and the
+    /// caller may destroy it.
+    bool layoutSwapPending() const {
+        return mLayoutRequestSeq.load(std::memory_order_acquire)
+            != mLayoutRetiredSeq.load(std::memory_order_acquire);
+    }
+
     // ── Status queries ───────────────────────────────────────────────────
 
     /// Current CPU load of the audio thread (0.0–1.0).
-    double cpuLoad() const { return mAudioIO.cpu(); }
+    double cpuLoad() const { return mFreewheel ? 0.0 : mAudioIO.cpu(); }
 
     /// Whether the audio stream is currently running.
     bool isRunning() { return mAudioIO.isRunning(); }
@@ -302,8 +432,8 @@ public:
     // ── Agent wiring ─────────────────────────────────────────────────────
     //
     // The backend holds raw pointers to agents. Ownership stays with main().
-    // Pointers are set once before start() and never change during audio
-    // streaming — no synchronization needed.
+    // Pointers are set once before start(); after that only the audio thread
+    // changes mPose / mSpatializer, when it adopts a requestLayoutSwap().
 
     /// Connect the streaming agent. Must be called BEFORE start().
     void setStreaming(Streaming* agent) {
@@ -318,8 +448,13 @@ public:
     /// Connect the spatializer agent. Must be called BEFORE start().
     void setSpatializer(Spatializer* agent) {
         mSpatializer = agent;
+        if (mSpatializer) mSpatializer->setProfiler(&mProfiler);
     }
 
+    /// Per-stage timing histograms for the audio callback. snapshot() is
+    /// safe from any thread; clear() only while the stream is stopped.
+    const StageProfiler& profiler() const { return mProfiler; }
+
     /// Cache source names from the streaming agent for use in processBlock().
     /// Must be called AFTER loadScene() and BEFORE start().
     void cacheSourceNames(const std::vector<std::string>& names) {
@@ -374,6 +509,14 @@ private:
         // cost — including all rendering and state updates — is measured.
         // Stored as a member so it's accessible at the early-return paths too.
         mCallbackStart = std::chrono::steady_clock::now();
+        const uint64_t profStart = StageProfiler::now();
+
+        // RT-safety builds (-DSPATIALROOT_RT_SAFETY=ON, RtSafety.hpp): every
+        // allocation, lock or file call until this block returns — early
+        // returns included — is counted and reported as one RtViolation
+        // event. An empty object otherwise.
+        const RtSafety::BlockScope rtScope(
+            mState.diagEvents, mState.frameCounter.load(std::memory_order_relaxed), mRtSeen);
 
         const unsigned int numFrames  = static_cast<unsigned int>(io.framesPerBuffer());
         const unsigned int numChannels= static_cast<unsigned int>(io.channelsOut());
@@ -413,7 +556,7 @@ private:
         // Read paused ONCE here (already separate from ControlSnapshot).
         // On a pause edge  (playing → paused): arm a fade-OUT (gain 1→0).
         // On a resume edge (paused → playing): arm a fade-IN  (gain 0→1).
-        // The per-sample ramp in Step D prevents hard-mute click transients.
+        // The per-sample ramp (Step 1 → output finalize) prevents hard-mute click transients.
         const bool pausedNow = mConfig.paused.load(std::memory_order_relaxed);
         if (pausedNow != mPrevPaused) {
             const unsigned int fadeFrames = std::max(1u,
@@ -432,6 +575,19 @@ private:
             mPrevPaused = pausedNow;
         }
 
+        // ── C2) Seek transport (see requestSeek()) ───────────────────────────
+        // Holds the output silent (gate) from the request until the loader
+        // has landed the jump; the pause ramp provides both fades.
+        updateSeek(pausedNow, sampleRate);
+        const bool gateNow = pausedNow || mSeekPhase != SeekPhase::Idle;
+
+        // ── C3) Layout hot-swap (see requestLayoutSwap()) ────────────────────
+        // Adopt a published pair at this block boundary. Over silence there
+        // is nothing to crossfade, so the outgoing pair is released at once.
+        adoptPendingLayout(sampleRate);
+        const bool silentNow = gateNow && mPauseFadeFramesLeft == 0 && mPauseFade <= 0.0f;
+        if (silentNow && mFadeSpatializer) retireOutgoingLayout();
+
         // ── Fast-path: already fully paused (no fade active) ─────────────────
         // Skip all rendering to save CPU and prevent the Spatializer from
         // updating its per-block interpolation anchors (mPrevSafePos etc.) on
@@ -441,8 +597,8 @@ private:
         // and then pauses again.
         // This path fires on every steady-paused block AFTER the fade completes.
         // The fade-completing block itself is handled by the late early-return
-        // after Step 4 (which plays the graceful ramp before stopping).
-        if (pausedNow && mPauseFadeFramesLeft == 0 && mPauseFade <= 0.0f) {
+        // below (which plays the graceful ramp before stopping).
+        if (silentNow) {
             for (unsigned int ch = 0; ch < numChannels; ++ch)
                 std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
             {
@@ -453,36 +609,47 @@ private:
                     std::max(0.0f, static_cast<float>(us / budget)),
                     std::memory_order_relaxed);
             }
+            mProfiler.lap(ProfileStage::Callback, profStart);
+            mProfiler.endBlock();
             return;
         }
 
         // ── D) Per-channel gain anchors (block-boundary interpolation) ────────
-        // Resize once if channel count changes (init or device change).
+        // Sized to the layout's output channels in allocateBlockBuses().
         // mPrevChannelGains holds the gains applied at the end of the last block;
         // mNextChannelGains will hold the target gains for this block.
         // Per-frame lerp across the block eliminates speaker-switch clicks.
         // Currently identity — future work: populate from Spatializer top-K.
-        if (mNextChannelGains.size() != numChannels) {
-            mPrevChannelGains.assign(numChannels, 1.0f);
-            mNextChannelGains.assign(numChannels, 1.0f);
-        }
-        for (unsigned int c = 0; c < numChannels; ++c) {
+        assert(mNextChannelGains.size() == static_cast<size_t>(mConfig.outputChannels));
+        const unsigned int gainChannels =
+            std::min(numChannels, static_cast<unsigned int>(mNextChannelGains.size()));
+        for (unsigned int c = 0; c < gainChannels; ++c) {
             mPrevChannelGains[c] = mNextChannelGains[c]; // shift: last→prev
             mNextChannelGains[c] = 1.0f;                 // TODO: per-source DBAP top-K
         }
 
-        // ── Step 1: Zero all output channels ─────────────────────────────────
-        for (unsigned int ch = 0; ch < numChannels; ++ch)
-            std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
+        // ── Step 1: Pause fade ramp for this block ───────────────────────────
+        // Advanced before rendering; applied per sample by the Spatializer's
+        // fused output finalize (or folded into the layout crossfade gains).
+        // nullptr when the gain is 1 for the whole block.
+        const float* outputRamp = advancePauseRamp(numFrames);
 
         // ── Step 2: Compute source positions for this block ───────────────────
         // Fix 2: pass block start and end times so Pose can compute positionStart
         // and positionEnd for the fast-mover sub-stepping path in the Spatializer.
+        // Sources whose silence map covers the block are flagged first (one
+        // mask for both poses of a layout crossfade — same handles); Pose
+        // marks them isSilent and the Spatializer skips them unread.
         if (mPose) {
             const uint64_t curFrame     = mState.frameCounter.load(std::memory_order_relaxed);
             const double   blockStartSec = static_cast<double>(curFrame)             / sampleRate;
             const double   blockEndSec   = static_cast<double>(curFrame + numFrames) / sampleRate;
-            mPose->computePositions(blockStartSec, blockEndSec);
+            const uint64_t t0 = StageProfiler::now();
+            const uint8_t* silentBlocks = (mSpatializer && mStreamer)
+                ? mStreamer->markSilentBlocks(curFrame, numFrames) : nullptr;
+            mPose->computePositions(blockStartSec, blockEndSec, silentBlocks);
+            if (mFadePose) mFadePose->computePositions(blockStartSec, blockEndSec, silentBlocks);
+            mProfiler.lap(ProfileStage::Pose, t0);
         }
 
         // ── Step 3: Spatialize all sources via DBAP ───────────────────────────
@@ -507,34 +674,33 @@ private:
             ctrl.subMix         = mSmooth.smoothed.subMix;
 
             const uint64_t currentFrame = mState.frameCounter.load(std::memory_order_relaxed);
-            mSpatializer->renderBlock(io, *mStreamer, mPose->getPoses(),
-                                      currentFrame, numFrames, ctrl);
-        }
-
-        // ── Step 4: Apply pause fade per-sample ──────────────────────────────
-        // After all rendering, scale output samples by mPauseFade.
-        // If fully paused (mPauseFade == 0 and no fade in progress), clear
-        // buffers and return — skips state updates to keep position stable.
-        if (mPauseFadeFramesLeft > 0 || mPauseFade < 1.0f) {
-            for (unsigned int f = 0; f < numFrames; ++f) {
-                // Advance fade ramp one sample at a time.
-                if (mPauseFadeFramesLeft > 0) {
-                    mPauseFade += mPauseFadeStep;
-                    mPauseFade  = std::max(0.0f, std::min(1.0f, mPauseFade));
-                    --mPauseFadeFramesLeft;
-                }
-                // Apply current fade gain to every output channel.
-                const float fadeGain = mPauseFade;
-                for (unsigned int ch = 0; ch < numChannels; ++ch)
-                    io.outBuffer(ch)[f] *= fadeGain;
+            if (!mFadeSpatializer) {
+                // renderBlock() overwrites every channel of io — no pre-zero
+                ctrl.outputRamp = outputRamp;
+                mSpatializer->renderBlock(io, *mStreamer, mPose->getPoses(),
+                                          currentFrame, numFrames, ctrl);
+            } else {
+                // Layout crossfade: outgoing pair into io, incoming pair into
+                // mLayoutFadeIO, then io = (out·cos θ + in·sin θ)·fade per frame.
+                mFadeSpatializer->renderBlock(io, *mStreamer, mFadePose->getPoses(),
+                                              currentFrame, numFrames, ctrl);
+                mSpatializer->renderBlock(mLayoutFadeIO, *mStreamer, mPose->getPoses(),
+                                          currentFrame, numFrames, ctrl);
+                mixLayoutCrossfade(io, numFrames, numChannels, outputRamp);
             }
+        } else {
+            for (unsigned int ch = 0; ch < numChannels; ++ch)
+                std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
         }
 
         // If fully paused (fade complete, gain == 0) — return without advancing
-        // playback position counters. No memset needed: Step 4's multiply-by-zero
-        // already zeroed the buffer. Zeroing here would wipe the graceful fade on
-        // the block where the ramp completes, causing an audible click.
-        if (pausedNow && mPauseFadeFramesLeft == 0 && mPauseFade <= 0.0f) {
+        // playback position counters. No memset needed: the ramp ended at 0
+        // inside this block's finalize. Zeroing here would wipe the graceful
+        // fade on the block where the ramp completes, causing an audible click.
+        if (gateNow && mPauseFadeFramesLeft == 0 && mPauseFade <= 0.0f) {
+            // A seek's fade-out just completed: hand it to the loader now
+            // rather than one block later.
+            if (mSeekPhase == SeekPhase::FadingOut) postSeekToLoader();
             // Update CPU load even in paused state (paused overhead is still real).
             {
                 auto t1 = std::chrono::steady_clock::now();
@@ -544,16 +710,33 @@ private:
                     std::max(0.0f, static_cast<float>(us / budget)),
                     std::memory_order_relaxed);
             }
+            mProfiler.lap(ProfileStage::Callback, profStart);
+            mProfiler.endBlock();
             return;
         }
 
         // ── Step 5: Update engine state ───────────────────────────────────────
         const uint64_t prevFrames = mState.frameCounter.load(std::memory_order_relaxed);
-        const uint64_t newFrames  = prevFrames + numFrames;
+        publishClock(prevFrames);
+        const uint64_t newFrames  = prevFrames + numFrames + takeSlew();
         mState.frameCounter.store(newFrames, std::memory_order_relaxed);
         mState.playbackTimeSec.store(
             static_cast<double>(newFrames) / sampleRate, std::memory_order_relaxed);
 
+        // Wake the loader if playback crossed its next refill deadline
+        // (lock-free; usually a single relaxed compare).
+        if (mStreamer) mStreamer->notifyPlayhead(newFrames);
+
+        // Stream misses from any render lane → one frame-stamped event
+        if (mStreamer) {
+            const uint64_t misses = mStreamer->underrunTally();
+            if (misses != mUnderrunsSeen) {
+                mState.diagEvents.push(DiagEventType::Underrun, prevFrames, 0, 0,
+                                       misses - mUnderrunsSeen);
+                mUnderrunsSeen = misses;
+            }
+        }
+
         // ── Step 6: CPU load monitoring ───────────────────────────────────────
         // Wall-clock measurement: elapsed callback time / block budget.
         // Values > 1.0 indicate overload (callback took longer than its budget).
@@ -564,13 +747,203 @@ private:
             auto t1 = std::chrono::steady_clock::now();
             double us = std::chrono::duration<double, std::micro>(t1 - mCallbackStart).count();
             double budget = (static_cast<double>(numFrames) / sampleRate) * 1e6;
+            const float load = static_cast<float>(us / budget);
             mState.callbackCpuLoad.store(
-                std::max(0.0f, std::min(2.0f, static_cast<float>(us / budget))),
+                std::max(0.0f, std::min(2.0f, load)),
                 std::memory_order_relaxed);
+            // Freewheel has no deadline — a slow block is not an overrun.
+            if (load > 1.0f && !mFreewheel) {
+                mState.diagEvents.push(DiagEventType::CpuOverrun, prevFrames, 0, 0, 0, load);
+            }
         }
         mState.cpuLoad.store(
-            std::max(0.0f, std::min(1.0f, static_cast<float>(mAudioIO.cpu()))),
+            mFreewheel ? 0.0f
+                       : std::max(0.0f, std::min(1.0f, static_cast<float>(mAudioIO.cpu()))),
             std::memory_order_relaxed);
+
+        mProfiler.lap(ProfileStage::Callback, profStart);
+        mProfiler.endBlock();
+    }
+
+    // ── Seek state machine (AUDIO thread) ────────────────────────────────
+    //   Idle      → FadingOut  new request seen; pause ramp armed toward 0
+    //   FadingOut → Loading    ramp at 0; Streaming::requestSeek() posted
+    //   Loading   → Idle       Streaming::seekDone(); frameCounter = target,
+    //                          Spatializer continuity reset, fade back in
+    //                          unless paused
+    // A newer request during FadingOut just updates the target; during
+    // Loading it is re-posted to the loader (which supersedes the old one).
+
+    void updateSeek(bool pausedNow, double sampleRate) {
+        const uint32_t req = mSeekRequestSeq.load(std::memory_order_acquire);
+        if (req != mSeekSeenSeq) {
+            mSeekSeenSeq = req;
+            mSeekTargetFrame = mSeekRequestFrame.load(std::memory_order_relaxed);
+            if (mSeekPhase == SeekPhase::Loading) {
+                postSeekToLoader();
+            } else {
+                mSeekPhase = SeekPhase::FadingOut;
+            }
+        }
+
+        if (mSeekPhase == SeekPhase::FadingOut) {
+            // Keep the ramp heading to 0 even if a resume edge re-armed a fade-in
+            const bool fadingDown = mPauseFadeFramesLeft > 0 && mPauseFadeStep < 0.0f;
+            if (mPauseFade > 0.0f && !fadingDown) {
+                const unsigned int fadeFrames = std::max(1u,
+                    static_cast<unsigned int>((kPauseFadeMs / 1000.0) * sampleRate));
+                mPauseFadeFramesLeft = fadeFrames;
+                mPauseFadeStep       = -(mPauseFade / static_cast<float>(fadeFrames));
+            }
+            if (mPauseFade <= 0.0f && mPauseFadeFramesLeft == 0) postSeekToLoader();
+        }
+
+        if (mSeekPhase != SeekPhase::Loading) return;
+        mPauseFade = 0.0f;            // a resume edge must not un-gate a half-loaded jump
+        mPauseFadeFramesLeft = 0;
+        if (mStreamer && !mStreamer->seekDone(mSeekLoaderSeq)) return;
+
+        // ── Landed ──
+        mState.frameCounter.store(mSeekTargetFrame, std::memory_order_relaxed);
+        mState.playbackTimeSec.store(
+            static_cast<double>(mSeekTargetFrame) / sampleRate, std::memory_order_relaxed);
+        if (mSpatializer) mSpatializer->resetSourceContinuity();
+        if (mFadeSpatializer) mFadeSpatializer->resetSourceContinuity();
+        mSlewPending.store(0, std::memory_order_relaxed);   // measured before the jump
+        mSeekPhase = SeekPhase::Idle;
+        mSeekLandedSeq.store(mSeekSeenSeq, std::memory_order_release);
+        if (!pausedNow) {
+            const unsigned int fadeFrames = std::max(1u,
+                static_cast<unsigned int>((kPauseFadeMs / 1000.0) * sampleRate));
+            mPauseFadeFramesLeft = fadeFrames;
+            mPauseFadeStep       = 1.0f / static_cast<float>(fadeFrames);
+        }
+    }
+
+    // ── Cluster clock (requestSlew() / clockStamp()) ─────────────────────────
+    // AUDIO THREAD, once per played block (Step 5).
+    void publishClock(uint64_t frame) {
+        const uint32_t seq = mClockSeq.load(std::memory_order_relaxed);
+        mClockSeq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mClockFrame.store(frame, std::memory_order_relaxed);
+        mClockTimeNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            mCallbackStart.time_since_epoch()).count(), std::memory_order_relaxed);
+        mClockSeq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Up to ±kMaxSlewFrames of the pending trim. A trim stored by another
+    // thread since the load wins (the CAS fails; nothing applied this block).
+    int64_t takeSlew() {
+        int64_t pending = mSlewPending.load(std::memory_order_relaxed);
+        if (pending == 0) return 0;
+        const int64_t step = std::max(-kMaxSlewFrames, std::min(kMaxSlewFrames, pending));
+        if (!mSlewPending.compare_exchange_strong(pending, pending - step,
+                                                  std::memory_order_relaxed)) return 0;
+        mSlewApplied.fetch_add(step, std::memory_order_relaxed);
+        return step;
+    }
+
+    // Second output bus for the incoming side of a layout crossfade.
+    // Same shape as the device bus; allocated at init, never on the audio thread.
+    // Also the per-frame pause ramp (advancePauseRamp()) and the per-channel
+    // gain anchors (processBlock() step D).
+    void allocateBlockBuses() {
+        mLayoutFadeIO.framesPerBuffer(mConfig.bufferSize);
+        mLayoutFadeIO.framesPerSecond(mConfig.sampleRate);
+        mLayoutFadeIO.channelsIn(0);
+        mLayoutFadeIO.channelsOut(mConfig.outputChannels);
+        mLayoutFadeGains.assign(2 * static_cast<size_t>(mConfig.bufferSize), 0.0f);
+        mPauseRamp.assign(static_cast<size_t>(mConfig.bufferSize), 0.0f);
+        mPrevChannelGains.assign(static_cast<size_t>(mConfig.outputChannels), 1.0f);
+        mNextChannelGains.assign(static_cast<size_t>(mConfig.outputChannels), 1.0f);
+    }
+
+    // Advance the pause fade over this block and return its per-frame gain
+    // (mPauseRamp), or nullptr when the gain stays at 1 for the whole block.
+    const float* advancePauseRamp(unsigned int numFrames) {
+        if (mPauseFadeFramesLeft == 0 && mPauseFade >= 1.0f) return nullptr;
+        for (unsigned int f = 0; f < numFrames; ++f) {
+            // Advance fade ramp one sample at a time.
+            if (mPauseFadeFramesLeft > 0) {
+                mPauseFade += mPauseFadeStep;
+                mPauseFade  = std::max(0.0f, std::min(1.0f, mPauseFade));
+                --mPauseFadeFramesLeft;
+            }
+            mPauseRamp[f] = mPauseFade;
+        }
+        return mPauseRamp.data();
+    }
+
+    void postSeekToLoader() {
+        if (mStreamer) mSeekLoaderSeq = mStreamer->requestSeek(mSeekTargetFrame);
+        mSeekPhase = SeekPhase::Loading;
+    }
+
+    // ── Layout hot-swap (AUDIO thread) ───────────────────────────────────
+    //   idle        → crossfading  new request seen; pending pair becomes
+    //                              mPose / mSpatializer, the old pair moves
+    //                              to mFadePose / mFadeSpatializer
+    //   crossfading → idle         kLayoutFadeMs rendered (or output went
+    //                              silent); old pair released to the main
+    //                              thread via mLayoutRetiredSeq
+    // A request is only accepted while idle (requestLayoutSwap()), so a
+    // second one cannot arrive mid-fade.
+
+    void adoptPendingLayout(double sampleRate) {
+        const uint32_t req = mLayoutRequestSeq.load(std::memory_order_acquire);
+        if (req == mLayoutSeenSeq) return;
+        mLayoutSeenSeq = req;
+
+        Pose*        pose = mPendingPose.load(std::memory_order_relaxed);
+        Spatializer* spat = mPendingSpatializer.load(std::memory_order_relaxed);
+        if (mSpatializer) spat->takeOver(*mSpatializer);
+        else              spat->setProfiler(&mProfiler);
+
+        mFadePose        = mPose;
+        mFadeSpatializer = mSpatializer;
+        mPose            = pose;
+        mSpatializer     = spat;
+
+        mLayoutFadeTotal = std::max(1u,
+            static_cast<unsigned int>((kLayoutFadeMs / 1000.0) * sampleRate));
+        mLayoutFadeDone  = 0;
+        if (!mFadeSpatializer) retireOutgoingLayout();   // first layout: no fade
+    }
+
+    void retireOutgoingLayout() {
+        mFadePose        = nullptr;
+        mFadeSpatializer = nullptr;
+        mLayoutRetiredSeq.store(mLayoutSeenSeq, std::memory_order_release);
+    }
+
+    // Equal-power mix of the outgoing (io) and incoming (mLayoutFadeIO)
+    // renders: gains cos θ / sin θ with θ = π/2 · progress, so
+    // gOut² + gIn² = 1 on every frame. The two layouts render the same
+    // sources from the same stream buffers, so their sum keeps the overall
+    // level steady while the image moves to the new speaker set. A pause
+    // ramp, if any, scales both gains (one pass for both fades).
+    void mixLayoutCrossfade(al::AudioIOData& io, unsigned int numFrames,
+                            unsigned int numChannels, const float* ramp) {
+        constexpr float kHalfPi = 1.5707963267948966f;
+        float* gOut = mLayoutFadeGains.data();
+        float* gIn  = gOut + numFrames;
+        const float invTotal = 1.0f / static_cast<float>(mLayoutFadeTotal);
+        for (unsigned int f = 0; f < numFrames; ++f) {
+            const unsigned int done = std::min(mLayoutFadeTotal, mLayoutFadeDone + f + 1);
+            const float theta = kHalfPi * static_cast<float>(done) * invTotal;
+            const float fade = ramp ? ramp[f] : 1.0f;
+            gOut[f] = std::cos(theta) * fade;
+            gIn[f]  = std::sin(theta) * fade;
+        }
+        for (unsigned int ch = 0; ch < numChannels; ++ch) {
+            float*       out = io.outBuffer(ch);
+            const float* in  = mLayoutFadeIO.outBuffer(ch);
+            for (unsigned int f = 0; f < numFrames; ++f)
+                out[f] = out[f] * gOut[f] + in[f] * gIn[f];
+        }
+        mLayoutFadeDone += numFrames;
+        if (mLayoutFadeDone >= mLayoutFadeTotal) retireOutgoingLayout();
     }
 
     // ── Member data ──────────────────────────────────────────────────────
@@ -579,15 +952,38 @@ private:
     EngineState&    mState;     // Reference to shared engine state
     al::AudioIO     mAudioIO;   // AlloLib audio device wrapper
     bool            mInitialized = false;
-
-    // ── Agent pointers (set once before start(), never changed) ──────────
-    // THREADING: Set on the MAIN thread before start(). After start() these
-    // are read-only on the AUDIO thread. No synchronization needed —
-    // start() provides the required happens-before relationship.
+    bool            mFreewheel   = false;  // initFreewheel(): no device, bus below
+    al::AudioIOData mFreewheelIO;          // freewheelBlock() output bus
+
+    // ── Agent pointers (set before start()) ──────────────────────────────
+    // THREADING: Set on the MAIN thread before start(). After start() only
+    // the AUDIO thread reads them, and only it replaces mPose / mSpatializer
+    // (adoptPendingLayout()). start() provides the initial happens-before;
+    // mLayoutRequestSeq (release/acquire) publishes each swapped-in pair.
     Streaming*    mStreamer     = nullptr;
     Pose*         mPose         = nullptr;
     Spatializer*  mSpatializer  = nullptr;
 
+    // ── Layout hot-swap (see requestLayoutSwap() / adoptPendingLayout()) ─
+    // mPendingPose / mPendingSpatializer / mLayoutRequestSeq: written by the
+    // requesting thread (EngineSession's layout build thread).
+    // mLayoutRetiredSeq: written by the audio thread, read by
+    // layoutSwapPending(). Everything else: audio thread only.
+    // mLayoutFadeIO and mLayoutFadeGains are sized in init().
+    static constexpr double kLayoutFadeMs = 50.0;
+
+    std::atomic<Pose*>        mPendingPose{nullptr};
+    std::atomic<Spatializer*> mPendingSpatializer{nullptr};
+    std::atomic<uint32_t>     mLayoutRequestSeq{0};
+    std::atomic<uint32_t>     mLayoutRetiredSeq{0};
+    uint32_t                  mLayoutSeenSeq   = 0;
+    Pose*                     mFadePose        = nullptr;  // outgoing pair while crossfading
+    Spatializer*              mFadeSpatializer = nullptr;
+    unsigned int              mLayoutFadeTotal = 1;        // crossfade length, frames
+    unsigned int              mLayoutFadeDone  = 0;        // frames of it already rendered
+    al::AudioIOData           mLayoutFadeIO;
+    std::vector<float>        mLayoutFadeGains;            // per-frame gOut | gIn scratch
+
     // ── Cached data for audio callback (set once, read-only in callback) ─
     // THREADING: Written by main thread (cacheSourceNames) before start(),
     // then only read on the audio thread. Same happens-before as agent ptrs.
@@ -636,7 +1032,8 @@ private:
     // Hard-muting on pause causes an audible click transient. Instead we ramp
     // the output gain linearly over kPauseFadeMs before going silent (fade-out)
     // and after resuming (fade-in). The ramp is applied per-sample after all
-    // rendering in processBlock Step 4.
+    // rendering: processBlock Step 1 fills mPauseRamp and the Spatializer's
+    // fused output finalize multiplies it in.
     //
     // State machine:
     //   playing: mPauseFade == 1.0, mPauseFadeFramesLeft == 0
@@ -652,6 +1049,39 @@ private:
     float        mPauseFade           = 1.0f;   // current fade envelope (0=silent, 1=full)
     float        mPauseFadeStep       = 0.0f;   // per-sample delta (negative=fade-out, positive=fade-in)
     unsigned int mPauseFadeFramesLeft = 0;       // samples remaining in current ramp
+    std::vector<float> mPauseRamp;               // this block's fade gain per frame (bufferSize)
+
+    // Streaming::underrunTally() at the last Underrun event. Audio thread only.
+    uint64_t mUnderrunsSeen = 0;
+
+    // RtSafety violation totals at the last RtViolation event (RT-safety
+    // builds only; BlockScope diffs against it). Audio thread only.
+    RtSafety::Tally mRtSeen;
+
+    // ── Seek transport (see updateSeek()) ────────────────────────────────────
+    // mSeekRequestFrame / mSeekRequestSeq: written by any thread (requestSeek()).
+    // mSeekLandedSeq: written by the audio thread, read by seekPending().
+    // Everything else: audio thread only.
+    enum class SeekPhase { Idle, FadingOut, Loading };
+
+    std::atomic<uint64_t> mSeekRequestFrame{0};
+    std::atomic<uint32_t> mSeekRequestSeq{0};
+    std::atomic<uint32_t> mSeekLandedSeq{0};
+    uint32_t              mSeekSeenSeq     = 0;
+    uint64_t              mSeekTargetFrame = 0;
+    uint32_t              mSeekLoaderSeq   = 0;
+    SeekPhase             mSeekPhase       = SeekPhase::Idle;
+
+    // ── Cluster transport (see publishClock() / takeSlew()) ──────────────────
+    // mSlewPending: stored by any thread (requestSlew()), consumed by the
+    // audio thread. mSlewApplied and the clock stamp: written by the audio
+    // thread only, read by any thread.
+    static constexpr int64_t kMaxSlewFrames = 1;
+    std::atomic<int64_t>  mSlewPending{0};
+    std::atomic<int64_t>  mSlewApplied{0};
+    std::atomic<uint32_t> mClockSeq{0};
+    std::atomic<uint64_t> mClockFrame{0};
+    std::atomic<int64_t>  mClockTimeNs{0};
 
     // ── Phase 10 polish: per-channel gain anchors (block-boundary ramp) ──────
     //
@@ -676,5 +1106,11 @@ private:
     // >1.0 = overload). Replaces the untrustworthy mAudioIO.cpu() reading.
     // THREADING: audio thread only.
     std::chrono::steady_clock::time_point mCallbackStart;
+
+    // ── Per-stage profiler ───────────────────────────────────────────────────
+    // Callback and Pose are recorded here; the Spatializer records its own
+    // stages through the pointer handed over in setSpatializer().
+    // THREADING: written by the audio thread only; snapshot() from any thread.
+    StageProfiler mProfiler;
 };
 
@@ -114,16 +114,89 @@
 #include <string>
 #include <vector>
 
+#include "DiagnosticRing.hpp"   // DiagnosticRing, DiagEvent
+
 // ─────────────────────────────────────────────────────────────────────────────
 // ElevationMode — Elevation handling for directions outside speaker coverage
 // ─────────────────────────────────────────────────────────────────────────────
 // Replicated from SpatialRenderer.hpp so the real-time engine doesn't depend
-// on the offline renderer headers. Must stay in sync.
+// on the offline renderer headers. Must stay in sync. The shared guard lets
+// offline code that reuses Streaming.hpp (ChunkedSourceReader) see both.
+#ifndef SPATIALROOT_ELEVATION_MODE_DEFINED
+#define SPATIALROOT_ELEVATION_MODE_DEFINED
 enum class ElevationMode {
     Clamp,              // Hard clip elevation to layout bounds
     RescaleAtmosUp,     // Default. Assumes content in [0, +π/2]. Maps to layout range.
     RescaleFullSphere   // Assumes content in [-π/2, +π/2]. Maps to layout range.
 };
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// DiagnosticsTier — how often the Phase 14 bus analysis runs
+// ─────────────────────────────────────────────────────────────────────────────
+// The render-bus / device-bus masks, cluster and RMS meters in EngineState
+// exist for monitoring only. Headless playback with nobody polling them can
+// turn them down; the published values then update less often or not at all.
+
+enum class DiagnosticsTier {
+    Off       = 0,   // never analysed; masks / meters read 0
+    Decimated = 1,   // one block in every RealtimeConfig::diagnosticsEvery
+    Full      = 2    // every block (default)
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ClusterRole — multi-node playback (ClusterSync.hpp)
+// ─────────────────────────────────────────────────────────────────────────────
+// Every node of a cluster plays the same scene and layout and renders its own
+// slice of the speakers (RealtimeConfig::clusterSpeakers). The leader's
+// transport is authoritative; followers lock their frame counter to it.
+
+enum class ClusterRole {
+    Off      = 0,   // standalone (default)
+    Leader   = 1,   // sends its transport clock to the followers
+    Follower = 2    // takes frame, pause and seek from the leader
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ProfileStage / StageTiming — Per-stage callback timing (StageProfiler.hpp)
+// ─────────────────────────────────────────────────────────────────────────────
+// Stages of one audio callback, in execution order. Callback is the whole of
+// processBlock(). StreamRead is the Streaming::getBlock() copies inside the
+// source loop, summed across render lanes (CPU time, not wall time — with
+// --render_threads > 1 it can exceed Sources).
+
+enum class ProfileStage : int {
+    Pose,          // Pose::computePositions()
+    Sources,       // per-source render loop incl. lane fork/join + partial-bus sum
+    StreamRead,    // Streaming::getBlock() copies (subset of Sources)
+    TrimClamp,     // fused output finalize: trims, NaN scrub, clamp, fade, remap
+    Diagnostics,   // Phase 14 render-bus and device-bus measurements
+    Remap,         // Phase 7 remap — fused into TrimClamp, always 0
+    Callback,      // whole processBlock()
+    Count
+};
+constexpr int kNumProfileStages = static_cast<int>(ProfileStage::Count);
+
+inline const char* profileStageName(ProfileStage s) {
+    switch (s) {
+        case ProfileStage::Pose:        return "pose";
+        case ProfileStage::Sources:     return "sources";
+        case ProfileStage::StreamRead:  return "stream";
+        case ProfileStage::TrimClamp:   return "trim";
+        case ProfileStage::Diagnostics: return "diag";
+        case ProfileStage::Remap:       return "remap";
+        case ProfileStage::Callback:    return "callback";
+        default:                        return "?";
+    }
+}
+
+// Rolling summary for one stage, in microseconds. Percentiles are resolved
+// to the histogram bucket (quarter-octave, ≤ 19% wide); max is exact.
+struct StageTiming {
+    float p50Us = 0.0f;
+    float p99Us = 0.0f;
+    float maxUs = 0.0f;
+};
 
 // ─────────────────────────────────────────────────────────────────────────────
 // RealtimeConfig — Global configuration for the real-time engine
@@ -159,6 +232,46 @@ struct RealtimeConfig {
     // stored in RealtimeConfig.
     int    outputChannels   = 0;
 
+    // ── Render parallelism ───────────────────────────────────────────────
+    // Number of render lanes the Spatializer splits the per-source loop
+    // across (1 = single-threaded, the audio thread renders everything).
+    // Lanes beyond the first are RenderWorkerPool helper threads. Clamped
+    // to the hardware thread count by Spatializer::init(). Set before
+    // start(); plain int because it is never changed during playback.
+    int    renderThreads    = 1;
+
+    // Streaming loader threads for mono-source refills (1 = loader thread
+    // only; >1 adds IO helpers so refills due in the same block are read in
+    // parallel, most urgent first). Set before startLoader().
+    int    loaderThreads    = 2;
+
+    // Retention budget in MB for released source chunks in the process-wide
+    // SourceIOService cache (0 = keep only chunks some session is playing).
+    // Sessions share chunks regardless; the largest budget requested wins.
+    // Set before loadScene().
+    int    sourceCacheMB    = 0;
+
+    // Streaming buffer budget in MB for this session's double buffers
+    // (0 = every source gets two kDefaultChunkFrames slots). >0 = Streaming
+    // sizes each source's chunk with ChunkPlanner to fit the budget: short
+    // and sparse sources shrink, sources whose refills leave less than
+    // streamMargin × their load time of runway grow. Set before loadScene().
+    int    streamBudgetMB   = 0;
+    float  streamMargin     = 4.0f;
+
+    // Threads that build each source's silence map (SilenceMap.hpp) in the
+    // background after loadScene() — from the .srsilence sidecar next to
+    // the audio file, or by one scan that writes it (0 = off). Once a
+    // source's map is published, silent ranges are neither read from disk
+    // nor rendered. Set before loadScene().
+    int    silenceIndexThreads = 2;
+
+    // Trajectory bake grid in frames (0 = off: Pose evaluates keyframes live
+    // every block). >0 = Pose bakes sanitized DBAP positions every N frames
+    // on a background thread and the audio thread lerps between them.
+    // Set before applyLayout().
+    int    poseBakeFrames   = 0;
+
     // ── Spatializer settings (mirrors offline RenderConfig) ──────────────
     // dbapFocus: atomic<float> so the OSC listener thread can safely write it
     // while the audio thread snapshots it in processBlock() Step A.
@@ -166,6 +279,26 @@ struct RealtimeConfig {
     // most architectures. Fixed here for correctness.)
     std::atomic<float> dbapFocus{1.0f};  // DBAP focus/rolloff exponent (minimum 0.1)
 
+    // Sparse speaker-bus accumulation (0 = off: every source mixes into
+    // every speaker). >0 = each source's DBAP gain vector is truncated to
+    // its K strongest speakers (and those above Spatializer::kSparseGainFloor
+    // of the strongest), renormalized to unit power, and only those channels
+    // are accumulated. Meant for 100+ speaker domes with focus > 1. Read by
+    // Spatializer::init(); a value >= the speaker count means dense.
+    int    sparseTopK       = 0;
+
+    // ── Cluster speaker partition (ClusterSync.hpp) ──────────────────────
+    // clusterPartition = false: this node renders the whole layout.
+    // true: only the layout speaker / subwoofer indices (0-based, order of
+    // the layout JSON arrays) listed here are mixed and routed. DBAP gains
+    // are still computed and normalized over the whole layout, so the nodes'
+    // outputs together equal a single-machine render. Owned device channels
+    // are shifted down by the lowest one, so each node's interface starts at
+    // channel 0. Read by Spatializer::init(); set before applyLayout().
+    bool             clusterPartition = false;
+    std::vector<int> clusterSpeakers;
+    std::vector<int> clusterSubwoofers;
+
     // Elevation rescaling mode — stored as atomic<int> so the OSC listener
     // thread can safely update it while the audio thread reads it per-block.
     // Cast to/from ElevationMode using static_cast<ElevationMode>(value).
@@ -204,6 +337,14 @@ struct RealtimeConfig {
     // When true, processBlock() outputs silence and returns immediately.
     // Stale-by-one-buffer is fine — same contract as playing/masterGain.
     std::atomic<bool> paused{false};     // True = audio callback outputs silence
+
+    // ── Monitoring cost (Phase 14 diagnostics) ───────────────────────────
+    // Cast to/from DiagnosticsTier. Read once per block by
+    // Spatializer::renderBlock() (relaxed); may change during playback.
+    // diagnosticsEvery: decimation period in blocks for the Decimated tier
+    // (8 blocks ≈ 85 ms at 512 / 48 kHz — still well above any UI poll rate).
+    std::atomic<int> diagnosticsTier{static_cast<int>(DiagnosticsTier::Full)};
+    std::atomic<int> diagnosticsEvery{8};
 };
 
 
@@ -259,9 +400,9 @@ struct EngineState {
     // If renderActiveMask itself changes, relocation is happening in mRenderIO
     // (upstream of the copy — a more fundamental problem).
     //
-    // One-shot relocation event latches: set by the audio thread when a mask
-    // changes materially, cleared by the main thread after printing. The Prev/
-    // Next pair captures the before and after masks at the moment of change.
+    // Relocation events: when a mask changes materially the audio thread
+    // pushes a DiagEvent (before / after masks, frame-stamped) into
+    // diagEvents below; EngineSession::consumeDiagnostics() drains them.
     //
     // mainRmsTotal / subRmsTotal are sqrt(mean-square) sums across main and sub
     // channels respectively in the render bus, latest block.
@@ -275,14 +416,6 @@ struct EngineState {
     std::atomic<uint64_t> renderActiveMask{0};    // render-bus active channel bitmask
     std::atomic<uint64_t> deviceActiveMask{0};    // device-output active channel bitmask
 
-    std::atomic<uint64_t> renderRelocPrev{0};     // render mask before most-recent change
-    std::atomic<uint64_t> renderRelocNext{0};     // render mask after most-recent change
-    std::atomic<bool>     renderRelocEvent{false};// latch: audio sets, main clears
-
-    std::atomic<uint64_t> deviceRelocPrev{0};
-    std::atomic<uint64_t> deviceRelocNext{0};
-    std::atomic<bool>     deviceRelocEvent{false};
-
     // Dominant-channel relocation (Phase 14 upgrade).
     // A channel is dominant if its block mean-square ≥ kDomRelThresh × max(ms).
     // kDomRelThresh = 0.01 (−20 dBFS relative to loudest channel). Filters
@@ -292,14 +425,6 @@ struct EngineState {
     std::atomic<uint64_t> renderDomMask{0};
     std::atomic<uint64_t> deviceDomMask{0};
 
-    std::atomic<uint64_t> renderDomRelocPrev{0};
-    std::atomic<uint64_t> renderDomRelocNext{0};
-    std::atomic<bool>     renderDomRelocEvent{false};
-
-    std::atomic<uint64_t> deviceDomRelocPrev{0};
-    std::atomic<uint64_t> deviceDomRelocNext{0};
-    std::atomic<bool>     deviceDomRelocEvent{false};
-
     std::atomic<float>    mainRmsTotal{0.0f};     // sqrt(sum of per-main-ch mean-square)
     std::atomic<float>    subRmsTotal{0.0f};      // sqrt(sum of per-sub-ch mean-square)
     std::atomic<float>    callbackCpuLoad{0.0f};  // wall-clock callback / block budget
@@ -312,12 +437,11 @@ struct EngineState {
     // affected by sub threshold crossings or far-field DBAP bleed.
     // Single writer (audio thread), relaxed stores — same contract as domMask fields.
     std::atomic<uint64_t> renderClusterMask{0};   // current top-4 mains bitmask
-    std::atomic<uint64_t> renderClusterPrev{0};   // top-4 before last significant shift
-    std::atomic<uint64_t> renderClusterNext{0};   // top-4 after last significant shift
-    std::atomic<bool>     renderClusterEvent{false};
-
     std::atomic<uint64_t> deviceClusterMask{0};
-    std::atomic<uint64_t> deviceClusterPrev{0};
-    std::atomic<uint64_t> deviceClusterNext{0};
-    std::atomic<bool>     deviceClusterEvent{false};
+
+    // ── Diagnostic event ring (DiagnosticRing.hpp) ───────────────────────
+    // Lossless, frame-stamped events: relocation / cluster shifts, guard
+    // fires, NaN clamps, stream underruns, callback overruns. Producer: the
+    // audio thread only. Consumer: EngineSession::consumeDiagnostics().
+    DiagnosticRing        diagEvents;
 };
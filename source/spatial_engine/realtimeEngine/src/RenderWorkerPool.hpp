@@ -0,0 +1,197 @@
+// RenderWorkerPool.hpp — Fork/join helper threads for parallel source rendering
+//
+// Lets Spatializer::renderBlock() split its per-source loop across several
+// cores. The AUDIO thread is always lane 0; the pool owns lanes 1..N-1 as
+// dedicated helper threads created once by start() and parked between blocks.
+//
+// PROTOCOL (one fork/join per audio block, no locks, no allocation):
+//
+//   AUDIO thread (run()):
+//     1. mJob / mJobCtx ← job          — plain stores
+//     2. mDone ← 0                     (relaxed)
+//     3. mGeneration += 1              (release) — publishes 1–2 to helpers
+//     4. job(ctx, 0)                   — audio thread renders lane 0
+//     5. spin until mDone == N-1       (acquire) — joins helper writes
+//
+//   HELPER thread t (workerLoop()):
+//     a. wait until mGeneration != last seen (acquire)
+//     b. job(ctx, t)
+//     c. mDone += 1                    (release) — publishes lane t output
+//
+// Waiting helpers spin with a CPU pause hint, then yield, then sleep in short
+// slices so an idle engine (paused, or between blocks on a lightly loaded
+// scene) does not pin N-1 cores at 100%. The sleep slice (kIdleSleepUs) bounds
+// the extra wake latency a helper can add to the first block after idling.
+// The audio thread never sleeps: it renders its own lane first and only then
+// spins on mDone, which is normally already complete; it falls back to
+// yield() only if a helper has been preempted past the spin budget.
+//
+// THREAD SETUP: helpers are pinned to cores 1..N-1 and given SCHED_FIFO on
+// Linux when permitted (silently falls back to normal scheduling without
+// privileges), and USER_INTERACTIVE QoS on macOS (no hard affinity there).
+//
+// THREADING: start() / stop() on the MAIN thread only, never while the audio
+// stream is running. run() on the AUDIO thread only.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "RtSafety.hpp"
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#elif defined(__APPLE__)
+#  include <pthread.h>
+#  include <sys/qos.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  include <immintrin.h>
+#  define SR_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#  define SR_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#  define SR_CPU_RELAX() ((void)0)
+#endif
+
+class RenderWorkerPool {
+public:
+    using JobFn = void (*)(void* ctx, int lane);
+
+    RenderWorkerPool() = default;
+    ~RenderWorkerPool() { stop(); }
+
+    RenderWorkerPool(const RenderWorkerPool&) = delete;
+    RenderWorkerPool& operator=(const RenderWorkerPool&) = delete;
+
+    /// Spawn numLanes - 1 helper threads (lane 0 is the caller of run()).
+    /// numLanes <= 1 leaves the pool inactive. MAIN thread only.
+    void start(int numLanes) {
+        stop();
+        if (numLanes <= 1) return;
+        mNumLanes = numLanes;
+        mRunning.store(true, std::memory_order_release);
+        mThreads.reserve(static_cast<size_t>(numLanes - 1));
+        // Helpers start from the current generation so a run() issued before
+        // a helper is first scheduled is still observed (never skipped).
+        const uint64_t gen0 = mGeneration.load(std::memory_order_acquire);
+        for (int lane = 1; lane < numLanes; ++lane) {
+            mThreads.emplace_back([this, lane, gen0]() { workerLoop(lane, gen0); });
+        }
+        std::cout << "[RenderWorkerPool] Started " << (numLanes - 1)
+                  << " helper render thread(s) (" << numLanes << " lanes)." << std::endl;
+    }
+
+    /// Join all helper threads. MAIN thread only, after the audio stream stopped.
+    void stop() {
+        if (mThreads.empty()) { mNumLanes = 1; return; }
+        mRunning.store(false, std::memory_order_release);
+        mGeneration.fetch_add(1, std::memory_order_release);  // wake parked helpers
+        for (auto& t : mThreads) {
+            if (t.joinable()) t.join();
+        }
+        mThreads.clear();
+        mNumLanes = 1;
+    }
+
+    /// Number of lanes including the caller (1 = pool inactive).
+    int numLanes() const { return mNumLanes; }
+
+    /// Run job(ctx, lane) for every lane and return once all have finished.
+    /// AUDIO thread only. No allocation, no locks.
+    void run(JobFn job, void* ctx) {
+        if (mNumLanes <= 1) { job(ctx, 0); return; }
+        mJob    = job;
+        mJobCtx = ctx;
+        mDone.store(0, std::memory_order_relaxed);
+        mGeneration.fetch_add(1, std::memory_order_release);
+
+        job(ctx, 0);
+
+        const int helpers = mNumLanes - 1;
+        int spins = 0;
+        while (mDone.load(std::memory_order_acquire) < helpers) {
+            // A helper that was preempted (oversubscribed machine) needs this
+            // core; stop burning it after the spin budget.
+            if (++spins < kSpinIters) SR_CPU_RELAX();
+            else                      std::this_thread::yield();
+        }
+    }
+
+private:
+
+    void workerLoop(int lane, uint64_t seen) {
+        configureHelperThread(lane);
+        for (;;) {
+            // ── Park until the next block (spin → yield → short sleep) ──
+            uint64_t gen;
+            int spins = 0;
+            while ((gen = mGeneration.load(std::memory_order_acquire)) == seen) {
+                if (spins < kSpinIters) {
+                    SR_CPU_RELAX();
+                } else if (spins < kSpinIters + kYieldIters) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(kIdleSleepUs));
+                }
+                if (spins < kSpinIters + kYieldIters) ++spins;
+            }
+            seen = gen;
+            if (!mRunning.load(std::memory_order_acquire)) break;
+
+            {
+                // RT-safety builds: the lane is under the block's contract too
+                const RtSafety::ThreadScope rtScope;
+                mJob(mJobCtx, lane);
+            }
+            mDone.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    static void configureHelperThread(int lane) {
+#if defined(__linux__)
+        const unsigned int nCpu = std::thread::hardware_concurrency();
+        if (nCpu > 1) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(static_cast<int>(static_cast<unsigned int>(lane) % nCpu), &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+        sched_param sp{};
+        sp.sched_priority = std::max(1, sched_get_priority_max(SCHED_FIFO) - 2);
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);  // best effort
+#elif defined(__APPLE__)
+        (void)lane;
+        pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#else
+        (void)lane;
+#endif
+    }
+
+    // Backoff tuning for parked helpers. kSpinIters of pause (~10–40 µs)
+    // covers the gap between consecutive lanes of a busy block; the yield
+    // phase covers the rest of a typical 10 ms block period; after that the
+    // helper sleeps in 100 µs slices.
+    static constexpr int kSpinIters   = 1 << 12;
+    static constexpr int kYieldIters  = 1 << 14;
+    static constexpr int kIdleSleepUs = 100;
+
+    std::vector<std::thread> mThreads;
+    int                      mNumLanes = 1;
+
+    // Job slot: written by the audio thread before the generation bump
+    // (release), read by helpers after observing it (acquire).
+    JobFn                    mJob    = nullptr;
+    void*                    mJobCtx = nullptr;
+
+    alignas(64) std::atomic<uint64_t> mGeneration{0};
+    alignas(64) std::atomic<int>      mDone{0};
+    alignas(64) std::atomic<bool>     mRunning{false};
+};
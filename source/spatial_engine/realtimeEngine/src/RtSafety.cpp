@@ -0,0 +1,444 @@
+// RtSafety.cpp — Interposers behind RtSafety.hpp (SPATIALROOT_RT_SAFETY builds)
+//
+// Compiled into every executable that links EngineSessionCore when the
+// option is on (CMake adds it as an INTERFACE source, so the definitions
+// live in the executable and win symbol resolution over libc). Allocation
+// hooks forward to glibc's __libc_* entry points; everything else to the
+// next definition found by dlsym(RTLD_NEXT), resolved once at startup by
+// warmUp() into one namespace-scope slot per symbol that the hook reads.
+//
+// A hook must never allocate, lock or do I/O on its own account before it
+// forwards: it runs inside malloc, inside pthread_mutex_lock, under other
+// threads' startup code. The bookkeeping is thread_local flags, relaxed
+// atomic counters and fixed sample slots; the only non-trivial call,
+// backtrace(), runs with tlInHook set so recursion into the hooks is inert.
+
+// Plain symbol names: no open → open64 / read → __read_chk redirections.
+// The *64 entry points that _FILE_OFFSET_BITS=64 code (libsndfile, most
+// distro libraries) calls are hooked separately below.
+#undef _FILE_OFFSET_BITS
+#undef _FORTIFY_SOURCE
+
+#include "RtSafety.hpp"
+
+#if !defined(SPATIALROOT_RT_SAFETY)
+#  error "RtSafety.cpp is only built with -DSPATIALROOT_RT_SAFETY=ON"
+#endif
+#if !defined(__GLIBC__)
+#  error "SPATIALROOT_RT_SAFETY interposition requires glibc (Linux)"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <unistd.h>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void  __libc_free(void*);
+}
+
+namespace {
+
+// Executable TLS (initial-exec): touching these never allocates.
+thread_local bool     tlTagged  = false;   // inside a BlockScope / ThreadScope
+thread_local bool     tlInHook  = false;   // bookkeeping in progress: ignore nested calls
+thread_local int      tlSampled = 0;       // samples taken this block
+thread_local uint64_t tlFrame   = 0;
+
+std::atomic<uint64_t> gCounts[kNumRtViolationKinds];
+std::atomic<uint64_t> gFrame{0};
+
+// Sample slot states: free → writing (producer claimed it) → ready → free (drained)
+enum : uint32_t { kSlotFree, kSlotWriting, kSlotReady };
+
+struct SampleSlot {
+    std::atomic<uint32_t> state{kSlotFree};
+    RtViolationSample     sample;
+};
+SampleSlot gSlots[RtSafety::kSampleSlots];
+
+// Not inlined, so sample frame 0 is always hit() and frame 1 the hook.
+__attribute__((noinline)) void hit(RtViolationKind kind) {
+    if (!tlTagged || tlInHook) return;
+    tlInHook = true;
+    gCounts[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+    if (tlSampled < RtSafety::kSamplesPerBlock) {
+        ++tlSampled;
+        for (SampleSlot& slot : gSlots) {
+            uint32_t expected = kSlotFree;
+            if (!slot.state.compare_exchange_strong(expected, kSlotWriting,
+                                                    std::memory_order_acquire)) continue;
+            slot.sample.kind  = kind;
+            slot.sample.frame = tlFrame;
+            slot.sample.depth = backtrace(slot.sample.pcs, RtViolationSample::kMaxFrames);
+            slot.state.store(kSlotReady, std::memory_order_release);
+            break;
+        }
+        // All slots full: counted, not sampled.
+    }
+    tlInHook = false;
+}
+
+// Next definition of name, cached in slot. The slots are constant-initialized
+// namespace-scope atomics, so no guard variable (and no lock) is involved in
+// reaching them; warmUp() fills every one before main(). The dlsym() fallback
+// only runs for a hook hit earlier than that (static initializers of other
+// libraries), never on a tagged thread.
+template <typename Fn>
+Fn nextFn(std::atomic<void*>& slot, const char* name) {
+    void* p = slot.load(std::memory_order_relaxed);
+    if (!p) {
+        p = dlsym(RTLD_NEXT, name);
+        slot.store(p, std::memory_order_relaxed);
+    }
+    return reinterpret_cast<Fn>(p);
+}
+
+// One slot per forwarded symbol, shared by its hook and warmUp().
+#define RT_SLOT(name) std::atomic<void*> gNext_##name{nullptr};
+RT_SLOT(pthread_mutex_lock)
+RT_SLOT(pthread_rwlock_rdlock)
+RT_SLOT(pthread_rwlock_wrlock)
+RT_SLOT(open)
+RT_SLOT(openat)
+RT_SLOT(open64)
+RT_SLOT(openat64)
+RT_SLOT(close)
+RT_SLOT(read)
+RT_SLOT(write)
+RT_SLOT(pread)
+RT_SLOT(pwrite)
+RT_SLOT(pread64)
+RT_SLOT(pwrite64)
+RT_SLOT(fopen)
+RT_SLOT(fopen64)
+RT_SLOT(fclose)
+RT_SLOT(fread)
+RT_SLOT(fwrite)
+RT_SLOT(fputs)
+RT_SLOT(fputc)
+RT_SLOT(putc)
+RT_SLOT(puts)
+RT_SLOT(fflush)
+RT_SLOT(vfprintf)
+RT_SLOT(vprintf)
+#undef RT_SLOT
+
+#define RT_NEXT(name) nextFn<decltype(&::name)>(gNext_##name, #name)
+
+// Resolve every forwarder and load backtrace()'s unwinder (dlopen of
+// libgcc_s) at startup, on the main thread.
+__attribute__((constructor)) void warmUp() {
+    void* pcs[2];
+    backtrace(pcs, 2);
+    RT_NEXT(pthread_mutex_lock);
+    RT_NEXT(pthread_rwlock_rdlock);
+    RT_NEXT(pthread_rwlock_wrlock);
+    RT_NEXT(open);
+    RT_NEXT(openat);
+    RT_NEXT(open64);
+    RT_NEXT(openat64);
+    RT_NEXT(close);
+    RT_NEXT(read);
+    RT_NEXT(write);
+    RT_NEXT(pread);
+    RT_NEXT(pwrite);
+    RT_NEXT(pread64);
+    RT_NEXT(pwrite64);
+    RT_NEXT(fopen);
+    RT_NEXT(fopen64);
+    RT_NEXT(fclose);
+    RT_NEXT(fread);
+    RT_NEXT(fwrite);
+    RT_NEXT(fputs);
+    RT_NEXT(fputc);
+    RT_NEXT(putc);
+    RT_NEXT(puts);
+    RT_NEXT(fflush);
+    RT_NEXT(vfprintf);
+    RT_NEXT(vprintf);
+}
+
+} // namespace
+
+// ============================================================================
+// RtSafety
+// ============================================================================
+
+bool RtSafety::enter(uint64_t frame) {
+    const bool prev = tlTagged;
+    tlFrame   = frame;
+    tlSampled = 0;
+    gFrame.store(frame, std::memory_order_relaxed);
+    tlTagged  = true;
+    return prev;
+}
+
+void RtSafety::leave(bool prevTag) {
+    tlTagged = prevTag;
+}
+
+uint64_t RtSafety::currentFrame() {
+    return gFrame.load(std::memory_order_relaxed);
+}
+
+uint64_t RtSafety::count(RtViolationKind k) {
+    return gCounts[static_cast<size_t>(k)].load(std::memory_order_relaxed);
+}
+
+size_t RtSafety::takeSamples(RtViolationSample* out, size_t max) {
+    size_t n = 0;
+    for (SampleSlot& slot : gSlots) {
+        if (n == max) break;
+        if (slot.state.load(std::memory_order_acquire) != kSlotReady) continue;
+        out[n++] = slot.sample;
+        slot.state.store(kSlotFree, std::memory_order_release);
+    }
+    return n;
+}
+
+std::vector<std::string> RtSafety::symbolize(const RtViolationSample& s) {
+    std::vector<std::string> lines;
+    if (s.depth <= 0) return lines;
+    char** syms = backtrace_symbols(s.pcs, s.depth);
+    if (!syms) return lines;
+    // Skip hit() and the hook: start at the caller.
+    for (int i = std::min(2, s.depth - 1); i < s.depth; ++i) lines.emplace_back(syms[i]);
+    std::free(syms);
+    return lines;
+}
+
+// ============================================================================
+// Interposers
+// ============================================================================
+
+extern "C" {
+
+// ── Alloc / Free ─────────────────────────────────────────────────────────
+
+void* malloc(size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    return __libc_malloc(n);
+}
+
+void* calloc(size_t count, size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    return __libc_calloc(count, n);
+}
+
+void* realloc(void* p, size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    return __libc_realloc(p, n);
+}
+
+void* memalign(size_t align, size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    return __libc_memalign(align, n);
+}
+
+void* aligned_alloc(size_t align, size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    return __libc_memalign(align, n);
+}
+
+int posix_memalign(void** out, size_t align, size_t n) noexcept {
+    hit(RtViolationKind::Alloc);
+    if (align < sizeof(void*) || (align & (align - 1)) != 0) return EINVAL;
+    void* p = __libc_memalign(align, n);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void free(void* p) noexcept {
+    if (p) hit(RtViolationKind::Free);
+    __libc_free(p);
+}
+
+// ── Lock ─────────────────────────────────────────────────────────────────
+
+int pthread_mutex_lock(pthread_mutex_t* m) noexcept {
+    hit(RtViolationKind::Lock);
+    return RT_NEXT(pthread_mutex_lock)(m);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* l) noexcept {
+    hit(RtViolationKind::Lock);
+    return RT_NEXT(pthread_rwlock_rdlock)(l);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* l) noexcept {
+    hit(RtViolationKind::Lock);
+    return RT_NEXT(pthread_rwlock_wrlock)(l);
+}
+
+// ── FileIo ───────────────────────────────────────────────────────────────
+
+int open(const char* path, int flags, ...) {
+    hit(RtViolationKind::FileIo);
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list ap;
+        va_start(ap, flags);
+        mode = static_cast<mode_t>(va_arg(ap, int));
+        va_end(ap);
+    }
+    return RT_NEXT(open)(path, flags, mode);
+}
+
+int openat(int dirfd, const char* path, int flags, ...) {
+    hit(RtViolationKind::FileIo);
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list ap;
+        va_start(ap, flags);
+        mode = static_cast<mode_t>(va_arg(ap, int));
+        va_end(ap);
+    }
+    return RT_NEXT(openat)(dirfd, path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...) {
+    hit(RtViolationKind::FileIo);
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list ap;
+        va_start(ap, flags);
+        mode = static_cast<mode_t>(va_arg(ap, int));
+        va_end(ap);
+    }
+    return RT_NEXT(open64)(path, flags, mode);
+}
+
+int openat64(int dirfd, const char* path, int flags, ...) {
+    hit(RtViolationKind::FileIo);
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list ap;
+        va_start(ap, flags);
+        mode = static_cast<mode_t>(va_arg(ap, int));
+        va_end(ap);
+    }
+    return RT_NEXT(openat64)(dirfd, path, flags, mode);
+}
+
+int close(int fd) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(close)(fd);
+}
+
+ssize_t read(int fd, void* buf, size_t n) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(read)(fd, buf, n);
+}
+
+ssize_t write(int fd, const void* buf, size_t n) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(write)(fd, buf, n);
+}
+
+ssize_t pread(int fd, void* buf, size_t n, off_t off) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(pread)(fd, buf, n, off);
+}
+
+ssize_t pwrite(int fd, const void* buf, size_t n, off_t off) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(pwrite)(fd, buf, n, off);
+}
+
+ssize_t pread64(int fd, void* buf, size_t n, off64_t off) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(pread64)(fd, buf, n, off);
+}
+
+ssize_t pwrite64(int fd, const void* buf, size_t n, off64_t off) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(pwrite64)(fd, buf, n, off);
+}
+
+// stdio entry points iostreams (stdio_sync_filebuf) and printf-style logging
+// go through; glibc calls its own internal write from there.
+
+FILE* fopen(const char* path, const char* mode) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fopen)(path, mode);
+}
+
+FILE* fopen64(const char* path, const char* mode) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fopen64)(path, mode);
+}
+
+int fclose(FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fclose)(f);
+}
+
+size_t fread(void* buf, size_t size, size_t n, FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fread)(buf, size, n, f);
+}
+
+size_t fwrite(const void* buf, size_t size, size_t n, FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fwrite)(buf, size, n, f);
+}
+
+int fputs(const char* s, FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fputs)(s, f);
+}
+
+int fputc(int c, FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fputc)(c, f);
+}
+
+int putc(int c, FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(putc)(c, f);
+}
+
+int puts(const char* s) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(puts)(s);
+}
+
+int fflush(FILE* f) {
+    hit(RtViolationKind::FileIo);
+    return RT_NEXT(fflush)(f);
+}
+
+int fprintf(FILE* f, const char* fmt, ...) {
+    hit(RtViolationKind::FileIo);
+    va_list ap;
+    va_start(ap, fmt);
+    const int r = RT_NEXT(vfprintf)(f, fmt, ap);
+    va_end(ap);
+    return r;
+}
+
+int printf(const char* fmt, ...) {
+    hit(RtViolationKind::FileIo);
+    va_list ap;
+    va_start(ap, fmt);
+    const int r = RT_NEXT(vprintf)(fmt, ap);
+    va_end(ap);
+    return r;
+}
+
+} // extern "C"
@@ -0,0 +1,173 @@
+// RtSafety.hpp — Opt-in enforcement of the audio thread's real-time contract
+//
+// RealtimeTypes.hpp, Streaming.hpp and Spatializer.hpp all promise "no
+// allocation, no locks, no I/O" inside processBlock(), but a regression (a
+// vector resize, a stray std::cout) only shows up as a dropout. Built with
+// -DSPATIALROOT_RT_SAFETY=ON (Linux / glibc), RtSafety.cpp interposes:
+//
+//   Alloc   malloc, calloc, realloc, memalign, posix_memalign, aligned_alloc
+//           (operator new reaches these)
+//   Free    free
+//   Lock    pthread_mutex_lock, pthread_rwlock_rdlock / _wrlock
+//   FileIo  open / openat / close / read / write / pread / pwrite (and their
+//           *64 large-file forms) and the stdio calls iostreams use (fopen,
+//           fopen64, fwrite, fputs, fflush, ...)
+//
+// Every hook forwards to the real function; it only counts the call when the
+// calling thread is tagged. Tagged threads:
+//   - the thread running RealtimeBackend::processBlock() (BlockScope, for the
+//     whole block including its early returns) — the device callback or the
+//     freewheel bounce thread;
+//   - render helper lanes while they run a block's job (ThreadScope, in
+//     RenderWorkerPool::workerLoop()).
+// So only violations inside a block are counted; setup, the loader and the
+// main thread allocate freely.
+//
+// REPORTING: per kind, a relaxed atomic counter. The first calls of each
+// block are also stack-sampled (backtrace() into one of kSampleSlots fixed
+// slots). At the end of every block that added violations, BlockScope pushes
+// one DiagEventType::RtViolation event (count = violations this block,
+// next = bitmask of RtViolationKind seen) into EngineState::diagEvents.
+// EngineSession::consumeDiagnostics() drains the samples, symbolizes them on
+// the main thread and returns them in DiagnosticEvents::rtViolationSamples.
+//
+// Sampling calls backtrace(), which is itself not real-time safe: it perturbs
+// the timing of a block that already broke the contract, never a clean one.
+// Build the option for validation runs (internal_validation_runner), not for
+// shows.
+//
+// Without SPATIALROOT_RT_SAFETY every call here is an empty inline.
+//
+// THREADING: scopes on any thread (see above); takeSamples() from ONE
+// consumer thread (EngineSession's main thread).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DiagnosticRing.hpp"
+
+enum class RtViolationKind : uint32_t {
+    Alloc,
+    Free,
+    Lock,
+    FileIo,
+    Count
+};
+
+inline const char* rtViolationName(RtViolationKind k) {
+    switch (k) {
+        case RtViolationKind::Alloc:  return "alloc";
+        case RtViolationKind::Free:   return "free";
+        case RtViolationKind::Lock:   return "lock";
+        case RtViolationKind::FileIo: return "file-io";
+        default:                      return "?";
+    }
+}
+
+constexpr size_t kNumRtViolationKinds = static_cast<size_t>(RtViolationKind::Count);
+
+// One stack-sampled violation, raw return addresses.
+struct RtViolationSample {
+    static constexpr int kMaxFrames = 24;
+    RtViolationKind kind  = RtViolationKind::Count;
+    uint64_t        frame = 0;     // playhead frame of the block
+    int             depth = 0;     // valid entries in pcs
+    void*           pcs[kMaxFrames] = {};
+};
+
+class RtSafety {
+public:
+
+#if defined(SPATIALROOT_RT_SAFETY)
+    static constexpr bool kEnabled = true;
+#else
+    static constexpr bool kEnabled = false;
+#endif
+
+    static constexpr size_t kSampleSlots    = 32;   // samples held until the next drain
+    static constexpr int    kSamplesPerBlock = 4;   // per tagged thread per block
+
+    // Per-kind totals since start (what BlockScope diffs against).
+    struct Tally {
+        uint64_t counts[kNumRtViolationKinds] = {};
+    };
+
+    // ── Audio thread: tag processBlock() and report its violations ───────
+    class BlockScope {
+    public:
+#if defined(SPATIALROOT_RT_SAFETY)
+        BlockScope(DiagnosticRing& ring, uint64_t frame, Tally& seen)
+            : mRing(ring), mFrame(frame), mSeen(seen), mPrevTag(enter(frame)) {}
+        ~BlockScope() { leave(mPrevTag); report(); }
+#else
+        BlockScope(DiagnosticRing&, uint64_t, Tally&) {}
+#endif
+        BlockScope(const BlockScope&) = delete;
+        BlockScope& operator=(const BlockScope&) = delete;
+
+    private:
+#if defined(SPATIALROOT_RT_SAFETY)
+        void report() {
+            uint64_t added = 0, kinds = 0;
+            for (size_t k = 0; k < kNumRtViolationKinds; ++k) {
+                const uint64_t now = count(static_cast<RtViolationKind>(k));
+                if (now != mSeen.counts[k]) {
+                    added += now - mSeen.counts[k];
+                    kinds |= uint64_t{1} << k;
+                    mSeen.counts[k] = now;
+                }
+            }
+            if (added) mRing.push(DiagEventType::RtViolation, mFrame, 0, kinds, added);
+        }
+
+        DiagnosticRing& mRing;
+        uint64_t        mFrame;
+        Tally&          mSeen;
+        bool            mPrevTag;
+#endif
+    };
+
+    // ── Render helper lane: tag one block's job ──────────────────────────
+    class ThreadScope {
+    public:
+#if defined(SPATIALROOT_RT_SAFETY)
+        ThreadScope() : mPrevTag(enter(currentFrame())) {}
+        ~ThreadScope() { leave(mPrevTag); }
+#else
+        ThreadScope() {}
+#endif
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+
+#if defined(SPATIALROOT_RT_SAFETY)
+    private:
+        bool mPrevTag;
+#endif
+    };
+
+#if defined(SPATIALROOT_RT_SAFETY)
+    /// Violations of kind k since start, all tagged threads. Any thread.
+    static uint64_t count(RtViolationKind k);
+
+    /// Move up to max pending samples into out, freeing their slots.
+    /// Consumer thread only.
+    static size_t takeSamples(RtViolationSample* out, size_t max);
+
+    /// One line per return address ("module(symbol+off) [pc]"). Allocates;
+    /// never on a tagged thread.
+    static std::vector<std::string> symbolize(const RtViolationSample& s);
+
+private:
+    static bool     enter(uint64_t frame);   // returns the previous tag
+    static void     leave(bool prevTag);
+    static uint64_t currentFrame();
+#else
+    static uint64_t count(RtViolationKind) { return 0; }
+    static size_t takeSamples(RtViolationSample*, size_t) { return 0; }
+    static std::vector<std::string> symbolize(const RtViolationSample&) { return {}; }
+#endif
+};
@@ -0,0 +1,326 @@
+// SourceIOService.hpp — Process-wide source chunk cache and IO thread pool
+//
+// Several EngineSession instances in one process (rehearsal room + preview
+// headphones: same scene, different layouts) used to read and buffer the
+// same source audio once per session. Every Streaming instance now attaches
+// to one shared service instead, so disk reads and decoded-audio memory
+// scale with unique content rather than with the number of sessions.
+//
+// CHUNK CACHE:
+//   - A chunk is one double-buffer slot's worth of decoded mono audio
+//     (chunkFrames floats, zero past validFrames), keyed by file, channel,
+//     start frame and length. SourceStream slots hold SourceChunkRef
+//     (shared_ptr) references; the cache holds one more.
+//   - acquire() returns the cached chunk on a hit. On a miss it claims the
+//     keys, runs the caller's fill outside the lock and publishes the
+//     result; a second client asking for a key that is still being filled
+//     waits for that read instead of issuing its own.
+//   - Referenced chunks are never evicted. Unreferenced ones (use_count 1,
+//     i.e. only the cache holds them) are kept up to the byte budget, oldest
+//     use first — budget 0 keeps nothing that no session is playing, which
+//     is the single-session footprint of the old private double buffers.
+//   - Ranges a SilenceMap marks silent share one zero chunk per length
+//     (acquireSilence(), keyed by an empty file name) — no read, no copy.
+//   - A chunk left behind by a refill was last played a full preload
+//     window (≥ 7.5 s at the default chunk size) before it is released, so
+//     eviction cannot free memory an audio thread is still reading.
+//
+// IO POOL:
+//   - Replaces the per-Streaming IO helper threads. runBatch() hands one
+//     client's refill batch to the pool (the caller drains jobs too and
+//     returns when the batch is done); batches from different clients run
+//     FIFO, each in its own deadline order. The pool grows to the largest
+//     helper count any client asked for and lives until the last client
+//     detaches.
+//
+// THREADING: attach() / release of the shared_ptr from setup threads (MAIN).
+// acquire() / runBatch() from loader, IO-pool and setup threads. Never from
+// the AUDIO thread — it only reads the float data a SourceStream published.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+struct SourceChunk {
+    std::vector<float> samples;   // chunkFrames floats, zero past validFrames
+    uint64_t validFrames = 0;
+};
+
+using SourceChunkRef = std::shared_ptr<const SourceChunk>;
+
+struct SourceChunkKey {
+    std::string file;             // canonical path of the source file
+    int         channel = 0;      // channel in that file (0 for mono sources)
+    uint64_t    start   = 0;      // first frame
+    uint64_t    frames  = 0;      // frames requested (chunk, seek burst, or tail)
+    uint64_t    chunkFrames = 0;  // slot size — part of the key, sets the allocation
+
+    bool operator<(const SourceChunkKey& o) const {
+        return std::tie(file, channel, start, frames, chunkFrames)
+             < std::tie(o.file, o.channel, o.start, o.frames, o.chunkFrames);
+    }
+};
+
+class SourceIOService {
+public:
+
+    /// Missing keys to fill: (index into the acquire() key list, destination
+    /// of chunkFrames zeroed floats). Returns frames read (same for all).
+    using FillTargets = std::vector<std::pair<size_t, float*>>;
+    using FillFn      = std::function<uint64_t(const FillTargets&)>;
+
+    struct Stats {
+        uint64_t hits = 0;           // chunks served from the cache
+        uint64_t misses = 0;         // chunks read from disk (zero chunks excluded)
+        size_t   residentBytes = 0;  // referenced + retained
+        size_t   entries = 0;
+    };
+
+    /// The process-wide instance, created on first attach and destroyed
+    /// when the last client drops its reference. ioThreads grows the pool;
+    /// cacheBytes raises the retention budget (largest request wins).
+    static std::shared_ptr<SourceIOService> attach(int ioThreads, size_t cacheBytes) {
+        static std::mutex sMutex;
+        static std::weak_ptr<SourceIOService> sInstance;
+        std::lock_guard<std::mutex> lk(sMutex);
+        std::shared_ptr<SourceIOService> svc = sInstance.lock();
+        if (!svc) {
+            svc.reset(new SourceIOService());
+            sInstance = svc;
+        }
+        svc->reserve(ioThreads, cacheBytes);
+        return svc;
+    }
+
+    ~SourceIOService() {
+        {
+            std::lock_guard<std::mutex> lk(mPoolMutex);
+            mPoolRunning = false;
+        }
+        mPoolCv.notify_all();
+        for (auto& t : mPool) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    SourceIOService(const SourceIOService&) = delete;
+    SourceIOService& operator=(const SourceIOService&) = delete;
+
+    // ── Chunk cache ──────────────────────────────────────────────────────
+
+    /// Resolve every key to a chunk (out[i] for keys[i]). Keys already
+    /// cached are shared; the rest are filled by one call to fill. Keys
+    /// being filled by another client are waited for, never read twice.
+    void acquire(const std::vector<SourceChunkKey>& keys, uint64_t chunkFrames,
+                 const FillFn& fill, std::vector<SourceChunkRef>& out) {
+        out.assign(keys.size(), nullptr);
+        std::vector<size_t> claimed;
+
+        std::unique_lock<std::mutex> lk(mCacheMutex);
+        // Claim all missing keys in one pass, and only once none of them is
+        // in flight elsewhere: a client never waits while holding claims,
+        // so two clients with overlapping key sets cannot deadlock.
+        mCacheCv.wait(lk, [&]() {
+            for (const auto& k : keys) {
+                auto it = mEntries.find(k);
+                if (it != mEntries.end() && it->second.loading) return false;
+            }
+            return true;
+        });
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto it = mEntries.find(keys[i]);
+            if (it != mEntries.end()) {
+                it->second.lastUse = ++mUseClock;
+                out[i] = it->second.chunk;
+                ++mHits;
+            } else {
+                mEntries[keys[i]].loading = true;
+                claimed.push_back(i);
+            }
+        }
+        if (claimed.empty()) return;
+        trimLocked();  // make room before allocating the replacements
+        lk.unlock();
+
+        // Read outside the lock
+        std::vector<std::shared_ptr<SourceChunk>> fresh;
+        FillTargets targets;
+        fresh.reserve(claimed.size());
+        targets.reserve(claimed.size());
+        for (size_t i : claimed) {
+            auto c = std::make_shared<SourceChunk>();
+            c->samples.assign(chunkFrames, 0.0f);
+            targets.emplace_back(i, c->samples.data());
+            fresh.push_back(std::move(c));
+        }
+        const uint64_t valid = std::min<uint64_t>(fill(targets), chunkFrames);
+
+        lk.lock();
+        for (size_t j = 0; j < claimed.size(); ++j) {
+            fresh[j]->validFrames = valid;
+            out[claimed[j]] = fresh[j];
+            auto it = mEntries.find(keys[claimed[j]]);
+            if (valid == 0) {
+                // Past EOF or a failed read: hand it out, but don't cache
+                // silence under a key that may read fine next time.
+                mEntries.erase(it);
+                continue;
+            }
+            it->second.chunk   = fresh[j];
+            it->second.loading = false;
+            it->second.lastUse = ++mUseClock;
+            mResidentBytes += chunkFrames * sizeof(float);
+            if (!keys[claimed[j]].file.empty()) ++mMisses;  // not a zero chunk
+        }
+        trimLocked();
+        lk.unlock();
+        mCacheCv.notify_all();
+    }
+
+    /// Single-key convenience (mono sources). fill writes into dst.
+    SourceChunkRef acquire(const SourceChunkKey& key,
+                           const std::function<uint64_t(float* dst)>& fill) {
+        std::vector<SourceChunkRef> out;
+        acquire(std::vector<SourceChunkKey>{key}, key.chunkFrames,
+                [&](const FillTargets& t) { return fill(t.front().second); }, out);
+        return out.front();
+    }
+
+    /// A chunk of frames zeros (silence-mapped range): one shared,
+    /// never-read chunk per length instead of a read into a fresh one.
+    SourceChunkRef acquireSilence(uint64_t frames, uint64_t chunkFrames) {
+        if (frames == 0) return nullptr;
+        return acquire({std::string(), -1, 0, frames, chunkFrames},
+                       [&](float*) -> uint64_t { return frames; });
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lk(mCacheMutex);
+        Stats s;
+        s.hits = mHits;
+        s.misses = mMisses;
+        s.residentBytes = mResidentBytes;
+        s.entries = mEntries.size();
+        return s;
+    }
+
+    // ── IO pool ──────────────────────────────────────────────────────────
+
+    /// Number of pool threads (excluding callers draining their own batch).
+    int numThreads() const {
+        std::lock_guard<std::mutex> lk(mPoolMutex);
+        return static_cast<int>(mPool.size());
+    }
+
+    /// Run job(0) … job(count - 1), in that order of start, on the pool and
+    /// the calling thread. Returns once every job of this batch finished.
+    void runBatch(size_t count, const std::function<void(size_t)>& job) {
+        if (count == 0) return;
+        Batch batch{&job, count, 0, count};
+        std::unique_lock<std::mutex> lk(mPoolMutex);
+        if (mPool.empty() || count == 1) {
+            lk.unlock();
+            for (size_t i = 0; i < count; ++i) job(i);
+            return;
+        }
+        mBatches.push_back(&batch);
+        mPoolCv.notify_all();
+        while (batch.next < batch.count) runOne(batch, lk);  // the caller takes jobs too
+        mBatchDoneCv.wait(lk, [&]() { return batch.left == 0; });
+    }
+
+private:
+
+    SourceIOService() = default;
+
+    struct Entry {
+        SourceChunkRef chunk;
+        bool           loading = false;
+        uint64_t       lastUse = 0;
+    };
+
+    struct Batch {
+        const std::function<void(size_t)>* job;
+        size_t count;
+        size_t next;   // next index to start (guarded by mPoolMutex)
+        size_t left;   // jobs not yet finished (guarded by mPoolMutex)
+    };
+
+    void reserve(int ioThreads, size_t cacheBytes) {
+        {
+            std::lock_guard<std::mutex> lk(mCacheMutex);
+            mBudgetBytes = std::max(mBudgetBytes, cacheBytes);
+        }
+        std::lock_guard<std::mutex> lk(mPoolMutex);
+        while (static_cast<int>(mPool.size()) < ioThreads) {
+            mPool.emplace_back([this]() { poolWorker(); });
+        }
+    }
+
+    /// Drop unreferenced chunks, least recently used first, until the
+    /// resident size fits the budget. mCacheMutex held.
+    void trimLocked() {
+        while (mResidentBytes > mBudgetBytes) {
+            auto victim = mEntries.end();
+            for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+                const Entry& e = it->second;
+                if (e.loading || e.chunk.use_count() != 1) continue;
+                if (victim == mEntries.end() || e.lastUse < victim->second.lastUse) victim = it;
+            }
+            if (victim == mEntries.end()) return;  // everything left is in use
+            mResidentBytes -= victim->second.chunk->samples.size() * sizeof(float);
+            mEntries.erase(victim);
+        }
+    }
+
+    /// Start the batch's next job; mPoolMutex held, released while it runs.
+    void runOne(Batch& b, std::unique_lock<std::mutex>& lk) {
+        const size_t i = b.next++;
+        if (b.next == b.count) {
+            mBatches.erase(std::find(mBatches.begin(), mBatches.end(), &b));
+        }
+        lk.unlock();
+        (*b.job)(i);
+        lk.lock();
+        if (--b.left == 0) mBatchDoneCv.notify_all();
+    }
+
+    void poolWorker() {
+        std::unique_lock<std::mutex> lk(mPoolMutex);
+        for (;;) {
+            mPoolCv.wait(lk, [this]() { return !mPoolRunning || !mBatches.empty(); });
+            if (!mPoolRunning) return;
+            runOne(*mBatches.front(), lk);
+        }
+    }
+
+    // Cache
+    mutable std::mutex                  mCacheMutex;
+    std::condition_variable             mCacheCv;     // a claimed key was published
+    std::map<SourceChunkKey, Entry>     mEntries;
+    size_t                              mBudgetBytes   = 0;
+    size_t                              mResidentBytes = 0;
+    uint64_t                            mUseClock = 0;
+    uint64_t                            mHits = 0;
+    uint64_t                            mMisses = 0;
+
+    // Pool
+    mutable std::mutex                  mPoolMutex;
+    std::condition_variable             mPoolCv;       // batch posted / stop
+    std::condition_variable             mBatchDoneCv;  // a batch finished
+    std::deque<Batch*>                  mBatches;      // batches with unstarted jobs
+    std::vector<std::thread>            mPool;
+    bool                                mPoolRunning = true;
+};
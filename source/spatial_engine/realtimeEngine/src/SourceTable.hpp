@@ -0,0 +1,72 @@
+// SourceTable.hpp — Dense integer handles for scene sources
+//
+// Source keys ("1.1", "11.1", "LFE", …) are strings in the scene JSON and in
+// every loader, but nothing on the audio thread should pay a std::map string
+// compare per source per block. The table resolves every key once, at scene
+// load time, to a SourceHandle: its rank in scene.sources (which is a
+// std::map, so the order is the sorted key order and is identical for every
+// agent that walks the same scene).
+//
+// HANDLE CONTRACT (relied on by Pose, Streaming and Spatializer):
+//   handle h  ==  index of the source in scene.sources iteration order
+//             ==  index into Pose::getPoses()  (SourcePose::handle)
+//             ==  Spatializer per-source state slot (si)
+//   Streaming keeps a parallel SourceStream* column indexed by the same
+//   handle (nullptr for a source whose WAV was missing or unmappable).
+//
+// Storage is structure-of-arrays: one column per attribute, so the per-block
+// loops touch only the columns they read.
+//
+// THREADING: build() on the main thread during loadScene(). Read-only
+// afterwards — every accessor is safe from any thread without sync.
+// find() is a binary search over strings and is meant for setup / tools,
+// never for the audio callback.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "JSONLoader.hpp"   // SpatialData
+
+using SourceHandle = int32_t;
+constexpr SourceHandle kInvalidSource = -1;
+
+class SourceTable {
+public:
+
+    /// (Re)build from a parsed scene. Handles are assigned in scene.sources order.
+    void build(const SpatialData& scene) {
+        mNames.clear();
+        mIsLFE.clear();
+        mNames.reserve(scene.sources.size());
+        mIsLFE.reserve(scene.sources.size());
+        for (const auto& [name, kfs] : scene.sources) {
+            mNames.push_back(name);
+            mIsLFE.push_back(name == "LFE" ? 1u : 0u);
+        }
+    }
+
+    /// Handle for a source key, or kInvalidSource. NOT for the audio thread.
+    SourceHandle find(const std::string& name) const {
+        auto it = std::lower_bound(mNames.begin(), mNames.end(), name);
+        if (it == mNames.end() || *it != name) return kInvalidSource;
+        return static_cast<SourceHandle>(it - mNames.begin());
+    }
+
+    size_t size() const { return mNames.size(); }
+    bool   valid(SourceHandle h) const {
+        return h >= 0 && static_cast<size_t>(h) < mNames.size();
+    }
+
+    const std::string& name(SourceHandle h)  const { return mNames[static_cast<size_t>(h)]; }
+    bool               isLFE(SourceHandle h) const { return mIsLFE[static_cast<size_t>(h)] != 0; }
+
+    const std::vector<std::string>& names() const { return mNames; }
+
+private:
+    std::vector<std::string> mNames;   // handle → source key (sorted)
+    std::vector<uint8_t>     mIsLFE;   // handle → 1 if the key is "LFE"
+};
@@ -15,12 +15,19 @@
 //    outputChannelCount is written into RealtimeConfig.outputChannels so the
 //    backend opens AudioIO with the correct physical channel count.
 // 3. Create al::Dbap with the speaker array and apply focus setting.
-// 4. For each audio block, spatialize every non-LFE source via renderBuffer().
+// 4. For each audio block, spatialize every non-LFE source: compute its
+//    normalized DBAP gain vector(s) (computeDbapGains()) and mix the mono
+//    block into the speaker channels with the GainMix.hpp kernels.
+//    Sparse mode (RealtimeConfig::sparseTopK > 0) truncates each vector to
+//    its top-K speakers (sparsifyGains()) and mixes only those channels.
 // 5. Route LFE sources directly to compact internal subwoofer channels.
 // 6. Apply loudspeaker/sub mix trims and master gain (Phase 6).
 // 7. Route from the internal bus to the physical output bus (Phase 7):
 //    - identity copy when outputChannelCount == internalChannelCount
 //    - scatter routing (self-clearing) for all non-identity layouts
+// 8. Cluster partition (RealtimeConfig::clusterPartition): gains stay
+//    layout-wide, but only the owned speakers / subwoofers are mixed and
+//    routed, onto a device bus holding just that slice.
 //
 // TWO-SPACE MODEL:
 //   Internal bus (mRenderIO): compact, contiguous, 0..internalChannelCount-1.
@@ -41,7 +48,10 @@
 //
 //  AUDIO thread:
 //    - Calls renderBlock() once per audio block.
-//    - EXCLUSIVELY owns mRenderIO and mSourceBuffer during playback.
+//    - EXCLUSIVELY owns mRenderIO and render lane 0 (mLanes[0]) during playback.
+//    - With renderThreads > 1, forks the per-source loop onto RenderWorkerPool
+//      helper lanes once per block and joins before the output phases; see
+//      RenderWorkerPool.hpp for the fork/join protocol.
 //    - Receives all live runtime controls via ControlsSnapshot (passed by
 //      const-ref from RealtimeBackend::processBlock). Does NOT read mConfig
 //      for masterGain / loudspeakerMix / subMix / focus — those values come
@@ -50,9 +60,25 @@
 //    - Reads mRemap via the non-owning pointer (set once before start(),
 //      then read-only). mRemap->entries() and mRemap->identity() are const.
 //
+//  RENDER HELPER threads (lanes 1..N-1, only when renderThreads > 1):
+//    - Run renderLane() between the fork and join inside renderBlock().
+//    - Each lane writes only its own RenderLane (source buffer, gain table,
+//      partial bus) and the per-source state slots of the sources assigned
+//      to it (si % numLanes == lane). Everything else is read-only.
+//
 //  LOADER thread:
 //    - Does NOT interact with Spatializer at all.
 //
+//  LAYOUT BUILD thread (EngineSession::switchLayout(), during playback):
+//    - Constructs a second Spatializer and runs init() / prepareForSources()
+//      / startWorkers() on it while this one keeps rendering. Nothing is
+//      shared between the two except mConfig atomics and mState counters.
+//    - With fixedOutputChannels > 0, init() validates the new layout against
+//      the already-open output bus and leaves mConfig.outputChannels alone.
+//    - RealtimeBackend adopts the new instance at a block boundary
+//      (takeOver(), AUDIO thread) and crossfades from this one; this one is
+//      destroyed on the MAIN thread once the backend has let go of it.
+//
 //  READ-ONLY after init() / setRemap() (safe to read from any thread):
 //    mSpeakers, mDBap, mNumSpeakers, mSubwooferInternalChannels,
 //    mSubwooferOutputChannels, mLayoutRadius,
@@ -60,7 +86,7 @@
 //
 //  AUDIO-THREAD-OWNED (must not be read/written from any other thread while
 //  audio is streaming):
-//    mRenderIO, mSourceBuffer
+//    mRenderIO, mLanes, mJob
 //
 // ─────────────────────────────────────────────────────────────────────────────
 //
@@ -69,7 +95,10 @@
 //   with the same radians→degrees fix and 0-based channel fix.
 // - Output channel sizing: adapted from SpatialRenderer::render() (lines 837-842):
 //   maxChannel = max(numSpeakers-1, max_sub_channel); out.channels = maxChannel+1
-// - DBAP panning: uses al::Dbap::renderBuffer() directly (same as offline).
+// - DBAP panning: gain math mirrors al::Dbap::renderBuffer() in cult-allolib
+//   (internalDocs/DBAP/dbapMath.md §3–§5). The gains are computed here rather
+//   than inside renderBuffer() so that one gain vector per segment boundary can
+//   be interpolated across the block instead of re-rendering sub-chunks.
 // - LFE routing: adapted from SpatialRenderer::renderPerBlock() (lines 1018-1028)
 //   with the same subGain = masterGain * 0.95 / numSubwoofers formula.
 // - Coordinate transform: already handled by Pose.hpp (direction → DBAP position).
@@ -79,7 +108,8 @@
 // REAL-TIME SAFETY:
 // - renderBlock() is called on the audio thread. No allocation, no locks,
 //   no I/O. All buffers are pre-allocated at init time.
-// - al::Dbap::renderBuffer() is real-time safe (fixed-size arrays, no alloc).
+// - computeDbapGains() and the GainMix.hpp kernels write only into buffers
+//   pre-allocated by init() (mLanes, mRenderIO).
 
 #pragma once
 
@@ -91,8 +121,11 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 // MSVC does not have __builtin_popcountll; use the intrinsic equivalent.
@@ -109,6 +142,10 @@ static inline int sr_popcountll(unsigned long long x) { return static_cast<int>(
 #include "RealtimeTypes.hpp"
 #include "LayoutLoader.hpp"
 #include "OutputRemap.hpp"
+#include "GainMix.hpp"
+#include "RenderWorkerPool.hpp"
+#include "StageProfiler.hpp"
+#include "BusDiagnostics.hpp"
 #include "Streaming.hpp"
 #include "Pose.hpp"
 
@@ -129,6 +166,9 @@ struct ControlsSnapshot {
     float focus          = 1.0f;
     float loudspeakerMix = 1.0f;
     float subMix         = 1.0f;
+    // Per-frame output gain (pause / seek fade), numFrames entries, applied
+    // by the fused output finalize. nullptr = unity (the common case).
+    const float* outputRamp = nullptr;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -136,11 +176,15 @@ struct ControlsSnapshot {
 // ─────────────────────────────────────────────────────────────────────────────
 
 class Spatializer {
+    struct RenderLane;  // per-render-thread scratch; defined with the members below
+
 public:
 
     Spatializer(RealtimeConfig& config, EngineState& state)
         : mConfig(config), mState(state) {}
 
+    ~Spatializer() { stopWorkers(); }
+
     // ── Initialize from speaker layout ───────────────────────────────────
     // Must be called BEFORE the audio stream starts.
     // Builds the al::Speakers array, derives internal and output bus widths,
@@ -161,8 +205,13 @@ public:
     //   internalChannelCount = numSpeakers + numSubwoofers  (compact, DBAP-owned)
     //   outputChannelCount   = max(all .deviceChannel) + 1  (physical bus width)
     //   mConfig.outputChannels = outputChannelCount  (backend opens AudioIO with this)
+    //
+    // LAYOUT HOT-SWAP: fixedOutputChannels > 0 means the device is already
+    // open with that many channels (EngineSession::switchLayout()). The
+    // layout must then fit inside it, and mConfig.outputChannels is not
+    // written — init() may be running on the layout build thread.
 
-    bool init(const SpeakerLayoutData& layout) {
+    bool init(const SpeakerLayoutData& layout, int fixedOutputChannels = 0) {
 
         // ── Build al::Speakers with 0-based consecutive channels ─────────
         mNumSpeakers = static_cast<int>(layout.speakers.size());
@@ -267,21 +316,84 @@ public:
         for (int oc : mSubwooferOutputChannels)   std::cout << " " << oc;
         std::cout << std::endl;
 
+        // ── Cluster partition: which channels this node mixes and routes ──
+        // The internal bus keeps the whole layout (gains are normalized over
+        // every speaker); unowned channels are never mixed into or routed.
+        // Owned device channels are shifted down by the lowest one
+        // (channelBase), so a node's slice starts at device channel 0.
+        std::vector<uint8_t> ownSpeaker(mNumSpeakers, mConfig.clusterPartition ? 0 : 1);
+        std::vector<uint8_t> ownSub(numSubs, mConfig.clusterPartition ? 0 : 1);
+        if (mConfig.clusterPartition) {
+            for (int i : mConfig.clusterSpeakers) {
+                if (i < 0 || i >= mNumSpeakers) {
+                    std::cerr << "[Spatializer] ERROR: Cluster speaker index " << i
+                              << " is outside the layout (0-" << (mNumSpeakers - 1) << ")." << std::endl;
+                    return false;
+                }
+                ownSpeaker[i] = 1;
+            }
+            for (int j : mConfig.clusterSubwoofers) {
+                if (j < 0 || j >= numSubs) {
+                    std::cerr << "[Spatializer] ERROR: Cluster subwoofer index " << j
+                              << " is outside the layout (" << numSubs << " subwoofers)." << std::endl;
+                    return false;
+                }
+                ownSub[j] = 1;
+            }
+        }
+        mMixSpeakers.clear();
+        for (int i = 0; i < mNumSpeakers; ++i)
+            if (ownSpeaker[i]) mMixSpeakers.push_back(i);
+        mLfeChannels.clear();
+        for (int j = 0; j < numSubs; ++j)
+            if (ownSub[j]) mLfeChannels.push_back(mNumSpeakers + j);
+        mMixSpeakerMask.assign(ownSpeaker.begin(), ownSpeaker.end());
+        mPartitioned = mConfig.clusterPartition;
+        if (mMixSpeakers.empty() && mLfeChannels.empty()) {
+            std::cerr << "[Spatializer] ERROR: Cluster partition owns no speaker or subwoofer." << std::endl;
+            return false;
+        }
+
+        int channelBase = 0;
+        if (mPartitioned) {
+            channelBase = std::numeric_limits<int>::max();
+            for (int i : mMixSpeakers)
+                channelBase = std::min(channelBase, layout.speakers[i].deviceChannel);
+            for (int ic : mLfeChannels)
+                channelBase = std::min(channelBase, layout.subwoofers[ic - mNumSpeakers].deviceChannel);
+            std::cout << "[Spatializer] Cluster partition: " << mMixSpeakers.size() << " of "
+                      << mNumSpeakers << " speakers, " << mLfeChannels.size() << " of " << numSubs
+                      << " subwoofers; device channels offset by -" << channelBase << "." << std::endl;
+            mSubwooferOutputChannels.clear();
+            for (int ic : mLfeChannels)
+                mSubwooferOutputChannels.push_back(layout.subwoofers[ic - mNumSpeakers].deviceChannel - channelBase);
+        }
+
         // ── Compute internal and output bus widths ───────────────────────
         // internalChannelCount: compact, owned by mRenderIO.
-        // outputChannelCount:   physical bus width for AudioIO.
+        // outputChannelCount:   physical bus width for AudioIO (this node's
+        //                       slice when partitioned).
         const int internalChannelCount = mNumSpeakers + numSubs;
 
         int maxOutputCh = 0;
-        for (int i = 0; i < mNumSpeakers; ++i)
-            maxOutputCh = std::max(maxOutputCh, layout.speakers[i].deviceChannel);
-        for (int oc : mSubwooferOutputChannels)
-            maxOutputCh = std::max(maxOutputCh, oc);
+        for (int i : mMixSpeakers)
+            maxOutputCh = std::max(maxOutputCh, layout.speakers[i].deviceChannel - channelBase);
+        for (int ic : mLfeChannels)
+            maxOutputCh = std::max(maxOutputCh, layout.subwoofers[ic - mNumSpeakers].deviceChannel - channelBase);
         const int outputChannelCount = maxOutputCh + 1;
 
         // outputChannelCount → config so the backend opens AudioIO correctly.
         // internalChannelCount is internal to Spatializer and never stored in config.
-        mConfig.outputChannels = outputChannelCount;
+        if (fixedOutputChannels > 0) {
+            if (outputChannelCount > fixedOutputChannels) {
+                std::cerr << "[Spatializer] ERROR: Layout needs " << outputChannelCount
+                          << " output channels but the open device bus has only "
+                          << fixedOutputChannels << "." << std::endl;
+                return false;
+            }
+        } else {
+            mConfig.outputChannels = outputChannelCount;
+        }
 
         std::cout << "[Spatializer] Internal bus: " << internalChannelCount
                   << " channels (speakers 0-" << (mNumSpeakers - 1)
@@ -291,6 +403,10 @@ public:
                   << " channels (max deviceChannel=" << maxOutputCh << ")." << std::endl;
 
         // ── Create DBAP panner ───────────────────────────────────────────
+        // renderBlock() computes gains itself (computeDbapGains()), but the
+        // al::Dbap instance is still built: its constructor enforces the
+        // DBAP_MAX_NUM_SPEAKERS cap and it is the reference implementation the
+        // gain stage must match.
         mDBap = std::make_unique<al::Dbap>(mSpeakers, mConfig.dbapFocus.load());
         std::cout << "[Spatializer] DBAP initialized (focus="
                   << mConfig.dbapFocus.load() << ")." << std::endl;
@@ -323,9 +439,6 @@ public:
                   << " speaker positions (DBAP-internal space) for proximity guard."
                   << std::endl;
 
-        // ── Pre-allocate per-source mono buffer ──────────────────────────
-        mSourceBuffer.resize(mConfig.bufferSize, 0.0f);
-
         // ── Pre-allocate internal render buffer ──────────────────────────
         // Sized to internalChannelCount (compact). DBAP writes to channels
         // 0..numSpeakers-1; LFE writes to numSpeakers..internalChannelCount-1.
@@ -340,17 +453,50 @@ public:
                   << internalChannelCount << " channels × "
                   << mConfig.bufferSize << " frames." << std::endl;
 
-        // Fix 2 — size the fast-mover scratch buffer (sub-chunk render target).
-        // Also sized to internalChannelCount — it is an internal render target.
-        {
-            int subFrames = std::max(1, mConfig.bufferSize / kNumSubSteps);
-            mFastMoverScratch.framesPerBuffer(subFrames);
-            mFastMoverScratch.framesPerSecond(mConfig.sampleRate);
-            mFastMoverScratch.channelsIn(0);
-            mFastMoverScratch.channelsOut(internalChannelCount);
-            std::cout << "[Spatializer] Fast-mover scratch buffer: "
-                      << internalChannelCount << " channels × "
-                      << subFrames << " frames (" << kNumSubSteps << " sub-steps)." << std::endl;
+        // ── Pre-allocate render lanes ────────────────────────────────────
+        // One lane per render thread (lane 0 = audio thread). Each lane owns
+        // a per-source mono buffer and a DBAP gain table; lanes ≥ 1 also own
+        // a partial bus shaped like mRenderIO, summed into it after the join.
+        // Fix 2 — gain table: one row of mNumSpeakers gains per segment
+        // boundary: kNumSubSteps + 1 rows covers the fast-mover path (block
+        // start, 3 interior breakpoints, block end); the normal and
+        // guard-blend paths use rows 0 and 1 only.
+        int numLanes = std::max(1, mConfig.renderThreads);
+        const unsigned int hw = std::thread::hardware_concurrency();
+        if (hw > 0 && numLanes > static_cast<int>(hw)) {
+            std::cout << "[Spatializer] renderThreads=" << numLanes
+                      << " exceeds " << hw << " hardware threads; clamping." << std::endl;
+            numLanes = static_cast<int>(hw);
+        }
+        // Sparse mode: K < numSpeakers speakers per gain row.
+        mSparseK = (mConfig.sparseTopK > 0 && mConfig.sparseTopK < mNumSpeakers)
+                 ? std::min(mConfig.sparseTopK, kMaxSparseK) : 0;
+        mLanes.clear();
+        for (int l = 0; l < numLanes; ++l) {
+            auto lane = std::make_unique<RenderLane>();
+            lane->sourceBuffer.assign(mConfig.bufferSize, 0.0f);
+            lane->gainTable.assign(static_cast<size_t>(kNumSubSteps + 1) * mNumSpeakers, 0.0f);
+            lane->numSpeakers = mNumSpeakers;
+            lane->sparseK     = mSparseK;
+            lane->activeIdx.assign(static_cast<size_t>(kNumSubSteps + 1) * mSparseK, 0);
+            if (l == 0) {
+                lane->bus = &mRenderIO;
+            } else {
+                lane->partialBus.framesPerBuffer(mConfig.bufferSize);
+                lane->partialBus.framesPerSecond(mConfig.sampleRate);
+                lane->partialBus.channelsIn(0);
+                lane->partialBus.channelsOut(internalChannelCount);
+                lane->partialBus.zeroOut();
+                lane->bus = &lane->partialBus;
+            }
+            mLanes.push_back(std::move(lane));
+        }
+        std::cout << "[Spatializer] Render lanes: " << numLanes
+                  << " (DBAP gain table " << (kNumSubSteps + 1)
+                  << " rows × " << mNumSpeakers << " speakers per lane)." << std::endl;
+        if (mSparseK > 0) {
+            std::cout << "[Spatializer] Sparse accumulation: top " << mSparseK << " of "
+                      << mNumSpeakers << " speakers per source." << std::endl;
         }
 
         // ── Build layout-derived output routing table ────────────────────
@@ -358,13 +504,14 @@ public:
         // No fan-in. Validation gate above guarantees no duplicate deviceChannels.
         //   Speaker i   (internal=i)             → output=layout.speakers[i].deviceChannel
         //   Sub j       (internal=numSpeakers+j) → output=layout.subwoofers[j].deviceChannel
+        // Partitioned: owned channels only, each minus channelBase.
         {
             std::vector<RemapEntry> entries;
             entries.reserve(internalChannelCount);
-            for (int i = 0; i < mNumSpeakers; ++i)
-                entries.push_back({i, layout.speakers[i].deviceChannel});
-            for (int j = 0; j < numSubs; ++j)
-                entries.push_back({mNumSpeakers + j, layout.subwoofers[j].deviceChannel});
+            for (int i : mMixSpeakers)
+                entries.push_back({i, layout.speakers[i].deviceChannel - channelBase});
+            for (int ic : mLfeChannels)
+                entries.push_back({ic, layout.subwoofers[ic - mNumSpeakers].deviceChannel - channelBase});
             mOutputRouting.buildAuto(std::move(entries), internalChannelCount, outputChannelCount);
         }
         if (mOutputRouting.entries().empty()) {
@@ -373,6 +520,7 @@ public:
             return false;
         }
         mRemap = &mOutputRouting;
+        buildFinalizeTables();
 
         mInitialized = true;
         return true;
@@ -385,12 +533,12 @@ public:
     //   - Non-LFE sources → DBAP spatialize into speaker channels
     //   - LFE sources → route directly to subwoofer channels
     //
-    // After rendering, Phase 7 routes the internal bus to the output bus via
-    // mOutputRouting (identity copy or scatter depending on the layout).
-    // Scatter path owns its own output-bus clear and does not rely on the caller.
+    // After rendering, one fused finalize pass applies the mix trims, the NaN
+    // clamp and ctrl.outputRamp and routes the internal bus to the output bus
+    // via mRemap (identity or scatter depending on the layout).
     //
-    // io output buffers must be zeroed BEFORE calling this method (required
-    // for the identity copy fast path; the scatter path self-clears).
+    // Every channel of io is overwritten (unrouted channels are cleared), so
+    // the caller does not need to zero io first.
     //
     // REAL-TIME SAFE: no allocation, no I/O, no locks.
 
@@ -406,405 +554,101 @@ public:
         const float masterGain = ctrl.masterGain;
         const unsigned int renderChannels = mRenderIO.channelsOut();
 
-        // ── Apply live focus update to DBAP panner ───────────────────────
+        // ── Apply live focus update to the gain stage ────────────────────
         // ctrl.focus is already smoothed by RealtimeBackend (50 ms tau).
         // The exponential smoother continuously ramps the value, so each block
         // receives a slightly-updated focus that is already interpolated — no
-        // within-block per-frame lerp needed. mPrevFocus is kept so a future
-        // fast-path (skip renderBuffer when focus is static) can be added.
-        mPrevFocus = ctrl.focus;
-        mDBap->setFocus(ctrl.focus);
+        // within-block per-frame lerp needed. Static-focus blocks are served
+        // from the per-source gain cache (see Source culling in renderSource()).
+        // Same 0.1 floor as al::Dbap::setFocus() (dbapMath.md §4).
+        const float focus = std::max(kMinFocus, ctrl.focus);
+        mPrevFocus = focus;
 
         // Zero the internal render buffer (DBAP accumulates into it)
         mRenderIO.zeroOut();
 
-        for (size_t si = 0; si < poses.size(); ++si) {
-            const auto& pose = poses[si];
-
-            // Skip sources with no valid position
-            if (!pose.isValid) continue;
-
-            // ── LFE routing (no spatialization) ──────────────────────────
-            // Adapted from SpatialRenderer::renderPerBlock() lines 1018-1028
-            // subGain = masterGain * 0.95 / numSubwoofers
-            // LFE writes into the render buffer (same as non-LFE).
-            // The remap step will later handle routing to physical outputs.
-            if (pose.isLFE) {
-                if (mSubwooferInternalChannels.empty()) continue;
-
-                // Read LFE audio into pre-allocated buffer
-                streaming.getBlock(pose.name, currentFrame, numFrames,
-                                   mSourceBuffer.data());
-
-                // Fix 1 — Onset fade (LFE path)
-                // Detect whether this block has meaningful signal energy.
-                // If the previous block was silent and this one is active,
-                // ramp the first kOnsetFadeSamples samples from 0→1 to
-                // suppress the step-from-zero low-end pop at source onset.
-                if (si < mSourceWasSilent.size()) {
-                    float energy = 0.0f;
-                    for (unsigned int f = 0; f < numFrames; ++f)
-                        energy += mSourceBuffer[f] * mSourceBuffer[f];
-                    const bool currentlyActive = (energy > kOnsetEnergyThreshold);
-                    if (mSourceWasSilent[si] && currentlyActive) {
-                        const unsigned int fadeEnd =
-                            std::min(kOnsetFadeSamples, numFrames);
-                        for (unsigned int f = 0; f < fadeEnd; ++f)
-                            mSourceBuffer[f] *=
-                                static_cast<float>(f) / static_cast<float>(fadeEnd);
-                    }
-                    mSourceWasSilent[si] = currentlyActive ? 0u : 1u;
-                }
-
-                float subGain = (masterGain * kSubCompensation)
-                                / static_cast<float>(mSubwooferInternalChannels.size());
-
-                for (int subCh : mSubwooferInternalChannels) {
-                    // Bounds check against internal render buffer
-                    if (static_cast<unsigned int>(subCh) >= renderChannels) continue;
-
-                    float* out = mRenderIO.outBuffer(subCh);
-                    for (unsigned int f = 0; f < numFrames; ++f) {
-                        out[f] += mSourceBuffer[f] * subGain;
-                    }
-                }
-                continue;
-            }
-
-            // ── DBAP spatialization ──────────────────────────────────────
-            // Read mono audio from streaming agent
-            streaming.getBlock(pose.name, currentFrame, numFrames,
-                               mSourceBuffer.data());
-            // Fix 1 — Onset fade (DBAP path)
-            // Same gate-and-ramp logic as the LFE path above.
-            // Applied before the master-gain multiply so the ramp is not
-            // scaled twice and does not affect the proximity guard below.
-            if (si < mSourceWasSilent.size()) {
-                float energy = 0.0f;
-                for (unsigned int f = 0; f < numFrames; ++f)
-                    energy += mSourceBuffer[f] * mSourceBuffer[f];
-                const bool currentlyActive = (energy > kOnsetEnergyThreshold);
-                if (mSourceWasSilent[si] && currentlyActive) {
-                    const unsigned int fadeEnd =
-                        std::min(kOnsetFadeSamples, numFrames);
-                    for (unsigned int f = 0; f < fadeEnd; ++f)
-                        mSourceBuffer[f] *=
-                            static_cast<float>(f) / static_cast<float>(fadeEnd);
-                }
-                mSourceWasSilent[si] = currentlyActive ? 0u : 1u;
-            }
-            // Apply master gain to the source buffer before DBAP.
-            for (unsigned int f = 0; f < numFrames; ++f) {
-                mSourceBuffer[f] *= masterGain;
-            }
-
-            // Phase 13: per-speaker proximity guard (geometrically exact).
-            //
-            // COORDINATE SPACE:
-            //   DBAP::renderBuffer() transforms the source position internally:
-            //     relpos = Vec3d(pos.x, -pos.z, pos.y)
-            //   Speaker vectors mSpeakerVecs[k] = speaker.vec() are in audio-space
-            //   Cartesian (y-forward, x-right, z-up). Distances are computed as:
-            //     dist = |relpos - mSpeakerVecs[k]|
-            //
-            //   Our mSpeakerPositions[] cache stores speaker.vec() exactly.
-            //   We apply the same flip to pose.position to get relpos, guard in
-            //   that space, then un-flip back to pose space for renderBuffer().
-            //
-            //   Forward flip  (pose space → DBAP-internal):  (x,y,z) → (x,-z,y)
-            //   Inverse flip  (DBAP-internal → pose space):  (x,y,z) → (x,z,-y)
-            //   (Both are their own inverse — one application undoes the other.)
-            //
-            // THRESHOLD: 0.15 m. Worst observed case is source 21.1 at 0.049 m
-            // from speaker ch15 at t=47.79 s. 0.15 m gives comfortable clearance
-            // without over-constraining trajectory freedom near speakers.
-
-            // Step 1: transform pose.position into DBAP-internal space
-            const al::Vec3f& p = pose.position;
-            al::Vec3f relpos(p.x, -p.z, p.y);  // same flip DBAP applies internally
-
-            // Step 2: guard in DBAP-internal space (exact geometry)
-            //
-            // Pass 1 — soft outer zone (single scan, no convergence loop).
-            // For sources in (kMinSpeakerDist, kGuardSoftZone), applies a
-            // smooth outward bias: zero effect at both zone boundaries,
-            // positive outward displacement in between. Prevents the hard-snap
-            // DBAP cluster change that occurred when sources crossed kMinSpeakerDist.
-            for (const auto& spkVec : mSpeakerPositions) {
-                al::Vec3f delta = relpos - spkVec;
-                float dist = delta.mag();
-                if (dist > kMinSpeakerDist && dist < kGuardSoftZone && dist > 1e-7f) {
-                    float u    = (dist - kMinSpeakerDist) / (kGuardSoftZone - kMinSpeakerDist);
-                    float push = (kGuardSoftZone - kMinSpeakerDist) * u * (1.0f - u);
-                    relpos = spkVec + (delta / dist) * (dist + push);
-                }
-            }
-            //
-            // Pass 2 — hard inner floor with convergence loop (unchanged).
-            // Catches any source still inside kMinSpeakerDist after Pass 1.
-            bool guardFiredForSource = false;
-            for (int iter = 0; iter < kGuardMaxIter; ++iter) {
-                bool pushed = false;
-                for (const auto& spkVec : mSpeakerPositions) {
-                    al::Vec3f delta = relpos - spkVec;
-                    float dist = delta.mag();
-                    if (dist < kMinSpeakerDist) {
-                        relpos = spkVec + ((dist > 1e-7f)
-                            ? (delta / dist) * kMinSpeakerDist
-                            : al::Vec3f(0.0f, kMinSpeakerDist, 0.0f));
-                        pushed = true;
-                    }
-                }
-                if (!pushed) break;
-                guardFiredForSource = true;
-            }
-            if (guardFiredForSource) {
-                mState.speakerProximityCount.fetch_add(1, std::memory_order_relaxed);
-            }
-
-            // Step 3: un-flip back to pose space for renderBuffer()
-            // renderBuffer() will re-apply (x,y,z)→(x,-z,y) internally,
-            // recovering the guarded relpos we just computed.
-            al::Vec3f safePos(relpos.x, relpos.z, -relpos.y);
-
-            // Fix 2 — Fast-mover sub-stepping.
-            //
-            // Detect whether this source moves more than kFastMoverAngleRad
-            // (~14.3°) between block start and block end. If so, split the
-            // block into kNumSubSteps equal sub-chunks and render each at an
-            // independently guarded, renormalised interpolated position.
-            // This converts a block-boundary DBAP gain step into a smooth
-            // within-block gain ramp, eliminating the pop at guard-entry and
-            // large-motion block boundaries.
-            //
-            // For static or slow-moving sources the normal single-position
-            // path is taken (zero overhead vs. pre-Fix-2 behaviour).
-            {
-                // Angular span of this block in DBAP position space.
-                // positionStart / positionEnd are at mLayoutRadius; normalising
-                // projects to unit sphere for the angle comparison.
-                al::Vec3f d0 = pose.positionStart.normalized();
-                al::Vec3f d1 = pose.positionEnd.normalized();
-                float dotVal     = std::clamp(d0.dot(d1), -1.0f, 1.0f);
-                float angleDelta = std::acos(dotVal);
-                bool  isFastMover = (angleDelta > kFastMoverAngleRad);
-
-                // subFrames is used by both the normal-path doBlend branch
-                // and the fast-mover branch — define it here so both can reach it.
-                const unsigned int subFrames =
-                    numFrames / static_cast<unsigned int>(kNumSubSteps);
-
-                if (!isFastMover) {
-                    // ── Normal path ───────────────────────────────────────
-                    // Bug 9.1 — cross-block guard-transition continuity.
-                    // When Pass 2 fired this block or last block, blend the
-                    // guard-resolved position from last block (mPrevSafePos)
-                    // into the first half of sub-steps, then safePos for the
-                    // second half.  Eliminates the ~23% DBAP gain step at
-                    // block boundaries when a source enters or exits the
-                    // hard-floor zone.
-                    //
-                    // doBlend activates only when a guard transition is detected
-                    // (current or prior block fired Pass 2) AND a valid prior
-                    // position exists.  Both conditions required to avoid
-                    // stale-data artefacts on the very first block.
-                    const bool doBlend = (si < mPrevSafePos.size())
-                        && mPrevSafeValid[si]
-                        && (guardFiredForSource || mPrevGuardFired[si]);
-
-                    if (doBlend) {
-                        for (int j = 0; j < kNumSubSteps; ++j) {
-                            const al::Vec3f& subPos =
-                                (j < kNumSubSteps / 2) ? mPrevSafePos[si] : safePos;
-                            mFastMoverScratch.zeroOut();
-                            mDBap->renderBuffer(mFastMoverScratch, subPos,
-                                                mSourceBuffer.data() + j * subFrames,
-                                                subFrames);
-                            for (unsigned int ch = 0; ch < renderChannels; ++ch) {
-                                const float* src = mFastMoverScratch.outBuffer(ch);
-                                float*       dst = mRenderIO.outBuffer(ch);
-                                for (unsigned int f = 0; f < subFrames; ++f)
-                                    dst[j * subFrames + f] += src[f];
-                            }
-                        }
-                    } else {
-                        // Normal single-position render (no guard transition).
-                        mDBap->renderBuffer(mRenderIO, safePos,
-                                            mSourceBuffer.data(), numFrames);
-                    }
-                } else {
-                    // ── Fast-mover path ───────────────────────────────────
-                    // Render 4 sub-chunks, each at a lerp'd position that is
-                    // renormalised to the layout-radius sphere, then guarded.
-                    //
-                    // Bug 10 (normalized DBAP): track the last sub-step's guarded
-                    // position so the state update below can write an accurate
-                    // continuity anchor (mPrevSafePos) for the next block.
-                    // Under normalized DBAP the gain function is sensitive to the
-                    // normalization basin boundary, so the block-center safePos
-                    // (written by the old unconditional update) could represent a
-                    // 4× different gain state from what the ear actually heard at
-                    // the end of this block.
-                    al::Vec3f lastSubSafePos = safePos;  // fallback: block-center
-
-                    for (int j = 0; j < kNumSubSteps; ++j) {
-                        // Sub-chunk center interpolation weight (0.125, 0.375, 0.625, 0.875)
-                        float alpha = (static_cast<float>(j) + 0.5f)
-                                      / static_cast<float>(kNumSubSteps);
-
-                        // Lerp in pose space (chord interpolation)
-                        al::Vec3f subPose = pose.positionStart
-                                            + alpha * (pose.positionEnd - pose.positionStart);
-
-                        // Renormalise back to layout-radius sphere.
-                        // The chord midpoint falls slightly inside the sphere;
-                        // scaling by mLayoutRadius / mag restores the correct radius.
-                        {
-                            float mag = subPose.mag();
-                            if (mag > 1e-7f) subPose = (subPose / mag) * mLayoutRadius;
-                        }
-
-                        // Flip to DBAP-internal space, apply two-pass guard, un-flip
-                        al::Vec3f subRelpos(subPose.x, -subPose.z, subPose.y);
-                        // Pass 1 — soft outer zone (single scan, mirrors normal path)
-                        for (const auto& spkVec : mSpeakerPositions) {
-                            al::Vec3f delta = subRelpos - spkVec;
-                            float dist = delta.mag();
-                            if (dist > kMinSpeakerDist && dist < kGuardSoftZone && dist > 1e-7f) {
-                                float u    = (dist - kMinSpeakerDist) / (kGuardSoftZone - kMinSpeakerDist);
-                                float push = (kGuardSoftZone - kMinSpeakerDist) * u * (1.0f - u);
-                                subRelpos = spkVec + (delta / dist) * (dist + push);
-                            }
-                        }
-                        // Pass 2 — hard inner floor with convergence loop (unchanged)
-                        for (int iter = 0; iter < kGuardMaxIter; ++iter) {
-                            bool pushed = false;
-                            for (const auto& spkVec : mSpeakerPositions) {
-                                al::Vec3f delta = subRelpos - spkVec;
-                                float dist = delta.mag();
-                                if (dist < kMinSpeakerDist) {
-                                    subRelpos = spkVec + ((dist > 1e-7f)
-                                        ? (delta / dist) * kMinSpeakerDist
-                                        : al::Vec3f(0.0f, kMinSpeakerDist, 0.0f));
-                                    pushed = true;
-                                }
-                            }
-                            if (!pushed) break;
-                        }
-                        al::Vec3f subSafePos(subRelpos.x, subRelpos.z, -subRelpos.y);
-
-                        // Capture the last sub-step's guarded position as the
-                        // continuity anchor for the next block.
-                        if (j == kNumSubSteps - 1) lastSubSafePos = subSafePos;
-
-                        // Render sub-chunk into scratch, then accumulate into
-                        // mRenderIO at the correct frame offset.
-                        mFastMoverScratch.zeroOut();
-                        mDBap->renderBuffer(mFastMoverScratch, subSafePos,
-                                            mSourceBuffer.data() + j * subFrames,
-                                            subFrames);
-                        for (unsigned int ch = 0; ch < renderChannels; ++ch) {
-                            const float* src = mFastMoverScratch.outBuffer(ch);
-                            float*       dst = mRenderIO.outBuffer(ch);
-                            for (unsigned int f = 0; f < subFrames; ++f)
-                                dst[j * subFrames + f] += src[f];
-                        }
-                    }
-
-                    // Write corrected anchor for next block's doBlend.
-                    // mPrevGuardFired is cleared: block-center guard state is
-                    // irrelevant for fast-mover blocks and must not trigger a
-                    // doBlend anchored to the wrong position on the next block.
-                    if (si < mPrevSafePos.size()) {
-                        mPrevSafePos[si]      = lastSubSafePos;
-                        mPrevSafeValid[si]    = 1u;
-                        mPrevGuardFired[si]   = 0u;
-                        mPrevWasFastMover[si] = 1u;
-                    }
-                }
-
-                // Bug 9.1 — update guard-transition blending state for next block.
-                // Fast-mover blocks write their own state (lastSubSafePos as anchor,
-                // mPrevGuardFired=0, mPrevWasFastMover=1) inside the fast-mover
-                // branch above. Only the normal path writes here.
-                if (!isFastMover && si < mPrevSafePos.size()) {
-                    mPrevSafePos[si]      = safePos;
-                    mPrevSafeValid[si]    = 1u;
-                    mPrevGuardFired[si]   = guardFiredForSource ? 1u : 0u;
-                    mPrevWasFastMover[si] = 0u;
-                }
-            }
+        // ── Per-source rendering (optionally split across worker lanes) ──
+        // Lane 0 is this (audio) thread and renders straight into mRenderIO.
+        // With renderThreads > 1, helper lanes render their share of the
+        // sources into private partial buses in parallel; the partial buses
+        // are then summed into mRenderIO in fixed lane order (deterministic).
+        // Sources are assigned round-robin (si % numLanes), so every per-source
+        // state slot (mSourceWasSilent[si], mPrevSafePos[si], …) and every
+        // SourceStream is touched by exactly one lane per block.
+        mJob.streaming    = &streaming;
+        mJob.poses        = &poses;
+        mJob.currentFrame = currentFrame;
+        mJob.numFrames    = numFrames;
+        mJob.masterGain   = masterGain;
+        mJob.focus        = focus;
+        mJob.profiling    = (mProfiler != nullptr);
+        uint64_t tStage   = mJob.profiling ? StageProfiler::now() : 0;
+        mWorkerPool.run(&Spatializer::renderLaneThunk, this);
+
+        // Only the channels a lane wrote this block (its touched range; never
+        // wider than this node's owned channels) are summed.
+        for (int l = 1; l < mWorkerPool.numLanes(); ++l) {
+            const RenderLane& lane = *mLanes[l];
+            const al::AudioIOData& partial = lane.partialBus;
+            const int hi = std::min(lane.touchHi, static_cast<int>(renderChannels));
+            for (int ch = lane.touchLo; ch < hi; ++ch)
+                mixGainConstant(mRenderIO.outBuffer(ch), partial.outBuffer(ch), 1.0f, numFrames);
         }
 
-        // mPrevFocus already updated above (= ctrl.focus set each block).
-
-        // ── Phase 6: Apply mix trims to mRenderIO ────────────────────
-        // Applied AFTER all DBAP + LFE rendering, BEFORE the clamp pass and
-        // copy to real AudioIO output. This matches the design doc specification:
-        //   - loudspeakerMix → all non-subwoofer channels (main speakers)
-        //   - subMix         → subwoofer channels only
-        // Values come from the ControlsSnapshot (smoothed, never from atomics).
-        //
-        // Unity-guard (== 1.0f) makes the no-op case zero cost.
-        const float spkMix = ctrl.loudspeakerMix;
-        const float lfeMix = ctrl.subMix;
-
-        if (spkMix != 1.0f) {
-            for (unsigned int ch = 0; ch < renderChannels; ++ch) {
-                if (!isInternalSubwooferChannel(static_cast<int>(ch))) {
-                    float* buf = mRenderIO.outBuffer(ch);
-                    for (unsigned int f = 0; f < numFrames; ++f) {
-                        buf[f] *= spkMix;
-                    }
-                }
+        // Guard fires may come from any lane; after the join one counter
+        // read turns them into a single per-block event. An outgoing
+        // (retiring) layout leaves this and the Phase 14 masks to the
+        // incoming one, so a crossfade block reports each event once.
+        if (!mRetiring) {
+            const uint64_t guards = mState.speakerProximityCount.load(std::memory_order_relaxed);
+            if (guards != mGuardCountSeen) {
+                mState.diagEvents.push(DiagEventType::GuardFire, currentFrame, 0, 0,
+                                       guards - mGuardCountSeen);
+                mGuardCountSeen = guards;
             }
         }
-        if (lfeMix != 1.0f) {
-            for (int subCh : mSubwooferInternalChannels) {
-                if (static_cast<unsigned int>(subCh) < renderChannels) {
-                    float* buf = mRenderIO.outBuffer(subCh);
-                    for (unsigned int f = 0; f < numFrames; ++f) {
-                        buf[f] *= lfeMix;
-                    }
-                }
-            }
+        if (mProfiler) {
+            tStage = mProfiler->lap(ProfileStage::Sources, tStage);
+            uint64_t streamTicks = 0;
+            for (int l = 0; l < mWorkerPool.numLanes(); ++l) streamTicks += mLanes[l]->streamTicks;
+            mProfiler->record(ProfileStage::StreamRead, streamTicks);
         }
 
-        // ── Phase 11 Fix 3: NaN / Inf / extreme-gain clamp pass ──────────
-        // Applied AFTER Phase 6 mix-trims, BEFORE the Phase 7 copy to output.
-        // Guarantees that no value outside [-kMaxSample, +kMaxSample] and no
-        // non-finite value ever reaches io.outBuffer() → hardware (Invariant 10).
+        // mPrevFocus already updated above (= ctrl.focus set each block).
+
+        // ── Phases 6 + 11 + 7: fused output finalize ─────────────────────
+        // One read of each render-bus channel and one write of its device
+        // channel (finalizeChannel(), GainMix.hpp) does what used to be four
+        // sweeps over the bus plus the backend's pause-fade pass:
+        //   - Phase 6 mix trims: loudspeakerMix → non-subwoofer channels,
+        //     subMix → subwoofer channels (from the ControlsSnapshot, smoothed,
+        //     never from atomics)
+        //   - Phase 11 Fix 3 scrub: NaN / Inf → 0, clamp to ±kMaxSample, so no
+        //     such value ever reaches io.outBuffer() → hardware (Invariant 10)
+        //   - ctrl.outputRamp: the backend's per-frame pause / seek fade
+        //   - Phase 7 routing: identity (internal ch N → output ch N) or
+        //     scatter through mRemap->entries(); device channels nothing is
+        //     routed to are cleared, so no caller pre-zero is required
+        // and, on diagnostic blocks, each channel's mean square (post-clamp,
+        // pre-fade — what the two Phase 14 analyses below consume).
         //
-        // This is a last-resort guard, not a normal operating path. The
+        // The scrub is a last-resort guard, not a normal operating path. The
         // minimum-distance guard above (kMinSourceDist) is the primary defence
         // against DBAP gain spikes. If nanGuardCount is non-zero in the log,
         // there is a source-position or DBAP-distance bug to investigate.
-        {
-            bool guardFired = false;
-            for (unsigned int ch = 0; ch < renderChannels; ++ch) {
-                float* buf = mRenderIO.outBuffer(ch);
-                for (unsigned int f = 0; f < numFrames; ++f) {
-                    float s = buf[f];
-                    if (!std::isfinite(s)) {
-                        buf[f] = 0.0f;
-                        guardFired = true;
-                    } else if (s > kMaxSample) {
-                        buf[f] = kMaxSample;
-                        guardFired = true;
-                    } else if (s < -kMaxSample) {
-                        buf[f] = -kMaxSample;
-                        guardFired = true;
-                    }
-                }
-            }
-            if (guardFired) {
-                mState.nanGuardCount.fetch_add(1, std::memory_order_relaxed);
-            }
+        const bool runDiagnostics = !mRetiring && diagnosticsDue();
+        const unsigned int numOutputChannels = io.channelsOut();
+        if (finalizeOutput(io, numFrames, ctrl, runDiagnostics)) {
+            mState.nanGuardCount.fetch_add(1, std::memory_order_relaxed);
+            mState.diagEvents.push(DiagEventType::NanClamp, currentFrame, 0, 0, 1);
+        }
+        if (mProfiler) {
+            tStage = mProfiler->lap(ProfileStage::TrimClamp, tStage);
+            mProfiler->record(ProfileStage::Remap, 0);  // folded into TrimClamp
         }
 
-        // ── Phase 14 diagnostic: render-bus active-channel mask (pre-copy) ──
-        // Measured AFTER all rendering and NaN clamp, BEFORE the OutputRemap
-        // copy. Two complementary masks are computed each block:
+        // ── Phase 14 diagnostic: render-bus and device-bus channel masks ──
+        // Two complementary masks are computed per diagnostic block and bus:
         //
         //   Active mask  (absolute): channels whose block mean-square exceeds
         //     kRmsThresh = 1e-8 (≈ −80 dBFS). Includes far-field DBAP bleed.
@@ -815,212 +659,117 @@ public:
         //     Tracks the speaker cluster carrying the bulk of spatial energy.
         //     More meaningful for detecting audible channel relocation.
         //
-        // Both relocation latches suppress the first-block 0→X false positive
+        // plus the top-4 mains cluster and the main / sub RMS meters
+        // (BusDiagnostics.hpp), from the mean squares the finalize produced.
+        // The device bus reads each device channel's source through the
+        // routing table, so comparing renderDomMask vs deviceDomMask directly
+        // shows whether the dominant speaker cluster shifts at the routing
+        // step. Runs every block, every mConfig.diagnosticsEvery blocks, or
+        // never, per DiagnosticsTier.
+        //
+        // All relocation latches suppress the first-block 0→X false positive
         // (prevMask == 0 guard). Only genuine mid-playback changes fire.
-        {
-            constexpr float kRmsThresh    = 1e-8f;
-            constexpr float kDomRelThresh = 0.01f;  // 1% of max power = −20 dBFS
-
-            uint64_t mask    = 0;
-            uint64_t domMask = 0;
-            float    maxMs     = 0.0f;
-            float    maxMainMs = 0.0f;  // mains-only max, used for domMask reference
-            float    mainMs  = 0.0f, subMs = 0.0f;
-            float    chMs[64] = {};
-
-            for (unsigned int ch = 0; ch < renderChannels && ch < 64u; ++ch) {
-                const float* buf = mRenderIO.outBuffer(ch);
-                float ss = 0.0f;
-                for (unsigned int f = 0; f < numFrames; ++f) ss += buf[f] * buf[f];
-                float ms = ss / static_cast<float>(numFrames);
-                chMs[ch] = ms;
-                if (ms > kRmsThresh) {
-                    mask |= (1ULL << ch);
-                    if (isInternalSubwooferChannel(static_cast<int>(ch)))
-                        subMs += ms;
-                    else
-                        mainMs += ms;
-                }
-                if (ms > maxMs) maxMs = ms;
-                if (!isInternalSubwooferChannel(static_cast<int>(ch)) && ms > maxMainMs)
-                    maxMainMs = ms;
-            }
-
-            // Dominant mask: relative threshold applied after finding per-block max.
-            // Guard: only compute if there is meaningful signal (avoids 1.0 * 0 = 0
-            // edge case where silence would mark all channels as equally dominant).
-            // Reference is maxMainMs (mains only) so sub threshold crossings do not
-            // rescale the threshold and cause spurious mains-cluster relocation events.
-            // Sub state is captured separately by subRmsTotal.
-            const float domThresh = maxMainMs * kDomRelThresh;
-            if (domThresh > kRmsThresh) {
-                for (unsigned int ch = 0; ch < renderChannels && ch < 64u; ++ch) {
-                    if (!isInternalSubwooferChannel(static_cast<int>(ch)) && chMs[ch] >= domThresh)
-                        domMask |= (1ULL << ch);
-                }
-            }
-
-            // Absolute-mask relocation latch — suppress first-block false positive
-            uint64_t prevMask = mState.renderActiveMask.load(std::memory_order_relaxed);
-            if (mask != prevMask && prevMask != 0) {
-                mState.renderRelocPrev.store(prevMask, std::memory_order_relaxed);
-                mState.renderRelocNext.store(mask,     std::memory_order_relaxed);
-                mState.renderRelocEvent.store(true,    std::memory_order_relaxed);
-            }
-            mState.renderActiveMask.store(mask, std::memory_order_relaxed);
-
-            // Dominant-mask relocation latch — suppress first-block false positive
-            uint64_t prevDom = mState.renderDomMask.load(std::memory_order_relaxed);
-            if (domMask != prevDom && prevDom != 0) {
-                mState.renderDomRelocPrev.store(prevDom,  std::memory_order_relaxed);
-                mState.renderDomRelocNext.store(domMask,  std::memory_order_relaxed);
-                mState.renderDomRelocEvent.store(true,    std::memory_order_relaxed);
-            }
-            mState.renderDomMask.store(domMask, std::memory_order_relaxed);
-
-            // Top-4 mains cluster: find 4 highest-MS main channels via 4-pass linear
-            // scan (O(K × channels), K=4). No allocation; RT-safe.
-            // A CLUSTER event fires when the new top-4 overlaps the previous by fewer
-            // than 3 channels (2+ channels changed) — a meaningful spatial shift.
-            {
-                uint64_t clusterMask = 0;
-                uint64_t picked = 0;
-                for (int k = 0; k < 4; ++k) {
-                    float best = kRmsThresh;
-                    int   bestCh = -1;
-                    for (unsigned int ch = 0; ch < renderChannels && ch < 64u; ++ch) {
-                        if (isInternalSubwooferChannel(static_cast<int>(ch))) continue;
-                        if (picked & (1ULL << ch)) continue;
-                        if (chMs[ch] > best) { best = chMs[ch]; bestCh = static_cast<int>(ch); }
-                    }
-                    if (bestCh >= 0) { clusterMask |= (1ULL << bestCh); picked = clusterMask; }
-                }
-                uint64_t prevCluster = mState.renderClusterMask.load(std::memory_order_relaxed);
-                if (prevCluster != 0) {
-                    int overlap = __builtin_popcountll(clusterMask & prevCluster);
-                    if (overlap < 3) {
-                        mState.renderClusterPrev.store(prevCluster,  std::memory_order_relaxed);
-                        mState.renderClusterNext.store(clusterMask,  std::memory_order_relaxed);
-                        mState.renderClusterEvent.store(true,        std::memory_order_relaxed);
-                    }
-                }
-                mState.renderClusterMask.store(clusterMask, std::memory_order_relaxed);
-            }
-
-            mState.mainRmsTotal.store(std::sqrt(mainMs), std::memory_order_relaxed);
-            mState.subRmsTotal.store(std::sqrt(subMs),   std::memory_order_relaxed);
+        if (runDiagnostics) {
+            BusDiagReport r = analyzeBus(renderChannels,
+                [this](unsigned int ch) { return mChannelMs[ch]; },
+                [this](unsigned int ch) { return mInternalIsSub[ch] != 0; });
+
+            latchRelocation(r.activeMask, mState.renderActiveMask, DiagEventType::RenderReloc, currentFrame);
+            latchRelocation(r.domMask, mState.renderDomMask, DiagEventType::RenderDomReloc, currentFrame);
+            latchCluster(r.clusterMask, mState.renderClusterMask, DiagEventType::RenderCluster, currentFrame);
+
+            mState.mainRmsTotal.store(std::sqrt(r.mainMs), std::memory_order_relaxed);
+            mState.subRmsTotal.store(std::sqrt(r.subMs),   std::memory_order_relaxed);
+
+            r = analyzeBus(numOutputChannels,
+                [this](unsigned int ch) {
+                    const int src = (ch < mDeviceSource.size()) ? mDeviceSource[ch] : -1;
+                    return src >= 0 ? mChannelMs[src] : 0.0f;
+                },
+                [this](unsigned int ch) { return isOutputSubwooferChannel(static_cast<int>(ch)); });
+
+            latchRelocation(r.activeMask, mState.deviceActiveMask, DiagEventType::DeviceReloc, currentFrame);
+            latchRelocation(r.domMask, mState.deviceDomMask, DiagEventType::DeviceDomReloc, currentFrame);
+            latchCluster(r.clusterMask, mState.deviceClusterMask, DiagEventType::DeviceCluster, currentFrame);
         }
+        if (mProfiler) mProfiler->lap(ProfileStage::Diagnostics, tStage);
+    }
 
-        // ── Phase 7: Route internal bus → output bus ─────────────────────
-        // Identity copy: valid only when outputChannelCount == internalChannelCount
-        //   (checkIdentity() enforces this). Relies on backend pre-zero.
-        // Scatter routing: self-clears the full output bus before scattering.
-        //   Does NOT rely on the caller to have zeroed io.outBuffer().
-        //   One-to-one mapping — no fan-in; memcpy is safe.
-
-        const unsigned int numOutputChannels = io.channelsOut();
-
-        if (mRemap->identity()) {
-            // Identity copy: internal ch N → output ch N, contiguous.
-            // outputChannelCount == internalChannelCount by invariant — no std::min needed.
-            for (unsigned int ch = 0; ch < renderChannels; ++ch) {
-                const float* src = mRenderIO.outBuffer(ch);
-                float*       dst = io.outBuffer(ch);
-                for (unsigned int f = 0; f < numFrames; ++f)
-                    dst[f] += src[f];
-            }
-        } else {
-            // Scatter routing: self-clear the full output bus, then scatter.
-            // renderBlock() owns this clear — caller pre-zero is not required.
-            for (unsigned int ch = 0; ch < numOutputChannels; ++ch)
-                std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
-
-            for (const auto& entry : mRemap->entries()) {
-                // Post-validation last-resort guards. Should never fire.
-                if (static_cast<unsigned int>(entry.layout) >= renderChannels)   continue;
-                if (static_cast<unsigned int>(entry.device) >= numOutputChannels) continue;
-                std::memcpy(io.outBuffer(entry.device),
-                            mRenderIO.outBuffer(entry.layout),
-                            numFrames * sizeof(float));
-            }
+    // ── Phase 14 diagnostics tier ────────────────────────────────────────
+    // Reads mConfig.diagnosticsTier / diagnosticsEvery (relaxed, once per
+    // block — a discrete setting like elevationMode, not part of the
+    // smoothed ControlsSnapshot). On the switch to Off, the published masks
+    // and meters are zeroed once so a monitor does not show frozen values;
+    // the prevMask == 0 guards then keep re-enabling from firing events.
+    bool diagnosticsDue() {
+        const auto tier = static_cast<DiagnosticsTier>(
+            mConfig.diagnosticsTier.load(std::memory_order_relaxed));
+        if (tier == DiagnosticsTier::Off) {
+            if (mDiagPublished) clearPublishedDiagnostics();
+            mDiagBlock = 0;
+            return false;
         }
+        mDiagPublished = true;
+        if (tier == DiagnosticsTier::Full) return true;
+        const uint32_t every = static_cast<uint32_t>(
+            std::max(1, mConfig.diagnosticsEvery.load(std::memory_order_relaxed)));
+        const bool due = (mDiagBlock == 0);
+        if (++mDiagBlock >= every) mDiagBlock = 0;
+        return due;
+    }
 
-        // ── Phase 14 diagnostic: device-output active-channel mask (post-copy) ─
-        // Same two-tier approach as the render-bus diagnostic above.
-        // Comparing renderDomMask vs deviceDomMask directly shows whether the
-        // dominant speaker cluster shifts at the OutputRemap copy step.
-        {
-            constexpr float kRmsThresh    = 1e-8f;
-            constexpr float kDomRelThresh = 0.01f;
-
-            uint64_t mask    = 0;
-            uint64_t domMask = 0;
-            float    maxMs     = 0.0f;
-            float    maxMainMs = 0.0f;  // mains-only max, mirrors render-side logic
-            float    chMs[64] = {};
-
-            for (unsigned int ch = 0; ch < numOutputChannels && ch < 64u; ++ch) {
-                const float* buf = io.outBuffer(ch);
-                float ss = 0.0f;
-                for (unsigned int f = 0; f < numFrames; ++f) ss += buf[f] * buf[f];
-                float ms = ss / static_cast<float>(numFrames);
-                chMs[ch] = ms;
-                if (ms > kRmsThresh) mask |= (1ULL << ch);
-                if (ms > maxMs) maxMs = ms;
-                if (!isOutputSubwooferChannel(static_cast<int>(ch)) && ms > maxMainMs)
-                    maxMainMs = ms;
-            }
-
-            const float domThresh = maxMainMs * kDomRelThresh;
-            if (domThresh > kRmsThresh) {
-                for (unsigned int ch = 0; ch < numOutputChannels && ch < 64u; ++ch) {
-                    if (!isOutputSubwooferChannel(static_cast<int>(ch)) && chMs[ch] >= domThresh)
-                        domMask |= (1ULL << ch);
-                }
-            }
+    void clearPublishedDiagnostics() {
+        mDiagPublished = false;
+        for (auto* m : {&mState.renderActiveMask, &mState.renderDomMask, &mState.renderClusterMask,
+                        &mState.deviceActiveMask, &mState.deviceDomMask, &mState.deviceClusterMask})
+            m->store(0, std::memory_order_relaxed);
+        mState.mainRmsTotal.store(0.0f, std::memory_order_relaxed);
+        mState.subRmsTotal.store(0.0f,  std::memory_order_relaxed);
+    }
 
-            uint64_t prevMask = mState.deviceActiveMask.load(std::memory_order_relaxed);
-            if (mask != prevMask && prevMask != 0) {
-                mState.deviceRelocPrev.store(prevMask, std::memory_order_relaxed);
-                mState.deviceRelocNext.store(mask,     std::memory_order_relaxed);
-                mState.deviceRelocEvent.store(true,    std::memory_order_relaxed);
-            }
-            mState.deviceActiveMask.store(mask, std::memory_order_relaxed);
+    // Publish mask; push a relocation event if it changed (not from 0).
+    void latchRelocation(uint64_t mask, std::atomic<uint64_t>& current,
+                         DiagEventType type, uint64_t frame) {
+        const uint64_t prev = current.load(std::memory_order_relaxed);
+        if (mask != prev && prev != 0) mState.diagEvents.push(type, frame, prev, mask);
+        current.store(mask, std::memory_order_relaxed);
+    }
 
-            uint64_t prevDom = mState.deviceDomMask.load(std::memory_order_relaxed);
-            if (domMask != prevDom && prevDom != 0) {
-                mState.deviceDomRelocPrev.store(prevDom,  std::memory_order_relaxed);
-                mState.deviceDomRelocNext.store(domMask,  std::memory_order_relaxed);
-                mState.deviceDomRelocEvent.store(true,    std::memory_order_relaxed);
-            }
-            mState.deviceDomMask.store(domMask, std::memory_order_relaxed);
-
-            // Top-4 mains cluster — mirrors render-side logic above.
-            {
-                uint64_t clusterMask = 0;
-                uint64_t picked = 0;
-                for (int k = 0; k < 4; ++k) {
-                    float best = kRmsThresh;
-                    int   bestCh = -1;
-                    for (unsigned int ch = 0; ch < numOutputChannels && ch < 64u; ++ch) {
-                        if (isOutputSubwooferChannel(static_cast<int>(ch))) continue;
-                        if (picked & (1ULL << ch)) continue;
-                        if (chMs[ch] > best) { best = chMs[ch]; bestCh = static_cast<int>(ch); }
-                    }
-                    if (bestCh >= 0) { clusterMask |= (1ULL << bestCh); picked = clusterMask; }
-                }
-                uint64_t prevCluster = mState.deviceClusterMask.load(std::memory_order_relaxed);
-                if (prevCluster != 0) {
-                    int overlap = __builtin_popcountll(clusterMask & prevCluster);
-                    if (overlap < 3) {
-                        mState.deviceClusterPrev.store(prevCluster,  std::memory_order_relaxed);
-                        mState.deviceClusterNext.store(clusterMask,  std::memory_order_relaxed);
-                        mState.deviceClusterEvent.store(true,        std::memory_order_relaxed);
-                    }
-                }
-                mState.deviceClusterMask.store(clusterMask, std::memory_order_relaxed);
-            }
+    // Publish the top-4 cluster. A CLUSTER event fires when the new top-4
+    // overlaps the previous by fewer than 3 channels (2+ channels changed)
+    // — a meaningful spatial shift.
+    void latchCluster(uint64_t cluster, std::atomic<uint64_t>& current,
+                      DiagEventType type, uint64_t frame) {
+        const uint64_t prev = current.load(std::memory_order_relaxed);
+        if (prev != 0 && __builtin_popcountll(cluster & prev) < 3) {
+            mState.diagEvents.push(type, frame, prev, cluster);
         }
+        current.store(cluster, std::memory_order_relaxed);
+    }
+
+    // ── Stage profiler ───────────────────────────────────────────────────
+    // Optional. When set, renderBlock() records the Sources, StreamRead,
+    // TrimClamp, Diagnostics and Remap stages into it (owned by the backend).
+    // MAIN THREAD ONLY, before start().
+    void setProfiler(StageProfiler* profiler) { mProfiler = profiler; }
+
+    // ── Layout hot-swap hand-over ─────────────────────────────────────────
+    // AUDIO THREAD, at the block boundary where RealtimeBackend adopts this
+    // (fully initialised, not yet rendering) instance in place of outgoing.
+    // Carries over the per-block bookkeeping that is not layout-dependent —
+    // the profiler sink, the guard-event baseline and the diagnostics
+    // decimation phase — and marks outgoing as retiring so that during the
+    // crossfade only this instance records stages and publishes diagnostics.
+    // Per-source state (onset fade, guard blend, gain cache) starts fresh:
+    // it is keyed to the old speaker set.
+    void takeOver(Spatializer& outgoing) {
+        mProfiler       = outgoing.mProfiler;
+        mGuardCountSeen = outgoing.mGuardCountSeen;
+        mDiagBlock      = outgoing.mDiagBlock;
+        mDiagPublished  = outgoing.mDiagPublished;
+        mPrevFocus      = outgoing.mPrevFocus;
+        outgoing.mProfiler = nullptr;
+        outgoing.mRetiring = true;
     }
 
     // ── Accessors ────────────────────────────────────────────────────────
@@ -1042,8 +791,24 @@ public:
     // ── Phase 7: Output Remap ─────────────────────────────────────────────
     // Call after init() and before the audio stream starts.
     // The OutputRemap object must outlive the Spatializer.
-    // Passing nullptr (the default) restores the identity fast-path.
-    void setRemap(const OutputRemap* remap) { mRemap = remap; }
+    // Passing nullptr restores the layout-derived routing table.
+    void setRemap(const OutputRemap* remap) {
+        mRemap = remap ? remap : &mOutputRouting;
+        buildFinalizeTables();
+    }
+
+    // ── Parallel render workers ───────────────────────────────────────────
+    // startWorkers() spawns one helper thread per render lane beyond lane 0
+    // (no-op when renderThreads = 1). MAIN thread, after init() and before
+    // the audio stream starts. stopWorkers() joins them; MAIN thread, after
+    // the audio stream has stopped. Safe to call more than once.
+    void startWorkers() {
+        if (!mInitialized) return;
+        mWorkerPool.start(static_cast<int>(mLanes.size()));
+    }
+    void stopWorkers() { mWorkerPool.stop(); }
+
+    int numRenderLanes() const { return mWorkerPool.numLanes(); }
 
     // ── Fix 1: Preallocate per-source onset-fade state ────────────────────
     // MUST be called from the MAIN thread after Pose::loadScene() has
@@ -1051,8 +816,9 @@ public:
     // Never call during playback — this method allocates.
     //
     // numSources should equal pose.numSources() (the size of the mPoses
-    // vector).  Using a stable, layout-order index (si in renderBlock())
-    // avoids any string-keyed lookup inside the audio callback.
+    // vector).  si in renderBlock() is the source handle (SourceTable.hpp),
+    // so these slots, the pose and the Streaming buffer are all addressed by
+    // the same integer — no string-keyed lookup inside the audio callback.
     void prepareForSources(size_t numSources) {
         // All sources start "silent" so the very first block always triggers
         // the fade-in ramp regardless of prior state.
@@ -1066,8 +832,27 @@ public:
         mPrevGuardFired.assign(numSources, 0u);
         mPrevWasFastMover.assign(numSources, 0u);
 
+        // Source culling — per-source gain cache, empty until first render.
+        mGainCache.assign(numSources, GainCacheEntry{});
+        mCachedGains.assign(numSources * static_cast<size_t>(mNumSpeakers), 0.0f);
+        mCachedIdx.assign(numSources * static_cast<size_t>(mSparseK), 0);
+
         std::cout << "[Spatializer] prepareForSources: " << numSources
-                  << " per-source state slots allocated (onset-fade + guard-blend)." << std::endl;
+                  << " per-source state slots allocated (onset-fade + guard-blend + gain cache)." << std::endl;
+    }
+
+    // ── Seek: drop block-to-block continuity state ────────────────────────
+    // AUDIO THREAD ONLY, between blocks (RealtimeBackend, when a seek lands).
+    // After a transport jump the previous block's position is unrelated to
+    // the next one, so the guard blend must not interpolate from it, and
+    // every source restarts with its onset fade-in. No allocation — only
+    // the slots sized by prepareForSources() are rewritten. The gain cache
+    // is keyed by position and stays valid.
+    void resetSourceContinuity() {
+        std::fill(mSourceWasSilent.begin(), mSourceWasSilent.end(), uint8_t(1));
+        std::fill(mPrevSafeValid.begin(),   mPrevSafeValid.end(),   uint8_t(0));
+        std::fill(mPrevGuardFired.begin(),  mPrevGuardFired.end(),  uint8_t(0));
+        std::fill(mPrevWasFastMover.begin(), mPrevWasFastMover.end(), uint8_t(0));
     }
 
     // ── Phase 6: Focus auto-compensation ─────────────────────────────────
@@ -1104,8 +889,516 @@ public:
 
 private:
 
+    // ── Worker lane entry points ─────────────────────────────────────────
+    // renderLaneThunk() adapts RenderWorkerPool's C-style job signature.
+    // renderLane() renders every source assigned to one lane into that lane's
+    // bus. Runs on the AUDIO thread (lane 0) or a pool helper (lanes ≥ 1).
+
+    static void renderLaneThunk(void* ctx, int laneIdx) {
+        static_cast<Spatializer*>(ctx)->renderLane(laneIdx);
+    }
+
+    void renderLane(int laneIdx) {
+        RenderLane& lane = *mLanes[laneIdx];
+        // A partial bus is zero outside the range written last block.
+        if (laneIdx > 0) {
+            for (int ch = lane.touchLo; ch < lane.touchHi; ++ch)
+                std::memset(lane.partialBus.outBuffer(ch), 0,
+                            lane.partialBus.framesPerBuffer() * sizeof(float));
+        }
+        lane.touchLo = std::numeric_limits<int>::max();
+        lane.touchHi = 0;
+        lane.streamTicks = 0;
+        const std::vector<SourcePose>& poses = *mJob.poses;
+        const size_t stride = static_cast<size_t>(mWorkerPool.numLanes());
+        for (size_t si = static_cast<size_t>(laneIdx); si < poses.size(); si += stride)
+            renderSource(si, poses[si], lane);
+    }
+
+    // ── Render one source into a lane's bus ──────────────────────────────
+    // Reads audio via Streaming::getBlock(), applies onset fade + master gain,
+    // then routes LFE to the subwoofer channels or runs the proximity guard,
+    // DBAP gain stage and gain-matrix mix into the speaker channels.
+    // Only lane-local buffers and source-si state are written, so distinct
+    // sources may be rendered concurrently on different lanes.
+
+    void renderSource(size_t si, const SourcePose& pose, RenderLane& lane) {
+        Streaming&         streaming    = *mJob.streaming;
+        const unsigned int numFrames    = mJob.numFrames;
+        const float        masterGain   = mJob.masterGain;
+        const float        focus        = mJob.focus;
+        al::AudioIOData&   bus          = *lane.bus;
+        float*             sourceBuf    = lane.sourceBuffer.data();
+        const unsigned int renderChannels = mRenderIO.channelsOut();
+
+        // Skip sources with no valid position
+        if (!pose.isValid) return;
+
+        // Silence-mapped block (Streaming::markSilentBlocks()): all zeros,
+        // and the stream was already stepped past it. Same outcome as the
+        // energy gates below — silent flag set, DBAP guard anchor cleared —
+        // reached without reading or summing a sample.
+        if (pose.isSilent) {
+            if (pose.isLFE && mLfeChannels.empty()) return;
+            if (si < mSourceWasSilent.size()) {
+                mSourceWasSilent[si] = 1u;
+                if (!pose.isLFE) {
+                    mPrevSafeValid[si]  = 0u;
+                    mPrevGuardFired[si] = 0u;
+                }
+            }
+            return;
+        }
+
+        // ── LFE routing (no spatialization) ──────────────────────────
+        // Adapted from SpatialRenderer::renderPerBlock() lines 1018-1028
+        // subGain = masterGain * 0.95 / numSubwoofers
+        // LFE writes into the render buffer (same as non-LFE).
+        // The remap step will later handle routing to physical outputs.
+        if (pose.isLFE) {
+            if (mLfeChannels.empty()) return;
+
+            // Read LFE audio into pre-allocated buffer
+            readSourceBlock(streaming, pose, lane);
+
+            // Fix 1 — Onset fade (LFE path)
+            // Detect whether this block has meaningful signal energy.
+            // If the previous block was silent and this one is active,
+            // ramp the first kOnsetFadeSamples samples from 0→1 to
+            // suppress the step-from-zero low-end pop at source onset.
+            if (si < mSourceWasSilent.size()) {
+                float energy = 0.0f;
+                for (unsigned int f = 0; f < numFrames; ++f)
+                    energy += sourceBuf[f] * sourceBuf[f];
+                const bool currentlyActive = (energy > kOnsetEnergyThreshold);
+                if (mSourceWasSilent[si] && currentlyActive) {
+                    const unsigned int fadeEnd =
+                        std::min(kOnsetFadeSamples, numFrames);
+                    for (unsigned int f = 0; f < fadeEnd; ++f)
+                        sourceBuf[f] *=
+                            static_cast<float>(f) / static_cast<float>(fadeEnd);
+                }
+                mSourceWasSilent[si] = currentlyActive ? 0u : 1u;
+                if (!currentlyActive) return;  // silent block — nothing to route
+            }
+
+            float subGain = (masterGain * kSubCompensation)
+                            / static_cast<float>(mSubwooferInternalChannels.size());
+
+            // Cluster partition: layout-wide sub count above, owned subs here.
+            for (int subCh : mLfeChannels) {
+                // Bounds check against internal render buffer
+                if (static_cast<unsigned int>(subCh) >= renderChannels) continue;
+
+                lane.touch(subCh);
+                float* out = bus.outBuffer(subCh);
+                for (unsigned int f = 0; f < numFrames; ++f) {
+                    out[f] += sourceBuf[f] * subGain;
+                }
+            }
+            return;
+        }
+
+        // ── DBAP spatialization ──────────────────────────────────────
+        // A cluster node that owns only subwoofers has nothing to mix.
+        if (mMixSpeakers.empty()) return;
+
+        // Read mono audio from streaming agent
+        readSourceBlock(streaming, pose, lane);
+        // Fix 1 — Onset fade (DBAP path)
+        // Same gate-and-ramp logic as the LFE path above.
+        // Applied before the master-gain multiply so the ramp is not
+        // scaled twice and does not affect the proximity guard below.
+        if (si < mSourceWasSilent.size()) {
+            float energy = 0.0f;
+            for (unsigned int f = 0; f < numFrames; ++f)
+                energy += sourceBuf[f] * sourceBuf[f];
+            const bool currentlyActive = (energy > kOnsetEnergyThreshold);
+            if (mSourceWasSilent[si] && currentlyActive) {
+                const unsigned int fadeEnd =
+                    std::min(kOnsetFadeSamples, numFrames);
+                for (unsigned int f = 0; f < fadeEnd; ++f)
+                    sourceBuf[f] *=
+                        static_cast<float>(f) / static_cast<float>(fadeEnd);
+            }
+            mSourceWasSilent[si] = currentlyActive ? 0u : 1u;
+
+            // ── Source culling: silent block ─────────────────────────
+            // Below the onset gate (≈ −127 dBFS RMS) the block contributes
+            // nothing audible, so the guard, the fast-mover test and the
+            // gain computation are skipped entirely. Nothing was heard, so
+            // there is no gain continuity to preserve into the next block:
+            // clear the guard-blend anchor (the next active block is onset-
+            // faded from zero anyway). The gain cache is left intact.
+            if (!currentlyActive) {
+                mPrevSafeValid[si]  = 0u;
+                mPrevGuardFired[si] = 0u;
+                return;
+            }
+        }
+        // Apply master gain to the source buffer before DBAP.
+        for (unsigned int f = 0; f < numFrames; ++f) {
+            sourceBuf[f] *= masterGain;
+        }
+
+        // Phase 13: per-speaker proximity guard (geometrically exact).
+        //
+        // COORDINATE SPACE:
+        //   DBAP transforms the source position internally:
+        //     relpos = Vec3d(pos.x, -pos.z, pos.y)
+        //   Speaker vectors mSpeakerVecs[k] = speaker.vec() are in audio-space
+        //   Cartesian (y-forward, x-right, z-up). Distances are computed as:
+        //     dist = |relpos - mSpeakerVecs[k]|
+        //
+        //   Our mSpeakerPositions[] cache stores speaker.vec() exactly.
+        //   We apply the same flip to pose.position to get relpos, guard in
+        //   that space, then un-flip back to pose space (the space
+        //   computeDbapGains() and mPrevSafePos use).
+        //
+        //   Forward flip  (pose space → DBAP-internal):  (x,y,z) → (x,-z,y)
+        //   Inverse flip  (DBAP-internal → pose space):  (x,y,z) → (x,z,-y)
+        //   (Both are their own inverse — one application undoes the other.)
+        //
+        // THRESHOLD: 0.15 m. Worst observed case is source 21.1 at 0.049 m
+        // from speaker ch15 at t=47.79 s. 0.15 m gives comfortable clearance
+        // without over-constraining trajectory freedom near speakers.
+
+        // ── Source culling: static position ──────────────────────────
+        // The guard and the DBAP gains are pure functions of pose.position
+        // (and focus), so a source that has not moved since its cache entry
+        // was written reuses the cached guard result — and, when focus is
+        // also unchanged, the cached gain row — bit-for-bit.
+        GainCacheEntry* cache = (si < mGainCache.size()) ? &mGainCache[si] : nullptr;
+        const bool posHit  = cache && cache->valid && cache->pos == pose.position;
+        const bool gainHit = posHit && cache->focus == focus;
+
+        al::Vec3f safePos;
+        bool      guardFiredForSource;
+        if (posHit) {
+            safePos             = cache->safePos;
+            guardFiredForSource = cache->guardFired != 0;
+        } else {
+            // Step 1: transform pose.position into DBAP-internal space
+            const al::Vec3f& p = pose.position;
+            al::Vec3f relpos(p.x, -p.z, p.y);  // same flip DBAP applies internally
+
+            // Step 2: guard in DBAP-internal space (exact geometry)
+            guardFiredForSource = applyProximityGuard(relpos);
+
+            // Step 3: un-flip back to pose space for computeDbapGains()
+            // computeDbapGains() re-applies (x,y,z)→(x,-z,y) internally,
+            // recovering the guarded relpos we just computed.
+            safePos = al::Vec3f(relpos.x, relpos.z, -relpos.y);
+        }
+        if (guardFiredForSource) {
+            mState.speakerProximityCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Fix 2 — Fast-mover sub-stepping.
+        //
+        // Detect whether this source moves more than kFastMoverAngleRad
+        // (~14.3°) between block start and block end. If so, split the
+        // block into kNumSubSteps equal segments and evaluate an
+        // independently guarded, renormalised gain vector at every segment
+        // boundary. The mix stage interpolates gains linearly inside each
+        // segment, converting a block-boundary DBAP gain step into a smooth
+        // within-block gain ramp, eliminating the pop at guard-entry and
+        // large-motion block boundaries.
+        //
+        // For static or slow-moving sources the normal single-position
+        // path is taken: one gain vector, one constant-gain mix pass.
+        //
+        // GAIN TABLE LAYOUT (mGainTable, row-major, mNumSpeakers per row):
+        //   normal path:       row 0 = g(safePos)                  (1 row)
+        //   guard blend:       row 0 = g(mPrevSafePos), row 1 = g(safePos)
+        //   fast-mover path:   row j = g(breakpoint j), j = 0..kNumSubSteps
+        // numSegments rows + 1 are interpolated; numSegments == 0 marks the
+        // constant-gain case.
+        {
+            // Angular span of this block in DBAP position space.
+            // positionStart / positionEnd are at mLayoutRadius; normalising
+            // projects to unit sphere for the angle comparison.
+            // A source that is static across the block skips the acos.
+            bool isFastMover = false;
+            if (!(pose.positionStart == pose.positionEnd)) {
+                al::Vec3f d0 = pose.positionStart.normalized();
+                al::Vec3f d1 = pose.positionEnd.normalized();
+                float dotVal     = std::clamp(d0.dot(d1), -1.0f, 1.0f);
+                float angleDelta = std::acos(dotVal);
+                isFastMover = (angleDelta > kFastMoverAngleRad);
+            }
+
+            int  numSegments = 0;     // 0 = constant gains (row 0 only)
+            bool audible     = false; // false = every row hit the maxW underflow guard
+
+            if (!isFastMover) {
+                // ── Normal path ───────────────────────────────────────
+                // Bug 9.1 — cross-block guard-transition continuity.
+                // When Pass 2 fired this block or last block, ramp from
+                // the gains of the guard-resolved position from last block
+                // (mPrevSafePos) to the gains of safePos across the block.
+                // Eliminates the ~23% DBAP gain step at block boundaries
+                // when a source enters or exits the hard-floor zone.
+                //
+                // doBlend activates only when a guard transition is detected
+                // (current or prior block fired Pass 2) AND a valid prior
+                // position exists.  Both conditions required to avoid
+                // stale-data artefacts on the very first block.
+                const bool doBlend = (si < mPrevSafePos.size())
+                    && mPrevSafeValid[si]
+                    && (guardFiredForSource || mPrevGuardFired[si]);
+
+                // Row holding g(safePos): 1 when blending, else 0.
+                const int rowIdx = doBlend ? 1 : 0;
+                if (doBlend) {
+                    audible |= computeRowGains(mPrevSafePos[si], focus, lane, 0);
+                    numSegments = 1;
+                }
+                if (gainHit) {
+                    std::copy(cachedGains(si), cachedGains(si) + mNumSpeakers,
+                              lane.gainRow(rowIdx));
+                    if (mSparseK > 0) {
+                        std::copy(cachedIdx(si), cachedIdx(si) + cache->activeCount,
+                                  lane.activeRow(rowIdx));
+                        lane.activeCount[rowIdx] = cache->activeCount;
+                    }
+                    audible |= (cache->audible != 0);
+                } else {
+                    // Normal single-position render (or blend target row).
+                    const bool rowAudible = computeRowGains(safePos, focus, lane, rowIdx);
+                    audible |= rowAudible;
+                    if (cache) {
+                        cache->pos        = pose.position;
+                        cache->safePos    = safePos;
+                        cache->focus      = focus;
+                        cache->guardFired = guardFiredForSource ? 1u : 0u;
+                        cache->audible    = rowAudible ? 1u : 0u;
+                        cache->valid      = 1u;
+                        std::copy(lane.gainRow(rowIdx), lane.gainRow(rowIdx) + mNumSpeakers,
+                                  cachedGains(si));
+                        if (mSparseK > 0) {
+                            cache->activeCount = lane.activeCount[rowIdx];
+                            std::copy(lane.activeRow(rowIdx),
+                                      lane.activeRow(rowIdx) + lane.activeCount[rowIdx],
+                                      cachedIdx(si));
+                        }
+                    }
+                }
+            } else {
+                // ── Fast-mover path ───────────────────────────────────
+                // Evaluate kNumSubSteps + 1 breakpoints at alpha = j / K,
+                // each at a lerp'd position that is renormalised to the
+                // layout-radius sphere, then guarded.
+                //
+                // Bug 10 (normalized DBAP): track the block-end guarded
+                // position so the state update below can write an accurate
+                // continuity anchor (mPrevSafePos) for the next block.
+                // Under normalized DBAP the gain function is sensitive to the
+                // normalization basin boundary, so the block-center safePos
+                // could represent a 4× different gain state from what the
+                // ear actually heard at the end of this block.
+                al::Vec3f lastSubSafePos = safePos;  // fallback: block-center
+
+                for (int j = 0; j <= kNumSubSteps; ++j) {
+                    // Breakpoint interpolation weight (0, 0.25, 0.5, 0.75, 1)
+                    float alpha = static_cast<float>(j)
+                                  / static_cast<float>(kNumSubSteps);
+
+                    // Lerp in pose space (chord interpolation)
+                    al::Vec3f subPose = pose.positionStart
+                                        + alpha * (pose.positionEnd - pose.positionStart);
+
+                    // Renormalise back to layout-radius sphere.
+                    // The chord midpoint falls slightly inside the sphere;
+                    // scaling by mLayoutRadius / mag restores the correct radius.
+                    {
+                        float mag = subPose.mag();
+                        if (mag > 1e-7f) subPose = (subPose / mag) * mLayoutRadius;
+                    }
+
+                    // Flip to DBAP-internal space, apply two-pass guard, un-flip
+                    al::Vec3f subRelpos(subPose.x, -subPose.z, subPose.y);
+                    applyProximityGuard(subRelpos);
+                    al::Vec3f subSafePos(subRelpos.x, subRelpos.z, -subRelpos.y);
+
+                    if (j == kNumSubSteps) lastSubSafePos = subSafePos;
+
+                    audible |= computeRowGains(subSafePos, focus, lane, j);
+                }
+                numSegments = kNumSubSteps;
+
+                // Write corrected anchor for next block's doBlend.
+                // mPrevGuardFired is cleared: block-center guard state is
+                // irrelevant for fast-mover blocks and must not trigger a
+                // doBlend anchored to the wrong position on the next block.
+                if (si < mPrevSafePos.size()) {
+                    mPrevSafePos[si]      = lastSubSafePos;
+                    mPrevSafeValid[si]    = 1u;
+                    mPrevGuardFired[si]   = 0u;
+                    mPrevWasFastMover[si] = 1u;
+                }
+            }
+
+            // ── Gain-matrix mix ───────────────────────────────────────
+            // One pass per speaker channel over the source block. Segment
+            // j spans frames [j·N/S, (j+1)·N/S) and ramps row j → row j+1,
+            // so every frame of the block is covered for any N (the old
+            // numFrames / kNumSubSteps sub-chunks dropped the remainder).
+            //
+            // Sparse mode walks only each row's active speakers. Dropped
+            // entries are zero in the dense rows, so a segment covers the
+            // union of rows j and j+1: row j's speakers ramp to row j+1's
+            // gain (0 if it dropped out), then row j+1's newcomers ramp up
+            // from 0.
+            //
+            // Either way only this node's speakers (mMixSpeakers; every
+            // speaker unless cluster-partitioned) are mixed.
+            if (audible && mSparseK > 0) {
+                mixSparse(lane, sourceBuf, numSegments, numFrames);
+            } else if (audible) {
+                const float* src = sourceBuf;
+                lane.touch(mMixSpeakers.front());
+                lane.touch(mMixSpeakers.back());
+                for (int k : mMixSpeakers) {
+                    float* dst = bus.outBuffer(k);
+                    if (numSegments == 0) {
+                        const float g = lane.gainRow(0)[k];
+                        if (g != 0.0f) mixGainConstant(dst, src, g, numFrames);
+                        continue;
+                    }
+                    for (int j = 0; j < numSegments; ++j) {
+                        const unsigned int f0 = (static_cast<unsigned int>(j) * numFrames)
+                                                / static_cast<unsigned int>(numSegments);
+                        const unsigned int f1 = (static_cast<unsigned int>(j + 1) * numFrames)
+                                                / static_cast<unsigned int>(numSegments);
+                        const float ga = lane.gainRow(j)[k];
+                        const float gb = lane.gainRow(j + 1)[k];
+                        if (ga == 0.0f && gb == 0.0f) continue;
+                        mixGainRamp(dst + f0, src + f0, ga, gb, f1 - f0);
+                    }
+                }
+            }
+
+            // Bug 9.1 — update guard-transition blending state for next block.
+            // Fast-mover blocks write their own state (lastSubSafePos as anchor,
+            // mPrevGuardFired=0, mPrevWasFastMover=1) inside the fast-mover
+            // branch above. Only the normal path writes here.
+            if (!isFastMover && si < mPrevSafePos.size()) {
+                mPrevSafePos[si]      = safePos;
+                mPrevSafeValid[si]    = 1u;
+                mPrevGuardFired[si]   = guardFiredForSource ? 1u : 0u;
+                mPrevWasFastMover[si] = 0u;
+            }
+        }
+    }
+
     // ── Small helpers ─────────────────────────────────────────────────────
 
+    // Streaming::getBlock() into the lane's source buffer, timed into the
+    // lane's StreamRead accumulator when profiling.
+    void readSourceBlock(Streaming& streaming, const SourcePose& pose, RenderLane& lane) {
+        if (!mJob.profiling) {
+            streaming.getBlock(pose.handle, mJob.currentFrame, mJob.numFrames,
+                               lane.sourceBuffer.data());
+            return;
+        }
+        const uint64_t t0 = StageProfiler::now();
+        streaming.getBlock(pose.handle, mJob.currentFrame, mJob.numFrames,
+                           lane.sourceBuffer.data());
+        lane.streamTicks += StageProfiler::now() - t0;
+    }
+
+    // DBAP gains for one gain-table row, truncated to the row's top-K
+    // speakers in sparse mode.
+    bool computeRowGains(const al::Vec3f& pos, float focus, RenderLane& lane, int row) const {
+        float* out = lane.gainRow(row);
+        const bool audible = computeDbapGains(pos, focus, out);
+        if (mSparseK > 0) {
+            lane.activeCount[row] = audible ? sparsifyGains(out, lane.activeRow(row)) : 0;
+            if (mPartitioned) {
+                // Keep the owned speakers of the layout-wide top K (not
+                // renormalized: the other nodes play the rest).
+                int* idx = lane.activeRow(row);
+                int kept = 0;
+                for (int i = 0; i < lane.activeCount[row]; ++i)
+                    if (mMixSpeakerMask[idx[i]]) idx[kept++] = idx[i];
+                lane.activeCount[row] = kept;
+            }
+        }
+        return audible;
+    }
+
+    // Sparse mode: keep the mSparseK largest gains that are also at least
+    // kSparseGainFloor × the largest, zero the rest, and rescale the kept
+    // ones so Σ g² = 1 again (computeDbapGains() output is unit-power, so
+    // the truncated vector carries the same energy — loudness is preserved).
+    // Writes the kept speaker indices into idx; returns how many.
+    // O(numSpeakers · K) with K small; no allocation.
+    int sparsifyGains(float* g, int* idx) const {
+        float gMax = 0.0f;
+        for (int k = 0; k < mNumSpeakers; ++k) gMax = std::max(gMax, g[k]);
+        const float floor = gMax * kSparseGainFloor;
+
+        // idx[0..count) sorted by descending gain (insertion into K slots).
+        int count = 0;
+        for (int k = 0; k < mNumSpeakers; ++k) {
+            const float v = g[k];
+            if (v < floor) continue;
+            if (count == mSparseK && v <= g[idx[count - 1]]) continue;
+            int pos = (count < mSparseK) ? count++ : count - 1;
+            while (pos > 0 && g[idx[pos - 1]] < v) { idx[pos] = idx[pos - 1]; --pos; }
+            idx[pos] = k;
+        }
+
+        float kept[kMaxSparseK];
+        float sumSq = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            kept[i] = g[idx[i]];
+            sumSq  += kept[i] * kept[i];
+        }
+        std::fill(g, g + mNumSpeakers, 0.0f);
+        const float scale = (sumSq > 0.0f) ? 1.0f / std::sqrt(sumSq) : 0.0f;
+        for (int i = 0; i < count; ++i) g[idx[i]] = kept[i] * scale;
+        return count;
+    }
+
+    // Sparse gain-matrix mix: same segment schedule as the dense loop in
+    // renderSource(), over each row's active speakers only.
+    void mixSparse(RenderLane& lane, const float* src, int numSegments,
+                   unsigned int numFrames) {
+        al::AudioIOData& bus = *lane.bus;
+        if (numSegments == 0) {
+            const float* g   = lane.gainRow(0);
+            const int*   idx = lane.activeRow(0);
+            for (int i = 0; i < lane.activeCount[0]; ++i) {
+                lane.touch(idx[i]);
+                mixGainConstant(bus.outBuffer(idx[i]), src, g[idx[i]], numFrames);
+            }
+            return;
+        }
+        for (int j = 0; j < numSegments; ++j) {
+            const unsigned int f0 = (static_cast<unsigned int>(j) * numFrames)
+                                    / static_cast<unsigned int>(numSegments);
+            const unsigned int f1 = (static_cast<unsigned int>(j + 1) * numFrames)
+                                    / static_cast<unsigned int>(numSegments);
+            const float* ga = lane.gainRow(j);
+            const float* gb = lane.gainRow(j + 1);
+            const int*   ia = lane.activeRow(j);
+            const int*   ib = lane.activeRow(j + 1);
+            for (int i = 0; i < lane.activeCount[j]; ++i) {
+                const int k = ia[i];
+                lane.touch(k);
+                mixGainRamp(bus.outBuffer(k) + f0, src + f0, ga[k], gb[k], f1 - f0);
+            }
+            for (int i = 0; i < lane.activeCount[j + 1]; ++i) {
+                const int k = ib[i];
+                if (ga[k] != 0.0f) continue;   // already ramped above
+                lane.touch(k);
+                mixGainRamp(bus.outBuffer(k) + f0, src + f0, 0.0f, gb[k], f1 - f0);
+            }
+        }
+    }
+
     // Internal-space: ch is in 0..internalChannelCount-1.
     // Used by Phase 6 mix-trim and Phase 14 render-bus diagnostic.
     bool isInternalSubwooferChannel(int ch) const {
@@ -1122,7 +1415,167 @@ private:
         return false;
     }
 
+    // ── Fused output finalize (renderBlock() Phases 6 + 11 + 7) ──────────
+    // Writes every channel of io: routed channels through finalizeChannel(),
+    // the rest cleared. With diag, fills mChannelMs[internal ch] (mean
+    // square after trim + scrub, before outputRamp). Returns true if the
+    // scrub fired. AUDIO thread; no allocation.
+    bool finalizeOutput(al::AudioIOData& io, unsigned int numFrames,
+                        const ControlsSnapshot& ctrl, bool diag) {
+        const unsigned int renderChannels    = mRenderIO.channelsOut();
+        const unsigned int numOutputChannels = io.channelsOut();
+        const float invFrames = numFrames > 0 ? 1.0f / static_cast<float>(numFrames) : 0.0f;
+        bool fired = false;
+
+        auto finalize = [&](unsigned int ch, float* dst) {
+            const float g = mInternalIsSub[ch] ? ctrl.subMix : ctrl.loudspeakerMix;
+            float sumSq = 0.0f;
+            fired |= finalizeChannel(dst, mRenderIO.outBuffer(ch), g, ctrl.outputRamp,
+                                     kMaxSample, numFrames, diag ? &sumSq : nullptr);
+            if (diag) mChannelMs[ch] = sumSq * invFrames;
+        };
+
+        if (mRemap->identity()) {
+            // outputChannelCount == internalChannelCount by invariant; a device
+            // opened wider (--output_channels) leaves the extra channels silent.
+            for (unsigned int ch = 0; ch < renderChannels; ++ch)
+                finalize(ch, io.outBuffer(ch));
+            for (unsigned int ch = renderChannels; ch < numOutputChannels; ++ch)
+                std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
+            return fired;
+        }
+
+        // Scatter routing. One-to-one for layout-derived tables; a legacy CSV
+        // may fan one internal channel out (finalized once per target) or
+        // name a device twice (last entry wins, as with the old copy).
+        for (const auto& entry : mRemap->entries()) {
+            // Post-validation last-resort guards. Should never fire.
+            if (static_cast<unsigned int>(entry.layout) >= renderChannels)   continue;
+            if (static_cast<unsigned int>(entry.device) >= numOutputChannels) continue;
+            finalize(static_cast<unsigned int>(entry.layout), io.outBuffer(entry.device));
+        }
+        for (unsigned int ch = 0; ch < numOutputChannels; ++ch) {
+            if (ch >= mDeviceSource.size() || mDeviceSource[ch] < 0)
+                std::memset(io.outBuffer(ch), 0, numFrames * sizeof(float));
+        }
+        if (diag) {
+            // Unrouted internal channels still feed the render-bus analysis
+            // (trim applied; the scrub only matters for what reaches a device).
+            for (unsigned int ch = 0; ch < renderChannels; ++ch) {
+                if (mInternalRouted[ch]) continue;
+                const float g = mInternalIsSub[ch] ? ctrl.subMix : ctrl.loudspeakerMix;
+                mChannelMs[ch] = sumSquares(mRenderIO.outBuffer(ch), numFrames) * g * g * invFrames;
+            }
+        }
+        return fired;
+    }
+
+    // Rebuild the per-channel tables finalizeOutput() and the device-bus
+    // analysis read: trim selection and routed flag per internal channel,
+    // and the internal channel feeding each device channel (-1 = none).
+    // MAIN thread, from init() / setRemap().
+    void buildFinalizeTables() {
+        const int renderChannels = static_cast<int>(mRenderIO.channelsOut());
+        mChannelMs.assign(renderChannels, 0.0f);
+        mInternalIsSub.assign(renderChannels, 0);
+        mInternalRouted.assign(renderChannels, 0);
+        for (int ch = 0; ch < renderChannels; ++ch)
+            mInternalIsSub[ch] = isInternalSubwooferChannel(ch) ? 1 : 0;
+
+        mDeviceSource.clear();
+        if (mRemap->identity()) {
+            for (int ch = 0; ch < renderChannels; ++ch) {
+                mDeviceSource.push_back(ch);
+                mInternalRouted[ch] = 1;
+            }
+            return;
+        }
+        mDeviceSource.assign(static_cast<size_t>(std::max(0, mRemap->maxDeviceIndex() + 1)), -1);
+        for (const auto& e : mRemap->entries()) {
+            if (e.layout < 0 || e.layout >= renderChannels) continue;
+            if (e.device < 0 || e.device >= static_cast<int>(mDeviceSource.size())) continue;
+            mDeviceSource[e.device] = e.layout;
+            mInternalRouted[e.layout] = 1;
+        }
+    }
+
+    // Phase 13 proximity guard, applied in place to a DBAP-internal position.
+    // Pass 1 — soft outer zone (single scan, no convergence loop).
+    //   For sources in (kMinSpeakerDist, kGuardSoftZone), applies a smooth
+    //   outward bias: zero effect at both zone boundaries, positive outward
+    //   displacement in between. Prevents the hard-snap DBAP cluster change
+    //   that occurred when sources crossed kMinSpeakerDist.
+    // Pass 2 — hard inner floor with convergence loop.
+    //   Catches any source still inside kMinSpeakerDist after Pass 1.
+    // Returns true if Pass 2 fired (used for speakerProximityCount and the
+    // Bug 9.1 guard-transition blend).
+    bool applyProximityGuard(al::Vec3f& relpos) const {
+        for (const auto& spkVec : mSpeakerPositions) {
+            al::Vec3f delta = relpos - spkVec;
+            float dist = delta.mag();
+            if (dist > kMinSpeakerDist && dist < kGuardSoftZone && dist > 1e-7f) {
+                float u    = (dist - kMinSpeakerDist) / (kGuardSoftZone - kMinSpeakerDist);
+                float push = (kGuardSoftZone - kMinSpeakerDist) * u * (1.0f - u);
+                relpos = spkVec + (delta / dist) * (dist + push);
+            }
+        }
+        bool fired = false;
+        for (int iter = 0; iter < kGuardMaxIter; ++iter) {
+            bool pushed = false;
+            for (const auto& spkVec : mSpeakerPositions) {
+                al::Vec3f delta = relpos - spkVec;
+                float dist = delta.mag();
+                if (dist < kMinSpeakerDist) {
+                    relpos = spkVec + ((dist > 1e-7f)
+                        ? (delta / dist) * kMinSpeakerDist
+                        : al::Vec3f(0.0f, kMinSpeakerDist, 0.0f));
+                    pushed = true;
+                }
+            }
+            if (!pushed) break;
+            fired = true;
+        }
+        return fired;
+    }
+
+    // Normalized DBAP gain vector for one pose-space position.
+    // Mirrors al::Dbap::renderBuffer() exactly (internalDocs/DBAP/dbapMath.md):
+    //   relpos = (pos.x, -pos.z, pos.y)
+    //   w_k    = (1 / (1 + |relpos - speakerVec_k|)) ^ focus
+    //   maxW   = max_k w_k          (maxW < 1e-6 → silence)
+    //   sumSq  = Σ (w_k / maxW)²
+    //   v_k    = w_k / (maxW · sqrt(sumSq))      → Σ v_k² = 1
+    // Writes mNumSpeakers gains into out. Returns false (and zero gains) when
+    // the underflow guard fires. Any change to the DBAP math must land in
+    // cult-allolib and here together.
+    bool computeDbapGains(const al::Vec3f& pos, float focus, float* out) const {
+        const al::Vec3f relpos(pos.x, -pos.z, pos.y);
+        float maxW = 0.0f;
+        for (int k = 0; k < mNumSpeakers; ++k) {
+            const float dist = (relpos - mSpeakerPositions[k]).mag();
+            const float w    = std::pow(1.0f / (1.0f + dist), focus);
+            out[k] = w;
+            if (w > maxW) maxW = w;
+        }
+        if (maxW < 1e-6f) {
+            std::fill(out, out + mNumSpeakers, 0.0f);
+            return false;
+        }
+        const float invMax = 1.0f / maxW;
+        float sumSq = 0.0f;
+        for (int k = 0; k < mNumSpeakers; ++k) {
+            const float r = out[k] * invMax;
+            sumSq += r * r;
+        }
+        const float kNorm = 1.0f / (maxW * std::sqrt(sumSq));
+        for (int k = 0; k < mNumSpeakers; ++k) out[k] *= kNorm;
+        return true;
+    }
+
     // ── Constants ────────────────────────────────────────────────────────
+    // Minimum DBAP focus — same clamp as al::Dbap::setFocus() (dbapMath.md §4).
+    static constexpr float kMinFocus = 0.1f;
+
     // LFE/subwoofer compensation factor (same as offline renderer).
     // TODO: Make configurable or derive from DBAP focus setting.
     static constexpr float kSubCompensation = 0.95f;
@@ -1134,7 +1587,7 @@ private:
 
     // Phase 12: minimum source-to-speaker distance in DBAP position space.
     // Sources within this radius of any speaker are pushed outward along the
-    // source→speaker axis before calling renderBuffer(). This replaces the
+    // source→speaker axis before computing DBAP gains. This replaces the
     // Phase 11 origin-distance guard (kMinSourceDist) which was geometrically
     // inert (positions always sit at ~mLayoutRadius from the origin).
     // Start value: 0.15 m — conservative first pass.
@@ -1164,10 +1617,10 @@ private:
     //   positionEnd (block start → end) that triggers sub-stepping. ~14.3°
     //   matches the offline renderer's Q1/Q3 threshold. Sources with smaller
     //   angular motion use the normal single-position path.
-    // kNumSubSteps: number of equal sub-chunks per block when fast-mover is
-    //   detected. 4 × 128 = 512 frames at the default buffer size. Each
-    //   sub-chunk is rendered at the lerp'd + renormalised position for its
-    //   center time, then accumulated into mRenderIO.
+    // kNumSubSteps: number of equal gain-ramp segments per block when a
+    //   fast-mover is detected. 4 × 128 = 512 frames at the default buffer
+    //   size. Gains are evaluated at the kNumSubSteps + 1 segment boundaries
+    //   (lerp'd + renormalised + guarded) and interpolated per frame.
     static constexpr float kFastMoverAngleRad = 0.25f;  // ~14.3°
     static constexpr int   kNumSubSteps       = 4;
 
@@ -1182,6 +1635,16 @@ private:
     static constexpr float        kOnsetEnergyThreshold = 1e-10f;
     static constexpr unsigned int kOnsetFadeSamples     = 128u;
 
+public:
+    // Sparse accumulation constants (RealtimeConfig::sparseTopK).
+    // kSparseGainFloor: speakers below this fraction of the source's
+    //   strongest gain (−60 dB) are dropped even when fewer than K remain.
+    // kMaxSparseK: upper bound on K (size of sparsifyGains()' stack scratch);
+    //   init() clamps larger requests.
+    static constexpr float kSparseGainFloor = 1e-3f;
+    static constexpr int   kMaxSparseK      = 64;
+private:
+
     // ── References ───────────────────────────────────────────────────────
     RealtimeConfig& mConfig;
     EngineState&    mState;
@@ -1196,7 +1659,15 @@ private:
     // Output subwoofer channel values: layout.subwoofers[j].deviceChannel
     std::vector<int>            mSubwooferInternalChannels;
     std::vector<int>            mSubwooferOutputChannels;
+    // Cluster partition (RealtimeConfig::clusterPartition): the speakers this
+    // node mixes (all when not partitioned, ascending), the same as a 0/1
+    // mask, and the internal channels LFE is written to (owned subwoofers).
+    std::vector<int>            mMixSpeakers;
+    std::vector<uint8_t>        mMixSpeakerMask;
+    std::vector<int>            mLfeChannels;
+    bool                        mPartitioned = false;
     float                       mLayoutRadius = 1.0f; // Median speaker radius (for focus compensation ref position)
+    int                         mSparseK = 0;        // Sparse accumulation K (0 = dense); see sparsifyGains()
     bool                        mInitialized = false;
 
     // Phase 12: speaker positions in DBAP coordinate space, cached at init().
@@ -1209,16 +1680,78 @@ private:
     // AUDIO-THREAD-OWNED: only accessed inside renderBlock().
     al::AudioIOData             mRenderIO;
 
-    // Fix 2 — Sub-chunk scratch buffer for fast-mover rendering.
-    // Sized to (bufferSize / kNumSubSteps) frames × outputChannels at init().
-    // Each fast-mover sub-chunk is rendered into this buffer, then accumulated
-    // into mRenderIO at the correct frame offset. Zero-allocation in callback.
-    // AUDIO-THREAD-OWNED after init().
-    al::AudioIOData             mFastMoverScratch;
-
-    // ── Pre-allocated audio buffer (one source at a time) ────────────────
-    // AUDIO-THREAD-OWNED: filled from Streaming::getBlock() inside renderBlock().
-    std::vector<float>          mSourceBuffer;
+    // ── Render lanes (one per render thread) ─────────────────────────────
+    // Lane scratch, sized at init():
+    //   sourceBuffer — one source's mono block, filled from Streaming::getBlock().
+    //   gainTable    — Fix 2 per-source DBAP gain table (replaces the old
+    //                  sub-chunk scratch AudioIOData). (kNumSubSteps + 1) rows
+    //                  × mNumSpeakers gains, rewritten for every source: row 0
+    //                  for the normal path, rows 0–1 for the guard blend,
+    //                  rows 0–kNumSubSteps for fast movers.
+    //   partialBus   — lanes ≥ 1 only: private accumulation bus, summed into
+    //                  mRenderIO in lane order after the join.
+    //   bus          — &mRenderIO for lane 0, &partialBus otherwise.
+    //   touchLo/Hi   — internal channels written this block, [lo, hi); the
+    //                  partial-bus clear and reduction walk only this range.
+    // unique_ptr keeps each lane on its own allocation (no false sharing of
+    // the hot vectors' headers between lanes).
+    struct RenderLane {
+        std::vector<float> sourceBuffer;
+        std::vector<float> gainTable;
+        al::AudioIOData    partialBus;
+        al::AudioIOData*   bus = nullptr;
+        int                numSpeakers = 0;
+        uint64_t           streamTicks = 0;   // profiler: getBlock() time this block
+        int                touchLo = 0;       // empty range until the first write
+        int                touchHi = 0;
+
+        // Sparse mode only: row j's kept speaker indices (sparseK slots per
+        // row, activeCount[j] used). Empty when sparseK == 0.
+        int                sparseK = 0;
+        std::vector<int>   activeIdx;
+        int                activeCount[kNumSubSteps + 1] = {};
+
+        // Row j of this lane's gain table (numSpeakers floats).
+        float* gainRow(int j) {
+            return gainTable.data() + static_cast<size_t>(j) * numSpeakers;
+        }
+        int* activeRow(int j) {
+            return activeIdx.data() + static_cast<size_t>(j) * sparseK;
+        }
+        void touch(int ch) {
+            touchLo = std::min(touchLo, ch);
+            touchHi = std::max(touchHi, ch + 1);
+        }
+    };
+    std::vector<std::unique_ptr<RenderLane>> mLanes;
+
+    // ── Per-block job parameters ─────────────────────────────────────────
+    // Written by renderBlock() before the fork, read by every lane. The
+    // pool's release/acquire generation bump publishes them to helpers.
+    struct BlockJob {
+        Streaming*                     streaming    = nullptr;
+        const std::vector<SourcePose>* poses        = nullptr;
+        uint64_t                       currentFrame = 0;
+        unsigned int                   numFrames    = 0;
+        float                          masterGain   = 1.0f;
+        float                          focus        = 1.0f;
+        bool                           profiling    = false;  // time getBlock() per lane
+    };
+    BlockJob                    mJob;
+
+    // Optional per-stage timing sink (see setProfiler()). Recorded from the
+    // audio thread only; helper lanes accumulate into RenderLane::streamTicks.
+    StageProfiler*              mProfiler = nullptr;
+
+    // Phase 14 diagnostics tier state (audio thread; see diagnosticsDue()).
+    uint32_t                    mDiagBlock     = 0;      // position in the decimation period
+    bool                        mDiagPublished = false;  // masks / meters hold live values
+    uint64_t                    mGuardCountSeen = 0;     // speakerProximityCount at last GuardFire event
+    bool                        mRetiring      = false;  // outgoing side of a layout crossfade (takeOver())
+
+    // Helper threads for lanes 1..N-1. Started by startWorkers() (MAIN
+    // thread, before the audio stream starts); inactive when renderThreads=1.
+    RenderWorkerPool            mWorkerPool;
 
     // ── Phase 7: Output routing table ────────────────────────────────────
     // mOutputRouting: owned layout-derived routing table, built by init().
@@ -1228,6 +1761,13 @@ private:
     OutputRemap                 mOutputRouting;
     const OutputRemap*          mRemap = nullptr;
 
+    // Fused-finalize tables (buildFinalizeTables(); read-only during
+    // playback) and the per-block mean squares (AUDIO thread, diag blocks).
+    std::vector<uint8_t>        mInternalIsSub;    // internal ch → subMix (1) / loudspeakerMix (0)
+    std::vector<uint8_t>        mInternalRouted;   // internal ch reaches some device channel
+    std::vector<int>            mDeviceSource;     // device ch → internal ch (-1 = cleared)
+    std::vector<float>          mChannelMs;        // internal ch → mean square (Phase 14)
+
     // ── Previous block focus (for per-frame interpolation) ───────────────
     // Holds the focus value used at the END of the last renderBlock() call.
     // Used as the interpolation start point for the next block so that a
@@ -1269,4 +1809,34 @@ private:
     std::vector<uint8_t>        mPrevSafeValid;
     std::vector<uint8_t>        mPrevGuardFired;
     std::vector<uint8_t>        mPrevWasFastMover;
+
+    // ── Source culling: per-source gain cache ─────────────────────────────
+    // Indexed by stable pose order (si). An entry is the guard result and the
+    // normalized DBAP gain row last computed for source si, keyed by the exact
+    // pre-guard pose.position and focus it was computed from. Exact float
+    // compares: a hit reproduces computeDbapGains() bit-for-bit, so idle
+    // sources cost one memcpy instead of mNumSpeakers pow() calls.
+    // mCachedGains is row-major, mNumSpeakers floats per source.
+    // Fast-mover blocks neither read nor write the cache.
+    // Allocated once by prepareForSources(). AUDIO-THREAD-OWNED after start();
+    // slot si is written only by the lane rendering source si.
+    struct GainCacheEntry {
+        al::Vec3f pos{0.0f, 0.0f, 0.0f};      // pose.position the entry was computed for
+        al::Vec3f safePos{0.0f, 0.0f, 0.0f};  // guard-resolved position
+        float     focus      = 0.0f;
+        uint8_t   guardFired = 0;
+        uint8_t   audible    = 0;             // computeDbapGains() return value
+        uint8_t   valid      = 0;
+        int       activeCount = 0;            // sparse mode: kept speakers in mCachedIdx
+    };
+    std::vector<GainCacheEntry> mGainCache;
+    std::vector<float>          mCachedGains;
+    std::vector<int>            mCachedIdx;   // sparse mode: mSparseK indices per source
+
+    float* cachedGains(size_t si) {
+        return mCachedGains.data() + si * static_cast<size_t>(mNumSpeakers);
+    }
+    int* cachedIdx(size_t si) {
+        return mCachedIdx.data() + si * static_cast<size_t>(mSparseK);
+    }
 };
@@ -0,0 +1,207 @@
+// StageProfiler.hpp — Lock-free per-stage timing histograms for the audio callback
+//
+// callbackCpuLoad says THAT a block blew its budget; this says WHERE. Each
+// ProfileStage (RealtimeTypes.hpp) gets a log-scale histogram of its duration
+// per block, from which rolling p50 / p99 / max are derived on demand.
+//
+// CLOCK: the CPU timestamp counter — rdtsc on x86, cntvct_el0 on AArch64,
+// steady_clock nanoseconds elsewhere. Two reads per stage per block, no
+// syscalls. Ticks are converted to microseconds only on the reader side,
+// with a tick rate measured against steady_clock since construction (the
+// invariant TSC of any machine we deploy on runs at a constant rate).
+//
+// HISTOGRAM: 4 buckets per octave of ticks (bucket width ≤ 19%), 160 buckets
+// covering up to 2^41 ticks. Percentiles report the bucket's upper edge, so
+// they are conservative by at most one bucket.
+//
+// ROLLING WINDOW: two banks of histograms. The audio thread records into the
+// active bank; every kWindowBlocks blocks it flips to the other bank and
+// clears it first. Readers merge both banks, so a snapshot always covers the
+// last kWindowBlocks .. 2 × kWindowBlocks blocks (≈ 5–11 s at 512 / 48 kHz).
+//
+// THREADING: record() / lap() / endBlock() from ONE writer thread (AUDIO) —
+// helper render lanes never call in; their StreamRead time is summed by the
+// Spatializer and recorded from the audio thread. snapshot() from any thread.
+// All shared counters are relaxed atomics: a reader racing a bank flip sees a
+// slightly short window, never a torn value.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#  define SR_PROFILER_TSC_X86 1
+#elif defined(__aarch64__)
+#  define SR_PROFILER_TSC_ARM64 1
+#endif
+
+#include "RealtimeTypes.hpp"   // ProfileStage, StageTiming
+
+class StageProfiler {
+public:
+
+    static constexpr int      kBuckets      = 160;
+    static constexpr uint32_t kWindowBlocks = 512;
+
+    StageProfiler() { clear(); }
+
+    StageProfiler(const StageProfiler&) = delete;
+    StageProfiler& operator=(const StageProfiler&) = delete;
+
+    // ── Clock ────────────────────────────────────────────────────────────
+
+    static uint64_t now() {
+#if defined(SR_PROFILER_TSC_X86)
+        return static_cast<uint64_t>(__rdtsc());
+#elif defined(SR_PROFILER_TSC_ARM64)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // ── Writer side (AUDIO thread) ───────────────────────────────────────
+
+    /// Add one sample of ticks to stage s in the active bank.
+    void record(ProfileStage s, uint64_t ticks) {
+        Bank& b = mBanks[mActive.load(std::memory_order_relaxed)];
+        const int st = static_cast<int>(s);
+        auto& c = b.counts[static_cast<size_t>(st)][static_cast<size_t>(bucketOf(ticks))];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        auto& m = b.maxTicks[static_cast<size_t>(st)];
+        if (ticks > m.load(std::memory_order_relaxed)) m.store(ticks, std::memory_order_relaxed);
+    }
+
+    /// Record the time since start for stage s; returns the new timestamp so
+    /// consecutive stages chain: t = lap(A, t); ... t = lap(B, t);
+    uint64_t lap(ProfileStage s, uint64_t start) {
+        const uint64_t t = now();
+        record(s, t - start);
+        return t;
+    }
+
+    /// Close one callback. Rotates the window bank every kWindowBlocks calls.
+    void endBlock() {
+        if (++mBlocksInWindow < kWindowBlocks) return;
+        mBlocksInWindow = 0;
+        const int next = 1 - mActive.load(std::memory_order_relaxed);
+        clearBank(mBanks[next]);
+        mActive.store(next, std::memory_order_relaxed);
+    }
+
+    // ── Reader side (any thread) ─────────────────────────────────────────
+
+    /// Rolling p50 / p99 / max for every stage, in microseconds.
+    void snapshot(StageTiming (&out)[kNumProfileStages]) const {
+        const double ticksPerUs = ticksPerMicrosecond();
+        for (int st = 0; st < kNumProfileStages; ++st) {
+            std::array<uint64_t, kBuckets> merged{};
+            uint64_t total = 0, maxT = 0;
+            for (const Bank& b : mBanks) {
+                for (int i = 0; i < kBuckets; ++i) {
+                    const uint64_t c = b.counts[static_cast<size_t>(st)][static_cast<size_t>(i)]
+                                           .load(std::memory_order_relaxed);
+                    merged[static_cast<size_t>(i)] += c;
+                    total += c;
+                }
+                maxT = std::max(maxT, b.maxTicks[static_cast<size_t>(st)].load(std::memory_order_relaxed));
+            }
+            out[st].p50Us = static_cast<float>(bucketUpper(percentileBucket(merged, total, 0.50)) / ticksPerUs);
+            out[st].p99Us = static_cast<float>(bucketUpper(percentileBucket(merged, total, 0.99)) / ticksPerUs);
+            out[st].maxUs = static_cast<float>(static_cast<double>(maxT) / ticksPerUs);
+            if (total == 0) out[st] = StageTiming{};
+        }
+    }
+
+    /// Reset every histogram and restart the clock-rate measurement.
+    /// Call only while the audio stream is stopped.
+    void clear() {
+        clearBank(mBanks[0]);
+        clearBank(mBanks[1]);
+        mActive.store(0, std::memory_order_relaxed);
+        mBlocksInWindow = 0;
+        mRefTicks = now();
+        mRefTime  = std::chrono::steady_clock::now();
+    }
+
+private:
+
+    struct Bank {
+        std::atomic<uint32_t> counts[kNumProfileStages][kBuckets];
+        std::atomic<uint64_t> maxTicks[kNumProfileStages];
+    };
+
+    static void clearBank(Bank& b) {
+        for (auto& stage : b.counts)
+            for (auto& c : stage) c.store(0, std::memory_order_relaxed);
+        for (auto& m : b.maxTicks) m.store(0, std::memory_order_relaxed);
+    }
+
+    static int highBit(uint64_t v) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int n = 0;
+        while (v >>= 1) ++n;
+        return n;
+#else
+        return 63 - __builtin_clzll(v);
+#endif
+    }
+
+    // 0..3 map to themselves; above that, 4 buckets per octave keyed by the
+    // two bits below the leading one.
+    static int bucketOf(uint64_t t) {
+        if (t < 4) return static_cast<int>(t);
+        const int e = highBit(t);
+        const int m = static_cast<int>((t >> (e - 2)) & 3u);
+        return std::min(kBuckets - 1, (e - 1) * 4 + m);
+    }
+
+    static double bucketUpper(int idx) {
+        if (idx < 4) return static_cast<double>(idx + 1);
+        const int e = idx / 4 + 1;
+        const int m = idx % 4;
+        return static_cast<double>(static_cast<uint64_t>(5 + m) << (e - 2));
+    }
+
+    static int percentileBucket(const std::array<uint64_t, kBuckets>& h,
+                                uint64_t total, double q) {
+        if (total == 0) return 0;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t acc = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            acc += h[static_cast<size_t>(i)];
+            if (acc >= rank) return i;
+        }
+        return kBuckets - 1;
+    }
+
+    double ticksPerMicrosecond() const {
+#if defined(SR_PROFILER_TSC_X86) || defined(SR_PROFILER_TSC_ARM64)
+        const double us = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - mRefTime).count();
+        const double ticks = static_cast<double>(now() - mRefTicks);
+        return (us > 1000.0 && ticks > 0.0) ? ticks / us : 1000.0;
+#else
+        return 1000.0;   // steady_clock nanoseconds
+#endif
+    }
+
+    Bank                      mBanks[2];
+    std::atomic<int>          mActive{0};
+    uint32_t                  mBlocksInWindow = 0;   // writer-owned
+
+    uint64_t                              mRefTicks = 0;   // set by clear()
+    std::chrono::steady_clock::time_point mRefTime;
+};
@@ -15,36 +15,51 @@
 // THREADING MODEL (Phase 8 — Threading and Safety)
 // ─────────────────────────────────────────────────────────────────────────────
 //
-// Three threads interact with Streaming:
+// Three threads (plus the silence indexers) interact with Streaming:
 //
 //  MAIN thread:
 //    - Calls loadScene() / loadSceneFromADM() (setup, before start())
-//    - Calls startLoader() (before start())
+//    - Calls startLoader() (before start()) and stopLoader() (bounce
+//      teardown; the loader is joined before the rewind runs here)
 //    - Calls shutdown() (ONLY after Backend::stop() has returned)
 //    Owns: mStreams map lifetime, mMultichannelReader lifetime,
 //          mLoaderRunning write (false → stops loader)
 //
 //  AUDIO thread:
 //    - Calls getSample() / getBlock() on every audio callback
+//    - Calls notifyPlayhead() once per block (one relaxed compare; posts
+//      mLoaderWake only when a deadline is crossed)
+//    - Calls requestSeek() / seekDone() for a transport jump and reads no
+//      buffers in between (the loader rewrites both — see requestSeek())
 //    - NEVER holds a lock, never accesses SNDFILE*
-//    Reads: SourceStream::bufferA/B, stateA/B (acquire), chunkStartA/B,
+//    Reads: SourceStream::dataA/B, stateA/B (acquire), chunkStartA/B,
 //           validFramesA/B, activeBuffer (acquire)
 //    Writes: activeBuffer (release), stateA/B (release, on buffer switch only)
 //
 //  LOADER thread:
-//    - Runs loaderWorker() in background
-//    - Holds fileMutex only while calling libsndfile (sf_seek / sf_readf_float)
+//    - Runs loaderWorker() in background. Sleeps on mLoaderWake until the
+//      audio thread reports (notifyPlayhead()) that playback reached the
+//      earliest refill deadline, with a kLoaderBackstopMs timeout as a net
+//    - With loaderThreads > 1, hands refills (most urgent first) to the
+//      process-wide SourceIOService pool and joins them before rescheduling
+//    - Holds fileMutex only while calling libsndfile (sf_seek / sf_readf_float);
+//      memory-mapped sources (MappedPcmFile) are read without any lock
 //    - Reads mState.frameCounter (relaxed) to check playback position
 //    Reads:  stateA/B, activeBuffer (acquire) to decide which buf to fill
-//    Writes: bufferA/B data, then chunkStart/validFrames (release),
+//    Writes: chunkA/B (a SourceIOService chunk, often shared with other
+//            sessions) and dataA/B, then chunkStart/validFrames (release),
 //            then state (EMPTY→LOADING→READY) (release)
 //
+//  SILENCE INDEXER threads (--silence_threads, see startSilenceIndex()):
+//    - Read / build each file's SilenceMap after load; never touch buffers
+//    Writes: SourceStream::silence (release, once per stream)
+//
 // MEMORY ORDERING (double-buffer acquire/release protocol):
 //
 //  Loader writes:
 //    1. state ← LOADING  (release)    — marks buffer in-flight
-//    2. buffer data written            — normal store (no ordering needed;
-//                                         visibility guaranteed by step 3)
+//    2. chunk acquired, dataA/B ← its  — SourceIOService cache hit, or a
+//       samples (release)                 read into a fresh chunk
 //    3. chunkStart ← N   (release)    — publish start position
 //    4. validFrames ← F  (release)    — publish frame count
 //    5. state ← READY    (release)    — final visibility fence;
@@ -93,10 +108,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>    // memset, memcpy
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -107,7 +127,13 @@
 
 #include "RealtimeTypes.hpp"
 #include "JSONLoader.hpp"  // SpatialData, Keyframe — shared from source/spatial_engine/src/
+#include "WavUtils.hpp"    // sourceFilePath() — package file naming
 #include "MultichannelReader.hpp"  // ADM direct streaming — multichannel reader
+#include "SourceTable.hpp"         // SourceHandle, dense per-source handles
+#include "LoaderSignal.hpp"        // audio → loader wakeup
+#include "SourceIOService.hpp"     // process-wide chunk cache + IO pool
+#include "ChunkPlanner.hpp"        // memory-budgeted chunk sizing
+#include "SilenceMap.hpp"          // SilenceRuns — shared from source/spatial_engine/src/
 
 namespace fs = std::filesystem;
 
@@ -120,6 +146,8 @@ namespace fs = std::filesystem;
 // Phase 11: raised from 5 s → 10 s at 48kHz = 480,000 frames.
 // Memory cost: ~1.8 MB → ~3.7 MB per source. For 80 sources: ~150 MB total
 // (2 buffers × 80 sources × ~960 KB). Acceptable on a DAW-class workstation.
+// With --stream_budget_mb this is only the dense-source default: each
+// source's chunk is then sized by ChunkPlanner to fit the budget.
 // Rationale: the loader needs to fill 10 s of audio while the audio thread
 // consumes the last 25% of the active 10 s buffer (= 2.5 s).  At 48kHz mono
 // float that is 192 KB/s × 80 sources = ~15 MB/s — well within any SSD.
@@ -133,6 +161,19 @@ static constexpr uint64_t kDefaultChunkFrames = 48000 * 10;  // 10 seconds
 // impossible under normal operating conditions (see Invariant 9).
 static constexpr float kPreloadThreshold = 0.75f;  // Start loading at 75%
 
+// Refill lead: the threshold above assumes a refill pass takes a small
+// fraction of the 2.5 s runway. A pass over many stems on a slow or shared
+// disk can take seconds, so the loader times every pass and starts refills at least
+// kRefillLeadMargin × (recent pass time) before the active chunk runs dry,
+// whichever of that and the 75% point comes first.
+static constexpr double kRefillLeadMargin = 2.0;
+
+// Event-driven loader backstop. The loader normally sleeps until the audio
+// thread crosses the next refill deadline; this timeout still lets it rescan
+// periodically (e.g. after a transport jump, or on platforms where a wake can
+// be lost — see LoaderSignal.hpp). Well under the 2.5 s refill headroom.
+static constexpr int kLoaderBackstopMs = 50;
+
 // Per-sample fade multiplier applied on a buffer miss (fallback safety net).
 // Phase 11: instead of returning hard 0.0f on underrun, the last sample is
 // returned scaled by this factor per sample. Time constant ≈ 5 ms at 48 kHz:
@@ -142,6 +183,25 @@ static constexpr float kPreloadThreshold = 0.75f;  // Start loading at 75%
 //   correct diagnostic signal).
 static constexpr float kMissFadeRate = 0.9958f;
 
+// Seek landing burst: after a seek the loader first fills only this fraction
+// of a chunk into buffer A for every source (so playback can resume after a
+// short read), then the full following chunk into buffer B. B's deadline is
+// the end of the burst, which gives it the same 2.5 s headroom as a normal
+// kPreloadThreshold refill.
+static constexpr uint64_t kSeekBurstDivisor = 4;  // burst = chunkFrames / 4
+
+// Content density probe (--stream_budget_mb only): at load, this many
+// windows spread over each mono file are read; the fraction whose peak
+// exceeds kDensityFloor (−80 dBFS) is the source's density for ChunkPlanner.
+static constexpr int      kDensityProbes = 32;
+static constexpr uint64_t kDensityWindow = 1024;
+static constexpr float    kDensityFloor  = 1e-4f;
+
+// Budget replans triggered by a refill that missed its margin are spaced at
+// least this many refill passes apart, so a source that cannot grow further
+// (at kMaxChunkSec or budget-bound) does not replan on every pass.
+static constexpr int kReplanMinPasses = 8;
+
 // ─────────────────────────────────────────────────────────────────────────────
 // BufferState — State machine for each double buffer slot
 // ─────────────────────────────────────────────────────────────────────────────
@@ -173,11 +233,36 @@ struct SourceStream {
     SNDFILE*    sndFile = nullptr;
     SF_INFO     sfInfo  = {};
     std::mutex  fileMutex;      // Protects sndFile seek/read operations
+    sf_count_t  sfPos = -1;     // sndFile read position (under fileMutex; -1 = unknown)
+
+    // Memory-mapped view of the same file (uncompressed WAV / RF64 only).
+    // When set, chunk loads read from it instead of sf_readf_float; sndFile
+    // stays open for the header info and as the unsupported-format fallback.
+    std::unique_ptr<MappedPcmFile> mapped;
 
     // ── Double buffers ───────────────────────────────────────────────────
-    // Two pre-allocated float buffers. Each holds up to chunkFrames samples.
-    std::vector<float> bufferA;
-    std::vector<float> bufferB;
+    // Two slots, each a reference to a chunkFrames-sample decoded chunk in
+    // the process-wide SourceIOService cache — shared with every other
+    // session streaming the same region of the same file. chunkA/B are
+    // touched only by the thread that loads the slot (loader / IO pool /
+    // setup); the audio thread reads dataA/B, published with the state.
+    SourceChunkRef            chunkA;
+    SourceChunkRef            chunkB;
+    std::atomic<const float*> dataA{nullptr};
+    std::atomic<const float*> dataB{nullptr};
+
+    // Cache identity: chunks are keyed by (cacheFile, channel, range).
+    // Set by Streaming::loadScene(); ADM streams are filled by
+    // MultichannelReader, which keys them by its own file and channel.
+    SourceIOService* io = nullptr;
+    std::string      cacheFile;
+
+    // Silence runs of this stream's channel (see SilenceMap.hpp). nullptr
+    // until Streaming's background indexer publishes them (release); the
+    // storage is owned by Streaming and outlives the stream's use of it.
+    // Read by the loader (skip silent reads) and by
+    // Streaming::markSilentBlocks() on the audio thread (skip silent blocks).
+    std::atomic<const SilenceRuns*> silence{nullptr};
 
     // Atomic state for each buffer (lock-free coordination)
     // Marked mutable because the audio thread may switch the active buffer
@@ -205,7 +290,13 @@ struct SourceStream {
     bool     isLFE       = false; // True if this is the LFE source
 
     // ── Buffer sizing ────────────────────────────────────────────────────
+    // chunkFrames is read by whichever thread loads a slot and rewritten
+    // only by the loader between refill batches (budget replan); the audio
+    // thread uses each slot's published validFrames, so the two slots may
+    // differ in length across a replan.
     uint64_t chunkFrames = kDefaultChunkFrames;
+    float    density     = 1.0f;  // probed content density (budget mode)
+    double   refillSec   = 0.0;   // slowest recent chunk load, decays 1/8 per load
 
     // ── Phase 11: underrun state (audio-thread-owned, mutable for const getSample) ──
     // mFadeGain: envelope applied on a buffer miss (1.0 = normal, decays toward 0).
@@ -217,6 +308,9 @@ struct SourceStream {
     //   Reported in the monitoring loop. Non-zero = pathological I/O condition.
     mutable float                    mFadeGain{1.0f};
     mutable std::atomic<uint64_t>    underrunCount{0};
+    // Streaming-wide miss tally (Streaming::underrunTally()), so the audio
+    // thread can detect misses from any render lane with one load per block.
+    std::atomic<uint64_t>*           missTotal = nullptr;
 
     // ── Methods ──────────────────────────────────────────────────────────
 
@@ -233,7 +327,7 @@ struct SourceStream {
         sfInfo = {};
         sndFile = sf_open(path.c_str(), SFM_READ, &sfInfo);
         if (!sndFile) {
-            std::cerr << "[Streaming] ERROR: Cannot open WAV: " << path
+            std::cerr << "[Streaming] ERROR: Cannot open source file: " << path
                       << " — " << sf_strerror(nullptr) << std::endl;
             return false;
         }
@@ -259,10 +353,18 @@ struct SourceStream {
 
         totalFrames = static_cast<uint64_t>(sfInfo.frames);
         sampleRate = sfInfo.samplerate;
+        sfPos = 0;
+
+        auto m = std::make_unique<MappedPcmFile>();
+        if (m->open(path) && m->numChannels() == 1 && m->totalFrames() == totalFrames) {
+            mapped = std::move(m);
+        }
 
-        // Pre-allocate double buffers (no allocation during playback!)
-        bufferA.resize(chunkFrames, 0.0f);
-        bufferB.resize(chunkFrames, 0.0f);
+        // Chunks are allocated (or shared) by SourceIOService on load; the
+        // audio thread never allocates.
+        std::error_code ec;
+        const fs::path canon = fs::weakly_canonical(path, ec);
+        cacheFile = ec ? path : canon.string();
 
         return true;
     }
@@ -282,13 +384,87 @@ struct SourceStream {
         // No file handle — MultichannelReader owns the SNDFILE*
         sndFile = nullptr;
 
-        // Pre-allocate double buffers
-        bufferA.resize(chunkFrames, 0.0f);
-        bufferB.resize(chunkFrames, 0.0f);
-
         return true;
     }
 
+    /// Install chunk in slot bufIdx as the data for frames starting at
+    /// fileFrame and mark the slot READY. The slot must be LOADING (or
+    /// otherwise unreadable by the audio thread). Loader / setup threads.
+    void publishChunk(int bufIdx, SourceChunkRef chunk, uint64_t fileFrame) {
+        auto& ref   = (bufIdx == 0) ? chunkA : chunkB;
+        auto& data  = (bufIdx == 0) ? dataA  : dataB;
+        auto& state = (bufIdx == 0) ? stateA : stateB;
+        auto& start = (bufIdx == 0) ? chunkStartA : chunkStartB;
+        auto& valid = (bufIdx == 0) ? validFramesA : validFramesB;
+
+        const uint64_t frames = chunk ? chunk->validFrames : 0;
+        data.store(chunk ? chunk->samples.data() : nullptr, std::memory_order_release);
+        ref = std::move(chunk);
+        start.store(fileFrame, std::memory_order_release);
+        valid.store(frames, std::memory_order_release);
+        state.store(StreamBufferState::READY, std::memory_order_release);
+    }
+
+    /// Drop slot bufIdx's chunk reference (slot LOADING / not readable), so
+    /// an unshared chunk can be evicted before its replacement is allocated.
+    void dropChunk(int bufIdx) {
+        auto& ref  = (bufIdx == 0) ? chunkA : chunkB;
+        auto& data = (bufIdx == 0) ? dataA  : dataB;
+        data.store(nullptr, std::memory_order_release);
+        ref.reset();
+    }
+
+    /// Chunk for [fileFrame, fileFrame + frames) of this stream's file,
+    /// from the cache or read from disk. frames == 0 (past EOF) → nullptr,
+    /// which publishChunk() installs as an empty slot.
+    /// A range the silence map covers is never read: every client shares
+    /// one zero chunk per length instead.
+    SourceChunkRef acquireChunk(uint64_t fileFrame, uint64_t frames) {
+        if (frames == 0) return nullptr;
+        const SilenceRuns* runs = silence.load(std::memory_order_acquire);
+        if (runs && runs->covers(fileFrame, fileFrame + frames)) {
+            return io->acquireSilence(frames, chunkFrames);
+        }
+        return io->acquire({cacheFile, 0, fileFrame, frames, chunkFrames},
+                           [&](float* dst) -> uint64_t {
+                               return readAudible(runs, fileFrame, frames, dst);
+                           });
+    }
+
+    /// readFrames() of [fileFrame, fileFrame + frames) into a zeroed dst,
+    /// skipping the silent runs inside it. Returns frames read (the skipped
+    /// runs count as read).
+    uint64_t readAudible(const SilenceRuns* runs, uint64_t fileFrame, uint64_t frames,
+                         float* dst) {
+        if (!runs) {
+            const sf_count_t n = readFrames(fileFrame, frames, dst);
+            return n > 0 ? static_cast<uint64_t>(n) : 0;
+        }
+        uint64_t good = frames;  // lowered to the end of the first short read
+        runs->forEachAudible(fileFrame, fileFrame + frames, [&](uint64_t a, uint64_t b) {
+            if (a - fileFrame >= good) return;
+            const sf_count_t n = readFrames(a, b - a, dst + (a - fileFrame));
+            if (n < static_cast<sf_count_t>(b - a)) {
+                good = a - fileFrame + static_cast<uint64_t>(std::max<sf_count_t>(0, n));
+            }
+        });
+        return good;
+    }
+
+    /// Seek support (loader thread, audio thread parked): drop both buffers
+    /// so nothing stale can be switched to while buffer A is reloaded.
+    void resetForSeek() {
+        activeBuffer.store(-1, std::memory_order_release);
+        stateA.store(StreamBufferState::EMPTY, std::memory_order_release);
+        stateB.store(StreamBufferState::EMPTY, std::memory_order_release);
+    }
+
+    /// Seek support: make the freshly loaded buffer A the playing buffer.
+    void activateBufferA() {
+        activeBuffer.store(0, std::memory_order_release);
+        stateA.store(StreamBufferState::PLAYING, std::memory_order_release);
+    }
+
     /// Load the first chunk synchronously into buffer A. Called once before
     /// playback starts (from the main thread, not the audio thread).
     bool loadFirstChunk() {
@@ -298,27 +474,16 @@ struct SourceStream {
 
         uint64_t framesToRead = std::min(chunkFrames, totalFrames);
 
-        std::lock_guard<std::mutex> lock(fileMutex);
-        sf_seek(sndFile, 0, SEEK_SET);
-        sf_count_t read = sf_readf_float(sndFile, bufferA.data(),
-                                          static_cast<sf_count_t>(framesToRead));
+        SourceChunkRef chunk = acquireChunk(0, framesToRead);
 
-        if (read <= 0) {
+        if (!chunk || chunk->validFrames == 0) {
             std::cerr << "[Streaming] ERROR: Failed to read first chunk for "
                       << name << std::endl;
             stateA.store(StreamBufferState::EMPTY, std::memory_order_release);
             return false;
         }
 
-        // Zero-fill remainder if we read less than the chunk size
-        if (static_cast<uint64_t>(read) < chunkFrames) {
-            std::memset(bufferA.data() + read, 0,
-                        (chunkFrames - read) * sizeof(float));
-        }
-
-        chunkStartA.store(0, std::memory_order_release);
-        validFramesA.store(static_cast<uint64_t>(read), std::memory_order_release);
-        stateA.store(StreamBufferState::READY, std::memory_order_release);
+        publishChunk(0, std::move(chunk), 0);
 
         // Activate buffer A for playback
         activeBuffer.store(0, std::memory_order_release);
@@ -328,47 +493,67 @@ struct SourceStream {
     }
 
     /// Load a chunk starting at fileFrame into the specified buffer.
+    /// maxFrames < chunkFrames loads a short window (seek landing burst).
     /// Called ONLY by the loader thread.
-    void loadChunkInto(int bufIdx, uint64_t fileFrame) {
-        auto& buffer = (bufIdx == 0) ? bufferA : bufferB;
+    void loadChunkInto(int bufIdx, uint64_t fileFrame, uint64_t maxFrames = ~uint64_t(0)) {
         auto& state  = (bufIdx == 0) ? stateA  : stateB;
-        auto& start  = (bufIdx == 0) ? chunkStartA : chunkStartB;
-        auto& valid  = (bufIdx == 0) ? validFramesA : validFramesB;
 
         state.store(StreamBufferState::LOADING, std::memory_order_release);
+        dropChunk(bufIdx);
 
-        // Clamp to file end
-        uint64_t framesToRead = chunkFrames;
+        // Clamp to the requested window and the file end
+        uint64_t framesToRead = std::min(chunkFrames, maxFrames);
         if (fileFrame + framesToRead > totalFrames) {
             framesToRead = (fileFrame < totalFrames) ? (totalFrames - fileFrame) : 0;
         }
 
-        if (framesToRead == 0) {
-            // Past end of file — fill with silence
-            std::memset(buffer.data(), 0, chunkFrames * sizeof(float));
-            start.store(fileFrame, std::memory_order_release);
-            valid.store(0, std::memory_order_release);
-            state.store(StreamBufferState::READY, std::memory_order_release);
-            return;
-        }
+        // Past end of file → a silent chunk (validFrames 0)
+        const auto t0 = std::chrono::steady_clock::now();
+        publishChunk(bufIdx, acquireChunk(fileFrame, framesToRead), fileFrame);
+        const double sec = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        refillSec = std::max(sec, refillSec - refillSec / 8);
+    }
 
-        sf_count_t read = 0;
-        {
-            std::lock_guard<std::mutex> lock(fileMutex);
-            sf_seek(sndFile, static_cast<sf_count_t>(fileFrame), SEEK_SET);
-            read = sf_readf_float(sndFile, buffer.data(),
-                                   static_cast<sf_count_t>(framesToRead));
+    /// Fraction of kDensityProbes windows spread over the file whose peak
+    /// exceeds kDensityFloor. Setup thread, before the first chunk loads.
+    float probeDensity() {
+        if (totalFrames < kDensityWindow * kDensityProbes) return 1.0f;  // fits a floor chunk anyway
+        std::vector<float> win(kDensityWindow);
+        int hits = 0;
+        for (int p = 0; p < kDensityProbes; ++p) {
+            const uint64_t at = (totalFrames - kDensityWindow) * p / (kDensityProbes - 1);
+            // Mapped files are read directly: readFrames() would also
+            // prefetch a whole chunk behind every probe.
+            const uint64_t n = mapped
+                ? mapped->readChannel(0, at, kDensityWindow, win.data())
+                : static_cast<uint64_t>(std::max<sf_count_t>(0, readFrames(at, kDensityWindow, win.data())));
+            float peak = 0.0f;
+            for (uint64_t i = 0; i < n; ++i) peak = std::max(peak, std::fabs(win[i]));
+            if (peak > kDensityFloor) ++hits;
         }
+        return static_cast<float>(hits) / kDensityProbes;
+    }
 
-        // Zero-fill remainder
-        if (static_cast<uint64_t>(read) < chunkFrames) {
-            std::memset(buffer.data() + read, 0,
-                        (chunkFrames - read) * sizeof(float));
+    /// Read framesToRead mono frames at fileFrame into dst. Memory-mapped
+    /// files are read lock-free (and their pages released / the next chunk
+    /// prefetched); otherwise libsndfile under fileMutex.
+    sf_count_t readFrames(uint64_t fileFrame, uint64_t framesToRead, float* dst) {
+        if (mapped) {
+            uint64_t n = mapped->readChannel(0, fileFrame, framesToRead, dst);
+            mapped->release(fileFrame, n);
+            mapped->prefetch(fileFrame + n, chunkFrames);
+            return static_cast<sf_count_t>(n);
         }
-
-        start.store(fileFrame, std::memory_order_release);
-        valid.store(static_cast<uint64_t>(read), std::memory_order_release);
-        state.store(StreamBufferState::READY, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(fileMutex);
+        // Consecutive chunks continue where the last read stopped, so a seek
+        // is only issued on a jump.
+        if (sfPos != static_cast<sf_count_t>(fileFrame)) {
+            sfPos = sf_seek(sndFile, static_cast<sf_count_t>(fileFrame), SEEK_SET);
+        }
+        const sf_count_t n = sf_readf_float(sndFile, dst, static_cast<sf_count_t>(framesToRead));
+        sfPos = (sfPos >= 0 && n > 0) ? sfPos + n : -1;
+        return n;
     }
 
     /// Get the sample value at a given global frame position.
@@ -387,7 +572,9 @@ struct SourceStream {
         if (active < 0) return 0.0f;  // No buffer active yet
 
         // Get active buffer's data
-        const auto& buffer = (active == 0) ? bufferA : bufferB;
+        const float* buffer = (active == 0)
+            ? dataA.load(std::memory_order_acquire)
+            : dataB.load(std::memory_order_acquire);
         uint64_t bufStart  = (active == 0)
             ? chunkStartA.load(std::memory_order_acquire)
             : chunkStartB.load(std::memory_order_acquire);
@@ -403,7 +590,9 @@ struct SourceStream {
 
         // Frame not in active buffer — check the other buffer
         int other = 1 - active;
-        const auto& otherBuf = (other == 0) ? bufferA : bufferB;
+        const float* otherBuf = (other == 0)
+            ? dataA.load(std::memory_order_acquire)
+            : dataB.load(std::memory_order_acquire);
         auto otherState = (other == 0)
             ? stateA.load(std::memory_order_acquire)
             : stateB.load(std::memory_order_acquire);
@@ -435,6 +624,7 @@ struct SourceStream {
         // Neither buffer has the requested frame. Apply exponential fade-to-zero
         // rather than returning a hard 0.0f click. Increment counter for log.
         underrunCount.fetch_add(1, std::memory_order_relaxed);
+        if (missTotal) missTotal->fetch_add(1, std::memory_order_relaxed);
         if (mFadeGain > 1e-4f) {
             mFadeGain *= kMissFadeRate;
         } else {
@@ -444,8 +634,84 @@ struct SourceStream {
         return 0.0f;
     }
 
+    /// Step over [startFrame, endFrame) without reading it — the block is
+    /// silence-mapped and its renderer skips it. Performs the buffer switch
+    /// getSample() would have made on the way, so the loader sees the
+    /// playhead move and keeps refilling. Called ONLY from the audio thread.
+    void skipBlock(uint64_t startFrame, uint64_t endFrame) const {
+        const int active = activeBuffer.load(std::memory_order_acquire);
+        if (active < 0 || startFrame >= endFrame) return;
+        const uint64_t last = endFrame - 1;
+
+        const uint64_t aStart = (active == 0)
+            ? chunkStartA.load(std::memory_order_acquire)
+            : chunkStartB.load(std::memory_order_acquire);
+        const uint64_t aValid = (active == 0)
+            ? validFramesA.load(std::memory_order_acquire)
+            : validFramesB.load(std::memory_order_acquire);
+        if (last >= aStart && last < aStart + aValid) {
+            mFadeGain = 1.0f;
+            return;
+        }
+
+        const int other = 1 - active;
+        const auto otherState = (other == 0)
+            ? stateA.load(std::memory_order_acquire)
+            : stateB.load(std::memory_order_acquire);
+        const uint64_t oStart = (other == 0)
+            ? chunkStartA.load(std::memory_order_acquire)
+            : chunkStartB.load(std::memory_order_acquire);
+        const uint64_t oValid = (other == 0)
+            ? validFramesA.load(std::memory_order_acquire)
+            : validFramesB.load(std::memory_order_acquire);
+        if (otherState == StreamBufferState::READY && last >= oStart && last < oStart + oValid) {
+            auto& mutState = (active == 0) ? stateA : stateB;
+            auto& othState = (other == 0)  ? stateA : stateB;
+            mutState.store(StreamBufferState::EMPTY, std::memory_order_release);
+            othState.store(StreamBufferState::PLAYING, std::memory_order_release);
+            activeBuffer.store(other, std::memory_order_release);
+            mFadeGain = 1.0f;
+        }
+        // Otherwise the frames are past EOF or not loaded yet; a skipped
+        // block has nothing to fade, so no underrun is counted for it.
+    }
+
+    /// Whether frames [startFrame, endFrame) can be read without a miss:
+    /// covered by the active buffer, the READY inactive buffer, or lying past
+    /// the end of the file. Same lock-free loads as getSample(); switches
+    /// nothing. Called from the thread that drives getBlock().
+    bool hasFrames(uint64_t startFrame, uint64_t endFrame) const {
+        endFrame = std::min(endFrame, totalFrames);
+        if (startFrame >= endFrame) return true;
+        const int active = activeBuffer.load(std::memory_order_acquire);
+        if (active < 0) return false;
+
+        const uint64_t aStart = (active == 0)
+            ? chunkStartA.load(std::memory_order_acquire)
+            : chunkStartB.load(std::memory_order_acquire);
+        const uint64_t aEnd = aStart + ((active == 0)
+            ? validFramesA.load(std::memory_order_acquire)
+            : validFramesB.load(std::memory_order_acquire));
+        if (startFrame >= aStart && startFrame < aEnd) startFrame = aEnd;
+        if (startFrame >= endFrame) return true;
+
+        const int other = 1 - active;
+        const auto otherState = (other == 0)
+            ? stateA.load(std::memory_order_acquire)
+            : stateB.load(std::memory_order_acquire);
+        if (otherState != StreamBufferState::READY) return false;
+        const uint64_t oStart = (other == 0)
+            ? chunkStartA.load(std::memory_order_acquire)
+            : chunkStartB.load(std::memory_order_acquire);
+        const uint64_t oEnd = oStart + ((other == 0)
+            ? validFramesA.load(std::memory_order_acquire)
+            : validFramesB.load(std::memory_order_acquire));
+        return startFrame >= oStart && endFrame <= oEnd;
+    }
+
     /// Close the file handle. Called at shutdown.
     void close() {
+        mapped.reset();
         if (sndFile) {
             sf_close(sndFile);
             sndFile = nullptr;
@@ -463,8 +729,15 @@ struct SourceStream {
         filePath = std::move(other.filePath);
         sndFile = other.sndFile;  other.sndFile = nullptr;
         sfInfo = other.sfInfo;
-        bufferA = std::move(other.bufferA);
-        bufferB = std::move(other.bufferB);
+        sfPos = other.sfPos;
+        mapped = std::move(other.mapped);
+        chunkA = std::move(other.chunkA);
+        chunkB = std::move(other.chunkB);
+        dataA.store(other.dataA.load());
+        dataB.store(other.dataB.load());
+        io = other.io;
+        cacheFile = std::move(other.cacheFile);
+        silence.store(other.silence.load());
         stateA.store(other.stateA.load());
         stateB.store(other.stateB.load());
         chunkStartA.store(other.chunkStartA.load());
@@ -476,8 +749,11 @@ struct SourceStream {
         sampleRate = other.sampleRate;
         isLFE = other.isLFE;
         chunkFrames = other.chunkFrames;
+        density = other.density;
+        refillSec = other.refillSec;
         mFadeGain = other.mFadeGain;
         underrunCount.store(other.underrunCount.load());
+        missTotal = other.missTotal;
     }
     SourceStream& operator=(SourceStream&& other) noexcept {
         if (this != &other) {
@@ -486,8 +762,15 @@ struct SourceStream {
             filePath = std::move(other.filePath);
             sndFile = other.sndFile;  other.sndFile = nullptr;
             sfInfo = other.sfInfo;
-            bufferA = std::move(other.bufferA);
-            bufferB = std::move(other.bufferB);
+            sfPos = other.sfPos;
+            mapped = std::move(other.mapped);
+            chunkA = std::move(other.chunkA);
+            chunkB = std::move(other.chunkB);
+            dataA.store(other.dataA.load());
+            dataB.store(other.dataB.load());
+            io = other.io;
+            cacheFile = std::move(other.cacheFile);
+            silence.store(other.silence.load());
             stateA.store(other.stateA.load());
             stateB.store(other.stateB.load());
             chunkStartA.store(other.chunkStartA.load());
@@ -499,8 +782,11 @@ struct SourceStream {
             sampleRate = other.sampleRate;
             isLFE = other.isLFE;
             chunkFrames = other.chunkFrames;
+            density = other.density;
+            refillSec = other.refillSec;
             mFadeGain = other.mFadeGain;
             underrunCount.store(other.underrunCount.load());
+            missTotal = other.missTotal;
         }
         return *this;
     }
@@ -520,7 +806,8 @@ public:
     ~Streaming() { shutdown(); }
 
     // ── Load all sources from a LUSID scene ──────────────────────────────
-    // Opens each source WAV file and pre-loads the first chunk.
+    // Opens each source WAV file and pre-loads the first chunk — after all
+    // files are open, so a stream budget can size every chunk first.
     // Must be called BEFORE starting the audio stream.
     //
     // The source name → filename convention follows WavUtils::loadSources():
@@ -531,46 +818,83 @@ public:
         std::cout << "[Streaming] Loading " << scene.sources.size()
                   << " sources from: " << mConfig.sourcesFolder << std::endl;
 
+        mSourceTable.build(scene);
+        attachIOService();
+
+        std::vector<std::unique_ptr<SourceStream>> opened;
         for (const auto& [sourceName, keyframes] : scene.sources) {
             // Build file path: sourcesFolder/sourceName.wav
-            fs::path wavPath = fs::path(mConfig.sourcesFolder) / (sourceName + ".wav");
+            const std::string wavPath =
+                WavUtils::sourceFilePath(mConfig.sourcesFolder, sourceName);
 
-            if (!fs::exists(wavPath)) {
-                std::cerr << "[Streaming] WARNING: Missing source WAV: "
-                          << wavPath << " — skipping." << std::endl;
+            if (wavPath.empty()) {
+                std::cerr << "[Streaming] WARNING: Missing source file: "
+                          << (fs::path(mConfig.sourcesFolder) / (sourceName + ".wav"))
+                          << " — skipping." << std::endl;
                 continue;
             }
 
             // Create stream for this source
             auto stream = std::make_unique<SourceStream>();
-            if (!stream->open(wavPath.string(), sourceName,
+            stream->io = mIO.get();
+            if (!stream->open(wavPath, sourceName,
                               kDefaultChunkFrames, mConfig.sampleRate)) {
-                std::cerr << "[Streaming] WARNING: Failed to open " 
-                          << sourceName << " — skipping." << std::endl;
+                std::cerr << "[Streaming] WARNING: Failed to open source file "
+                          << wavPath << " — skipping." << std::endl;
                 continue;
             }
+            opened.push_back(std::move(stream));
+        }
+
+        if (streamBudgetBytes() > 0) {
+            std::vector<SourceStream*> toPlan;
+            for (auto& stream : opened) {
+                stream->density = stream->probeDensity();
+                toPlan.push_back(stream.get());
+            }
+            planChunks(toPlan);
+            const double planMB = static_cast<double>(mPlannedBytes) / (1 << 20);
+            std::cout << "[Streaming] Stream budget " << mConfig.streamBudgetMB << " MB: "
+                      << planMB << " MB planned for " << toPlan.size() << " sources." << std::endl;
+            if (mPlannedBytes > streamBudgetBytes()) {
+                std::cerr << "[Streaming] WARNING: " << ChunkPlanner::kMinChunkSec
+                          << " s minimum chunks exceed the stream budget." << std::endl;
+            }
+        }
 
+        for (auto& stream : opened) {
             // Load first chunk synchronously
             if (!stream->loadFirstChunk()) {
                 std::cerr << "[Streaming] WARNING: Failed to preload "
-                          << sourceName << " — skipping." << std::endl;
+                          << stream->name << " — skipping." << std::endl;
                 continue;
             }
 
-            std::cout << "  ✓ " << sourceName << " — "
+            std::cout << "  ✓ " << stream->name << " — "
                       << stream->totalFrames << " frames ("
                       << (double)stream->totalFrames / stream->sampleRate
-                      << "s)" << (stream->isLFE ? " [LFE]" : "") << std::endl;
+                      << "s)" << (stream->isLFE ? " [LFE]" : "");
+            if (streamBudgetBytes() > 0) {
+                std::cout << " chunk " << (double)stream->chunkFrames / stream->sampleRate
+                          << "s, density " << stream->density;
+            }
+            std::cout << std::endl;
 
-            mStreams[sourceName] = std::move(stream);
+            mStreams[stream->name] = std::move(stream);
         }
 
+        indexStreamsByHandle();
         mState.numSources.store(static_cast<int>(mStreams.size()),
                                 std::memory_order_relaxed);
 
         std::cout << "[Streaming] Loaded " << mStreams.size() << " sources."
                   << std::endl;
 
+        for (auto& [name, stream] : mStreams) {
+            mSilenceJobs.push_back({stream->filePath, {{0, stream.get()}}, {}});
+        }
+        startSilenceIndex();
+
         return !mStreams.empty();
     }
 
@@ -589,11 +913,31 @@ public:
                   << " sources from multichannel ADM: " << admFilePath << std::endl;
 
         mMultichannelMode = true;
+        mSourceTable.build(scene);
+        attachIOService();
+
+        // All channels share one chunk grid (one bulk read per chunk), so a
+        // stream budget gives every source the same length: the plan for
+        // that many dense sources. Sized before the channels are mapped,
+        // from the scene's source count (an upper bound).
+        uint64_t chunkFrames = kDefaultChunkFrames;
+        if (streamBudgetBytes() > 0) {
+            ChunkDemand d;
+            d.totalFrames = ~uint64_t(0);
+            const std::vector<uint64_t> plan = ChunkPlanner::planChunkFrames(
+                std::vector<ChunkDemand>(std::max<size_t>(1, scene.sources.size()), d),
+                streamBudgetBytes(), mConfig.sampleRate, kDefaultChunkFrames,
+                1.0 - kPreloadThreshold, streamMargin());
+            chunkFrames = plan.front();
+            mPlannedBytes = ChunkPlanner::planBytes(plan);
+            std::cout << "[Streaming] Stream budget " << mConfig.streamBudgetMB << " MB: "
+                      << (double)chunkFrames / mConfig.sampleRate << " s chunks." << std::endl;
+        }
 
         // Create the multichannel reader and open the ADM file
         mMultichannelReader = std::make_unique<MultichannelReader>();
         if (!mMultichannelReader->open(admFilePath, mConfig.sampleRate,
-                                        kDefaultChunkFrames)) {
+                                        chunkFrames, mIO.get())) {
             std::cerr << "[Streaming] FATAL: Failed to open ADM file." << std::endl;
             return false;
         }
@@ -602,6 +946,7 @@ public:
         int      admNumChannels = mMultichannelReader->numChannels();
 
         // Create buffer-only SourceStreams and map channels
+        std::vector<std::pair<int, SourceStream*>> admChannels;
         for (const auto& [sourceName, keyframes] : scene.sources) {
             // Parse source name to get 0-based channel index
             int channelIndex = parseChannelIndex(sourceName, admNumChannels);
@@ -614,11 +959,12 @@ public:
 
             // Create a buffer-only stream (no individual file handle)
             auto stream = std::make_unique<SourceStream>();
-            stream->initBuffersOnly(sourceName, kDefaultChunkFrames,
+            stream->initBuffersOnly(sourceName, chunkFrames,
                                     mConfig.sampleRate, admTotalFrames);
 
             // Register with the multichannel reader
             mMultichannelReader->mapChannel(channelIndex, stream.get());
+            admChannels.emplace_back(channelIndex, stream.get());
 
             std::cout << "  ✓ " << sourceName << " → ADM ch " << (channelIndex + 1)
                       << " (0-based: " << channelIndex << ")"
@@ -646,6 +992,7 @@ public:
             stream->stateA.store(StreamBufferState::PLAYING, std::memory_order_release);
         }
 
+        indexStreamsByHandle();
         mState.numSources.store(static_cast<int>(mStreams.size()),
                                 std::memory_order_relaxed);
 
@@ -653,6 +1000,10 @@ public:
                   << mMultichannelReader->numMappedChannels() << " of "
                   << admNumChannels << " channels mapped)." << std::endl;
 
+        // One sequential scan indexes every mapped channel
+        mSilenceJobs.push_back({admFilePath, std::move(admChannels), {}});
+        startSilenceIndex();
+
         return true;
     }
 
@@ -660,18 +1011,97 @@ public:
     // Must be called AFTER loadScene() and BEFORE starting audio.
 
     void startLoader() {
+        // Parallel refills only help with independent files (mono mode);
+        // ADM mode is one bulk read per chunk. The helpers are the shared
+        // SourceIOService pool, grown to this session's request.
+        int helpers = mMultichannelMode ? 0 : std::max(0, mConfig.loaderThreads - 1);
+        helpers = std::min<int>(helpers, static_cast<int>(mStreams.size()) - 1);
+        mParallelRefills = helpers > 0;
+        if (mParallelRefills) {
+            mIO = SourceIOService::attach(helpers, sourceCacheBytes());
+        }
+        mRefillJobs.reserve(mStreams.size());
+
+        mNextWakeFrame.store(0, std::memory_order_relaxed);  // schedule on first block
         mLoaderRunning.store(true, std::memory_order_release);
         mLoaderThread = std::thread([this]() { loaderWorker(); });
-        std::cout << "[Streaming] Background loader thread started." << std::endl;
+        std::cout << "[Streaming] Background loader thread started";
+        if (mParallelRefills) {
+            std::cout << " (shared IO pool: " << mIO->numThreads() << " thread(s))";
+        }
+        std::cout << "." << std::endl;
+    }
+
+    // ── Stop the loader, keep the streams ────────────────────────────────
+    // Joins the loader thread and lands a seek to frame 0 on the calling
+    // thread, leaving every stream as loadScene() did, so startLoader() may
+    // run again (EngineSession::bounce() teardown). Same precondition as
+    // shutdown(): nothing calls getSample() / getBlock() any more.
+    void stopLoader() {
+        mLoaderRunning.store(false, std::memory_order_release);
+        mLoaderWake.post();
+        if (mLoaderThread.joinable()) {
+            mLoaderThread.join();
+        }
+        const uint32_t seq = mSeekSeq.fetch_add(1, std::memory_order_relaxed) + 1;
+        mSeekHandledSeq = seq;
+        performSeek(0, seq);
+    }
+
+    // ── Playhead notification ────────────────────────────────────────────
+    // Called from the audio callback once per block, after frameCounter has
+    // advanced to frame. Lock-free: a relaxed compare against the earliest
+    // refill deadline published by the loader; on a crossing, one post() to
+    // wake it (the deadline is cleared so the post happens once).
+
+    void notifyPlayhead(uint64_t frame) {
+        if (frame < mNextWakeFrame.load(std::memory_order_relaxed)) return;
+        mNextWakeFrame.store(kNoWake, std::memory_order_relaxed);
+        mLoaderWake.post();
+    }
+
+    // ── Seek ─────────────────────────────────────────────────────────────
+    // Two-sided handshake between the AUDIO thread and the loader:
+    //   1. audio: requestSeek(frame) — lock-free (two atomic stores + one
+    //      LoaderSignal post). From here until seekDone(seq) returns true the
+    //      caller MUST NOT call getBlock() / getSample(): the loader
+    //      rewrites both double buffers of every stream.
+    //   2. loader: refills buffer A of every stream at frame (short landing
+    //      burst, deadline-ordered, parallel on the IO helpers), activates it
+    //      and publishes the request's sequence number (release).
+    //   3. audio: seekDone(seq) (acquire) → playback may resume at frame.
+    //   4. loader: fills buffer B with the following chunk, while the audio
+    //      thread already plays A — the normal inactive-buffer refill path.
+    // A newer request supersedes an older one still in flight; only the
+    // latest sequence number is ever reported done.
+
+    /// Post a seek to frame. Returns the sequence number to poll with seekDone().
+    uint32_t requestSeek(uint64_t frame) {
+        mSeekFrame.store(frame, std::memory_order_relaxed);
+        const uint32_t seq = mSeekSeq.fetch_add(1, std::memory_order_release) + 1;
+        mLoaderWake.post();
+        return seq;
+    }
+
+    /// True once the loader has landed the seek with sequence number seq.
+    bool seekDone(uint32_t seq) const {
+        return mSeekDoneSeq.load(std::memory_order_acquire) == seq;
     }
 
     // ── Get a sample for a given source at a global frame position ───────
     // Called from the audio callback — MUST be lock-free and real-time safe.
+    // handle comes from sourceTable() / SourcePose::handle: one bounds check
+    // and one vector index, no string compare.
 
+    float getSample(SourceHandle handle, uint64_t globalFrame) const {
+        const SourceStream* src = streamFor(handle);
+        return src ? src->getSample(globalFrame) : 0.0f;
+    }
+
+    /// Name-keyed convenience overload — resolves the handle with a binary
+    /// search. For tools and tests only; NOT for the audio callback.
     float getSample(const std::string& sourceName, uint64_t globalFrame) const {
-        auto it = mStreams.find(sourceName);
-        if (it == mStreams.end()) return 0.0f;
-        return it->second->getSample(globalFrame);
+        return getSample(mSourceTable.find(sourceName), globalFrame);
     }
 
     // ── Get a block of samples for a source into a pre-allocated buffer ──
@@ -679,15 +1109,15 @@ public:
     // block from the active buffer when possible.
     // Called from the audio callback — MUST be lock-free.
 
-    void getBlock(const std::string& sourceName, uint64_t startFrame,
+    void getBlock(SourceHandle handle, uint64_t startFrame,
                   unsigned int numFrames, float* outBuffer) const {
-        auto it = mStreams.find(sourceName);
-        if (it == mStreams.end()) {
+        const SourceStream* stream = streamFor(handle);
+        if (!stream) {
             std::memset(outBuffer, 0, numFrames * sizeof(float));
             return;
         }
 
-        const SourceStream& src = *it->second;
+        const SourceStream& src = *stream;
         int active = src.activeBuffer.load(std::memory_order_acquire);
 
         if (active < 0) {
@@ -696,7 +1126,9 @@ public:
         }
 
         // Try to get the whole block from the active buffer
-        const auto& buffer   = (active == 0) ? src.bufferA : src.bufferB;
+        const float* buffer  = (active == 0)
+            ? src.dataA.load(std::memory_order_acquire)
+            : src.dataB.load(std::memory_order_acquire);
         uint64_t bufStart    = (active == 0)
             ? src.chunkStartA.load(std::memory_order_acquire)
             : src.chunkStartB.load(std::memory_order_acquire);
@@ -708,7 +1140,7 @@ public:
 
         // Happy path: entire block fits in the active buffer
         if (startFrame >= bufStart && endFrame <= bufStart + bufValid) {
-            std::memcpy(outBuffer, buffer.data() + (startFrame - bufStart),
+            std::memcpy(outBuffer, buffer + (startFrame - bufStart),
                         numFrames * sizeof(float));
             return;
         }
@@ -720,6 +1152,49 @@ public:
         }
     }
 
+    /// Name-keyed convenience overload. NOT for the audio callback.
+    void getBlock(const std::string& sourceName, uint64_t startFrame,
+                  unsigned int numFrames, float* outBuffer) const {
+        getBlock(mSourceTable.find(sourceName), startFrame, numFrames, outBuffer);
+    }
+
+    // ── Freewheel synchronization ─────────────────────────────────────────
+    // A freewheel bounce (RealtimeBackend::freewheelBlock()) runs the audio
+    // path as fast as the CPU allows, so the loader's 2.5 s preload margin
+    // can be consumed before a refill lands. The bounce loop polls this
+    // before each block and waits instead of rendering an underrun, which
+    // keeps the bounce sample-identical to an unstarved realtime run.
+
+    /// Whether every stream can serve [startFrame, startFrame + numFrames).
+    bool framesReady(uint64_t startFrame, unsigned int numFrames) const {
+        for (const SourceStream* s : mStreamByHandle) {
+            if (s && !s->hasFrames(startFrame, startFrame + numFrames)) return false;
+        }
+        return true;
+    }
+
+    // ── Silence-mapped blocks ─────────────────────────────────────────────
+    // Per-handle flags for [startFrame, startFrame + numFrames): 1 = the
+    // source's published silence map covers the whole block. The stream of
+    // every flagged source is stepped past the block (skipBlock()) so it
+    // must not be read — Pose marks its pose isSilent and the Spatializer
+    // skips it. nullptr when no map is being built (--silence_threads 0).
+    // Called from the audio thread once per block, before Pose; lock-free,
+    // writes only the preallocated mSilentBlocks.
+
+    const uint8_t* markSilentBlocks(uint64_t startFrame, unsigned int numFrames) {
+        if (mSilenceJobs.empty()) return nullptr;
+        const uint64_t endFrame = startFrame + numFrames;
+        for (size_t h = 0; h < mStreamByHandle.size(); ++h) {
+            const SourceStream* s = mStreamByHandle[h];
+            const SilenceRuns* runs = s ? s->silence.load(std::memory_order_acquire) : nullptr;
+            const bool silent = runs && runs->covers(startFrame, endFrame);
+            if (silent) s->skipBlock(startFrame, endFrame);
+            mSilentBlocks[h] = silent ? 1u : 0u;
+        }
+        return mSilentBlocks.data();
+    }
+
     // ── Source queries ────────────────────────────────────────────────────
 
     /// Get the list of loaded source names.
@@ -747,11 +1222,20 @@ public:
     /// Number of loaded sources.
     size_t numSources() const { return mStreams.size(); }
 
+    /// Handle table for the loaded scene (covers every scene source, including
+    /// ones that were skipped here — their stream column entry is nullptr).
+    const SourceTable& sourceTable() const { return mSourceTable; }
+
     /// Phase 11: total underrun sample count across all sources.
     /// Each count represents one sample that was requested but not available.
     /// Called from the main thread monitoring loop (relaxed read is fine —
     /// display lag of one buffer is acceptable).
     /// Non-zero value = pathological I/O condition. See Invariant 9.
+    /// Streaming-wide miss count, same units as totalUnderruns(), as a
+    /// single atomic. AUDIO thread reads it once per block (relaxed) to emit
+    /// DiagEventType::Underrun; cheaper than walking every stream.
+    uint64_t underrunTally() const { return mMissTotal.load(std::memory_order_relaxed); }
+
     uint64_t totalUnderruns() const {
         uint64_t total = 0;
         for (const auto& [name, stream] : mStreams) {
@@ -773,10 +1257,15 @@ public:
     // Violating this ordering → use-after-free on the audio thread.
 
     void shutdown() {
-        // Stop loader thread first — sets the flag (release) and joins.
+        // Silence indexers hold stream pointers: cancel their scans and
+        // join them before anything is torn down.
+        stopSilenceIndex();
+
+        // Stop loader thread next — sets the flag (release) and joins.
         // After join() returns, the loader thread has exited and will never
         // again write to any SourceStream buffer.
         mLoaderRunning.store(false, std::memory_order_release);
+        mLoaderWake.post();
         if (mLoaderThread.joinable()) {
             mLoaderThread.join();
         }
@@ -792,7 +1281,31 @@ public:
         for (auto& [name, stream] : mStreams) {
             stream->close();
         }
+        mStreamByHandle.clear();
         mStreams.clear();
+        mSilenceJobs.clear();   // after the streams: nothing points into them now
+        if (mSlowestRefillSec > 0.0) {
+            std::cout << "[Streaming] Slowest refill pass: "
+                      << static_cast<int>(mSlowestRefillSec * 1000.0) << " ms"
+                      << " (runway at the preload threshold: "
+                      << (1.0f - kPreloadThreshold) * kDefaultChunkFrames / mConfig.sampleRate
+                      << " s" << (mPlannedBytes > 0 ? " at the default chunk" : "")
+                      << ")." << std::endl;
+        }
+        if (mChunkReplans > 0) {
+            std::cout << "[Streaming] Stream budget: " << mChunkReplans
+                      << " replan(s) for refills under the margin; "
+                      << static_cast<double>(mPlannedBytes) / (1 << 20)
+                      << " MB planned at exit." << std::endl;
+        }
+        // Chunk references are gone; detach from the shared service (the
+        // last session out stops its IO pool and frees the cache).
+        if (mIO) {
+            const SourceIOService::Stats st = mIO->stats();
+            std::cout << "[Streaming] Source cache: " << st.hits << " shared / "
+                      << st.misses << " read chunk(s) process-wide." << std::endl;
+            mIO.reset();
+        }
         std::cout << "[Streaming] Shutdown complete." << std::endl;
     }
 
@@ -800,36 +1313,56 @@ public:
 private:
 
     // ── Background loader thread ─────────────────────────────────────────
-    // Runs continuously, checking each source to see if the inactive buffer
-    // needs to be filled with the next chunk. Sleeps briefly between scans
-    // to avoid burning CPU.
+    // Event-driven: each pass refills every buffer whose preload threshold
+    // has been reached, then publishes the earliest future deadline in
+    // mNextWakeFrame and sleeps until the audio thread crosses it
+    // (notifyPlayhead()) or the backstop timeout expires. Deadlines are:
+    //   - inactive buffer EMPTY  → the kPreloadThreshold point of the active
+    //                              chunk (time to start the refill)
+    //   - inactive buffer READY  → the start of that chunk (the audio thread
+    //                              switches there; the following chunk can
+    //                              then be scheduled)
+    // so an idle stretch costs ~two wakeups per chunk period instead of one
+    // scan of every stream every 2 ms.
 
     void loaderWorker() {
         while (mLoaderRunning.load(std::memory_order_acquire)) {
 
+            // A pending seek takes priority over regular refills
+            const uint32_t seekSeq = mSeekSeq.load(std::memory_order_acquire);
+            if (seekSeq != mSeekHandledSeq) {
+                mSeekHandledSeq = seekSeq;
+                performSeek(mSeekFrame.load(std::memory_order_relaxed), seekSeq);
+            }
+
             // Get current playback position from engine state
             uint64_t currentFrame = mState.frameCounter.load(std::memory_order_relaxed);
 
+            uint64_t nextWake;
             if (mMultichannelMode && mMultichannelReader) {
                 // ── Multichannel (ADM direct) mode ───────────────────────
                 // All streams share the same file and chunk boundaries.
                 // We check ANY stream's active buffer to decide when to
                 // trigger a bulk read + distribute for all channels at once.
-                loaderWorkerMultichannel(currentFrame);
+                nextWake = loaderWorkerMultichannel(currentFrame);
             } else {
-                // ── Mono file mode (original behavior) ───────────────────
-                loaderWorkerMono(currentFrame);
+                // ── Mono file mode ───────────────────────────────────────
+                nextWake = loaderWorkerMono(currentFrame);
             }
+            mNextWakeFrame.store(nextWake, std::memory_order_relaxed);
 
-            // Sleep to avoid busy-waiting. 2ms is well under the audio buffer
-            // period (~10ms at 512 frames/48kHz) but frequent enough to catch
-            // preload triggers in time.
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            mLoaderWake.waitFor(std::chrono::milliseconds(kLoaderBackstopMs));
         }
     }
 
-    /// Mono mode loader: each source has its own file, load independently.
-    void loaderWorkerMono(uint64_t currentFrame) {
+    /// Mono mode loader: each source has its own file. Collects every due
+    /// refill, runs them most-urgent-first (deadline = frame at which the
+    /// active buffer runs dry), in parallel when IO helpers exist.
+    /// Returns the next wake deadline (kNoWake if none).
+    uint64_t loaderWorkerMono(uint64_t currentFrame) {
+        uint64_t nextWake = kNoWake;
+        mRefillJobs.clear();
+
         for (auto& [name, stream] : mStreams) {
             if (!stream->sndFile) continue;
 
@@ -849,36 +1382,53 @@ private:
                 ? stream->stateA.load(std::memory_order_acquire)
                 : stream->stateB.load(std::memory_order_acquire);
 
-            // Check if we've consumed enough of the active buffer to
-            // warrant preloading the next chunk into the inactive buffer.
-            // Trigger at kPreloadThreshold (50%) of the active chunk.
-            if (activeValid > 0 && inactiveState == StreamBufferState::EMPTY) {
-                uint64_t threshold = activeStart +
-                    static_cast<uint64_t>(activeValid * kPreloadThreshold);
+            // The next chunk starts where the active one's data ends (a full
+            // chunk, or a seek landing burst); nothing to schedule past the
+            // end of the file
+            uint64_t nextChunkStart = activeStart + activeValid;
+            if (activeValid == 0 || nextChunkStart >= stream->totalFrames) continue;
 
-                if (currentFrame >= threshold) {
-                    // Calculate the start of the next chunk
-                    uint64_t nextChunkStart = activeStart + stream->chunkFrames;
+            if (inactiveState == StreamBufferState::EMPTY) {
+                // Check if we've consumed enough of the active buffer to
+                // warrant preloading the next chunk into the inactive buffer.
+                uint64_t threshold = preloadPoint(activeStart, activeValid);
 
-                    // Don't load past the end of the file
-                    if (nextChunkStart < stream->totalFrames) {
-                        stream->loadChunkInto(inactive, nextChunkStart);
-                    }
+                if (currentFrame >= threshold) {
+                    mRefillJobs.push_back({stream.get(), inactive, nextChunkStart,
+                                           activeStart + activeValid});
+                } else {
+                    nextWake = std::min(nextWake, threshold);
                 }
+            } else if (inactiveState == StreamBufferState::READY) {
+                uint64_t switchAt = (inactive == 0)
+                    ? stream->chunkStartA.load(std::memory_order_acquire)
+                    : stream->chunkStartB.load(std::memory_order_acquire);
+                if (switchAt > currentFrame) nextWake = std::min(nextWake, switchAt);
+            }
+        }
+
+        if (!mRefillJobs.empty()) {
+            runRefillJobs();
+            // Each refilled stream next needs attention when it switches
+            for (const auto& job : mRefillJobs) {
+                nextWake = std::min(nextWake, job.fileFrame);
             }
+            if (streamBudgetBytes() > 0) replanIfMarginMissed();
         }
+        return nextWake;
     }
 
     /// Multichannel mode loader: one shared file, bulk read + de-interleave.
     /// All streams share chunk boundaries — check one representative stream
     /// to decide when to trigger the next bulk read.
-    void loaderWorkerMultichannel(uint64_t currentFrame) {
+    /// Returns the next wake deadline (kNoWake if none).
+    uint64_t loaderWorkerMultichannel(uint64_t currentFrame) {
         // Find a representative stream (first one) to check timing
-        if (mStreams.empty()) return;
+        if (mStreams.empty()) return kNoWake;
         auto& representative = mStreams.begin()->second;
 
         int active = representative->activeBuffer.load(std::memory_order_acquire);
-        if (active < 0) return;
+        if (active < 0) return kNoWake;
 
         uint64_t activeStart = (active == 0)
             ? representative->chunkStartA.load(std::memory_order_acquire)
@@ -892,20 +1442,253 @@ private:
             ? representative->stateA.load(std::memory_order_acquire)
             : representative->stateB.load(std::memory_order_acquire);
 
+        uint64_t nextChunkStart = activeStart + activeValid;  // see loaderWorkerMono()
+        if (activeValid == 0 || nextChunkStart >= mMultichannelReader->totalFrames()) {
+            return kNoWake;
+        }
+
         // Same preload logic as mono mode, but applied to all channels at once
-        if (activeValid > 0 && inactiveState == StreamBufferState::EMPTY) {
-            uint64_t threshold = activeStart +
-                static_cast<uint64_t>(activeValid * kPreloadThreshold);
+        if (inactiveState == StreamBufferState::EMPTY) {
+            uint64_t threshold = preloadPoint(activeStart, activeValid);
 
-            if (currentFrame >= threshold) {
-                uint64_t nextChunkStart = activeStart + representative->chunkFrames;
+            if (currentFrame < threshold) return threshold;
 
-                if (nextChunkStart < mMultichannelReader->totalFrames()) {
-                    // One bulk read + de-interleave fills ALL mapped streams
-                    mMultichannelReader->readAndDistribute(nextChunkStart, inactive);
-                }
+            // One bulk read + de-interleave fills ALL mapped streams
+            const auto t0 = std::chrono::steady_clock::now();
+            mMultichannelReader->readAndDistribute(nextChunkStart, inactive);
+            noteRefillPass(t0);
+            return nextChunkStart;
+        }
+        if (inactiveState == StreamBufferState::READY && nextChunkStart > currentFrame) {
+            return nextChunkStart;
+        }
+        return kNoWake;
+    }
+
+    // ── Seek (loader side) ───────────────────────────────────────────────
+    // Runs while the audio thread is parked (see requestSeek()), so both
+    // buffers of every stream may be rewritten. Phase 1 loads a
+    // chunkFrames / kSeekBurstDivisor landing window at targetFrame into
+    // buffer A (mono: one deadline-ordered batch across the IO helpers;
+    // ADM: one bulk read), activates A and reports the seek done. Phase 2
+    // loads the following full chunk into B while playback already runs
+    // from A; from there the regular preload schedule takes over.
+
+    void performSeek(uint64_t targetFrame, uint32_t seq) {
+        if (mMultichannelMode && mMultichannelReader) {
+            const uint64_t burst = std::max<uint64_t>(
+                1, mMultichannelReader->chunkFrames() / kSeekBurstDivisor);
+            for (auto& [name, stream] : mStreams) stream->resetForSeek();
+            const uint64_t landed = mMultichannelReader->readAndDistribute(targetFrame, 0, burst);
+            for (auto& [name, stream] : mStreams) stream->activateBufferA();
+            mSeekDoneSeq.store(seq, std::memory_order_release);
+
+            if (landed > 0 && targetFrame + landed < mMultichannelReader->totalFrames()) {
+                mMultichannelReader->readAndDistribute(targetFrame + landed, 1);
             }
+            return;
+        }
+
+        mRefillJobs.clear();
+        for (auto& [name, stream] : mStreams) {
+            if (!stream->sndFile) continue;
+            stream->resetForSeek();
+            const uint64_t burst = std::max<uint64_t>(1, stream->chunkFrames / kSeekBurstDivisor);
+            mRefillJobs.push_back({stream.get(), 0, targetFrame, targetFrame, burst});
+        }
+        runRefillJobs();
+        for (auto& [name, stream] : mStreams) {
+            if (stream->sndFile) stream->activateBufferA();
+        }
+        mSeekDoneSeq.store(seq, std::memory_order_release);
+
+        mRefillJobs.clear();
+        for (auto& [name, stream] : mStreams) {
+            if (!stream->sndFile) continue;
+            const uint64_t landed = stream->validFramesA.load(std::memory_order_acquire);
+            const uint64_t next = targetFrame + landed;
+            if (landed == 0 || next >= stream->totalFrames) continue;
+            mRefillJobs.push_back({stream.get(), 1, next, next});
+        }
+        if (!mRefillJobs.empty()) runRefillJobs();
+    }
+
+    // ── Refill scheduling (mono mode) ────────────────────────────────────
+    // mRefillJobs is filled by the loader thread only while no batch is in
+    // flight; pool threads read it only inside runBatch(), which returns
+    // once every job of the batch has finished.
+
+    struct RefillJob {
+        SourceStream* stream;
+        int           bufIdx;
+        uint64_t      fileFrame;   // chunk to load
+        uint64_t      deadline;    // frame at which the active buffer runs dry
+        uint64_t      maxFrames = ~uint64_t(0);  // < chunkFrames: seek landing burst
+    };
+
+    void runRefillJobs() {
+        std::sort(mRefillJobs.begin(), mRefillJobs.end(),
+                  [](const RefillJob& a, const RefillJob& b) { return a.deadline < b.deadline; });
+
+        const auto t0 = std::chrono::steady_clock::now();
+        if (!mParallelRefills || mRefillJobs.size() == 1) {
+            for (const auto& job : mRefillJobs) {
+                job.stream->loadChunkInto(job.bufIdx, job.fileFrame, job.maxFrames);
+            }
+        } else {
+            // Deadline order within the batch; the loader takes jobs too
+            mIO->runBatch(mRefillJobs.size(), [this](size_t i) {
+                const RefillJob& job = mRefillJobs[i];
+                job.stream->loadChunkInto(job.bufIdx, job.fileFrame, job.maxFrames);
+            });
+        }
+        noteRefillPass(t0);
+    }
+
+    // ── Refill lead (see kRefillLeadMargin) ──────────────────────────────
+
+    /// Frame at which the chunk after [activeStart, activeStart + activeValid)
+    /// must start loading: the kPreloadThreshold point, or earlier when
+    /// recent refill passes (decode included) need more runway than it leaves.
+    uint64_t preloadPoint(uint64_t activeStart, uint64_t activeValid) const {
+        const uint64_t threshold = activeStart +
+            static_cast<uint64_t>(activeValid * kPreloadThreshold);
+        const uint64_t lead = std::min(mRefillLeadFrames, activeValid);
+        return std::min(threshold, activeStart + activeValid - lead);
+    }
+
+    /// Account one refill pass that started at t0. The lead follows a slower
+    /// pass at once and relaxes by 1/8 per pass, so one cache-warm pass does
+    /// not hide a slow decode.
+    void noteRefillPass(std::chrono::steady_clock::time_point t0) {
+        const double sec = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        const uint64_t need = static_cast<uint64_t>(
+            sec * mConfig.sampleRate * kRefillLeadMargin);
+        mRefillLeadFrames = std::max(need, mRefillLeadFrames - mRefillLeadFrames / 8);
+        mSlowestRefillSec = std::max(mSlowestRefillSec, sec);
+    }
+
+    // ── Stream budget (see ChunkPlanner.hpp) ─────────────────────────────
+
+    size_t streamBudgetBytes() const {
+        return static_cast<size_t>(std::max(0, mConfig.streamBudgetMB)) << 20;
+    }
+
+    double streamMargin() const { return std::max(1.0f, mConfig.streamMargin); }
+
+    /// Size every stream's chunk to the budget. Setup thread before the
+    /// first chunks load, or the loader thread between refill batches (no
+    /// IO pool job is running then, so chunkFrames has no other reader).
+    void planChunks(const std::vector<SourceStream*>& streams) {
+        std::vector<ChunkDemand> demands(streams.size());
+        for (size_t i = 0; i < streams.size(); ++i) {
+            demands[i].totalFrames   = streams[i]->totalFrames;
+            demands[i].density       = streams[i]->density;
+            demands[i].refillSec     = streams[i]->refillSec;
+            demands[i].currentFrames = mPlannedBytes > 0 ? streams[i]->chunkFrames : 0;
         }
+        const std::vector<uint64_t> plan = ChunkPlanner::planChunkFrames(
+            demands, streamBudgetBytes(), mConfig.sampleRate, kDefaultChunkFrames,
+            1.0 - kPreloadThreshold, streamMargin());
+        for (size_t i = 0; i < streams.size(); ++i) streams[i]->chunkFrames = plan[i];
+        mPlannedBytes = ChunkPlanner::planBytes(plan);
+    }
+
+    /// After a refill batch: replan when a refilled source's last load left
+    /// less than streamMargin() × its time of runway and it can still grow.
+    /// Takes effect from each stream's next refill.
+    void replanIfMarginMissed() {
+        if (++mPassesSinceReplan < kReplanMinPasses) return;
+        const uint64_t maxFrames =
+            static_cast<uint64_t>(ChunkPlanner::kMaxChunkSec * mConfig.sampleRate);
+        bool missed = false;
+        for (const auto& job : mRefillJobs) {
+            const SourceStream* st = job.stream;
+            const double runwaySec = (1.0 - kPreloadThreshold) * st->chunkFrames / mConfig.sampleRate;
+            if (streamMargin() * st->refillSec > runwaySec &&
+                st->chunkFrames < std::min(maxFrames, st->totalFrames)) {
+                missed = true;
+                break;
+            }
+        }
+        if (!missed) return;
+        std::vector<SourceStream*> streams;
+        streams.reserve(mStreams.size());
+        for (auto& [name, stream] : mStreams) {
+            if (stream->sndFile) streams.push_back(stream.get());
+        }
+        planChunks(streams);
+        ++mChunkReplans;
+        mPassesSinceReplan = 0;
+    }
+
+    // ── Silence map indexer (see SilenceMap.hpp) ─────────────────────────
+    // Started at the end of loadScene() / loadSceneFromADM(), after the
+    // first chunks are loaded, so indexing never delays the start of
+    // playback. mSilenceIndexThreads threads take one file each from
+    // mSilenceJobs — read the .srsilence sidecar or scan the file and write
+    // it — and publish each channel's runs to its stream (release). Until a
+    // stream's runs are published it is read and rendered normally. Scans
+    // run on their own threads, not the SourceIOService pool, so they never
+    // queue ahead of deadline-ordered refills.
+
+    void startSilenceIndex() {
+        mSilentBlocks.assign(mSourceTable.size(), 0u);
+        const size_t threads = std::min<size_t>(
+            static_cast<size_t>(std::max(0, mConfig.silenceIndexThreads)), mSilenceJobs.size());
+        if (threads == 0) {
+            mSilenceJobs.clear();   // markSilentBlocks() → nullptr
+            return;
+        }
+        mSilenceCancel.store(false, std::memory_order_relaxed);
+        mSilenceNext.store(0, std::memory_order_relaxed);
+        mSilenceDone.store(0, std::memory_order_relaxed);
+        for (size_t t = 0; t < threads; ++t) {
+            mSilenceThreads.emplace_back([this]() { silenceIndexWorker(); });
+        }
+    }
+
+    void stopSilenceIndex() {
+        mSilenceCancel.store(true, std::memory_order_relaxed);
+        for (auto& t : mSilenceThreads) {
+            if (t.joinable()) t.join();
+        }
+        mSilenceThreads.clear();
+    }
+
+    void silenceIndexWorker() {
+        for (;;) {
+            const size_t j = mSilenceNext.fetch_add(1, std::memory_order_relaxed);
+            if (j >= mSilenceJobs.size() || mSilenceCancel.load(std::memory_order_relaxed)) return;
+            SilenceJob& job = mSilenceJobs[j];
+            if (!SilenceMap::load(job.path, job.runs, &mSilenceCancel)) continue;
+            for (const auto& [ch, stream] : job.channels) {
+                if (ch < 0 || static_cast<size_t>(ch) >= job.runs.size()) continue;
+                const SilenceRuns& runs = job.runs[static_cast<size_t>(ch)];
+                stream->silence.store(&runs, std::memory_order_release);
+                mSilentFramesIndexed.fetch_add(runs.silentFrames(), std::memory_order_relaxed);
+                mFramesIndexed.fetch_add(runs.totalFrames, std::memory_order_relaxed);
+            }
+            if (mSilenceDone.fetch_add(1, std::memory_order_acq_rel) + 1 == mSilenceJobs.size()) {
+                const uint64_t total = mFramesIndexed.load(std::memory_order_relaxed);
+                std::cout << "[Streaming] Silence map ready: "
+                          << (total ? 100.0 * mSilentFramesIndexed.load(std::memory_order_relaxed) / total : 0.0)
+                          << "% of " << mSilenceJobs.size() << " file(s) skippable." << std::endl;
+            }
+        }
+    }
+
+    // ── Shared IO service ────────────────────────────────────────────────
+    // Attached at scene load (the first chunks already go through the
+    // cache). Released in shutdown() after every stream is destroyed.
+
+    size_t sourceCacheBytes() const {
+        return static_cast<size_t>(std::max(0, mConfig.sourceCacheMB)) << 20;
+    }
+
+    void attachIOService() {
+        if (!mIO) mIO = SourceIOService::attach(0, sourceCacheBytes());
     }
 
     // ── Channel index parsing ────────────────────────────────────────────
@@ -942,6 +1725,25 @@ private:
         return -1;
     }
 
+    // ── Handle column ────────────────────────────────────────────────────
+    // Called at the end of loadScene() / loadSceneFromADM(), after mStreams
+    // is final. The unique_ptrs in mStreams own the streams; this column
+    // only borrows them and is cleared alongside mStreams in shutdown().
+
+    void indexStreamsByHandle() {
+        mStreamByHandle.assign(mSourceTable.size(), nullptr);
+        for (auto& [name, stream] : mStreams) {
+            SourceHandle h = mSourceTable.find(name);
+            if (h != kInvalidSource) mStreamByHandle[static_cast<size_t>(h)] = stream.get();
+            stream->missTotal = &mMissTotal;
+        }
+    }
+
+    const SourceStream* streamFor(SourceHandle handle) const {
+        if (handle < 0 || static_cast<size_t>(handle) >= mStreamByHandle.size()) return nullptr;
+        return mStreamByHandle[static_cast<size_t>(handle)];
+    }
+
     // ── Member data ──────────────────────────────────────────────────────
 
     RealtimeConfig& mConfig;
@@ -950,6 +1752,15 @@ private:
     // All active source streams, keyed by source name (e.g., "1.1", "LFE")
     std::map<std::string, std::unique_ptr<SourceStream>> mStreams;
 
+    // Dense handle → stream column (parallel to mSourceTable; nullptr for
+    // scene sources that were skipped). Built once at load time and read
+    // by getBlock() / getSample() on the audio thread instead of mStreams.
+    SourceTable                 mSourceTable;
+    std::vector<SourceStream*>  mStreamByHandle;
+
+    // Sum of every stream's misses (see SourceStream::missTotal)
+    alignas(64) std::atomic<uint64_t> mMissTotal{0};
+
     // ── Multichannel (ADM direct) mode ───────────────────────────────────
     // When true, sources are read from one multichannel file via the reader,
     // not from individual mono files.
@@ -959,6 +1770,55 @@ private:
     // Background loader thread
     std::thread          mLoaderThread;
     std::atomic<bool>    mLoaderRunning{false};
+
+    // Event-driven scheduling: earliest frame at which the loader must run
+    // again (written by the loader; cleared to kNoWake by the audio thread
+    // when it posts mLoaderWake).
+    static constexpr uint64_t kNoWake = ~uint64_t(0);
+    alignas(64) std::atomic<uint64_t> mNextWakeFrame{0};
+    LoaderSignal         mLoaderWake;
+
+    // Seek handshake (see requestSeek()). mSeekFrame / mSeekSeq written by
+    // the audio thread, mSeekDoneSeq by the loader; mSeekHandledSeq is
+    // loader-private.
+    std::atomic<uint64_t> mSeekFrame{0};
+    std::atomic<uint32_t> mSeekSeq{0};
+    std::atomic<uint32_t> mSeekDoneSeq{0};
+    uint32_t              mSeekHandledSeq = 0;
+
+    // Process-wide chunk cache + IO pool, shared with every other session
+    // (see SourceIOService.hpp). Parallel mono-mode refills go to its pool
+    // when loaderThreads > 1.
+    std::shared_ptr<SourceIOService> mIO;
+    std::vector<RefillJob>           mRefillJobs;
+    bool                             mParallelRefills = false;
+
+    // Refill pass timing (loader thread only; read at shutdown after join)
+    uint64_t mRefillLeadFrames = 0;
+    double   mSlowestRefillSec = 0.0;
+
+    // Silence map indexer (see startSilenceIndex()). mSilenceJobs is fixed
+    // before the threads start; each job's runs are written by the one
+    // thread that takes it, then only read. mSilentBlocks: audio thread.
+    struct SilenceJob {
+        std::string                                path;      // audio file to index
+        std::vector<std::pair<int, SourceStream*>> channels;  // file channel → stream
+        std::vector<SilenceRuns>                   runs;      // per file channel
+    };
+    std::vector<SilenceJob>  mSilenceJobs;
+    std::vector<std::thread> mSilenceThreads;
+    std::atomic<bool>        mSilenceCancel{false};
+    std::atomic<size_t>      mSilenceNext{0};
+    std::atomic<size_t>      mSilenceDone{0};
+    std::atomic<uint64_t>    mFramesIndexed{0};
+    std::atomic<uint64_t>    mSilentFramesIndexed{0};
+    std::vector<uint8_t>     mSilentBlocks;
+
+    // Stream budget state (setup thread, then loader thread only).
+    // mPlannedBytes > 0 ⇔ chunks were sized by ChunkPlanner.
+    size_t   mPlannedBytes      = 0;
+    int      mPassesSinceReplan = 0;
+    int      mChunkReplans      = 0;
 };
 
 
@@ -969,49 +1829,82 @@ private:
 // MultichannelReader.hpp, because they need access to SourceStream's members.
 // This is standard C++ practice for breaking circular header dependencies.
 
-inline void MultichannelReader::deinterleaveInto(
-    SourceStream* stream, int bufIdx, int channelIndex,
-    uint64_t framesRead, uint64_t fileFrame)
-{
-    auto& buffer = (bufIdx == 0) ? stream->bufferA : stream->bufferB;
-    auto& state  = (bufIdx == 0) ? stream->stateA  : stream->stateB;
-    auto& start  = (bufIdx == 0) ? stream->chunkStartA : stream->chunkStartB;
-    auto& valid  = (bufIdx == 0) ? stream->validFramesA : stream->validFramesB;
-
-    state.store(StreamBufferState::LOADING, std::memory_order_release);
-
-    // De-interleave: extract this channel from the interleaved buffer.
-    // Interleaved layout: [ch0_f0, ch1_f0, ..., chN_f0, ch0_f1, ch1_f1, ...]
-    // For frame i, channel c: interleavedBuffer[i * numChannels + c]
-    const float* src = mInterleavedBuffer.data();
-    float* dst = buffer.data();
-
-    for (uint64_t i = 0; i < framesRead; ++i) {
-        dst[i] = src[i * mNumChannels + channelIndex];
+inline void MultichannelReader::markLoading(int bufIdx) {
+    for (auto& [chIdx, stream] : mChannelMap) {
+        auto& state = (bufIdx == 0) ? stream->stateA : stream->stateB;
+        state.store(StreamBufferState::LOADING, std::memory_order_release);
+        stream->dropChunk(bufIdx);
     }
+}
 
-    // Zero-fill remainder if we read less than the chunk size
-    if (framesRead < stream->chunkFrames) {
-        std::memset(dst + framesRead, 0,
-                    (stream->chunkFrames - framesRead) * sizeof(float));
+inline void MultichannelReader::publishAll(int bufIdx, uint64_t fileFrame) {
+    size_t i = 0;
+    for (auto& [chIdx, stream] : mChannelMap) {
+        stream->publishChunk(bufIdx, i < mChunkRefs.size() ? std::move(mChunkRefs[i]) : nullptr,
+                             fileFrame);
+        ++i;
     }
+    mChunkRefs.clear();
+}
 
-    start.store(fileFrame, std::memory_order_release);
-    valid.store(framesRead, std::memory_order_release);
-    state.store(StreamBufferState::READY, std::memory_order_release);
+inline void MultichannelReader::keyAudibleChannels(uint64_t fileFrame, uint64_t frames) {
+    mKeys.clear();
+    mKeySlot.clear();
+    mChunkRefs.assign(mChannelMap.size(), nullptr);
+    SourceChunkRef zero;
+    size_t i = 0;
+    for (auto& [ch, stream] : mChannelMap) {
+        const SilenceRuns* runs = stream->silence.load(std::memory_order_acquire);
+        if (runs && runs->covers(fileFrame, fileFrame + frames)) {
+            if (!zero) zero = mIO->acquireSilence(frames, mChunkFrames);
+            mChunkRefs[i] = zero;
+        } else {
+            mKeys.push_back({mCacheFile, ch, fileFrame, frames, mChunkFrames});
+            mKeySlot.push_back(i);
+        }
+        ++i;
+    }
 }
 
-inline void MultichannelReader::zeroFillBuffer(
-    SourceStream* stream, int bufIdx, uint64_t fileFrame)
+inline uint64_t MultichannelReader::fillTargets(
+    const SourceIOService::FillTargets& targets, uint64_t fileFrame, uint64_t frames)
 {
-    auto& buffer = (bufIdx == 0) ? stream->bufferA : stream->bufferB;
-    auto& state  = (bufIdx == 0) ? stream->stateA  : stream->stateB;
-    auto& start  = (bufIdx == 0) ? stream->chunkStartA : stream->chunkStartB;
-    auto& valid  = (bufIdx == 0) ? stream->validFramesA : stream->validFramesB;
-
-    state.store(StreamBufferState::LOADING, std::memory_order_release);
-    std::memset(buffer.data(), 0, stream->chunkFrames * sizeof(float));
-    start.store(fileFrame, std::memory_order_release);
-    valid.store(0, std::memory_order_release);
-    state.store(StreamBufferState::READY, std::memory_order_release);
+    if (mMapped.isOpen()) {
+        // 1024 frames × 64 ch × 4 bytes = 256 KB of source per tile — L2-sized
+        static constexpr uint64_t kTileFrames = 1024;
+        for (uint64_t t = 0; t < frames; t += kTileFrames) {
+            const uint64_t n = std::min(kTileFrames, frames - t);
+            for (const auto& [keyIdx, dst] : targets) {
+                mMapped.readChannel(mKeys[keyIdx].channel, fileFrame + t, n, dst + t);
+            }
+        }
+        // Chunk is copied out: drop its pages, start reading the next one
+        mMapped.release(fileFrame, frames);
+        mMapped.prefetch(fileFrame + frames, mChunkFrames);
+        return frames;
+    }
+
+    sf_count_t framesRead = 0;
+    {
+        std::lock_guard<std::mutex> lock(mFileMutex);
+        if (mSfPos != static_cast<sf_count_t>(fileFrame)) {  // see SourceStream::readFrames()
+            mSfPos = sf_seek(mSndFile, static_cast<sf_count_t>(fileFrame), SEEK_SET);
+        }
+        framesRead = sf_readf_float(mSndFile, mInterleavedBuffer.data(),
+                                     static_cast<sf_count_t>(frames));
+        mSfPos = (mSfPos >= 0 && framesRead > 0) ? mSfPos + framesRead : -1;
+    }
+    if (framesRead <= 0) return 0;
+
+    // Interleaved layout: [ch0_f0, ch1_f0, ..., chN_f0, ch0_f1, ch1_f1, ...]
+    // Targets follow mChannelMap's channel order, so runs of consecutive
+    // channels reach the kernel's SIMD path.
+    mTargets.clear();
+    for (const auto& [keyIdx, dst] : targets) {
+        mTargets.push_back({mKeys[keyIdx].channel, dst});
+    }
+    deinterleaveTargets(mInterleavedBuffer.data(), mNumChannels,
+                        static_cast<uint64_t>(framesRead),
+                        mTargets.data(), mTargets.size());
+    return static_cast<uint64_t>(framesRead);
 }
@@ -5,8 +5,8 @@
 //
 // This test does NOT require audio hardware or test data files. It exercises
 // the lifecycle methods and all V1.1 runtime setter methods. configureEngine()
-// succeeds; loadScene() will fail (no scene file provided) and the test handles
-// that gracefully. The setters are called directly to verify they compile and link.
+// succeeds; both loadScene() overloads will fail (no scene file / no source
+// files) and the test handles that gracefully. The setters are called directly to verify they compile and link.
 //
 // Stage 2 completion bar: this file compiles, links EngineSessionCore, calls the
 // full lifecycle, calls all six runtime setter methods, reads queryStatus() and
@@ -14,6 +14,7 @@
 
 #include "EngineSession.hpp"
 #include "RealtimeTypes.hpp"
+#include "JSONLoader.hpp"
 #include <iostream>
 #include <cassert>
 
@@ -44,6 +45,16 @@ int main() {
               << (!ok ? "FAIL (correct)" : "unexpected OK") << "\n";
     std::cout << "[embedding_test]   error: " << session.getLastError() << "\n\n";
 
+    // ── loadScene, in-memory handoff (expected to fail — no source files) ─
+    SpatialData memScene;
+    memScene.sampleRate = 48000;
+    memScene.sources["1.1"] = {{0.0, 0.0f, 1.0f, 0.0f}, {1.0, 1.0f, 0.0f, 0.0f}};
+
+    ok = session.loadScene(scene, std::move(memScene));
+    std::cout << "[embedding_test] loadScene in-memory (expected FAIL): "
+              << (!ok ? "FAIL (correct)" : "unexpected OK") << "\n";
+    std::cout << "[embedding_test]   error: " << session.getLastError() << "\n\n";
+
     // ── V1.1 runtime setter surface ───────────────────────────────────────
     // Calling setters before start() writes the atomics (harmless, no effect on engine).
     // Primary purpose here: verify all six methods compile and link against EngineSessionCore.
@@ -1,5 +1,7 @@
 // internal_validation_runner.cpp
 #include "EngineSession.hpp"
+#include "RtSafety.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <thread>
@@ -39,6 +41,16 @@ int main() {
         return 1;
     }
 
+    // Real-time contract checks: callback latency against the block budget
+    // always; allocation / lock / I/O calls inside processBlock() when built
+    // with -DSPATIALROOT_RT_SAFETY=ON (RtSafety.hpp).
+    const double budgetUs = 1e6 * eCfg.bufferSize / eCfg.sampleRate;
+    const int callbackStage = static_cast<int>(ProfileStage::Callback);
+    float worstP99Us = 0.0f, worstMaxUs = 0.0f;
+    uint64_t overruns = 0, rtViolations = 0;
+    size_t samplesPrinted = 0;
+    constexpr size_t kMaxSamplesPrinted = 8;
+
     // Main Thread Render Loop
     for (int i = 0; i < 600; ++i) { // 10 seconds at 60fps UI tick
         session.update(); // CRITICAL: processes focus compensation
@@ -50,14 +62,38 @@ int main() {
             std::cout << "Engine Warning: Relocation Event\n";
         }
 
+        for (const DiagEvent& e : diagnostics.events) {
+            if (e.type == DiagEventType::CpuOverrun) ++overruns;
+        }
+        rtViolations += diagnostics.rtViolations;
+        for (const RtViolationReport& r : diagnostics.rtViolationSamples) {
+            if (samplesPrinted++ >= kMaxSamplesPrinted) break;
+            std::cout << "RT Violation: " << r.kind << " at frame " << r.frame << "\n";
+            for (const std::string& line : r.stack) std::cout << "    " << line << "\n";
+        }
+        worstP99Us = std::max(worstP99Us, status.stageTiming[callbackStage].p99Us);
+        worstMaxUs = std::max(worstMaxUs, status.stageTiming[callbackStage].maxUs);
+
         // Test transport constraint
         if (i == 300) session.setPaused(true);
         if (i == 360) session.setPaused(false);
+        if (i == 420) session.seek(2.0);
 
         std::this_thread::sleep_for(std::chrono::milliseconds(16));
     }
 
     // 6. Strict Teardown sequence triggered internally by shutdown()
     session.shutdown();
+
+    std::cout << "Callback: worst p99 " << worstP99Us << " us, worst max " << worstMaxUs
+              << " us, budget " << budgetUs << " us, " << overruns << " overrun(s)\n";
+    std::cout << "RT safety: "
+              << (RtSafety::kEnabled ? std::to_string(rtViolations) + " violation(s)"
+                                     : std::string("not instrumented (-DSPATIALROOT_RT_SAFETY=ON)"))
+              << "\n";
+    if (rtViolations > 0 || worstP99Us > budgetUs) {
+        std::cerr << "Validation Fail: real-time contract broken\n";
+        return 1;
+    }
     return 0;
 }
@@ -4,12 +4,15 @@
 #include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 #include <chrono>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
 
 #include "RealtimeTypes.hpp"
 #include "EngineSession.hpp"
+#include "RtSafety.hpp"
 
 // Phase 10 — GUI Agent: OSC parameter server
 // Only needed for list-devices in main, actually AlloLib AudioDevice is used below.
@@ -64,6 +67,34 @@ static bool hasArg(int argc, char* argv[], const std::string& flag) {
     return false;
 }
 
+// "a,b,c" → {"a", "b", "c"} (empty items dropped)
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start <= s.size()) {
+        const size_t comma = std::min(s.find(',', start), s.size());
+        if (comma > start) out.push_back(s.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return out;
+}
+
+// "0-31,40,42" → {0, ..., 31, 40, 42}. Returns false on a malformed item.
+static bool parseIndexList(const std::string& s, std::vector<int>& out) {
+    for (const std::string& item : splitList(s)) {
+        try {
+            const size_t dash = item.find('-', 1);
+            const int lo = std::stoi(item.substr(0, dash));
+            const int hi = (dash == std::string::npos) ? lo : std::stoi(item.substr(dash + 1));
+            if (lo < 0 || hi < lo) return false;
+            for (int i = lo; i <= hi; ++i) out.push_back(i);
+        } catch (...) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Usage / help
 // ─────────────────────────────────────────────────────────────────────────────
@@ -90,7 +121,42 @@ static void printUsage(const char* progName) {
               << "  --remap <path>      [DEPRECATED] CSV override for output routing. Not a\n"
               << "                       supported workflow — routing is now layout-derived.\n"
               << "                       Retained as internal scaffolding during validation.\n"
+              << "  --render_threads <int> Spatializer render threads incl. the audio thread\n"
+              << "                       (default: 1; >1 splits sources across cores)\n"
+              << "  --loader_threads <int> Streaming refill threads incl. the loader thread\n"
+              << "                       (default: 2; parallel reads of mono source files)\n"
+              << "  --source_cache_mb <int> Keep up to N MB of released source chunks for\n"
+              << "                       re-use (default: 0 = only chunks being played)\n"
+              << "  --stream_budget_mb <int> Fit all source double buffers in N MB, sizing each\n"
+              << "                       source's chunk (default: 0 = fixed 10 s chunks)\n"
+              << "  --stream_margin <float> Stream budget: runway per refill time a source\n"
+              << "                       must keep before its chunk grows (default: 4.0)\n"
+              << "  --silence_threads <int> Background threads indexing digital silence so\n"
+              << "                       silent ranges are not read or rendered (default: 2, 0 = off)\n"
+              << "  --pose_bake <frames> Precompute source trajectories every N frames on a\n"
+              << "                       background thread (default: 0 = evaluate live; e.g. 64)\n"
+              << "  --sparse_k <int>    Mix each source into only its K strongest speakers,\n"
+              << "                       energy-renormalized (default: 0 = all; e.g. 8 for 100+ speaker domes)\n"
+              << "  --output_channels <int> Open at least this many device channels, so a wider\n"
+              << "                       layout can be hot-swapped in via OSC (default: 0 = layout)\n"
+              << "  --bounce <path>     Render offline through the realtime path as fast as the\n"
+              << "                       CPU allows to a multichannel WAV, then exit (no device)\n"
+              << "  --bounce_sec <float> Bounce length in seconds (default: scene duration)\n"
               << "  --osc_port <int>    UDP port for al::ParameterServer OSC control (default: 9009)\n"
+              << "  --profile           Print per-stage callback timing (p50/p99/max µs) every 5 s\n"
+              << "  --profile_osc_port <int> Send stage timings once per second as OSC to\n"
+              << "                       127.0.0.1:<port> (/realtime/profile/<stage>; default: off)\n"
+              << "  --diagnostics <n>   Channel mask / RMS monitoring rate (default: 1):\n"
+              << "                       0 = off, 1 = every --diag_every blocks, 2 = every block\n"
+              << "  --diag_every <int>  Decimation period in blocks for --diagnostics 1 (default: 8)\n"
+              << "  --cluster <role>    Multi-node playback: leader | follower (default: off).\n"
+              << "                       Every node runs the same scene and layout\n"
+              << "  --cluster_peers <list> Leader: followers as host:port,host:port,...\n"
+              << "  --cluster_port <int> Follower: UDP port for the leader clock (default: 9110)\n"
+              << "  --cluster_speakers <list> Layout speaker indices this node renders, e.g.\n"
+              << "                       0-31,40 (default: all; output starts at device channel 0)\n"
+              << "  --cluster_subs <list> Layout subwoofer indices this node renders (default:\n"
+              << "                       all if --cluster_speakers is not given, else none)\n"
               << "  --device <name>     Exact name of the output audio device to open.\n"
               << "  --list-devices      List available output audio devices and exit.\n"
               << "  --help              Show this message\n\n"
@@ -147,6 +213,39 @@ int main(int argc, char* argv[]) {
     
     int elModeInt = getArgInt(argc, argv, "--elevation_mode", 0);
     opts.elevationMode = static_cast<ElevationMode>(std::max(0, std::min(2, elModeInt)));
+    opts.renderThreads = std::max(1, getArgInt(argc, argv, "--render_threads", 1));
+    opts.loaderThreads = std::max(1, getArgInt(argc, argv, "--loader_threads", 2));
+    opts.sourceCacheMB = std::max(0, getArgInt(argc, argv, "--source_cache_mb", 0));
+    opts.streamBudgetMB = std::max(0, getArgInt(argc, argv, "--stream_budget_mb", 0));
+    opts.streamMargin = std::max(1.0f, getArgFloat(argc, argv, "--stream_margin", 4.0f));
+    opts.silenceIndexThreads = std::max(0, getArgInt(argc, argv, "--silence_threads", 2));
+    opts.poseBakeFrames = std::max(0, getArgInt(argc, argv, "--pose_bake", 0));
+    opts.outputChannels = std::max(0, getArgInt(argc, argv, "--output_channels", 0));
+    opts.sparseTopK = std::max(0, getArgInt(argc, argv, "--sparse_k", 0));
+    opts.profileOscPort = std::max(0, getArgInt(argc, argv, "--profile_osc_port", 0));
+    const bool printProfile = hasArg(argc, argv, "--profile");
+    // Headless default is decimated: the status line below polls every 500 ms.
+    int diagTierInt = getArgInt(argc, argv, "--diagnostics", 1);
+    opts.diagnosticsTier  = static_cast<DiagnosticsTier>(std::max(0, std::min(2, diagTierInt)));
+    opts.diagnosticsEvery = std::max(1, getArgInt(argc, argv, "--diag_every", 8));
+
+    const std::string clusterRole = getArgString(argc, argv, "--cluster");
+    if (clusterRole == "leader") {
+        opts.clusterRole = ClusterRole::Leader;
+    } else if (clusterRole == "follower") {
+        opts.clusterRole = ClusterRole::Follower;
+    } else if (!clusterRole.empty()) {
+        std::cerr << "[Main] ERROR: --cluster must be leader or follower." << std::endl;
+        return 1;
+    }
+    opts.clusterPort  = getArgInt(argc, argv, "--cluster_port", 9110);
+    opts.clusterPeers = splitList(getArgString(argc, argv, "--cluster_peers"));
+    if (!parseIndexList(getArgString(argc, argv, "--cluster_speakers"), opts.clusterSpeakers)
+        || !parseIndexList(getArgString(argc, argv, "--cluster_subs"), opts.clusterSubwoofers)) {
+        std::cerr << "[Main] ERROR: --cluster_speakers / --cluster_subs take indices and"
+                     " ranges like 0-31,40." << std::endl;
+        return 1;
+    }
 
     // 2) Define scene configuration (LUSID metadata + media sources).
     SceneInput sceneIn;
@@ -194,12 +293,27 @@ int main(int argc, char* argv[]) {
         std::cerr << "Runtime config failed: " << session.getLastError() << std::endl; return 1;
     }
 
+    // --bounce: freewheel render to a file instead of opening the device.
+    const std::string bouncePath = getArgString(argc, argv, "--bounce");
+    if (!bouncePath.empty()) {
+        BounceOptions bOpts;
+        bOpts.outputPath  = bouncePath;
+        bOpts.durationSec = std::max(0.0f, getArgFloat(argc, argv, "--bounce_sec", 0.0f));
+        bOpts.cancel      = &g_shouldExit;
+        const bool ok = session.bounce(bOpts);
+        if (!ok) std::cerr << "Bounce failed: " << session.getLastError() << std::endl;
+        session.shutdown();
+        return ok ? 0 : 1;
+    }
+
     if (!session.start()) {
         std::cerr << "Start failed: " << session.getLastError() << std::endl; return 1;
     }
 
     std::cout << "[Main] Engine started successfully. Press Ctrl+C to stop.\n" << std::endl;
 
+    int profileTick = 0;
+    uint64_t lastDropped = 0;
     while (!g_shouldExit.load(std::memory_order_relaxed)) {
         EngineStatus status = session.queryStatus();
         if (status.isExitRequested) break;
@@ -208,42 +322,66 @@ int main(int argc, char* argv[]) {
 
         DiagnosticEvents ev = session.consumeDiagnostics();
 
-        double timeSec = status.timeSec;
         constexpr float kEventRmsGate = 0.005f;
         float mainRmsGate = status.mainRms;
 
-        if (ev.renderRelocEvent) {
-            std::cout << "\n[RELOC-RENDER] t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  mask: 0x" << std::hex << ev.renderRelocPrev
-                      << " → 0x" << ev.renderRelocNext << std::dec << std::endl;
-        }
-        if (ev.deviceRelocEvent) {
-            std::cout << "\n[RELOC-DEVICE] t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  mask: 0x" << std::hex << ev.deviceRelocPrev
-                      << " → 0x" << ev.deviceRelocNext << std::dec << std::endl;
-        }
-        if (ev.renderDomRelocEvent && mainRmsGate > kEventRmsGate) {
-            std::cout << "\n[DOM-RENDER]   t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  dom: 0x" << std::hex << ev.renderDomRelocPrev
-                      << " → 0x" << ev.renderDomRelocNext << std::dec << std::endl;
+        // Every event since the last poll, stamped with its own block time.
+        // GUARD events are left to the SpkG counter on the status line.
+        for (const DiagEvent& e : ev.events) {
+            const bool gated = e.type == DiagEventType::RenderDomReloc
+                            || e.type == DiagEventType::DeviceDomReloc
+                            || e.type == DiagEventType::RenderCluster
+                            || e.type == DiagEventType::DeviceCluster;
+            if (e.type == DiagEventType::GuardFire) continue;
+            if (gated && mainRmsGate <= kEventRmsGate) continue;
+
+            const double eventSec = static_cast<double>(e.frame) / opts.sampleRate;
+            std::cout << "\n[" << diagEventName(e.type) << "] t=" << std::fixed
+                      << std::setprecision(3) << eventSec << "s  ";
+            switch (e.type) {
+                case DiagEventType::Underrun:
+                    std::cout << e.count << " samples missed"; break;
+                case DiagEventType::NanClamp:
+                    std::cout << "post-render clamp fired"; break;
+                case DiagEventType::CpuOverrun:
+                    std::cout << "load=" << std::setprecision(2) << e.value; break;
+                case DiagEventType::RtViolation:
+                    std::cout << e.count << " call(s):";
+                    for (size_t k = 0; k < kNumRtViolationKinds; ++k)
+                        if (e.next & (uint64_t{1} << k))
+                            std::cout << " " << rtViolationName(static_cast<RtViolationKind>(k));
+                    break;
+                default:
+                    std::cout << "0x" << std::hex << e.prev << " → 0x" << e.next << std::dec; break;
+            }
+            std::cout << std::endl;
         }
-        if (ev.deviceDomRelocEvent && mainRmsGate > kEventRmsGate) {
-            std::cout << "\n[DOM-DEVICE]   t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  dom: 0x" << std::hex << ev.deviceDomRelocPrev
-                      << " → 0x" << ev.deviceDomRelocNext << std::dec << std::endl;
+        // RT-safety builds: where the offending calls came from
+        for (const RtViolationReport& r : ev.rtViolationSamples) {
+            std::cout << "\n[RT-VIOLATION] " << r.kind << " at frame " << r.frame << ":\n";
+            for (const std::string& line : r.stack) std::cout << "    " << line << "\n";
+            std::cout << std::flush;
         }
-        if (ev.renderClusterEvent && mainRmsGate > kEventRmsGate) {
-            std::cout << "\n[CLUSTER-RENDER] t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  top4: 0x" << std::hex << ev.renderClusterPrev
-                      << " → 0x" << ev.renderClusterNext << std::dec << std::endl;
+        if (ev.dropped != lastDropped) {
+            std::cout << "\n[DIAG] " << (ev.dropped - lastDropped)
+                      << " events dropped (ring full)" << std::endl;
+            lastDropped = ev.dropped;
         }
-        if (ev.deviceClusterEvent && mainRmsGate > kEventRmsGate) {
-            std::cout << "\n[CLUSTER-DEVICE] t=" << std::fixed << std::setprecision(2)
-                      << timeSec << "s  top4: 0x" << std::hex << ev.deviceClusterPrev
-                      << " → 0x" << ev.deviceClusterNext << std::dec << std::endl;
+
+        // --profile: per-stage timing every 10 polls (5 s)
+        if (printProfile && ++profileTick >= 10) {
+            profileTick = 0;
+            std::cout << "\n[PROFILE] µs p50/p99/max:";
+            for (int i = 0; i < kNumProfileStages; ++i) {
+                const StageTiming& t = status.stageTiming[i];
+                std::cout << "  " << profileStageName(static_cast<ProfileStage>(i)) << "="
+                          << std::fixed << std::setprecision(0)
+                          << t.p50Us << "/" << t.p99Us << "/" << t.maxUs;
+            }
+            std::cout << std::endl;
         }
 
-        std::cout << "\r  t=" << std::fixed << std::setprecision(1) << timeSec << "s"
+        std::cout << "\r  t=" << std::fixed << std::setprecision(1) << status.timeSec << "s"
                   << "  CPU=" << (status.cpuLoad * 100.0f) << "%"
                   << "  rDom=0x" << std::hex << status.renderDomMask
                   << "  dDom=0x" << status.deviceDomMask
@@ -254,8 +392,17 @@ int main(int argc, char* argv[]) {
                   << "  Xrun=" << status.xruns
                   << "  NaN=" << status.nanGuardCount
                   << "  SpkG=" << status.speakerProximityCount
-                  << "  " << (status.paused ? "PAUSED " : "PLAYING")
-                  << "     " << std::flush;
+                  << "  " << (status.seeking ? "SEEKING" : status.paused ? "PAUSED " : "PLAYING");
+        if (status.clusterRole == ClusterRole::Follower) {
+            if (status.clusterLinkAgeMs < 0.0) {
+                std::cout << "  Leader=waiting";
+            } else {
+                std::cout << "  Leader=" << std::setprecision(2) << status.clusterOffsetMs << "ms"
+                          << "  Resync=" << status.clusterResyncs;
+                if (status.clusterLinkAgeMs > 1000.0) std::cout << "  LINK LOST";
+            }
+        }
+        std::cout << "     " << std::flush;
 
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
@@ -0,0 +1,461 @@
+// spatialroot_bench.cpp — Headless microbenchmark / scaling suite for the render kernels
+//
+// Drives the realtime agents (Pose::computePositions(), Streaming::getBlock(),
+// Spatializer::renderBlock()) and the offline SpatialRenderer (render() →
+// renderPerBlock()) with synthetic scenes, without an audio device, and
+// prints one JSON document with per-configuration timings. The point is a
+// stable, scriptable number for each kernel so optimizations can be compared
+// and regressions tracked — callbackCpuLoad on a live device is too noisy.
+//
+// SYNTHETIC SCENE (per configuration):
+//   - speakers: golden-spiral dome, elevation 0–60°, radius 5 m, one sub.
+//   - sources:  mono white noise, kSourceSec long (fits Streaming's first
+//     chunk, so getBlock() never waits on the loader), one "LFE" source.
+//     A fast-mover fraction orbits at kFastRadPerSec (past the Spatializer's
+//     sub-stepping threshold at every block size ≥ 128); the rest drift at
+//     kSlowRadPerSec, so neither path is served from the gain cache.
+//   - WAVs are written to a temp directory for Streaming and removed on exit;
+//     the offline renderer gets the same samples in memory.
+//
+// MEASUREMENTS (steady_clock, after kWarmupBlocks untimed blocks):
+//   pose / getBlock / spatializer — realtime stages, timed separately, so
+//     spatializer includes its own getBlock() calls.
+//   realtime    — pose + spatializer, i.e. one callback's render work.
+//   offline     — SpatialRenderer::render() over the same number of blocks.
+// Each reports nsPerBlock, nsPerSourceBlock and realtimeFactor (audio
+// seconds per wall second). allocations counts operator new calls during the
+// timed loop on any thread; the realtime stages must report 0.
+//
+// Usage: spatialroot_bench [--sources 16,64] [--speakers 8,32,128]
+//         [--block 128,512] [--focus 1.5] [--fast 0.25] [--blocks 2000]
+//         [--render_threads 1] [--sparse_k 0] [--no_offline] [--out file.json]
+// Comma lists are swept as a full cross product.
+
+#include "RealtimeTypes.hpp"
+#include "JSONLoader.hpp"
+#include "LayoutLoader.hpp"
+#include "Streaming.hpp"
+#include "Pose.hpp"
+#include "Spatializer.hpp"
+#include "SpatialRenderer.hpp"
+
+#include <sndfile.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Allocation counter — replaces global operator new for this executable only
+// ─────────────────────────────────────────────────────────────────────────────
+
+static std::atomic<uint64_t> g_allocCount{0};
+
+void* operator new(std::size_t n) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Options
+// ─────────────────────────────────────────────────────────────────────────────
+
+static constexpr int    kSampleRate     = 48000;
+static constexpr double kSourceSec      = 4.0;     // < Streaming kDefaultChunkFrames
+static constexpr double kKeyframeSec    = 0.005;
+static constexpr double kFastRadPerSec  = 120.0;   // 0.32 rad per 128-frame block
+static constexpr double kSlowRadPerSec  = 0.5;
+static constexpr int    kWarmupBlocks   = 50;
+static constexpr double kPi             = 3.14159265358979323846;
+
+struct BenchOptions {
+    std::vector<int> sources   = {16, 64};
+    std::vector<int> speakers  = {8, 32, 128};
+    std::vector<int> blocks    = {128, 512};
+    float focus         = 1.5f;
+    float fastFraction  = 0.25f;
+    int   timedBlocks   = 2000;
+    int   renderThreads = 1;
+    int   sparseTopK    = 0;
+    bool  offline       = true;
+    std::string outPath;
+};
+
+static std::vector<int> parseList(const std::string& s) {
+    std::vector<int> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        try { out.push_back(std::max(1, std::stoi(item))); } catch (...) {}
+    }
+    return out;
+}
+
+static bool parseArgs(int argc, char* argv[], BenchOptions& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasVal = (i + 1 < argc);
+        auto val = [&]() { return std::string(argv[++i]); };
+        if      (a == "--sources"        && hasVal) o.sources  = parseList(val());
+        else if (a == "--speakers"       && hasVal) o.speakers = parseList(val());
+        else if (a == "--block"          && hasVal) o.blocks   = parseList(val());
+        else if (a == "--focus"          && hasVal) o.focus         = std::max(0.1f, std::stof(val()));
+        else if (a == "--fast"           && hasVal) o.fastFraction  = std::min(1.0f, std::max(0.0f, std::stof(val())));
+        else if (a == "--blocks"         && hasVal) o.timedBlocks   = std::max(1, std::stoi(val()));
+        else if (a == "--render_threads" && hasVal) o.renderThreads = std::max(1, std::stoi(val()));
+        else if (a == "--sparse_k"       && hasVal) o.sparseTopK    = std::max(0, std::stoi(val()));
+        else if (a == "--out"            && hasVal) o.outPath       = val();
+        else if (a == "--no_offline") o.offline = false;
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--sources 16,64] [--speakers 8,32,128]"
+                      << " [--block 128,512] [--focus 1.5] [--fast 0.25] [--blocks 2000]"
+                      << " [--render_threads 1] [--sparse_k 0] [--no_offline] [--out file.json]\n";
+            return false;
+        }
+    }
+    return !o.sources.empty() && !o.speakers.empty() && !o.blocks.empty();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Synthetic scene
+// ─────────────────────────────────────────────────────────────────────────────
+
+static SpeakerLayoutData makeLayout(int numSpeakers) {
+    SpeakerLayoutData layout;
+    const double golden = kPi * (3.0 - std::sqrt(5.0));
+    const double maxEl  = 60.0 * kPi / 180.0;
+    for (int i = 0; i < numSpeakers; ++i) {
+        SpeakerData spk;
+        const double u = (numSpeakers > 1) ? static_cast<double>(i) / (numSpeakers - 1) : 0.0;
+        spk.elevation     = static_cast<float>(std::asin(u * std::sin(maxEl)));
+        spk.azimuth       = static_cast<float>(std::remainder(i * golden, 2.0 * kPi));
+        spk.radius        = 5.0f;
+        spk.deviceChannel = i;
+        layout.speakers.push_back(spk);
+    }
+    layout.subwoofers.push_back({numSpeakers});
+    return layout;
+}
+
+static std::string sourceName(int i, int numSources) {
+    return (i == numSources - 1) ? std::string("LFE") : std::to_string(i + 1) + ".1";
+}
+
+static SpatialData makeScene(int numSources, float fastFraction) {
+    SpatialData scene;
+    scene.sampleRate = kSampleRate;
+    scene.timeUnit   = TimeUnit::Seconds;
+    scene.duration   = kSourceSec;
+    const int numFast = static_cast<int>(std::lround(fastFraction * (numSources - 1)));
+    const int numKeys = static_cast<int>(kSourceSec / kKeyframeSec) + 1;
+    for (int i = 0; i < numSources; ++i) {
+        const double az0   = 2.0 * kPi * i / numSources;
+        const double el    = 0.4 * std::sin(1.7 * i);
+        const double omega = (i < numFast) ? kFastRadPerSec : kSlowRadPerSec;
+        std::vector<Keyframe> kfs;
+        kfs.reserve(numKeys);
+        for (int k = 0; k < numKeys; ++k) {
+            const double t  = k * kKeyframeSec;
+            const double az = az0 + omega * t;
+            kfs.push_back({t,
+                           static_cast<float>(std::sin(az) * std::cos(el)),
+                           static_cast<float>(std::cos(az) * std::cos(el)),
+                           static_cast<float>(std::sin(el))});
+        }
+        scene.sources[sourceName(i, numSources)] = std::move(kfs);
+    }
+    return scene;
+}
+
+// Mono noise per source (−12 dBFS peak), deterministic per index.
+static std::vector<float> makeSignal(int i) {
+    std::mt19937 rng(1234u + static_cast<unsigned>(i));
+    std::uniform_real_distribution<float> dist(-0.25f, 0.25f);
+    std::vector<float> s(static_cast<size_t>(kSourceSec * kSampleRate));
+    for (float& x : s) x = dist(rng);
+    return s;
+}
+
+static bool writeMonoWav(const fs::path& path, const std::vector<float>& samples) {
+    SF_INFO info{};
+    info.samplerate = kSampleRate;
+    info.channels   = 1;
+    info.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+    SNDFILE* f = sf_open(path.string().c_str(), SFM_WRITE, &info);
+    if (!f) return false;
+    const sf_count_t n = static_cast<sf_count_t>(samples.size());
+    const bool ok = sf_writef_float(f, samples.data(), n) == n;
+    sf_close(f);
+    return ok;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Timing
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct StageResult {
+    double   totalNs     = 0.0;
+    uint64_t allocations = 0;
+};
+
+using BenchClock = std::chrono::steady_clock;
+
+static double elapsedNs(BenchClock::time_point t0) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - t0).count();
+}
+
+struct Config {
+    int numSources, numSpeakers, blockSize;
+};
+
+struct ConfigResult {
+    Config      cfg;
+    int         measuredBlocks = 0;
+    StageResult pose, getBlock, spatializer, realtime, offline;
+    bool        hasOffline = false;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// One configuration
+// ─────────────────────────────────────────────────────────────────────────────
+
+static bool runConfig(const Config& c, const BenchOptions& o, const fs::path& workDir,
+                      ConfigResult& res) {
+    res.cfg = c;
+    res.measuredBlocks = o.timedBlocks;
+
+    const SpatialData       scene  = makeScene(c.numSources, o.fastFraction);
+    const SpeakerLayoutData layout = makeLayout(c.numSpeakers);
+
+    std::map<std::string, MonoWavData> mono;
+    fs::create_directories(workDir);
+    for (int i = 0; i < c.numSources; ++i) {
+        const std::string name = sourceName(i, c.numSources);
+        MonoWavData& w = mono[name];
+        w.sampleRate = kSampleRate;
+        w.samples    = makeSignal(i);
+        if (!writeMonoWav(workDir / (name + ".wav"), w.samples)) {
+            std::cerr << "[bench] ERROR: cannot write " << (workDir / (name + ".wav")) << "\n";
+            return false;
+        }
+    }
+
+    RealtimeConfig config;
+    EngineState    state;
+    config.sampleRate    = kSampleRate;
+    config.bufferSize    = c.blockSize;
+    config.sourcesFolder = workDir.string();
+    config.renderThreads = o.renderThreads;
+    config.sparseTopK    = o.sparseTopK;
+    config.dbapFocus.store(o.focus);
+
+    Streaming   streaming(config, state);
+    Pose        pose(config, state);
+    Spatializer spatializer(config, state);
+    if (!streaming.loadScene(scene) || !pose.loadScene(scene, layout)
+        || !spatializer.init(layout)) {
+        std::cerr << "[bench] ERROR: agent setup failed\n";
+        return false;
+    }
+    spatializer.prepareForSources(pose.numSources());
+    spatializer.startWorkers();
+
+    al::AudioIOData io;
+    io.framesPerBuffer(c.blockSize);
+    io.framesPerSecond(kSampleRate);
+    io.channelsIn(0);
+    io.channelsOut(config.outputChannels);
+
+    ControlsSnapshot ctrl;
+    ctrl.focus = o.focus;
+    std::vector<float> scratch(c.blockSize);
+
+    const uint64_t block   = static_cast<uint64_t>(c.blockSize);
+    const uint64_t wrapAt  = (static_cast<uint64_t>(kSourceSec * kSampleRate) / block - 1) * block;
+    const auto& poses      = pose.getPoses();
+    auto frameOf = [&](int b) { return (static_cast<uint64_t>(b) * block) % wrapAt; };
+    auto poseStep = [&](uint64_t frame) {
+        pose.computePositions(static_cast<double>(frame) / kSampleRate,
+                              static_cast<double>(frame + block) / kSampleRate);
+    };
+    auto renderStep = [&](uint64_t frame) {
+        for (int ch = 0; ch < static_cast<int>(io.channelsOut()); ++ch)
+            std::memset(io.outBuffer(ch), 0, block * sizeof(float));
+        spatializer.renderBlock(io, streaming, poses, frame, c.blockSize, ctrl);
+    };
+
+    for (int b = 0; b < kWarmupBlocks; ++b) { poseStep(frameOf(b)); renderStep(frameOf(b)); }
+
+    // ── pose ──
+    {
+        const uint64_t a0 = g_allocCount.load();
+        const auto t0 = BenchClock::now();
+        for (int b = 0; b < o.timedBlocks; ++b) poseStep(frameOf(b));
+        res.pose.totalNs     = elapsedNs(t0);
+        res.pose.allocations = g_allocCount.load() - a0;
+    }
+    // ── getBlock ──
+    {
+        const uint64_t a0 = g_allocCount.load();
+        const auto t0 = BenchClock::now();
+        for (int b = 0; b < o.timedBlocks; ++b) {
+            const uint64_t frame = frameOf(b);
+            for (const auto& p : poses)
+                streaming.getBlock(p.handle, frame, c.blockSize, scratch.data());
+        }
+        res.getBlock.totalNs     = elapsedNs(t0);
+        res.getBlock.allocations = g_allocCount.load() - a0;
+    }
+    // ── spatializer (positions fixed at the last pose step) ──
+    {
+        const uint64_t a0 = g_allocCount.load();
+        const auto t0 = BenchClock::now();
+        for (int b = 0; b < o.timedBlocks; ++b) renderStep(frameOf(b));
+        res.spatializer.totalNs     = elapsedNs(t0);
+        res.spatializer.allocations = g_allocCount.load() - a0;
+    }
+    // ── realtime: pose + spatializer, as in RealtimeBackend::processBlock() ──
+    {
+        const uint64_t a0 = g_allocCount.load();
+        const auto t0 = BenchClock::now();
+        for (int b = 0; b < o.timedBlocks; ++b) { poseStep(frameOf(b)); renderStep(frameOf(b)); }
+        res.realtime.totalNs     = elapsedNs(t0);
+        res.realtime.allocations = g_allocCount.load() - a0;
+    }
+    spatializer.stopWorkers();
+    streaming.shutdown();
+
+    // ── offline: SpatialRenderer::render() → renderPerBlock() ──
+    if (o.offline) {
+        SpatialRenderer renderer(layout, scene, mono);
+        RenderConfig rc;
+        rc.blockSize        = c.blockSize;
+        rc.dbapFocus        = o.focus;
+        rc.debugDiagnostics = false;
+        rc.t0 = 0.0;
+        rc.t1 = std::min(kSourceSec,
+                         static_cast<double>(o.timedBlocks) * c.blockSize / kSampleRate);
+        const int offlineBlocks = static_cast<int>(std::ceil(rc.t1 * kSampleRate / c.blockSize));
+        const uint64_t a0 = g_allocCount.load();
+        const auto t0 = BenchClock::now();
+        MultiWavData out = renderer.render(rc);
+        const double ns = elapsedNs(t0);
+        res.offline.allocations = g_allocCount.load() - a0;
+        // Normalize to the realtime block count so all stages share units.
+        res.offline.totalNs = ns * static_cast<double>(o.timedBlocks) / std::max(1, offlineBlocks);
+        res.hasOffline = true;
+    }
+
+    for (int i = 0; i < c.numSources; ++i)
+        fs::remove(workDir / (sourceName(i, c.numSources) + ".wav"));
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JSON report
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void writeStage(std::ostream& os, const char* name, const StageResult& s,
+                       const ConfigResult& r, bool last) {
+    const double blocks    = static_cast<double>(r.measuredBlocks);
+    const double nsBlock   = s.totalNs / blocks;
+    const double audioNs   = 1e9 * r.cfg.blockSize / kSampleRate;
+    os << "        \"" << name << "\": {"
+       << "\"nsPerBlock\": " << nsBlock
+       << ", \"nsPerSourceBlock\": " << nsBlock / r.cfg.numSources
+       << ", \"realtimeFactor\": " << (nsBlock > 0.0 ? audioNs / nsBlock : 0.0)
+       << ", \"allocations\": " << s.allocations << "}" << (last ? "\n" : ",\n");
+}
+
+static void writeReport(std::ostream& os, const BenchOptions& o,
+                        const std::vector<ConfigResult>& results) {
+    os << "{\n"
+       << "  \"bench\": \"spatialroot_bench\",\n"
+       << "  \"sampleRate\": " << kSampleRate << ",\n"
+       << "  \"focus\": " << o.focus << ",\n"
+       << "  \"fastFraction\": " << o.fastFraction << ",\n"
+       << "  \"renderThreads\": " << o.renderThreads << ",\n"
+       << "  \"sparseTopK\": " << o.sparseTopK << ",\n"
+       << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ConfigResult& r = results[i];
+        os << "    {\n"
+           << "      \"sources\": " << r.cfg.numSources
+           << ", \"speakers\": " << r.cfg.numSpeakers
+           << ", \"blockSize\": " << r.cfg.blockSize
+           << ", \"blocks\": " << r.measuredBlocks << ",\n"
+           << "      \"stages\": {\n";
+        writeStage(os, "pose", r.pose, r, false);
+        writeStage(os, "getBlock", r.getBlock, r, false);
+        writeStage(os, "spatializer", r.spatializer, r, false);
+        writeStage(os, "realtime", r.realtime, r, !r.hasOffline);
+        if (r.hasOffline) writeStage(os, "offline", r.offline, r, true);
+        os << "      }\n"
+           << "    }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// main
+// ─────────────────────────────────────────────────────────────────────────────
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parseArgs(argc, argv, opts)) return 2;
+
+    const fs::path workDir = fs::temp_directory_path()
+        / ("spatialroot_bench_" + std::to_string(
+               std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    // The agents log setup to std::cout; keep stdout for the JSON report.
+    std::ofstream devNull;
+    std::streambuf* coutBuf = std::cout.rdbuf();
+    std::cout.rdbuf(devNull.rdbuf());
+
+    std::vector<ConfigResult> results;
+    bool ok = true;
+    for (int ns : opts.sources)
+        for (int nk : opts.speakers)
+            for (int bs : opts.blocks) {
+                std::cerr << "[bench] sources=" << ns << " speakers=" << nk
+                          << " block=" << bs << std::endl;
+                ConfigResult r;
+                if (!runConfig({std::max(2, ns), nk, bs}, opts, workDir, r)) { ok = false; break; }
+                results.push_back(r);
+            }
+
+    std::cout.rdbuf(coutBuf);
+    std::error_code ec;
+    fs::remove_all(workDir, ec);
+
+    if (opts.outPath.empty()) {
+        writeReport(std::cout, opts, results);
+    } else {
+        std::ofstream f(opts.outPath);
+        writeReport(f, opts, results);
+        std::cerr << "[bench] wrote " << opts.outPath << std::endl;
+    }
+    return ok ? 0 : 1;
+}
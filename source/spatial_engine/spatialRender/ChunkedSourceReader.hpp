@@ -0,0 +1,231 @@
+// ChunkedSourceReader.hpp — Bounded-memory source access for chunked offline renders
+//
+// The whole-file offline path (WavUtils::loadSources / loadSourcesFromADM)
+// decodes every source into a MonoWavData up front, so resident memory grows
+// with program length × source count. This reader serves the same audio to
+// SpatialRenderer::renderPerBlock() one render chunk at a time instead, by
+// reusing the realtime engine's streaming primitives synchronously:
+//
+//   --sources FOLDER → one SourceStream per mono WAV (own SNDFILE handle),
+//                      refilled with SourceStream::loadChunkInto().
+//   --adm FILE       → buffer-only SourceStreams fed by one MultichannelReader
+//                      (one interleaved read + de-interleave per chunk).
+//
+// USAGE (single thread, no loader thread):
+//   reader.openFolder(...) / reader.openADM(...)
+//   for each render chunk [c0, c0 + chunkFrames):
+//       reader.loadWindow(c0);
+//       ... readBlock(name, t, n, dst) for t in the chunk ...
+//
+// Only buffer A of each SourceStream is used (the offline renderer pulls data
+// synchronously, so there is nothing to double-buffer); buffer B never gets a
+// chunk. Chunks come from the process-wide SourceIOService with no retention
+// budget, so peak source memory = numSources × chunkFrames × 4 bytes
+// (plus chunkFrames × fileChannels × 4 bytes of interleave scratch in ADM mode).
+//
+// SILENCE MAP: open*() also loads each file's SilenceMap (the .srsilence
+// sidecar, or one scan per file on parallel threads that writes it) and
+// hands every stream its channel's runs. loadWindow() then reads nothing
+// for silent stretches, and silence(name) lets SpatialRenderer skip blocks
+// they cover without a copy.
+//
+// Errors at open time throw std::runtime_error, matching WavUtils' loaders.
+//
+// THREADING: loadWindow() on one thread between render chunks. readBlock()
+// may be called concurrently (--threads) as long as every request lies
+// inside the loaded window — it then only reads buffer A.
+//
+// PROVENANCE:
+// - SourceStream / MultichannelReader: realtimeEngine/src/Streaming.hpp.
+// - Source naming and ADM channel mapping: WavUtils::loadSources(),
+//   WavUtils::admChannelIndex().
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Streaming.hpp"       // SourceStream, MultichannelReader (realtime engine)
+#include "../src/JSONLoader.hpp"
+#include "../src/SilenceMap.hpp"
+#include "../src/WavUtils.hpp"
+
+class ChunkedSourceReader {
+public:
+
+    ChunkedSourceReader() = default;
+
+    ChunkedSourceReader(const ChunkedSourceReader&) = delete;
+    ChunkedSourceReader& operator=(const ChunkedSourceReader&) = delete;
+
+    /// Open one mono WAV per source key: folder/<name>.wav.
+    void openFolder(const std::string& folder,
+                    const std::map<std::string, std::vector<Keyframe>>& sourceKeys,
+                    int expectedSR, uint64_t chunkFrames) {
+        mChunkFrames = chunkFrames;
+        for (const auto& [name, kf] : sourceKeys) {
+            const std::string p = WavUtils::sourceFilePath(folder, name);
+            if (p.empty()) {
+                throw std::runtime_error("Missing source file: " +
+                    (std::filesystem::path(folder) / (name + ".wav")).string());
+            }
+            auto stream = std::make_unique<SourceStream>();
+            stream->io = mIO.get();
+            if (!stream->open(p, name, chunkFrames, expectedSR)) {
+                throw std::runtime_error("Failed to open source file: " + p);
+            }
+            mTotalFrames = std::max(mTotalFrames, stream->totalFrames);
+            mStreams[name] = std::move(stream);
+        }
+
+        std::vector<std::string> files;
+        for (const auto& [name, stream] : mStreams) files.push_back(stream->filePath);
+        const std::vector<std::vector<SilenceRuns>> maps = loadSilenceMaps(files);
+        size_t f = 0;
+        for (auto& [name, stream] : mStreams) {
+            if (!maps[f].empty()) adoptSilence(name, *stream, maps[f].front());
+            ++f;
+        }
+        std::cout << "  Chunked reader: " << mStreams.size() << " mono sources, "
+                  << chunkFrames << " frames/chunk ("
+                  << (mStreams.size() * chunkFrames * sizeof(float)) / (1024 * 1024)
+                  << " MB resident)\n";
+    }
+
+    /// Open a multichannel ADM WAV and map each source key to its channel.
+    void openADM(const std::string& admFile,
+                 const std::map<std::string, std::vector<Keyframe>>& sourceKeys,
+                 int expectedSR, uint64_t chunkFrames) {
+        mChunkFrames = chunkFrames;
+        mMultichannel = std::make_unique<MultichannelReader>();
+        if (!mMultichannel->open(admFile, expectedSR, chunkFrames, mIO.get())) {
+            throw std::runtime_error("Failed to open ADM WAV: " + admFile);
+        }
+        mTotalFrames = mMultichannel->totalFrames();
+
+        for (const auto& [name, kf] : sourceKeys) {
+            int channelIndex = WavUtils::admChannelIndex(name, mMultichannel->numChannels());
+            if (channelIndex < 0) {
+                std::cerr << "Warning: Cannot map source '" << name << "' to ADM channel — skipping\n";
+                continue;
+            }
+            auto stream = std::make_unique<SourceStream>();
+            stream->initBuffersOnly(name, chunkFrames, expectedSR, mTotalFrames);
+            mMultichannel->mapChannel(channelIndex, stream.get());
+            std::cout << "  ✓ " << name << " → ADM ch " << (channelIndex + 1) << "\n";
+            mStreams[name] = std::move(stream);
+        }
+
+        const std::vector<SilenceRuns> runs = loadSilenceMaps({admFile}).front();
+        for (auto& [name, stream] : mStreams) {
+            const int ch = WavUtils::admChannelIndex(name, mMultichannel->numChannels());
+            if (ch >= 0 && static_cast<size_t>(ch) < runs.size()) {
+                adoptSilence(name, *stream, runs[static_cast<size_t>(ch)]);
+            }
+        }
+    }
+
+    bool hasSource(const std::string& name) const { return mStreams.count(name) != 0; }
+    size_t numSources() const { return mStreams.size(); }
+
+    /// Longest source length in frames (the ADM file length in ADM mode).
+    uint64_t totalFrames() const { return mTotalFrames; }
+    uint64_t chunkFrames() const { return mChunkFrames; }
+
+    /// Silence runs of a source (nullptr if its file could not be indexed).
+    const SilenceRuns* silence(const std::string& name) const {
+        auto it = mSilence.find(name);
+        return (it != mSilence.end()) ? &it->second : nullptr;
+    }
+
+    /// Fill every source's window with [startFrame, startFrame + chunkFrames).
+    void loadWindow(uint64_t startFrame) {
+        if (mMultichannel) {
+            mMultichannel->readAndDistribute(startFrame, 0);
+        } else {
+            for (auto& [name, stream] : mStreams) {
+                stream->loadChunkInto(0, startFrame);
+            }
+        }
+        mWindowStart = startFrame;
+        mWindowValid = true;
+    }
+
+    /// Copy numFrames samples of a source starting at startFrame into out.
+    /// Frames past the end of the source read as silence. A request outside
+    /// the current window reloads the window at startFrame (never happens
+    /// when the caller aligns loadWindow() with its render chunks).
+    void readBlock(const std::string& name, uint64_t startFrame,
+                   size_t numFrames, float* out) {
+        auto it = mStreams.find(name);
+        if (it == mStreams.end()) {
+            std::memset(out, 0, numFrames * sizeof(float));
+            return;
+        }
+        if (!mWindowValid || startFrame < mWindowStart ||
+            startFrame + numFrames > mWindowStart + mChunkFrames) {
+            loadWindow(startFrame);
+        }
+
+        const SourceStream& s = *it->second;
+        const uint64_t valid  = s.validFramesA.load(std::memory_order_relaxed);
+        const uint64_t offset = startFrame - mWindowStart;
+        const size_t   avail  = (offset < valid)
+            ? static_cast<size_t>(std::min<uint64_t>(numFrames, valid - offset)) : 0;
+
+        if (avail > 0) {
+            std::memcpy(out, s.dataA.load(std::memory_order_relaxed) + offset,
+                        avail * sizeof(float));
+        }
+        if (avail < numFrames) std::memset(out + avail, 0, (numFrames - avail) * sizeof(float));
+    }
+
+private:
+
+    /// SilenceMap::load() of every file, spread over the hardware threads
+    /// (sidecar hits return at once; misses are one sequential scan each).
+    /// An entry is empty when its file could not be indexed.
+    static std::vector<std::vector<SilenceRuns>> loadSilenceMaps(const std::vector<std::string>& files) {
+        std::vector<std::vector<SilenceRuns>> out(files.size());
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i; (i = next.fetch_add(1)) < files.size();) {
+                if (!SilenceMap::load(files[i], out[i])) out[i].clear();
+            }
+        };
+        const size_t n = std::min<size_t>(files.size(),
+                                          std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < n; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+        return out;
+    }
+
+    /// Keep runs for name and point its stream at them (before any load).
+    void adoptSilence(const std::string& name, SourceStream& stream, const SilenceRuns& runs) {
+        const SilenceRuns& kept = mSilence[name] = runs;
+        stream.silence.store(&kept, std::memory_order_release);
+    }
+
+    // Declared first so it outlives the streams' chunk references
+    std::shared_ptr<SourceIOService> mIO = SourceIOService::attach(0, 0);
+
+    std::map<std::string, std::unique_ptr<SourceStream>> mStreams;
+    std::unique_ptr<MultichannelReader> mMultichannel;  // ADM mode only
+    std::map<std::string, SilenceRuns>  mSilence;       // per source; streams point into it
+
+    uint64_t mChunkFrames = 0;
+    uint64_t mTotalFrames = 0;
+    uint64_t mWindowStart = 0;
+    bool     mWindowValid = false;
+};
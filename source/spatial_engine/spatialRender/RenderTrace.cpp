@@ -0,0 +1,283 @@
+#include "RenderTrace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char     kMagic[8] = {'S', 'R', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr uint32_t kVersion  = 1;
+constexpr uint32_t kFlagAllBlocks = 1;
+
+struct TraceFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t sampleRate;
+    uint32_t blockSize;
+    uint32_t numSources;
+    uint32_t flags;          // kFlagAllBlocks
+    uint32_t recordSize;     // sizeof(TraceRecord)
+    uint64_t records;        // 0 until close()
+    uint64_t stalls;
+    uint64_t reserved[2];
+};
+
+static_assert(sizeof(TraceFileHeader) == 64, "TraceFileHeader layout changed — bump kVersion");
+
+TraceFileHeader makeHeader(uint32_t sampleRate, uint32_t blockSize, uint32_t numSources,
+                           bool allBlocks) {
+    TraceFileHeader hdr{};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version    = kVersion;
+    hdr.sampleRate = sampleRate;
+    hdr.blockSize  = blockSize;
+    hdr.numSources = numSources;
+    hdr.flags      = allBlocks ? kFlagAllBlocks : 0;
+    hdr.recordSize = sizeof(TraceRecord);
+    return hdr;
+}
+
+// Writer idle poll: progress lines appear within this of being pushed
+constexpr auto kWriterIdle = std::chrono::milliseconds(2);
+
+} // namespace
+
+const char *traceRecordTypeName(TraceRecordType t) {
+    switch (t) {
+        case TraceRecordType::Block:    return "block";
+        case TraceRecordType::Progress: return "progress";
+        case TraceRecordType::Discard:  return "discard";
+        default:                        return "?";
+    }
+}
+
+const char *traceFlagName(uint16_t flag) {
+    switch (flag) {
+        case kTraceSubstep:    return "substep";
+        case kTraceRetarget:   return "retarget";
+        case kTraceFallback:   return "fallback";
+        case kTraceInvalidDir: return "invalid_dir";
+        case kTraceClampedEl:  return "clamped_el";
+        case kTraceRescaled:   return "rescaled_el";
+        case kTraceFlattened:  return "flattened_2d";
+        case kTraceLfe:        return "lfe";
+        default:               return "?";
+    }
+}
+
+// ============================================================================
+// TraceContext (producer side)
+// ============================================================================
+
+void TraceContext::block(uint64_t frame, uint32_t source, TraceRecord rec) const {
+    if (!trace || (!(rec.flags & kTraceEventMask) && !trace->mAllBlocks)) return;
+    rec.frame = frame;
+    rec.pass  = pass;
+    rec.index = source;
+    rec.type  = TraceRecordType::Block;
+    trace->push(lane, rec);
+}
+
+void TraceContext::progress(uint64_t frame, uint32_t blocksDone, float fraction) const {
+    if (!trace) return;
+    TraceRecord rec;
+    rec.frame = frame;
+    rec.pass  = pass;
+    rec.index = blocksDone;
+    rec.type  = TraceRecordType::Progress;
+    rec.value = fraction;
+    rec.az    = std::chrono::duration<float>(std::chrono::steady_clock::now() - trace->mStart).count();
+    trace->push(lane, rec);
+}
+
+void RenderTrace::push(size_t lane, const TraceRecord &rec) {
+    Lane &l = *mLanes[lane];
+    const uint64_t head = l.head.load(std::memory_order_relaxed);
+    if (head - l.tailCache >= kLaneCapacity) {
+        l.tailCache = l.tail.load(std::memory_order_acquire);
+        if (head - l.tailCache >= kLaneCapacity) {
+            // Offline: wait for the writer rather than lose the record
+            l.stalls.store(l.stalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            do {
+                std::this_thread::yield();
+                l.tailCache = l.tail.load(std::memory_order_acquire);
+            } while (head - l.tailCache >= kLaneCapacity);
+        }
+    }
+    l.slots[head & (kLaneCapacity - 1)] = rec;
+    l.head.store(head + 1, std::memory_order_release);
+}
+
+// ============================================================================
+// RenderTrace
+// ============================================================================
+
+bool RenderTrace::open(const std::string &path, uint32_t sampleRate, uint32_t blockSize,
+                       const std::vector<std::string> &sources, size_t numLanes, bool allBlocks) {
+    close();
+
+    mFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!mFile.good()) return false;
+
+    mSampleRate = sampleRate;
+    mBlockSize  = blockSize;
+    mNumSources = static_cast<uint32_t>(sources.size());
+    const TraceFileHeader hdr = makeHeader(mSampleRate, mBlockSize, mNumSources, allBlocks);
+    mFile.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+
+    uint64_t tableBytes = 0;
+    for (const std::string &name : sources) {
+        const uint32_t len = static_cast<uint32_t>(name.size());
+        mFile.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        mFile.write(name.data(), len);
+        tableBytes += sizeof(len) + len;
+    }
+    const char pad[8] = {};
+    mFile.write(pad, static_cast<std::streamsize>((8 - tableBytes % 8) % 8));
+    if (!mFile.good()) {
+        mFile.close();
+        return false;
+    }
+
+    mLanes.clear();
+    for (size_t i = 0; i < std::max<size_t>(1, numLanes); ++i) {
+        mLanes.push_back(std::make_unique<Lane>());
+    }
+    mBatch.reserve(kLaneCapacity);
+    mPath = path;
+    mRecords = 0;
+    mAllBlocks = allBlocks;
+    mStart = std::chrono::steady_clock::now();
+    mStop.store(false, std::memory_order_relaxed);
+    mOpen = true;
+    mWriter = std::thread(&RenderTrace::writerLoop, this);
+    return true;
+}
+
+void RenderTrace::close() {
+    if (!mOpen) return;
+    mStop.store(true, std::memory_order_release);
+    mWriter.join();
+
+    TraceFileHeader hdr = makeHeader(mSampleRate, mBlockSize, mNumSources, mAllBlocks);
+    hdr.records = mRecords;
+    hdr.stalls  = stalls();
+    mFile.seekp(0);
+    mFile.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    mFile.close();
+    if (!mFile) {
+        std::cerr << "Warning: trace " << mPath << " may be incomplete (write failed)\n";
+    }
+    mOpen = false;
+}
+
+TraceContext RenderTrace::context(size_t lane) {
+    if (!mOpen || lane >= mLanes.size()) return {};
+    TraceContext ctx;
+    ctx.trace = this;
+    ctx.lane  = lane;
+    ctx.pass  = mNextPass.fetch_add(1, std::memory_order_relaxed);
+    return ctx;
+}
+
+void RenderTrace::discard(size_t lane, uint32_t pass) {
+    if (!mOpen || lane >= mLanes.size() || pass == 0) return;
+    TraceRecord rec;
+    rec.pass = pass;
+    rec.type = TraceRecordType::Discard;
+    push(lane, rec);
+}
+
+uint64_t RenderTrace::stalls() const {
+    uint64_t n = 0;
+    for (const auto &l : mLanes) n += l->stalls.load(std::memory_order_relaxed);
+    return n;
+}
+
+// ── Consumer (writer thread) ─────────────────────────────────────────────
+
+size_t RenderTrace::drainAll() {
+    mBatch.clear();
+    for (auto &lp : mLanes) {
+        Lane &l = *lp;
+        const uint64_t tail = l.tail.load(std::memory_order_relaxed);
+        const uint64_t head = l.head.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i != head; ++i) {
+            const TraceRecord &rec = l.slots[i & (kLaneCapacity - 1)];
+            if (rec.type == TraceRecordType::Progress) {
+                std::cout << "  Block " << rec.index << " ("
+                          << (int)(100.0f * rec.value) << "%)\n" << std::flush;
+            }
+            mBatch.push_back(rec);
+        }
+        l.tail.store(head, std::memory_order_release);
+    }
+    if (!mBatch.empty()) {
+        mFile.write(reinterpret_cast<const char*>(mBatch.data()),
+                    static_cast<std::streamsize>(mBatch.size() * sizeof(TraceRecord)));
+        mRecords += mBatch.size();
+    }
+    return mBatch.size();
+}
+
+void RenderTrace::writerLoop() {
+    while (!mStop.load(std::memory_order_acquire)) {
+        if (drainAll() == 0) std::this_thread::sleep_for(kWriterIdle);
+    }
+    // Producers are done (close() runs after the last join): final sweep
+    while (drainAll() > 0) {}
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+void RenderTrace::read(const std::string &path, TraceFileInfo &info, std::vector<TraceRecord> &records) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f.good()) throw std::runtime_error("Cannot open trace file: " + path);
+    const std::streamoff fileSize = f.tellg();
+    f.seekg(0);
+
+    TraceFileHeader hdr;
+    if (!f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)) ||
+        std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a render trace: " + path);
+    }
+    if (hdr.version != kVersion || hdr.recordSize != sizeof(TraceRecord)) {
+        throw std::runtime_error("Unsupported render trace version in " + path);
+    }
+
+    info = TraceFileInfo();
+    info.sampleRate = hdr.sampleRate;
+    info.blockSize  = hdr.blockSize;
+    info.allBlocks  = (hdr.flags & kFlagAllBlocks) != 0;
+    info.stalls     = hdr.stalls;
+    uint64_t tableBytes = 0;
+    for (uint32_t i = 0; i < hdr.numSources; ++i) {
+        uint32_t len = 0;
+        if (!f.read(reinterpret_cast<char*>(&len), sizeof(len)) ||
+            len > static_cast<uint64_t>(fileSize)) {
+            throw std::runtime_error("Truncated source table in " + path);
+        }
+        std::string name(len, '\0');
+        if (!f.read(name.data(), len)) throw std::runtime_error("Truncated source table in " + path);
+        info.sources.push_back(std::move(name));
+        tableBytes += sizeof(len) + len;
+    }
+    f.seekg(static_cast<std::streamoff>((8 - tableBytes % 8) % 8), std::ios::cur);
+
+    const std::streamoff bodyStart = f.tellg();
+    if (bodyStart < 0 || bodyStart > fileSize) throw std::runtime_error("Truncated trace: " + path);
+    uint64_t n = static_cast<uint64_t>(fileSize - bodyStart) / sizeof(TraceRecord);
+    if (hdr.records > 0 && hdr.records < n) n = hdr.records;
+    if (hdr.records > n) {
+        std::cerr << "Warning: trace " << path << " holds " << n << " of " << hdr.records
+                  << " records (truncated)\n";
+    }
+    records.resize(static_cast<size_t>(n));
+    if (n > 0 && !f.read(reinterpret_cast<char*>(records.data()),
+                         static_cast<std::streamsize>(n * sizeof(TraceRecord)))) {
+        throw std::runtime_error("Cannot read records from " + path);
+    }
+}
@@ -0,0 +1,180 @@
+// RenderTrace.hpp — Binary per-block diagnostics trace for the offline renderer
+//
+// The end-of-render summaries (fallbacks, zero blocks, sub-steps, direction
+// sanitization) only say how often something happened. With
+// RenderConfig::traceFile set, the render loop also emits one fixed-size
+// TraceRecord per source block that hit one of those paths (or per rendered
+// source block with RenderConfig::traceAllBlocks), and the "Block N (x%)"
+// progress lines travel the same way instead of going through std::cout on
+// the render thread:
+//
+//   producers (render threads): TraceContext::block() / progress() — one
+//     32-byte record into the thread's own lane, a single-producer /
+//     single-consumer ring, then one release store of its head. No lock, no
+//     allocation, no iostream. A full lane makes the producer yield until
+//     the writer catches up (counted in stalls()); records are never dropped.
+//   consumer (writer thread): drains every lane in batches, appends the
+//     records to the file and prints progress records to std::cout.
+//
+// Records from different lanes reach the file interleaved;
+// spatialroot_trace_convert (trace_convert.cpp) drops discarded passes,
+// orders the rest by frame and writes JSON or CSV.
+//
+// PASSES: every renderBlockRange() / renderSourceChunk() call tags its
+// records with a pass id. When a time slice or stem is thrown away and
+// rendered again (see renderPerBlock() / renderIncremental()), a Discard
+// record names the dropped pass and readers ignore its records, so a trace
+// lists each block once, as it is in the output.
+//
+// FILE LAYOUT (little-endian):
+//   TraceFileHeader    64 bytes   magic "SRTRACE\0", version, sample rate,
+//                                 block size, source count, flags,
+//                                 record / stall counts (set on close)
+//   source names       per source: uint32_t length + bytes; padded to 8
+//   records[]          TraceRecord until end of file
+//
+// A trace whose writer never closed (crash) has records == 0 in its header;
+// readers take every whole record up to the end of the file instead.
+//
+// THREADING: open() / close() on the render (main) thread with no producer
+// running. Between them each lane has exactly one producer at a time; a lane
+// may pass from one thread to another across a join.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TraceRecordType : uint16_t {
+    Block,      // one source block (see TraceRecord::flags)
+    Progress,   // render progress (index = blocks done, value = fraction done)
+    Discard,    // pass `pass` was thrown away: ignore its records
+    Count
+};
+
+// TraceRecord::flags for Block records
+enum TraceFlags : uint16_t {
+    kTraceSubstep    = 1 << 0,   // fast mover: block rendered in kSubStepHop sub-steps
+    kTraceRetarget   = 1 << 1,   // panner output ~silent, retargeted to nearest speaker
+    kTraceFallback   = 1 << 2,   // degenerate direction: last-good / keyframe fallback
+    kTraceInvalidDir = 1 << 3,   // sanitizer rejected a direction (front used)
+    kTraceClampedEl  = 1 << 4,   // elevation clamped to the layout
+    kTraceRescaled   = 1 << 5,   // elevation rescaled (RescaleAtmosUp / RescaleFullSphere)
+    kTraceFlattened  = 1 << 6,   // 2D layout: elevation flattened
+    kTraceLfe        = 1 << 7,   // LFE block (routed to the subs, no direction)
+
+    // Blocks traced without RenderConfig::traceAllBlocks
+    kTraceEventMask = kTraceSubstep | kTraceRetarget | kTraceFallback | kTraceInvalidDir,
+};
+
+const char *traceRecordTypeName(TraceRecordType t);
+const char *traceFlagName(uint16_t flag);   // single bit → "substep", ...
+
+// One record, two per cache line.
+struct TraceRecord {
+    uint64_t frame  = 0;    // first frame of the block (render timeline)
+    uint32_t pass   = 0;    // pass that produced it (Discard: the pass dropped)
+    uint32_t index  = 0;    // Block: source index (file name table); Progress: blocks done
+    TraceRecordType type = TraceRecordType::Block;
+    uint16_t flags  = 0;    // Block: TraceFlags
+    float    value  = 0.0f; // Block: direction change across the block (rad); Progress: fraction
+    float    az     = 0.0f; // Block: panned azimuth (deg, 0 = front, + = right); Progress: seconds
+    float    el     = 0.0f; // Block: panned elevation (deg)
+};
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord layout changed — bump the trace version");
+
+struct TraceFileInfo {
+    uint32_t sampleRate = 0;
+    uint32_t blockSize = 0;
+    bool     allBlocks = false;   // written with RenderConfig::traceAllBlocks
+    uint64_t stalls = 0;
+    std::vector<std::string> sources;
+};
+
+class RenderTrace;
+
+// One producer's handle for one pass. Cheap to copy; default-constructed = off.
+struct TraceContext {
+    RenderTrace *trace = nullptr;
+    size_t   lane = 0;
+    uint32_t pass = 0;
+
+    explicit operator bool() const { return trace != nullptr; }
+
+    // Push rec as a Block record if it carries an event flag, or always with
+    // traceAllBlocks. frame / pass / index / type are stamped here.
+    void block(uint64_t frame, uint32_t source, TraceRecord rec) const;
+    void progress(uint64_t frame, uint32_t blocksDone, float fraction) const;
+};
+
+class RenderTrace {
+public:
+    static constexpr size_t kLaneCapacity = 4096;   // records per lane; power of two, 128 KB
+    static_assert((kLaneCapacity & (kLaneCapacity - 1)) == 0, "capacity must be a power of two");
+
+    RenderTrace() = default;
+    RenderTrace(const RenderTrace&) = delete;
+    RenderTrace& operator=(const RenderTrace&) = delete;
+    ~RenderTrace() { close(); }
+
+    /// Create path, write the header and name table and start the writer
+    /// thread with numLanes lanes. Closes any open trace first. False (and
+    /// inactive) if the file cannot be written.
+    bool open(const std::string &path, uint32_t sampleRate, uint32_t blockSize,
+              const std::vector<std::string> &sources, size_t numLanes, bool allBlocks);
+
+    /// Stop the writer after it drained every lane, and finish the header.
+    void close();
+
+    bool active() const { return mOpen; }
+
+    /// Handle for a new pass on lane (lane < numLanes), or an inactive one.
+    TraceContext context(size_t lane);
+
+    /// Mark pass as thrown away (pushed on lane).
+    void discard(size_t lane, uint32_t pass);
+
+    uint64_t records() const { return mRecords; }
+    uint64_t stalls() const;
+    const std::string &path() const { return mPath; }
+
+    /// Read a trace written by this class. Throws std::runtime_error if path
+    /// is missing or not a trace.
+    static void read(const std::string &path, TraceFileInfo &info, std::vector<TraceRecord> &records);
+
+private:
+    friend struct TraceContext;
+
+    // Single-producer / single-consumer ring (layout as DiagnosticRing)
+    struct Lane {
+        TraceRecord slots[kLaneCapacity];
+        alignas(64) std::atomic<uint64_t> head{0};     // producer-written
+        uint64_t                          tailCache = 0;
+        std::atomic<uint64_t>             stalls{0};   // producer-written
+        alignas(64) std::atomic<uint64_t> tail{0};     // consumer-written
+    };
+
+    void push(size_t lane, const TraceRecord &rec);
+    size_t drainAll();
+    void writerLoop();
+
+    std::vector<std::unique_ptr<Lane>> mLanes;
+    std::vector<TraceRecord> mBatch;              // writer-private
+    std::ofstream mFile;
+    std::thread   mWriter;
+    std::atomic<bool>     mStop{false};
+    std::atomic<uint32_t> mNextPass{1};
+    std::chrono::steady_clock::time_point mStart;
+    std::string mPath;
+    uint64_t mRecords = 0;                        // writer-private until close()
+    uint32_t mSampleRate = 0, mBlockSize = 0, mNumSources = 0;
+    bool mAllBlocks = false;
+    bool mOpen = false;
+};
@@ -3,13 +3,18 @@
 #endif
 
 #include "SpatialRenderer.hpp"
+#include "ChunkedSourceReader.hpp"
+#include "../src/SceneCache.hpp"
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 #include <algorithm>
 #include <numeric>
 #include <filesystem>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -35,6 +40,17 @@ std::string SpatialRenderer::pannerTypeName(PannerType type) {
 float dbap_sub_compensation = 0.95f; // LFE/subwoofer compensation factor for DBAP. TEMPORARY - UPDATE IN THE FUTURE BASED ON FOCUS SETTING
 // ^ update to not be a global variable later 
 
+// Placeholder source map for the chunked constructor (audio comes from mReader).
+static const std::map<std::string, MonoWavData> kNoInMemorySources;
+
+SpatialRenderer::SpatialRenderer(const SpeakerLayoutData &layout,
+                                 const SpatialData &spatial,
+                                 ChunkedSourceReader &reader)
+    : SpatialRenderer(layout, spatial, kNoInMemorySources)
+{
+    mReader = &reader;
+}
+
 SpatialRenderer::SpatialRenderer(const SpeakerLayoutData &layout,
                                  const SpatialData &spatial,
                                  const std::map<std::string, MonoWavData> &sources)
@@ -141,19 +157,39 @@ SpatialRenderer::SpatialRenderer(const SpeakerLayoutData &layout,
     mLBAP = std::make_unique<al::Lbap>(mSpeakers);
     mLBAP->compile();
     std::cout << "LBAP initialized with " << mSpeakers.size() << " speakers\n";
+
+    // Silence index of the in-memory sources: one pass over each, repaid by
+    // every block renderBlockRange() then skips without a fill or abs-sum.
+    // Sources are scanned by parallel workers; the map nodes are inserted up
+    // front so each worker only writes its own entry.
+    std::vector<std::pair<const MonoWavData *, SilenceRuns *>> scans;
+    scans.reserve(mSources.size());
+    for (const auto &[name, wav] : mSources) scans.emplace_back(&wav, &mSilence[name]);
+    std::atomic<size_t> next{0};
+    auto scanSources = [&]() {
+        for (size_t j; (j = next.fetch_add(1)) < scans.size();) {
+            const MonoWavData &wav = *scans[j].first;
+            *scans[j].second = SilenceMap::fromSamples(wav.samples.data(), wav.samples.size());
+        }
+    };
+    const size_t numWorkers =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), scans.size());
+    std::vector<std::thread> workers;
+    for (size_t w = 1; w < numWorkers; ++w) workers.emplace_back(scanSources);
+    scanSources();
+    for (auto &t : workers) t.join();
+}
+
+const SilenceRuns *SpatialRenderer::silenceFor(const std::string &name) const {
+    if (mReader) return mReader->silence(name);
+    auto it = mSilence.find(name);
+    return (it != mSilence.end()) ? &it->second : nullptr;
 }
 
 // Reset per-render state (call at start of each render)
 void SpatialRenderer::resetPerRenderState() {
-    mLastGoodDir.clear();
-    mWarnedDegenerate.clear();
-    mFallbackCount.clear();
-    
-    // Reset direction sanitization diagnostics
-    mDirDiag = DirDiag();
-    
-    // Reset panner diagnostics
-    mPannerDiag = PannerDiag();
+    // Continuity state, direction sanitization and panner diagnostics
+    mState = RenderState();
 }
 
 // Initialize the selected spatializer for this render
@@ -235,20 +271,21 @@ al::Vec3f SpatialRenderer::directionToDBAPPosition(const al::Vec3f& dir) {
 // This prevents sources from becoming inaudible due to out-of-range directions
 
  //updating to compensate for low speakers 
-al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMode mode) {
+al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMode mode,
+                                                DirDiag& diag) {
     al::Vec3f d = safeNormalize(v);
     float mag = d.mag();
     
     // Handle degenerate input
     if (!std::isfinite(mag) || mag < 1e-6f) {
-        mDirDiag.invalidDir++;
+        diag.invalidDir++;
         return al::Vec3f(0.0f, 1.0f, 0.0f);  // fallback: front
     }
     
     // 2D layout: flatten elevation to z=0
     if (mLayoutIs2D) {
         if (std::abs(d.z) > 1e-6f) {
-            mDirDiag.flattened2D++;
+            diag.flattened2D++;
         }
         d.z = 0.0f;
         return safeNormalize(d);
@@ -270,7 +307,7 @@ al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMod
             // Hard clip elevation to layout bounds
             float clamped = std::clamp(el, mLayoutMinElRad, mLayoutMaxElRad);
             if (clamped != el) {
-                mDirDiag.clampedEl++;
+                diag.clampedEl++;
             }
             el2 = clamped;
             break;
@@ -281,7 +318,7 @@ al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMod
             // or above +pi/2 are clamped by remapClamped.
             float mapped = remapClamped(el, 0.0f, float(M_PI)/2.0f, mLayoutMinElRad, mLayoutMaxElRad);
             if (std::abs(mapped - el) > 1e-5f) {
-                mDirDiag.rescaledAtmosUp++;
+                diag.rescaledAtmosUp++;
             }
             el2 = mapped;
             break;
@@ -290,7 +327,7 @@ al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMod
             // Source assumed in [-pi/2, +pi/2]. Map full sphere into layout range.
             float mapped = remapClamped(el, -float(M_PI)/2.0f, float(M_PI)/2.0f, mLayoutMinElRad, mLayoutMaxElRad);
             if (std::abs(mapped - el) > 1e-5f) {
-                mDirDiag.rescaledFullSphere++;
+                diag.rescaledFullSphere++;
             }
             el2 = mapped;
             break;
@@ -298,7 +335,7 @@ al::Vec3f SpatialRenderer::sanitizeDirForLayout(const al::Vec3f& v, ElevationMod
         default: {
             // Safe fallback: clamp
             float clamped = std::clamp(el, mLayoutMinElRad, mLayoutMaxElRad);
-            if (clamped != el) mDirDiag.clampedEl++;
+            if (clamped != el) diag.clampedEl++;
             el2 = clamped;
             break;
         }
@@ -320,13 +357,13 @@ void SpatialRenderer::printSanitizationSummary() {
               << (mLayoutMaxElRad * 180.0f / M_PI) << "°]\n";
     
     if (mLayoutIs2D) {
-        std::cout << "  Flattened to plane: " << mDirDiag.flattened2D << " directions\n";
+        std::cout << "  Flattened to plane: " << mState.dirDiag.flattened2D << " directions\n";
     } else {
-        std::cout << "  Clamped elevations: " << mDirDiag.clampedEl << "\n";
-        std::cout << "  Rescaled (AtmosUp): " << mDirDiag.rescaledAtmosUp << "\n";
-        std::cout << "  Rescaled (FullSphere): " << mDirDiag.rescaledFullSphere << "\n";
+        std::cout << "  Clamped elevations: " << mState.dirDiag.clampedEl << "\n";
+        std::cout << "  Rescaled (AtmosUp): " << mState.dirDiag.rescaledAtmosUp << "\n";
+        std::cout << "  Rescaled (FullSphere): " << mState.dirDiag.rescaledFullSphere << "\n";
     }
-    std::cout << "  Invalid/fallback directions: " << mDirDiag.invalidDir << "\n";
+    std::cout << "  Invalid/fallback directions: " << mState.dirDiag.invalidDir << "\n";
 }
 
 // Find nearest speaker direction for fallback
@@ -357,19 +394,19 @@ al::Vec3f SpatialRenderer::nearestSpeakerDir(const al::Vec3f& dir) {
 void SpatialRenderer::printPannerDiagSummary() {
     std::cout << "\n" << pannerTypeName(mActivePannerType) << " Robustness Summary:\n";
     
-    if (mPannerDiag.totalZeroBlocks == 0 && mPannerDiag.totalRetargets == 0 && mPannerDiag.totalSubsteps == 0) {
+    if (mState.pannerDiag.totalZeroBlocks == 0 && mState.pannerDiag.totalRetargets == 0 && mState.pannerDiag.totalSubsteps == 0) {
         std::cout << "  All blocks rendered normally (no panner failures or fast motion detected)\n";
         return;
     }
     
-    std::cout << "  Total zero-output blocks detected: " << mPannerDiag.totalZeroBlocks << "\n";
-    std::cout << "  Total retargets to nearest speaker: " << mPannerDiag.totalRetargets << "\n";
-    std::cout << "  Total sub-stepped blocks (fast motion): " << mPannerDiag.totalSubsteps << "\n";
+    std::cout << "  Total zero-output blocks detected: " << mState.pannerDiag.totalZeroBlocks << "\n";
+    std::cout << "  Total retargets to nearest speaker: " << mState.pannerDiag.totalRetargets << "\n";
+    std::cout << "  Total sub-stepped blocks (fast motion): " << mState.pannerDiag.totalSubsteps << "\n";
     
     // Show top offenders for zero blocks
-    if (!mPannerDiag.zeroBlocks.empty()) {
+    if (!mState.pannerDiag.zeroBlocks.empty()) {
         std::vector<std::pair<std::string, uint64_t>> sorted(
-            mPannerDiag.zeroBlocks.begin(), mPannerDiag.zeroBlocks.end());
+            mState.pannerDiag.zeroBlocks.begin(), mState.pannerDiag.zeroBlocks.end());
         std::sort(sorted.begin(), sorted.end(),
                   [](const auto& a, const auto& b) { return a.second > b.second; });
         
@@ -382,9 +419,9 @@ void SpatialRenderer::printPannerDiagSummary() {
     }
     
     // Show top offenders for substeps
-    if (!mPannerDiag.substeppedBlocks.empty()) {
+    if (!mState.pannerDiag.substeppedBlocks.empty()) {
         std::vector<std::pair<std::string, uint64_t>> sorted(
-            mPannerDiag.substeppedBlocks.begin(), mPannerDiag.substeppedBlocks.end());
+            mState.pannerDiag.substeppedBlocks.begin(), mState.pannerDiag.substeppedBlocks.end());
         std::sort(sorted.begin(), sorted.end(),
                   [](const auto& a, const auto& b) { return a.second > b.second; });
         
@@ -438,18 +475,19 @@ al::Vec3f SpatialRenderer::slerpDir(const al::Vec3f& a, const al::Vec3f& b, floa
 // Main safe direction getter - wraps interpolation with fallback logic
 al::Vec3f SpatialRenderer::safeDirForSource(const std::string& name, 
                                              const std::vector<Keyframe>& kfs, 
-                                             double t) {
+                                             double t, RenderState& st) {
     // Get raw interpolated direction
-    al::Vec3f v = interpolateDirRaw(kfs, t);
+    al::Vec3f v = interpolateDirRaw(kfs, t, st.keyframeCursor[name]);
     float m2 = v.magSqr();
     
     // Check for degenerate direction
     if (!finite3(v) || !std::isfinite(m2) || m2 < 1e-8f) {
         // Increment fallback counter
-        mFallbackCount[name]++;
+        st.fallbackCount[name]++;
+        st.totalFallbacks++;
         
         // Warn once per source with detailed reason
-        if (mWarnedDegenerate.find(name) == mWarnedDegenerate.end()) {
+        if (st.warnedDegenerate.find(name) == st.warnedDegenerate.end()) {
             std::cerr << "Warning: degenerate direction for source '" << name 
                       << "' at t=" << t << "s";
             
@@ -465,17 +503,20 @@ al::Vec3f SpatialRenderer::safeDirForSource(const std::string& name,
                           << ", range: " << kfs.front().time << "s to " << kfs.back().time << "s]";
             }
             std::cerr << "\n";
-            mWarnedDegenerate.insert(name);
+            st.warnedDegenerate.insert(name);
         }
         
         // Try last-good direction for this source
-        auto it = mLastGoodDir.find(name);
-        if (it != mLastGoodDir.end()) {
+        auto it = st.lastGoodDir.find(name);
+        if (it != st.lastGoodDir.end()) {
             return it->second;
         }
         
         // No last-good exists: use nearest keyframe direction instead of global front
         // This provides a more sensible fallback that's related to the source's actual data
+        // (Recorded so a parallel time slice can tell whether it diverged
+        // from the serial render — see renderPerBlock().)
+        st.coldFallback.insert(name);
         if (!kfs.empty()) {
             al::Vec3f fallbackDir;
             if (t <= kfs.front().time) {
@@ -499,7 +540,7 @@ al::Vec3f SpatialRenderer::safeDirForSource(const std::string& name,
             }
             
             // Store as last-good so future fallbacks use this
-            mLastGoodDir[name] = fallbackDir;
+            st.lastGoodDir[name] = fallbackDir;
             return fallbackDir;
         }
         
@@ -509,12 +550,12 @@ al::Vec3f SpatialRenderer::safeDirForSource(const std::string& name,
     
     // Valid direction - normalize and store as last-good
     al::Vec3f normalized = v.normalize();
-    mLastGoodDir[name] = normalized;
+    st.lastGoodDir[name] = normalized;
     return normalized;
 }
 
 // Raw interpolation - may return invalid vectors (caller must validate)
-al::Vec3f SpatialRenderer::interpolateDirRaw(const std::vector<Keyframe> &kfs, double t) {
+al::Vec3f SpatialRenderer::interpolateDirRaw(const std::vector<Keyframe> &kfs, double t, size_t &cursor) {
     // Returns interpolated direction from keyframes using SLERP.
     // This avoids the near-zero vector problem that linear Cartesian interpolation has
     // when keyframes are far apart on the sphere (chord through origin).
@@ -540,16 +581,10 @@ al::Vec3f SpatialRenderer::interpolateDirRaw(const std::vector<Keyframe> &kfs, d
         return safeNormalize(al::Vec3f(kfs.back().x, kfs.back().y, kfs.back().z));
     }
     
-    // Find the keyframe segment containing time t
-    const Keyframe *k1 = &kfs[0];
-    const Keyframe *k2 = &kfs[1];
-    for (size_t i = 0; i < kfs.size() - 1; i++) {
-        if (t >= kfs[i].time && t <= kfs[i+1].time) {
-            k1 = &kfs[i];
-            k2 = &kfs[i+1];
-            break;
-        }
-    }
+    // Find the keyframe segment containing time t (cursor hint, O(1) amortized)
+    const size_t seg = findKeyframeSegment(kfs, t, cursor);
+    const Keyframe *k1 = &kfs[seg];
+    const Keyframe *k2 = &kfs[seg + 1];
     
     // Handle degenerate time segments (dt <= 0)
     double dt = k2->time - k1->time;
@@ -571,13 +606,13 @@ al::Vec3f SpatialRenderer::interpolateDirRaw(const std::vector<Keyframe> &kfs, d
 
 // Print end-of-render fallback summary
 void SpatialRenderer::printFallbackSummary(int totalBlocks) {
-    if (mFallbackCount.empty()) {
+    if (mState.fallbackCount.empty()) {
         std::cout << "  Direction fallbacks: none (all sources had valid directions)\n";
         return;
     }
     
     // Sort sources by fallback count (descending)
-    std::vector<std::pair<std::string, int>> sorted(mFallbackCount.begin(), mFallbackCount.end());
+    std::vector<std::pair<std::string, int>> sorted(mState.fallbackCount.begin(), mState.fallbackCount.end());
     std::sort(sorted.begin(), sorted.end(), 
               [](const auto& a, const auto& b) { return a.second > b.second; });
     
@@ -622,24 +657,36 @@ void SpatialRenderer::normalizeKeyframeTimes(double durationSec, size_t totalSam
 
 // Compute statistics on rendered output
 void SpatialRenderer::computeRenderStats(const MultiWavData &output) {
+    beginRenderStats(output.channels, output.sampleRate);
+    accumulateRenderStats(output, output.samples.empty() ? 0 : output.samples[0].size());
+    finishRenderStats();
+}
+
+// Incremental statistics: begin once, accumulate every rendered chunk in
+// order, finish once. Sums run over the same sample sequence as the
+// whole-file pass, so chunked and in-memory renders report identical stats.
+void SpatialRenderer::beginRenderStats(int channels, int sampleRate) {
     mLastStats = RenderStats();
-    mLastStats.numChannels = output.channels;
-    mLastStats.totalSamples = output.samples.empty() ? 0 : output.samples[0].size();
-    mLastStats.durationSec = (double)mLastStats.totalSamples / output.sampleRate;
+    mLastStats.numChannels = channels;
     mLastStats.numSources = mSpatial.sources.size();
-    
-    mLastStats.channelRMS.resize(output.channels, 0.0f);
-    mLastStats.channelPeak.resize(output.channels, 0.0f);
-    mLastStats.channelNaNCount.resize(output.channels, 0);
-    mLastStats.channelInfCount.resize(output.channels, 0);
-    
-    for (int ch = 0; ch < output.channels; ch++) {
-        const auto &samples = output.samples[ch];
-        double sumSq = 0.0;
-        float peak = 0.0f;
+    mStatsSampleRate = sampleRate;
+
+    mLastStats.channelRMS.resize(channels, 0.0f);
+    mLastStats.channelPeak.resize(channels, 0.0f);
+    mLastStats.channelNaNCount.resize(channels, 0);
+    mLastStats.channelInfCount.resize(channels, 0);
+    mStatsSumSq.assign(channels, 0.0);
+}
+
+void SpatialRenderer::accumulateRenderStats(const MultiWavData &chunk, size_t numFrames) {
+    for (int ch = 0; ch < chunk.channels; ch++) {
+        const float *samples = chunk.samples[ch].data();
+        double sumSq = mStatsSumSq[ch];
+        float peak = mLastStats.channelPeak[ch];
         int nanCount = 0, infCount = 0;
         
-        for (float s : samples) {
+        for (size_t i = 0; i < numFrames; i++) {
+            float s = samples[i];
             if (std::isnan(s)) {
                 nanCount++;
             } else if (std::isinf(s)) {
@@ -650,14 +697,21 @@ void SpatialRenderer::computeRenderStats(const MultiWavData &output) {
             }
         }
         
-        double rms = std::sqrt(sumSq / samples.size());
+        mStatsSumSq[ch] = sumSq;
+        mLastStats.channelPeak[ch] = peak;
+        mLastStats.channelNaNCount[ch] += nanCount;
+        mLastStats.channelInfCount[ch] += infCount;
+    }
+    mLastStats.totalSamples += (int)numFrames;
+}
+
+void SpatialRenderer::finishRenderStats() {
+    mLastStats.durationSec = (double)mLastStats.totalSamples / mStatsSampleRate;
+    for (int ch = 0; ch < mLastStats.numChannels; ch++) {
+        double rms = std::sqrt(mStatsSumSq[ch] / mLastStats.totalSamples);
         // Convert to dBFS (0 dB = full scale = 1.0)
         float rmsDB = (rms > 1e-10) ? 20.0f * std::log10((float)rms) : -120.0f;
-        
         mLastStats.channelRMS[ch] = rmsDB;
-        mLastStats.channelPeak[ch] = peak;
-        mLastStats.channelNaNCount[ch] = nanCount;
-        mLastStats.channelInfCount[ch] = infCount;
     }
 }
 
@@ -669,22 +723,614 @@ MultiWavData SpatialRenderer::render() {
 
 // Main render function with configuration options
 MultiWavData SpatialRenderer::render(const RenderConfig &config) {
+    const RenderRange range = beginRender(config);
+    
+    // output uses consecutive channels 0 to numSpeakers-1
+    //return here if there are indexing issues with channel output 
+    MultiWavData out;
+    out.sampleRate = mSpatial.sampleRate;
+    out.channels = outputChannelCount();
+    out.samples.resize(out.channels);
+    for (auto &c : out.samples) c.resize(range.renderSamples, 0.0f);
+
+    // Dispatch to appropriate render resolution
+    if (!checkRenderResolution(config)) {
+        mLayoutIs2D = mSavedLayoutIs2D;
+        return {};  // Return empty result
+    }
+    renderPerBlock(out, config, range.startSample, range.endSample);
+    
+    // Compute and store render statistics
+    computeRenderStats(out);
+    
+    endRender(config, range);
+    return out;
+}
+
+// Chunked streaming render: sources are pulled through mReader one chunk at
+// a time and every rendered chunk is appended straight to the output file, so
+// peak memory is bounded by config.chunkSec rather than program length.
+//
+// The chunk length is rounded to a whole number of config.blockSize blocks and
+// every chunk starts on the same block grid as the whole-file render, and all
+// per-source continuity state (last-good directions, keyframe cursors,
+// diagnostics) lives in members that persist across renderPerBlock() calls —
+// so the output is sample-identical to render() on the same inputs.
+void SpatialRenderer::renderToFile(const RenderConfig &config, const std::string &outPath) {
+    if (!config.stemCacheDir.empty()) {
+        renderIncremental(config, outPath);
+        return;
+    }
+    if (!mReader) {
+        // In-memory construction: fall back to the whole-file path.
+        MultiWavData out = render(config);
+        if (!out.samples.empty()) WavUtils::writeMultichannelWav(outPath, out);
+        return;
+    }
+    
+    const RenderRange range = beginRender(config);
+    if (!checkRenderResolution(config)) {
+        mLayoutIs2D = mSavedLayoutIs2D;
+        return;
+    }
+    
+    const int sr = mSpatial.sampleRate;
+    const size_t blockSize = (size_t)config.blockSize;
+    size_t chunkFrames = (size_t)(std::max(config.chunkSec, 0.0) * sr);
+    chunkFrames = std::max(blockSize, (chunkFrames / blockSize) * blockSize);
+    if (chunkFrames > mReader->chunkFrames()) {
+        // The reader window must cover a whole render chunk.
+        chunkFrames = ((size_t)mReader->chunkFrames() / blockSize) * blockSize;
+        chunkFrames = std::max(chunkFrames, blockSize);
+    }
+    
+    MultiWavData chunk;
+    chunk.sampleRate = sr;
+    chunk.channels = outputChannelCount();
+    chunk.samples.resize(chunk.channels);
+    for (auto &c : chunk.samples) c.resize(chunkFrames, 0.0f);
+    
+    std::cout << "  Chunked render: " << chunkFrames << " frames/chunk ("
+              << (double)chunkFrames / sr << " s, "
+              << (chunk.channels * chunkFrames * sizeof(float)) / (1024 * 1024)
+              << " MB output buffer + same again in the writer queue)\n";
+    
+    // Writer thread with a queue of one chunk: chunk N is written to disk
+    // while chunk N+1 renders (peak memory: two chunk buffers).
+    MultichannelWavWriter writer;
+    writer.open(outPath, chunk.channels, sr, range.renderSamples,
+                chunkFrames / MultichannelWavWriter::kSlabFrames + 1);
+    beginRenderStats(chunk.channels, sr);
+    
+    for (size_t c0 = range.startSample; c0 < range.endSample; c0 += chunkFrames) {
+        const size_t c1 = std::min(range.endSample, c0 + chunkFrames);
+        const size_t len = c1 - c0;
+        
+        std::cout << "  Chunk @ " << std::fixed << std::setprecision(1)
+                  << (double)c0 / sr << " s ("
+                  << (int)(100.0 * (c0 - range.startSample) / std::max<size_t>(range.renderSamples, 1))
+                  << "%)\n" << std::flush;
+        
+        for (auto &c : chunk.samples) std::fill(c.begin(), c.begin() + len, 0.0f);
+        mReader->loadWindow(c0);
+        renderPerBlock(chunk, config, c0, c1, /*logProgress=*/false);
+        
+        accumulateRenderStats(chunk, len);
+        writer.append(chunk, len);
+    }
+    
+    writer.close();
+    std::cout << "Wrote " << writer.framesWritten() << " frames to " << outPath << "\n";
+    
+    finishRenderStats();
+    endRender(config, range);
+}
+
+// Incremental render: renderToFile() with config.stemCacheDir. The program
+// is cut into chunks on the render grid and, per chunk:
+//   1. every audible source is keyed (render settings, its audio in the
+//      chunk, the keyframes around it) and its cached stem header probed;
+//   2. stale stems are rendered on the worker threads, one source per job,
+//      each streamed to the cache as it renders;
+//   3. the chunk bus is read from the cached mix when the mix key (the stem
+//      keys in order) matches, else re-summed from the stems in source order
+//      and the mix rewritten;
+//   4. each source's continuity state and diagnostics advance from its
+//      rendered state or are replayed from its stem header;
+//   5. LFE routing, the NaN scrub and master gain are applied exactly as in
+//      renderBlockRange(), and the chunk is written out.
+// A chunk where nothing changed costs one mix read. An edited trajectory
+// re-renders that source only, and only in the chunks the edit reaches.
+void SpatialRenderer::renderIncremental(const RenderConfig &config, const std::string &outPath) {
+    StemCache cache;
+    if (!cache.open(config.stemCacheDir)) {
+        std::cerr << "  ERROR: cannot create stem cache directory '" << config.stemCacheDir
+                  << "' — rendering without it\n";
+        RenderConfig full = config;
+        full.stemCacheDir.clear();
+        renderToFile(full, outPath);
+        return;
+    }
+    
+    const RenderRange range = beginRender(config);
+    if (!checkRenderResolution(config)) {
+        mLayoutIs2D = mSavedLayoutIs2D;
+        return;
+    }
+    
+    const int sr = mSpatial.sampleRate;
+    const int numSpeakers = mLayout.speakers.size();
+    const size_t blockSize = (size_t)config.blockSize;
+    const double chunkSec = (config.chunkSec > 0.0) ? config.chunkSec : kDefaultStemChunkSec;
+    size_t chunkFrames = (size_t)(chunkSec * sr);
+    chunkFrames = std::max(blockSize, (chunkFrames / blockSize) * blockSize);
+    if (mReader && chunkFrames > mReader->chunkFrames()) {
+        // The reader window must cover a whole render chunk.
+        chunkFrames = ((size_t)mReader->chunkFrames() / blockSize) * blockSize;
+        chunkFrames = std::max(chunkFrames, blockSize);
+    }
+    const uint64_t settingsKey = stemSettingsKey(config, range.startSample, chunkFrames);
+    
+    MultiWavData chunk;
+    chunk.sampleRate = sr;
+    chunk.channels = outputChannelCount();
+    chunk.samples.resize(chunk.channels);
+    for (auto &c : chunk.samples) c.resize(chunkFrames, 0.0f);
+    
+    // Summed bus of one chunk before gain: speaker rows, then the LFE row
+    std::vector<std::vector<float>> bus(numSpeakers + 1, std::vector<float>(chunkFrames, 0.0f));
+    std::vector<float *> busRows;
+    for (auto &row : bus) busRows.push_back(row.data());
+    std::vector<float> audio(chunkFrames);
+    
+    std::cout << "  Incremental render: stems in " << config.stemCacheDir << ", "
+              << chunkFrames << " frames/chunk (" << (double)chunkFrames / sr << " s)\n";
+    
+    MultichannelWavWriter writer;
+    writer.open(outPath, chunk.channels, sr, range.renderSamples,
+                chunkFrames / MultichannelWavWriter::kSlabFrames + 1);
+    beginRenderStats(chunk.channels, sr);
+    
+    struct ChunkSource {
+        const std::string *name = nullptr;
+        const std::vector<Keyframe> *kfs = nullptr;
+        uint64_t key = 0;
+        StemInfo info;        // cached stem header, or that of the stem rendered now
+        bool cached = false;
+        RenderState state;    // rendered stems: the chunk state they leave
+        uint32_t tracePass = 0;   // trace pass of the stem rendered in step 2
+    };
+    
+    // Stale stems render source-parallel; worker 0 uses the active panner
+    const size_t numWorkers = (size_t)std::max(1, config.numThreads);
+    std::vector<std::unique_ptr<al::Dbap>> workerDbap(numWorkers);
+    std::vector<std::unique_ptr<al::Lbap>> workerLbap(numWorkers);
+    std::vector<al::Spatializer *> workerPanner(numWorkers, mActiveSpatializer);
+    for (size_t w = 1; w < numWorkers; ++w) {
+        workerPanner[w] = makeWorkerPanner(config, workerDbap[w], workerLbap[w]);
+    }
+    
+    size_t stemsTotal = 0, stemsRendered = 0, numChunks = 0, mixesReused = 0;
+    std::atomic<bool> warnedWrite{false};
+    
+    for (size_t c0 = range.startSample; c0 < range.endSample; c0 += chunkFrames) {
+        const size_t c1 = std::min(range.endSample, c0 + chunkFrames);
+        const size_t len = c1 - c0;
+        const StemShape busShape{(uint32_t)numSpeakers, (uint32_t)blockSize, len};
+        const StemShape lfeShape{1, (uint32_t)blockSize, len};
+        numChunks++;
+        
+        // 1. Key every audible source and probe its stem
+        if (mReader) mReader->loadWindow(c0);
+        std::vector<ChunkSource> srcs;
+        for (const auto &[name, kfs] : mSpatial.sources) {
+            if (!config.soloSource.empty() && name != config.soloSource) continue;
+            const bool hasAudio = mReader ? mReader->hasSource(name)
+                                          : (mSources.find(name) != mSources.end());
+            if (!hasAudio) continue;
+            const SilenceRuns *runs = silenceFor(name);
+            if (runs && runs->covers(c0, c1)) continue;   // adds nothing to the bus
+            
+            readSourceRange(name, c0, len, audio.data());
+            ChunkSource cs;
+            cs.name = &name;
+            cs.kfs = &kfs;
+            cs.key = stemKey(settingsKey, name, kfs, c0, c1, audio.data());
+            cs.cached = StemCache::probe(cache.stemPath(name, c0),
+                                         name == "LFE" ? lfeShape : busShape, cs.info)
+                     && cs.info.key == cs.key && incomingMatches(cs.info, name);
+            srcs.push_back(std::move(cs));
+        }
+        
+        // 2. Render stale stems, streaming each to the cache
+        std::vector<ChunkSource *> stale;
+        for (auto &cs : srcs) {
+            if (!cs.cached) stale.push_back(&cs);
+        }
+        std::atomic<size_t> next{0};
+        auto renderStale = [&](size_t w) {
+            for (size_t j; (j = next.fetch_add(1)) < stale.size();) {
+                ChunkSource &cs = *stale[j];
+                const std::string path = cache.stemPath(*cs.name, c0);
+                StemCache::Writer stem;
+                const bool opened = stem.open(path, *cs.name == "LFE" ? lfeShape : busShape);
+                cs.state = chunkStartState(*cs.name);
+                const TraceContext trace = mTrace.context(w);
+                cs.tracePass = trace.pass;
+                renderSourceChunk(*cs.name, *cs.kfs, config, c0, c1, cs.state, workerPanner[w],
+                                  [&](size_t b, const float *const *rows, size_t n) {
+                                      stem.addBlock(b, rows, n);
+                                  }, trace);
+                cs.info = stemInfoFor(cs.key, *cs.name, cs.state);
+                if (!(opened && stem.close(cs.info)) && !warnedWrite.exchange(true)) {
+                    std::cerr << "  Warning: could not write stem " << path
+                              << " (summed directly; further warnings suppressed)\n";
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t w = 1; w < std::min(numWorkers, stale.size()); ++w) {
+            workers.emplace_back(renderStale, w);
+        }
+        renderStale(0);
+        for (auto &t : workers) t.join();
+        
+        // 3. Chunk bus: the cached mix, else the stems re-summed in source order
+        StemKey mixKey;
+        mixKey.add(settingsKey).add((uint64_t)c0).add((uint64_t)c1);
+        for (const auto &cs : srcs) mixKey.add(*cs.name).add(cs.info.effectiveKey());
+        const StemShape mixShape{(uint32_t)numSpeakers + 1, (uint32_t)len, len};
+        const std::string mixFile = cache.mixPath(c0);
+        StemInfo mixInfo;
+        mixInfo.key = mixKey.digest();
+        
+        for (auto &row : bus) std::fill(row.begin(), row.begin() + len, 0.0f);
+        const bool mixHit = StemCache::accumulate(mixFile, mixInfo.key, mixShape, busRows.data());
+        if (mixHit) {
+            mixesReused++;
+        } else {
+            for (auto &cs : srcs) {
+                const bool isLFE = (*cs.name == "LFE");
+                float *const *dst = isLFE ? &busRows[numSpeakers] : busRows.data();
+                const StemShape &shape = isLFE ? lfeShape : busShape;
+                if (StemCache::accumulate(cache.stemPath(*cs.name, c0), cs.info.key, shape, dst)) continue;
+                
+                // Not written, or gone since the probe: render it onto the bus
+                // (its step-2 trace records, if any, are superseded)
+                mTrace.discard(0, cs.tracePass);
+                cs.state = chunkStartState(*cs.name);
+                cs.cached = false;
+                renderSourceChunk(*cs.name, *cs.kfs, config, c0, c1, cs.state, mActiveSpatializer,
+                                  [&](size_t b, const float *const *rows, size_t n) {
+                                      for (uint32_t ch = 0; ch < shape.channels; ++ch) {
+                                          float *o = dst[ch] + b * blockSize;
+                                          for (size_t i = 0; i < n; ++i) o[i] += rows[ch][i];
+                                      }
+                                  }, mTrace.context(0));
+            }
+            StemCache::Writer mix;
+            if (mix.open(mixFile, mixShape)) {
+                mix.addBlock(0, busRows.data(), len);
+                mix.close(mixInfo);
+            }
+        }
+        
+        // 4. Continuity state and diagnostics, in source order
+        size_t renderedHere = 0;
+        for (auto &cs : srcs) {
+            if (cs.cached) {
+                applyStemInfo(*cs.name, cs.info);
+            } else {
+                mergeSliceState(mState, cs.state);
+                renderedHere++;
+            }
+        }
+        stemsTotal += srcs.size();
+        stemsRendered += renderedHere;
+        
+        std::cout << "  Chunk @ " << std::fixed << std::setprecision(1)
+                  << (double)c0 / sr << " s ("
+                  << (int)(100.0 * (c0 - range.startSample) / std::max<size_t>(range.renderSamples, 1))
+                  << "%): " << renderedHere << "/" << srcs.size() << " stems rendered"
+                  << (mixHit ? ", mix cached" : "") << "\n" << std::flush;
+        
+        // 5. Output: LFE to the subs, then speakers with NaN scrub and gain.
+        // Same order and arithmetic as renderBlockRange().
+        for (auto &c : chunk.samples) std::fill(c.begin(), c.begin() + len, 0.0f);
+        if (!mSubwooferChannels.empty()) {
+            float subGain = (config.masterGainLinear() * dbap_sub_compensation) / mSubwooferChannels.size();
+            const float *lfe = bus[numSpeakers].data();
+            for (size_t i = 0; i < len; ++i) {
+                for (int subCh : mSubwooferChannels) {
+                    chunk.samples[subCh][i] += lfe[i] * subGain;
+                }
+            }
+        }
+        for (int ch = 0; ch < numSpeakers; ch++) {
+            const float *in = bus[ch].data();
+            float *out = chunk.samples[ch].data();
+            for (size_t i = 0; i < len; i++) {
+                float sample = in[i];
+                if (!std::isfinite(sample)) sample = 0.0f;
+                out[i] = sample * config.masterGainLinear();
+            }
+        }
+        
+        accumulateRenderStats(chunk, len);
+        writer.append(chunk, len);
+    }
+    
+    writer.close();
+    std::cout << "Wrote " << writer.framesWritten() << " frames to " << outPath << "\n";
+    std::cout << "  Stem cache: rendered " << stemsRendered << "/" << stemsTotal
+              << " source stems, reused " << mixesReused << "/" << numChunks << " chunk mixes\n";
+    
+    finishRenderStats();
+    endRender(config, range);
+}
+
+void SpatialRenderer::renderSourceChunk(const std::string &name, const std::vector<Keyframe> &kfs,
+                                         const RenderConfig &config, size_t c0, size_t c1,
+                                         RenderState &st, al::Spatializer *panner,
+                                         const StemBlockFn &onBlock, const TraceContext &trace) {
+    int sr = mSpatial.sampleRate;
+    int numSpeakers = mLayout.speakers.size();
+    int bufferSize = config.blockSize;
+    
+    al::AudioIOData audioIO;
+    audioIO.framesPerBuffer(bufferSize);
+    audioIO.framesPerSecond(sr);
+    audioIO.channelsIn(0);
+    audioIO.channelsOut(numSpeakers);
+    
+    al::AudioIOData audioTemp;
+    audioTemp.framesPerBuffer(bufferSize);
+    audioTemp.framesPerSecond(sr);
+    audioTemp.channelsIn(0);
+    audioTemp.channelsOut(numSpeakers);
+    
+    std::vector<float> sourceBuffer(bufferSize, 0.0f);
+    const bool isLFE = (name == "LFE");
+    const float *lfeRow = sourceBuffer.data();
+    std::vector<std::vector<float>> rows(isLFE ? 0 : numSpeakers, std::vector<float>(bufferSize));
+    std::vector<const float *> rowPtrs;
+    for (const auto &row : rows) rowPtrs.push_back(row.data());
+    const uint32_t srcIndex = trace
+        ? (uint32_t)std::distance(mSpatial.sources.begin(), mSpatial.sources.find(name)) : 0;
+    
+    for (size_t blockStart = c0; blockStart < c1; blockStart += bufferSize) {
+        size_t blockLen = std::min(c1, blockStart + bufferSize) - blockStart;
+        if (!fillSourceBlock(name, blockStart, blockLen, sourceBuffer)) continue;
+        const size_t blockIndex = (blockStart - c0) / bufferSize;
+        
+        if (isLFE) {
+            onBlock(blockIndex, &lfeRow, blockLen);
+            if (trace) {
+                TraceRecord rec;
+                rec.flags = kTraceLfe;
+                trace.block(blockStart, srcIndex, rec);
+            }
+            continue;
+        }
+        
+        // Zeroed accumulator: the rows are exactly what this source adds to
+        // the shared bus in renderBlockRange()
+        audioIO.zeroOut();
+        TraceRecord rec;
+        panSourceBlock(name, kfs, config, blockStart, blockLen, sourceBuffer.data(),
+                       st, panner, audioIO, audioTemp, trace ? &rec : nullptr);
+        if (trace) trace.block(blockStart, srcIndex, rec);
+        audioIO.frame(0);
+        for (int ch = 0; ch < numSpeakers; ch++) {
+            for (size_t i = 0; i < blockLen; i++) rows[ch][i] = audioIO.out(ch, i);
+        }
+        onBlock(blockIndex, rowPtrs.data(), blockLen);
+    }
+}
+
+uint64_t SpatialRenderer::stemSettingsKey(const RenderConfig &config, size_t gridStart,
+                                          size_t chunkFrames) const {
+    StemKey k;
+    k.add(mSpatial.sampleRate).add(config.blockSize)
+     .add((uint64_t)gridStart).add((uint64_t)chunkFrames);
+    k.add((int)mActivePannerType);
+    if (mActivePannerType == PannerType::DBAP) k.add(config.dbapFocus);
+    else                                       k.add(config.lbapDispersion);
+    k.add((int)config.elevationMode).add(mLayoutIs2D)
+     .add(mLayoutRadius).add(mLayoutMinElRad).add(mLayoutMaxElRad);
+    k.add((uint64_t)mLayout.speakers.size());
+    for (const auto &spk : mLayout.speakers) {
+        k.add(spk.azimuth).add(spk.elevation).add(spk.radius).add(spk.deviceChannel);
+    }
+    // Robustness tunables change rendered samples too
+    k.add(kInputEnergyThreshold).add(kPannerZeroThreshold).add(kFastMoverAngleRad).add(kSubStepHop);
+    return k.digest();
+}
+
+uint64_t SpatialRenderer::stemKey(uint64_t settingsKey, const std::string &name,
+                                  const std::vector<Keyframe> &kfs,
+                                  size_t c0, size_t c1, const float *audio) const {
+    StemKey k;
+    k.add(settingsKey).add(name).add((uint64_t)c0).add((uint64_t)c1);
+    k.add(SceneCache::hashBytes(audio, (c1 - c0) * sizeof(float)));
+    if (name == "LFE" || kfs.empty()) return k.digest();   // LFE bypasses the panner
+    
+    // Keyframes a direction evaluated in [c0, c1) can read: the last one
+    // before the chunk (and its equal-time twins), every one inside it, and
+    // the first one after it. Neither interpolateDirRaw() nor the
+    // nearest-keyframe fallback in safeDirForSource() looks further.
+    const double tStart = (double)c0 / mSpatial.sampleRate;
+    const double tEnd = (double)c1 / mSpatial.sampleRate;
+    const auto byTime = [](const Keyframe &kf, double t) { return kf.time < t; };
+    size_t lo = (size_t)(std::lower_bound(kfs.begin(), kfs.end(), tStart, byTime) - kfs.begin());
+    lo = (lo > 0) ? lo - 1 : 0;
+    while (lo > 0 && kfs[lo - 1].time == kfs[lo].time) --lo;
+    size_t hi = (size_t)(std::upper_bound(kfs.begin(), kfs.end(), tEnd,
+                                          [](double t, const Keyframe &kf) { return t < kf.time; })
+                         - kfs.begin());
+    hi = std::min(hi, kfs.size() - 1);
+    k.add((uint64_t)(hi - lo + 1));
+    for (size_t i = lo; i <= hi; ++i) {
+        k.add(kfs[i].time).add(kfs[i].x).add(kfs[i].y).add(kfs[i].z);
+    }
+    return k.digest();
+}
+
+void SpatialRenderer::readSourceRange(const std::string &name, size_t start, size_t n, float *dst) {
+    if (mReader) {
+        mReader->readBlock(name, start, n, dst);
+        return;
+    }
+    auto it = mSources.find(name);
+    const size_t size = (it != mSources.end()) ? it->second.samples.size() : 0;
+    const size_t avail = (start < size) ? std::min(n, size - start) : 0;
+    if (avail > 0) std::memcpy(dst, it->second.samples.data() + start, avail * sizeof(float));
+    std::fill(dst + avail, dst + n, 0.0f);
+}
+
+SpatialRenderer::RenderState SpatialRenderer::chunkStartState(const std::string &name) const {
+    RenderState st;
+    auto lg = mState.lastGoodDir.find(name);
+    if (lg != mState.lastGoodDir.end()) st.lastGoodDir[name] = lg->second;
+    auto cur = mState.keyframeCursor.find(name);
+    if (cur != mState.keyframeCursor.end()) st.keyframeCursor[name] = cur->second;
+    if (mState.warnedDegenerate.count(name)) st.warnedDegenerate.insert(name);
+    return st;
+}
+
+StemInfo SpatialRenderer::stemInfoFor(uint64_t key, const std::string &name,
+                                      const RenderState &st) const {
+    StemInfo info;
+    info.key = key;
+    
+    // Incoming direction: mState still holds the chunk-start state
+    auto in = mState.lastGoodDir.find(name);
+    const bool hasIn = (in != mState.lastGoodDir.end());
+    if (hasIn) {
+        info.flags |= StemInfo::kHasIncoming;
+        info.incoming[0] = in->second.x;
+        info.incoming[1] = in->second.y;
+        info.incoming[2] = in->second.z;
+    }
+    
+    // Only a fallback reads the incoming direction. Whether one happens
+    // depends on the keyframes alone, so the key already fixes this flag.
+    auto count = [&](const auto &map) -> uint64_t {
+        auto it = map.find(name);
+        return (it != map.end()) ? (uint64_t)it->second : 0;
+    };
+    info.diag.fallbacks = count(st.fallbackCount);
+    if (info.diag.fallbacks > 0) info.flags |= StemInfo::kUsesIncoming;
+    
+    auto out = st.lastGoodDir.find(name);
+    if (out != st.lastGoodDir.end()) {
+        info.outgoing[0] = out->second.x;
+        info.outgoing[1] = out->second.y;
+        info.outgoing[2] = out->second.z;
+        if (!hasIn || std::memcmp(info.outgoing, info.incoming, sizeof(info.outgoing)) != 0) {
+            info.flags |= StemInfo::kSetsOutgoing;
+        }
+    }
+    
+    info.diag.zeroBlocks         = count(st.pannerDiag.zeroBlocks);
+    info.diag.retargets          = count(st.pannerDiag.retargetBlocks);
+    info.diag.substeps           = count(st.pannerDiag.substeppedBlocks);
+    info.diag.clampedEl          = st.dirDiag.clampedEl;
+    info.diag.rescaledAtmosUp    = st.dirDiag.rescaledAtmosUp;
+    info.diag.rescaledFullSphere = st.dirDiag.rescaledFullSphere;
+    info.diag.flattened2D        = st.dirDiag.flattened2D;
+    info.diag.invalidDir         = st.dirDiag.invalidDir;
+    return info;
+}
+
+bool SpatialRenderer::incomingMatches(const StemInfo &info, const std::string &name) const {
+    if (!(info.flags & StemInfo::kUsesIncoming)) return true;
+    auto in = mState.lastGoodDir.find(name);
+    const bool hasIn = (in != mState.lastGoodDir.end());
+    if (hasIn != ((info.flags & StemInfo::kHasIncoming) != 0)) return false;
+    if (!hasIn) return true;
+    const float cur[3] = {in->second.x, in->second.y, in->second.z};
+    return std::memcmp(cur, info.incoming, sizeof(cur)) == 0;
+}
+
+void SpatialRenderer::applyStemInfo(const std::string &name, const StemInfo &info) {
+    if (info.flags & StemInfo::kSetsOutgoing) {
+        mState.lastGoodDir[name] = al::Vec3f(info.outgoing[0], info.outgoing[1], info.outgoing[2]);
+    }
+    const StemDiag &d = info.diag;
+    if (d.fallbacks > 0) {
+        mState.fallbackCount[name] += (int)d.fallbacks;
+        mState.totalFallbacks += d.fallbacks;
+    }
+    if (d.zeroBlocks > 0) {
+        mState.pannerDiag.zeroBlocks[name] += d.zeroBlocks;
+        mState.pannerDiag.totalZeroBlocks += d.zeroBlocks;
+    }
+    if (d.retargets > 0) {
+        mState.pannerDiag.retargetBlocks[name] += d.retargets;
+        mState.pannerDiag.totalRetargets += d.retargets;
+    }
+    if (d.substeps > 0) {
+        mState.pannerDiag.substeppedBlocks[name] += d.substeps;
+        mState.pannerDiag.totalSubsteps += d.substeps;
+    }
+    mState.dirDiag.clampedEl          += d.clampedEl;
+    mState.dirDiag.rescaledAtmosUp    += d.rescaledAtmosUp;
+    mState.dirDiag.rescaledFullSphere += d.rescaledFullSphere;
+    mState.dirDiag.flattened2D        += d.flattened2D;
+    mState.dirDiag.invalidDir         += d.invalidDir;
+}
+
+// Output width: consecutive channels 0..numSpeakers-1 plus any subwoofer
+// channels placed beyond (or out of order with) the speaker count.
+int SpatialRenderer::outputChannelCount() const {
+    int maxChannel = (int)mLayout.speakers.size() - 1;
+    for (int subCh : mSubwooferChannels) {
+        if (subCh > maxChannel) maxChannel = subCh;
+    }
+    return maxChannel + 1;
+}
+
+// Only 'block' resolution is active; 'sample' and 'smooth' are disabled.
+bool SpatialRenderer::checkRenderResolution(const RenderConfig &config) const {
+    if (config.renderResolution == "sample") {
+        std::cerr << "  ERROR: 'sample' mode is DISABLED. Use 'block' mode instead.\n";
+        std::cerr << "         For per-sample accuracy, use 'block' mode with --block_size 1.\n";
+        return false;
+    } else if (config.renderResolution == "smooth") {
+        std::cerr << "  ERROR: 'smooth' mode is DISABLED. Use 'block' mode instead.\n";
+        std::cerr << "         For smooth interpolation, use 'block' mode with small --block_size.\n";
+        return false;
+    } else if (config.renderResolution != "block") {
+        std::cerr << "  ERROR: Unknown render resolution '" << config.renderResolution << "', using 'block'\n";
+    }
+    return true;
+}
+
+// Shared render prologue: spatializer setup, per-render state reset, time
+// range resolution, and the pre-render console report / source diagnostics.
+SpatialRenderer::RenderRange SpatialRenderer::beginRender(const RenderConfig &config) {
     int sr = mSpatial.sampleRate;
     int numSpeakers = mLayout.speakers.size();
+    RenderRange range;
     
     // Initialize the selected spatializer
     initializeSpatializer(config);
     
     // Apply force2D mode if requested via config
-    bool originalIs2D = mLayoutIs2D;
+    mSavedLayoutIs2D = mLayoutIs2D;
     if (config.force2D && !mLayoutIs2D) {
         mLayoutIs2D = true;
         std::cout << "FORCE_2D: Treating layout as 2D (all elevations will be flattened)\n";
     }
 
     size_t totalSamples = 0;
-    for (auto &[name, wav] : mSources) {
-        totalSamples = std::max(totalSamples, wav.samples.size());
+    if (mReader) {
+        totalSamples = (size_t)mReader->totalFrames();
+    } else {
+        for (auto &[name, wav] : mSources) {
+            totalSamples = std::max(totalSamples, wav.samples.size());
+        }
     }
     
     // Use LUSID scene duration if available, otherwise calculate from WAV files
@@ -724,13 +1370,17 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
 
     std::cout << "Rendering " << renderSamples << " samples (" 
               << (double)renderSamples / sr << " sec) to " 
-              << numSpeakers << " speakers from " << mSources.size() << " sources\n";
+              << numSpeakers << " speakers from "
+              << (mReader ? mReader->numSources() : mSources.size()) << " sources\n";
     
     // Print spatializer info
     printSpatializerInfo(config);
     
     std::cout << "  Master gain: " << config.masterGainDb << " dB\n";
     std::cout << "  Render resolution: " << config.renderResolution << " (block size: " << config.blockSize << ")\n";
+    if (config.numThreads > 1) {
+        std::cout << "  Render threads: " << config.numThreads << " (time-sliced)\n";
+    }
     // Print a human-readable elevation mode string
     std::string emodeStr;
     switch (config.elevationMode) {
@@ -756,15 +1406,25 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
     int missingAudio = 0;
     
     for (const auto& [name, kfs] : mSpatial.sources) {
-        auto srcIt = mSources.find(name);
-        if (srcIt == mSources.end()) {
+        const bool hasAudio = mReader ? mReader->hasSource(name)
+                                      : (mSources.find(name) != mSources.end());
+        if (!hasAudio) {
             std::cerr << "    WARNING: Source '" << name << "' has spatial data but no audio file!\n";
             missingAudio++;
             continue;
         }
         
+        if (kfs.empty()) {
+            std::cerr << "    WARNING: Source '" << name << "' has no keyframes!\n";
+            missingSpatial++;
+        }
+        
+        // Input RMS needs the whole source resident — in-memory mode only
+        // (chunked mode would have to read every source twice).
+        if (mReader) continue;
+        
         // Compute input RMS for this source
-        const MonoWavData& src = srcIt->second;
+        const MonoWavData& src = mSources.find(name)->second;
         double sumSq = 0.0;
         size_t count = 0;
         for (size_t i = startSample; i < endSample && i < src.samples.size(); i++) {
@@ -779,11 +1439,6 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
                       << std::fixed << std::setprecision(1) << rmsDB << " dBFS)\n";
             silentSources++;
         }
-        
-        if (kfs.empty()) {
-            std::cerr << "    WARNING: Source '" << name << "' has no keyframes!\n";
-            missingSpatial++;
-        }
     }
     
     // Check for audio files without spatial data
@@ -798,40 +1453,45 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
     }
     std::cout << "\n";
     
-    // output uses consecutive channels 0 to numSpeakers-1
-    //return here if there are indexing issues with channel output 
-    MultiWavData out;
-    out.sampleRate = sr;
-    int maxChannel = numSpeakers - 1;
-    for (int subCh : mSubwooferChannels) {
-        if (subCh > maxChannel) maxChannel = subCh;
+    // Diagnostics trace: one lane per render thread
+    mTrace.close();
+    if (!config.traceFile.empty()) {
+        std::vector<std::string> names;
+        for (const auto &[name, kfs] : mSpatial.sources) names.push_back(name);
+        const size_t lanes = (size_t)std::max(1, config.numThreads);
+        if (mTrace.open(config.traceFile, (uint32_t)sr, (uint32_t)config.blockSize, names, lanes,
+                        config.traceAllBlocks)) {
+            std::cout << "  Trace: " << config.traceFile
+                      << (config.traceAllBlocks ? " (all blocks)" : " (events)") << "\n";
+        } else {
+            std::cerr << "Warning: could not open trace file " << config.traceFile
+                      << " (continuing without it)\n";
+        }
     }
-    //logic to accommodate subwoofer channels that may be beyond speaker count / placed out of order 
-    out.channels = maxChannel + 1;
-    out.samples.resize(out.channels);
-    for (auto &c : out.samples) c.resize(renderSamples, 0.0f);
+    
+    range.startSample = startSample;
+    range.endSample = endSample;
+    range.renderSamples = renderSamples;
+    range.durationSec = durationSec;
+    return range;
+    
+}
 
-    // Dispatch to appropriate render resolution
-    if (config.renderResolution == "block") {
-        renderPerBlock(out, config, startSample, endSample);
-    } else if (config.renderResolution == "sample") {
-        std::cerr << "  ERROR: 'sample' mode is DISABLED. Use 'block' mode instead.\n";
-        std::cerr << "         For per-sample accuracy, use 'block' mode with --block_size 1.\n";
-        return {};  // Return empty result
-    } else if (config.renderResolution == "smooth") {
-        std::cerr << "  ERROR: 'smooth' mode is DISABLED. Use 'block' mode instead.\n";
-        std::cerr << "         For smooth interpolation, use 'block' mode with small --block_size.\n";
-        return {};  // Return empty result
-    } else {
-        std::cerr << "  ERROR: Unknown render resolution '" << config.renderResolution << "', using 'block'\n";
-        renderPerBlock(out, config, startSample, endSample);
+// Shared render epilogue: console statistics, fallback / sanitization /
+// panner summaries and render_stats.json. Expects mLastStats to be final.
+void SpatialRenderer::endRender(const RenderConfig &config, const RenderRange &range) {
+    int numSpeakers = mLayout.speakers.size();
+    
+    // Every producer has joined: flush and finish the trace
+    if (mTrace.active()) {
+        mTrace.close();
+        std::cout << "  Trace: " << mTrace.records() << " records written to " << mTrace.path();
+        if (mTrace.stalls() > 0) std::cout << " (" << mTrace.stalls() << " writer stalls)";
+        std::cout << "\n";
     }
     
     // Calculate total blocks for fallback summary
-    int totalBlocks = (renderSamples + config.blockSize - 1) / config.blockSize;
-    
-    // Compute and store render statistics
-    computeRenderStats(out);
+    int totalBlocks = (range.renderSamples + config.blockSize - 1) / config.blockSize;
     
     // Log summary statistics
     std::cout << "\nRender Statistics:\n";
@@ -903,13 +1563,140 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
     }
     
     // Restore original layout 2D setting if it was overridden
-    mLayoutIs2D = originalIs2D;
+    mLayoutIs2D = mSavedLayoutIs2D;
     
     std::cout << "\n";
-    return out;
 }
 
-// renderPerBlock: Direction computed at block center (reduces stepping artifacts)
+// renderPerBlock: split [startSample, endSample) into config.numThreads
+// contiguous time slices on the block grid and render them concurrently.
+//
+// BIT-IDENTICAL OUTPUT: every block is computed by the same code, with the
+// same source summation order, as in the serial loop, and slices write
+// disjoint ranges of out. The only cross-block dependency is the per-source
+// last-good direction used when interpolation degenerates. Slice 0 starts
+// from the real state; later slices start cold and record every source that
+// had to fall back with no last-good direction (RenderState::coldFallback).
+// After the join the slices are stitched in time order: a slice whose cold
+// fallbacks would have found a last-good direction in the true incoming state
+// is re-rendered serially from that state; otherwise its state is merged as is.
+// Degenerate directions are rare, so re-renders are the exception.
+//
+// Each helper slice gets its own panner instance, AudioIOData buffers and
+// trace lane, so nothing mutable is shared between threads. Only slice 0
+// logs progress. A re-rendered slice's first trace pass is discarded.
+void SpatialRenderer::renderPerBlock(MultiWavData &out, const RenderConfig &config,
+                                      size_t startSample, size_t endSample,
+                                      bool logProgress) {
+    const size_t blockSize = (size_t)config.blockSize;
+    const size_t numBlocks = (endSample > startSample)
+        ? (endSample - startSample + blockSize - 1) / blockSize : 0;
+    const size_t numSlices = std::min<size_t>((size_t)std::max(1, config.numThreads), numBlocks);
+    
+    if (numSlices <= 1) {
+        renderBlockRange(out, config, startSample, startSample, endSample,
+                         mState, mActiveSpatializer, logProgress, mTrace.context(0));
+        return;
+    }
+    
+    struct Slice {
+        size_t start = 0, end = 0;
+        RenderState state;
+        TraceContext trace;
+        std::unique_ptr<al::Dbap> dbap;
+        std::unique_ptr<al::Lbap> lbap;
+        al::Spatializer *panner = nullptr;
+    };
+    std::vector<Slice> slices(numSlices);
+    for (size_t k = 0; k < numSlices; ++k) {
+        Slice &sl = slices[k];
+        sl.start = std::min(endSample, startSample + (numBlocks * k / numSlices) * blockSize);
+        sl.end   = std::min(endSample, startSample + (numBlocks * (k + 1) / numSlices) * blockSize);
+        sl.trace = mTrace.context(k);
+        if (k == 0) {
+            sl.state = std::move(mState);
+            sl.panner = mActiveSpatializer;
+        } else {
+            sl.panner = makeWorkerPanner(config, sl.dbap, sl.lbap);
+        }
+    }
+    
+    auto renderSlice = [&](size_t k) {
+        Slice &sl = slices[k];
+        renderBlockRange(out, config, startSample, sl.start, sl.end,
+                         sl.state, sl.panner, logProgress && k == 0, sl.trace);
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(numSlices - 1);
+    for (size_t k = 1; k < numSlices; ++k) workers.emplace_back(renderSlice, k);
+    renderSlice(0);
+    for (auto &t : workers) t.join();
+    
+    // Stitch slices in time order
+    mState = std::move(slices[0].state);
+    int rerendered = 0;
+    for (size_t k = 1; k < numSlices; ++k) {
+        Slice &sl = slices[k];
+        bool diverged = false;
+        for (const auto &name : sl.state.coldFallback) {
+            if (mState.lastGoodDir.count(name)) { diverged = true; break; }
+        }
+        if (!diverged) {
+            mergeSliceState(mState, sl.state);
+            continue;
+        }
+        for (auto &c : out.samples) {
+            std::fill(c.begin() + (sl.start - startSample), c.begin() + (sl.end - startSample), 0.0f);
+        }
+        mTrace.discard(0, sl.trace.pass);
+        renderBlockRange(out, config, startSample, sl.start, sl.end,
+                         mState, mActiveSpatializer, false, mTrace.context(0));
+        rerendered++;
+    }
+    if (rerendered > 0) {
+        std::cout << "  Re-rendered " << rerendered << "/" << numSlices
+                  << " time slices serially (direction fallback crossed a slice boundary)\n";
+    }
+}
+
+al::Spatializer *SpatialRenderer::makeWorkerPanner(const RenderConfig &config,
+                                                   std::unique_ptr<al::Dbap> &dbap,
+                                                   std::unique_ptr<al::Lbap> &lbap) {
+    if (mActivePannerType == PannerType::DBAP) {
+        dbap = std::make_unique<al::Dbap>(mSpeakers);
+        dbap->setFocus(config.dbapFocus);
+        return dbap.get();
+    }
+    lbap = std::make_unique<al::Lbap>(mSpeakers);
+    lbap->compile();
+    lbap->setDispersionThreshold(config.lbapDispersion);
+    return lbap.get();
+}
+
+void SpatialRenderer::mergeSliceState(RenderState &into, const RenderState &slice) {
+    // Later evaluations win for continuity state, counters add up
+    for (const auto &[name, dir] : slice.lastGoodDir) into.lastGoodDir[name] = dir;
+    for (const auto &[name, cur] : slice.keyframeCursor) into.keyframeCursor[name] = cur;
+    into.warnedDegenerate.insert(slice.warnedDegenerate.begin(), slice.warnedDegenerate.end());
+    into.coldFallback.insert(slice.coldFallback.begin(), slice.coldFallback.end());
+    for (const auto &[name, n] : slice.fallbackCount) into.fallbackCount[name] += n;
+    into.totalFallbacks += slice.totalFallbacks;
+    
+    into.dirDiag.clampedEl          += slice.dirDiag.clampedEl;
+    into.dirDiag.rescaledAtmosUp    += slice.dirDiag.rescaledAtmosUp;
+    into.dirDiag.rescaledFullSphere += slice.dirDiag.rescaledFullSphere;
+    into.dirDiag.flattened2D        += slice.dirDiag.flattened2D;
+    into.dirDiag.invalidDir         += slice.dirDiag.invalidDir;
+    
+    for (const auto &[name, n] : slice.pannerDiag.zeroBlocks)       into.pannerDiag.zeroBlocks[name] += n;
+    for (const auto &[name, n] : slice.pannerDiag.retargetBlocks)   into.pannerDiag.retargetBlocks[name] += n;
+    for (const auto &[name, n] : slice.pannerDiag.substeppedBlocks) into.pannerDiag.substeppedBlocks[name] += n;
+    into.pannerDiag.totalZeroBlocks += slice.pannerDiag.totalZeroBlocks;
+    into.pannerDiag.totalRetargets  += slice.pannerDiag.totalRetargets;
+    into.pannerDiag.totalSubsteps   += slice.pannerDiag.totalSubsteps;
+}
+
+// renderBlockRange: Direction computed at block center (reduces stepping artifacts)
 // 
 // ROBUSTNESS FEATURES (added 2026-01-27):
 // 1. Input energy detection - skip expensive checks for silent blocks
@@ -920,8 +1707,10 @@ MultiWavData SpatialRenderer::render(const RenderConfig &config) {
 // DEV NOTE: Zero-block detection runs for all panners for consistency.
 // Consider optimizing for DBAP/LBAP in future - they shouldn't produce zero blocks.
 //
-void SpatialRenderer::renderPerBlock(MultiWavData &out, const RenderConfig &config,
-                                      size_t startSample, size_t endSample) {
+void SpatialRenderer::renderBlockRange(MultiWavData &out, const RenderConfig &config,
+                                        size_t outBase, size_t startSample, size_t endSample,
+                                        RenderState &st, al::Spatializer *panner,
+                                        bool logProgress, const TraceContext &trace) {
     int sr = mSpatial.sampleRate;
     int numSpeakers = mLayout.speakers.size();
     int bufferSize = config.blockSize;
@@ -948,42 +1737,31 @@ void SpatialRenderer::renderPerBlock(MultiWavData &out, const RenderConfig &conf
     for (size_t blockStart = startSample; blockStart < endSample; blockStart += bufferSize) {
         size_t blockEnd = std::min(endSample, blockStart + bufferSize);
         size_t blockLen = blockEnd - blockStart;
-        size_t outBlockStart = blockStart - startSample;
+        size_t outBlockStart = blockStart - outBase;
         
-        if (blocksProcessed % 1000 == 0) {
-            std::cout << "  Block " << blocksProcessed << " (" 
-                      << (int)(100.0 * (blockStart - startSample) / renderSamples) << "%)\n" << std::flush;
+        if (logProgress && blocksProcessed % 1000 == 0) {
+            if (trace) {
+                // Printed by the trace writer thread instead
+                trace.progress(blockStart, blocksProcessed,
+                               (float)((double)(blockStart - startSample) / renderSamples));
+            } else {
+                std::cout << "  Block " << blocksProcessed << " (" 
+                          << (int)(100.0 * (blockStart - startSample) / renderSamples) << "%)\n" << std::flush;
+            }
         }
         blocksProcessed++;
         
         audioIO.zeroOut();
         
+        uint32_t nextIndex = 0;   // trace source index: position in mSpatial.sources
         for (auto &[name, kfs] : mSpatial.sources) {
+            const uint32_t srcIndex = nextIndex++;
             if (!config.soloSource.empty() && name != config.soloSource) continue;
+
+            // Fill source buffer (silence-mapped, missing and below-threshold
+            // blocks need no panning)
+            if (!fillSourceBlock(name, blockStart, blockLen, sourceBuffer)) continue;
             
-            auto srcIt = mSources.find(name);
-            if (srcIt == mSources.end()) continue;
-            const MonoWavData &src = srcIt->second;
-            
-            // Fill source buffer
-            std::fill(sourceBuffer.begin(), sourceBuffer.end(), 0.0f);
-            for (size_t i = 0; i < blockLen; i++) {
-                size_t globalIdx = blockStart + i;
-                sourceBuffer[i] = (globalIdx < src.samples.size()) ? src.samples[globalIdx] : 0.0f;
-            }
-            
-            // Compute input energy - skip expensive checks for silent blocks
-            float inAbsSum = 0.0f;
-            for (size_t i = 0; i < blockLen; i++) {
-                inAbsSum += std::abs(sourceBuffer[i]);
-            }
-            float inputThreshold = kInputEnergyThreshold * blockLen;
-            bool hasInputEnergy = (inAbsSum >= inputThreshold);
-            
-            // Skip silent sources entirely (no panning needed)
-            if (!hasInputEnergy) {
-                continue;
-            }
             // Special handling for LFE channel / SUB (no spatialization) 
             if (name == "LFE") {
                 // Example: assume mSubwooferChannels is a std::vector<int> of sub channel indices
@@ -994,156 +1772,233 @@ void SpatialRenderer::renderPerBlock(MultiWavData &out, const RenderConfig &conf
                         out.samples[subCh][outBlockStart + i] += sample * subGain;
                     }
                 }
+                if (trace) {
+                    TraceRecord rec;
+                    rec.flags = kTraceLfe;
+                    trace.block(blockStart, srcIndex, rec);
+                }
                 continue; // Skip spatialization for LFE
             }
-
             
-            // Measure angular delta for fast-mover detection
-            // Sample directions at 25% and 75% through the block
-            double t0 = (double)(blockStart + blockLen / 4) / (double)sr;
-            double t1 = (double)(blockStart + 3 * blockLen / 4) / (double)sr;
+            TraceRecord rec;
+            panSourceBlock(name, kfs, config, blockStart, blockLen, sourceBuffer.data(),
+                           st, panner, audioIO, audioTemp, trace ? &rec : nullptr);
+            if (trace) trace.block(blockStart, srcIndex, rec);
+        }
+        
+        // Copy output with gain
+        audioIO.frame(0);
+        for (size_t i = 0; i < blockLen; i++) {
+            for (int ch = 0; ch < numSpeakers; ch++) {
+                float sample = audioIO.out(ch, i);
+                if (!std::isfinite(sample)) sample = 0.0f;
+                out.samples[ch][outBlockStart + i] = sample * config.masterGainLinear();
+            }
+        }
+
+
+    }
+}
+
+// Fill buf with one block of a source. False when the block needs no panning:
+// silence-mapped (all exact zeros, which the energy gate would skip anyway —
+// skipped before the fill instead), no audio for the source, or input energy
+// below kInputEnergyThreshold.
+bool SpatialRenderer::fillSourceBlock(const std::string &name, size_t blockStart, size_t blockLen,
+                                      std::vector<float> &buf) {
+    const SilenceRuns *runs = silenceFor(name);
+    if (runs && runs->covers(blockStart, blockStart + blockLen)) return false;
+    
+    // Fill source buffer (chunked reader or whole-file map)
+    std::fill(buf.begin(), buf.end(), 0.0f);
+    if (mReader) {
+        if (!mReader->hasSource(name)) return false;
+        mReader->readBlock(name, blockStart, blockLen, buf.data());
+    } else {
+        auto srcIt = mSources.find(name);
+        if (srcIt == mSources.end()) return false;
+        const MonoWavData &src = srcIt->second;
+        for (size_t i = 0; i < blockLen; i++) {
+            size_t globalIdx = blockStart + i;
+            buf[i] = (globalIdx < src.samples.size()) ? src.samples[globalIdx] : 0.0f;
+        }
+    }
+    
+    // Compute input energy - skip expensive checks for silent blocks
+    float inAbsSum = 0.0f;
+    for (size_t i = 0; i < blockLen; i++) {
+        inAbsSum += std::abs(buf[i]);
+    }
+    float inputThreshold = kInputEnergyThreshold * blockLen;
+    return inAbsSum >= inputThreshold;
+}
+
+// Pan one (non-LFE) source block onto audioIO, with fast-mover sub-stepping
+// and nearest-speaker retargeting. audioTemp is scratch.
+void SpatialRenderer::panSourceBlock(const std::string &name, const std::vector<Keyframe> &kfs,
+                                     const RenderConfig &config, size_t blockStart, size_t blockLen,
+                                     const float *src, RenderState &st, al::Spatializer *panner,
+                                     al::AudioIOData &audioIO, al::AudioIOData &audioTemp,
+                                     TraceRecord *rec) {
+    int sr = mSpatial.sampleRate;
+    int numSpeakers = mLayout.speakers.size();
+    
+    // Trace: counters before this block (compared at the end) and the
+    // direction panned at the block center
+    const DirDiag diagBefore = st.dirDiag;
+    const uint64_t fallbacksBefore = st.totalFallbacks;
+    const uint64_t retargetsBefore = st.pannerDiag.totalRetargets;
+    al::Vec3f traceDir(0.0f, 1.0f, 0.0f);
+    
+    // Measure angular delta for fast-mover detection
+    // Sample directions at 25% and 75% through the block
+    double t0 = (double)(blockStart + blockLen / 4) / (double)sr;
+    double t1 = (double)(blockStart + 3 * blockLen / 4) / (double)sr;
+    
+    al::Vec3f rawDir0 = safeDirForSource(name, kfs, t0, st);
+    al::Vec3f rawDir1 = safeDirForSource(name, kfs, t1, st);
+    al::Vec3f dir0 = sanitizeDirForLayout(rawDir0, config.elevationMode, st.dirDiag);
+    al::Vec3f dir1 = sanitizeDirForLayout(rawDir1, config.elevationMode, st.dirDiag);
+    
+    float dotVal = std::clamp(dir0.dot(dir1), -1.0f, 1.0f);
+    float angleDelta = std::acos(dotVal);
+    
+    bool isFastMover = (angleDelta > kFastMoverAngleRad);
+    
+    // Sub-step rendering for fast movers
+    if (isFastMover) {
+        st.pannerDiag.substeppedBlocks[name]++;
+        st.pannerDiag.totalSubsteps++;
+        
+        // Render in smaller chunks with direction computed per chunk
+        for (size_t off = 0; off < blockLen; off += kSubStepHop) {
+            size_t len = std::min((size_t)kSubStepHop, blockLen - off);
+            double tSub = (double)(blockStart + off + len / 2) / (double)sr;
             
-            al::Vec3f rawDir0 = safeDirForSource(name, kfs, t0);
-            al::Vec3f rawDir1 = safeDirForSource(name, kfs, t1);
-            al::Vec3f dir0 = sanitizeDirForLayout(rawDir0, config.elevationMode);
-            al::Vec3f dir1 = sanitizeDirForLayout(rawDir1, config.elevationMode);
+            al::Vec3f rawDirSub = safeDirForSource(name, kfs, tSub, st);
+            al::Vec3f dirSub = sanitizeDirForLayout(rawDirSub, config.elevationMode, st.dirDiag);
+            if (off <= blockLen / 2 && blockLen / 2 < off + len) traceDir = dirSub;
             
-            float dotVal = std::clamp(dir0.dot(dir1), -1.0f, 1.0f);
-            float angleDelta = std::acos(dotVal);
+            // Convert direction to position for DBAP, use direction for LBAP
+            al::Vec3f posOrDir = (mActivePannerType == PannerType::DBAP) 
+                ? directionToDBAPPosition(dirSub) : dirSub;
             
-            bool isFastMover = (angleDelta > kFastMoverAngleRad);
+            // Render sub-chunk into temp buffer for zero-detection
+            audioTemp.zeroOut();
+            audioTemp.frame(0);
+            panner->renderBuffer(audioTemp, posOrDir, src + off, len);
             
-            // Sub-step rendering for fast movers
-            if (isFastMover) {
-                mPannerDiag.substeppedBlocks[name]++;
-                mPannerDiag.totalSubsteps++;
-                
-                // Render in smaller chunks with direction computed per chunk
-                for (size_t off = 0; off < blockLen; off += kSubStepHop) {
-                    size_t len = std::min((size_t)kSubStepHop, blockLen - off);
-                    double tSub = (double)(blockStart + off + len / 2) / (double)sr;
-                    
-                    al::Vec3f rawDirSub = safeDirForSource(name, kfs, tSub);
-                    al::Vec3f dirSub = sanitizeDirForLayout(rawDirSub, config.elevationMode);
-                    
-                    // Convert direction to position for DBAP, use direction for LBAP
-                    al::Vec3f posOrDir = (mActivePannerType == PannerType::DBAP) 
-                        ? directionToDBAPPosition(dirSub) : dirSub;
-                    
-                    // Render sub-chunk into temp buffer for zero-detection
-                    audioTemp.zeroOut();
-                    audioTemp.frame(0);
-                    mActiveSpatializer->renderBuffer(audioTemp, posOrDir, sourceBuffer.data() + off, len);
-                    
-                    // Check for panner failure on this sub-chunk
-                    float outAbsSum = 0.0f;
-                    audioTemp.frame(0);
-                    for (size_t i = 0; i < len; i++) {
-                        for (int ch = 0; ch < numSpeakers; ch++) {
-                            outAbsSum += std::abs(audioTemp.out(ch, i));
-                        }
-                    }
-                    
-                    // Compute sub-chunk input energy
-                    float subInAbsSum = 0.0f;
-                    for (size_t i = 0; i < len; i++) {
-                        subInAbsSum += std::abs(sourceBuffer[off + i]);
-                    }
-                    float subThreshold = kInputEnergyThreshold * len;
-                    
-                    // If panner failed, retarget to nearest speaker
-                    if (subInAbsSum >= subThreshold && outAbsSum < kPannerZeroThreshold * len * numSpeakers) {
-                        mPannerDiag.zeroBlocks[name]++;
-                        mPannerDiag.totalZeroBlocks++;
-                        
-                        al::Vec3f dirFallback = nearestSpeakerDir(dirSub);
-                        al::Vec3f posOrDirFallback = (mActivePannerType == PannerType::DBAP)
-                            ? directionToDBAPPosition(dirFallback) : dirFallback;
-                        
-                        audioTemp.zeroOut();
-                        audioTemp.frame(0);
-                        mActiveSpatializer->renderBuffer(audioTemp, posOrDirFallback, sourceBuffer.data() + off, len);
-                        
-                        mPannerDiag.retargetBlocks[name]++;
-                        mPannerDiag.totalRetargets++;
-                    }
-                    
-                    // Accumulate sub-chunk into main buffer
-                    audioTemp.frame(0);
-                    audioIO.frame(0);
-                    for (size_t i = 0; i < len; i++) {
-                        for (int ch = 0; ch < numSpeakers; ch++) {
-                            float current = audioIO.out(ch, off + i);
-                            float addition = audioTemp.out(ch, i);
-                            audioIO.out(ch, off + i) = current + addition;
-                        }
-                    }
+            // Check for panner failure on this sub-chunk
+            float outAbsSum = 0.0f;
+            audioTemp.frame(0);
+            for (size_t i = 0; i < len; i++) {
+                for (int ch = 0; ch < numSpeakers; ch++) {
+                    outAbsSum += std::abs(audioTemp.out(ch, i));
                 }
-            } else {
-                // Normal path: single direction for entire block
-                double timeSec = (double)(blockStart + blockLen / 2) / (double)sr;
-                al::Vec3f rawDir = safeDirForSource(name, kfs, timeSec);
-                al::Vec3f dir = sanitizeDirForLayout(rawDir, config.elevationMode);
+            }
+            
+            // Compute sub-chunk input energy
+            float subInAbsSum = 0.0f;
+            for (size_t i = 0; i < len; i++) {
+                subInAbsSum += std::abs(src[off + i]);
+            }
+            float subThreshold = kInputEnergyThreshold * len;
+            
+            // If panner failed, retarget to nearest speaker
+            if (subInAbsSum >= subThreshold && outAbsSum < kPannerZeroThreshold * len * numSpeakers) {
+                st.pannerDiag.zeroBlocks[name]++;
+                st.pannerDiag.totalZeroBlocks++;
                 
-                // Convert direction to position for DBAP
-                al::Vec3f posOrDir = (mActivePannerType == PannerType::DBAP)
-                    ? directionToDBAPPosition(dir) : dir;
+                al::Vec3f dirFallback = nearestSpeakerDir(dirSub);
+                al::Vec3f posOrDirFallback = (mActivePannerType == PannerType::DBAP)
+                    ? directionToDBAPPosition(dirFallback) : dirFallback;
                 
-                // Render into temp buffer to detect panner failure
                 audioTemp.zeroOut();
                 audioTemp.frame(0);
-                mActiveSpatializer->renderBuffer(audioTemp, posOrDir, sourceBuffer.data(), blockLen);
+                panner->renderBuffer(audioTemp, posOrDirFallback, src + off, len);
                 
-                // Measure output energy
-                float outAbsSum = 0.0f;
-                audioTemp.frame(0);
-                for (size_t i = 0; i < blockLen; i++) {
-                    for (int ch = 0; ch < numSpeakers; ch++) {
-                        outAbsSum += std::abs(audioTemp.out(ch, i));
-                    }
-                }
-                
-                // If panner produced ~silence despite input, retarget
-                if (outAbsSum < kPannerZeroThreshold * blockLen * numSpeakers) {
-                    mPannerDiag.zeroBlocks[name]++;
-                    mPannerDiag.totalZeroBlocks++;
-                    
-                    al::Vec3f dirFallback = nearestSpeakerDir(dir);
-                    al::Vec3f posOrDirFallback = (mActivePannerType == PannerType::DBAP)
-                        ? directionToDBAPPosition(dirFallback) : dirFallback;
-                    
-                    audioTemp.zeroOut();
-                    audioTemp.frame(0);
-                    mActiveSpatializer->renderBuffer(audioTemp, posOrDirFallback, sourceBuffer.data(), blockLen);
-                    
-                    mPannerDiag.retargetBlocks[name]++;
-                    mPannerDiag.totalRetargets++;
-                }
-                
-                // Accumulate into main buffer
-                audioTemp.frame(0);
-                audioIO.frame(0);
-                for (size_t i = 0; i < blockLen; i++) {
-                    for (int ch = 0; ch < numSpeakers; ch++) {
-                        float current = audioIO.out(ch, i);
-                        float addition = audioTemp.out(ch, i);
-                        audioIO.out(ch, i) = current + addition;
-                    }
+                st.pannerDiag.retargetBlocks[name]++;
+                st.pannerDiag.totalRetargets++;
+            }
+            
+            // Accumulate sub-chunk into main buffer
+            audioTemp.frame(0);
+            audioIO.frame(0);
+            for (size_t i = 0; i < len; i++) {
+                for (int ch = 0; ch < numSpeakers; ch++) {
+                    float current = audioIO.out(ch, off + i);
+                    float addition = audioTemp.out(ch, i);
+                    audioIO.out(ch, off + i) = current + addition;
                 }
             }
         }
+    } else {
+        // Normal path: single direction for entire block
+        double timeSec = (double)(blockStart + blockLen / 2) / (double)sr;
+        al::Vec3f rawDir = safeDirForSource(name, kfs, timeSec, st);
+        al::Vec3f dir = sanitizeDirForLayout(rawDir, config.elevationMode, st.dirDiag);
+        traceDir = dir;
         
-        // Copy output with gain
+        // Convert direction to position for DBAP
+        al::Vec3f posOrDir = (mActivePannerType == PannerType::DBAP)
+            ? directionToDBAPPosition(dir) : dir;
+        
+        // Render into temp buffer to detect panner failure
+        audioTemp.zeroOut();
+        audioTemp.frame(0);
+        panner->renderBuffer(audioTemp, posOrDir, src, blockLen);
+        
+        // Measure output energy
+        float outAbsSum = 0.0f;
+        audioTemp.frame(0);
+        for (size_t i = 0; i < blockLen; i++) {
+            for (int ch = 0; ch < numSpeakers; ch++) {
+                outAbsSum += std::abs(audioTemp.out(ch, i));
+            }
+        }
+        
+        // If panner produced ~silence despite input, retarget
+        if (outAbsSum < kPannerZeroThreshold * blockLen * numSpeakers) {
+            st.pannerDiag.zeroBlocks[name]++;
+            st.pannerDiag.totalZeroBlocks++;
+            
+            al::Vec3f dirFallback = nearestSpeakerDir(dir);
+            al::Vec3f posOrDirFallback = (mActivePannerType == PannerType::DBAP)
+                ? directionToDBAPPosition(dirFallback) : dirFallback;
+            
+            audioTemp.zeroOut();
+            audioTemp.frame(0);
+            panner->renderBuffer(audioTemp, posOrDirFallback, src, blockLen);
+            
+            st.pannerDiag.retargetBlocks[name]++;
+            st.pannerDiag.totalRetargets++;
+        }
+        
+        // Accumulate into main buffer
+        audioTemp.frame(0);
         audioIO.frame(0);
         for (size_t i = 0; i < blockLen; i++) {
             for (int ch = 0; ch < numSpeakers; ch++) {
-                float sample = audioIO.out(ch, i);
-                if (!std::isfinite(sample)) sample = 0.0f;
-                out.samples[ch][outBlockStart + i] = sample * config.masterGainLinear();
+                float current = audioIO.out(ch, i);
+                float addition = audioTemp.out(ch, i);
+                audioIO.out(ch, i) = current + addition;
             }
         }
-
-
+    }
+    
+    if (rec) {
+        uint16_t flags = isFastMover ? kTraceSubstep : 0;
+        if (st.pannerDiag.totalRetargets != retargetsBefore) flags |= kTraceRetarget;
+        if (st.totalFallbacks != fallbacksBefore) flags |= kTraceFallback;
+        if (st.dirDiag.invalidDir != diagBefore.invalidDir) flags |= kTraceInvalidDir;
+        if (st.dirDiag.clampedEl != diagBefore.clampedEl) flags |= kTraceClampedEl;
+        if (st.dirDiag.rescaledAtmosUp != diagBefore.rescaledAtmosUp ||
+            st.dirDiag.rescaledFullSphere != diagBefore.rescaledFullSphere) flags |= kTraceRescaled;
+        if (st.dirDiag.flattened2D != diagBefore.flattened2D) flags |= kTraceFlattened;
+        rec->flags = flags;
+        rec->value = angleDelta;
+        rec->az = std::atan2(traceDir.x, traceDir.y) * (180.0f / float(M_PI));
+        rec->el = std::asin(std::clamp(traceDir.z, -1.0f, 1.0f)) * (180.0f / float(M_PI));
     }
 }
 
@@ -1185,12 +2040,12 @@ void SpatialRenderer::renderSmooth(MultiWavData &out, const RenderConfig &config
             double timeStart = (double)blockStart / (double)sr;
             double timeEnd = (double)blockEnd / (double)sr;
             
-            al::Vec3f rawDirStart = safeDirForSource(name, kfs, timeStart);
-            al::Vec3f rawDirEnd = safeDirForSource(name, kfs, timeEnd);
+            al::Vec3f rawDirStart = safeDirForSource(name, kfs, timeStart, mState);
+            al::Vec3f rawDirEnd = safeDirForSource(name, kfs, timeEnd, mState);
             
             // Sanitize directions to fit within speaker layout's representable range
-            al::Vec3f dirStart = sanitizeDirForLayout(rawDirStart, config.elevationMode);
-            al::Vec3f dirEnd = sanitizeDirForLayout(rawDirEnd, config.elevationMode);
+            al::Vec3f dirStart = sanitizeDirForLayout(rawDirStart, config.elevationMode, mState.dirDiag);
+            al::Vec3f dirEnd = sanitizeDirForLayout(rawDirEnd, config.elevationMode, mState.dirDiag);
             
             // Smooth mode is disabled; retained code path is intentionally inert.
             // Smooth mode is disabled, so this code should not be reached
@@ -1253,10 +2108,10 @@ void SpatialRenderer::renderPerSample(MultiWavData &out, const RenderConfig &con
             float inputSample = (sampleIdx < src.samples.size()) ? src.samples[sampleIdx] : 0.0f;
             
             // Compute direction at exact sample time
-            al::Vec3f rawDir = safeDirForSource(name, kfs, timeSec);
+            al::Vec3f rawDir = safeDirForSource(name, kfs, timeSec, mState);
             
             // Sanitize direction to fit within speaker layout's representable range
-            al::Vec3f dir = sanitizeDirForLayout(rawDir, config.elevationMode);
+            al::Vec3f dir = sanitizeDirForLayout(rawDir, config.elevationMode, mState.dirDiag);
             
             // Sample mode is disabled; retained code path is intentionally inert.
             // Sample mode is disabled, so this code should not be reached
@@ -39,6 +39,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -53,7 +54,12 @@
 
 #include "../src/JSONLoader.hpp"
 #include "../src/LayoutLoader.hpp"
+#include "../src/SilenceMap.hpp"
 #include "../src/WavUtils.hpp"
+#include "RenderTrace.hpp"
+#include "StemCache.hpp"
+
+class ChunkedSourceReader;
 
 // Panner/Spatializer type selection
 enum class PannerType {
@@ -62,11 +68,15 @@ enum class PannerType {
 };
 
 // Elevation handling mode for directions outside speaker layout coverage
+// (replicated in realtimeEngine/src/RealtimeTypes.hpp under the same guard)
+#ifndef SPATIALROOT_ELEVATION_MODE_DEFINED
+#define SPATIALROOT_ELEVATION_MODE_DEFINED
 enum class ElevationMode {
     Clamp,    // Hard clip elevation to layout bounds (may cause "sticking" at extremes)
     RescaleAtmosUp,  // (default / “vertical compensation ON”) Assumes content elevation lives in [0, +π/2] (ear → top)
     RescaleFullSphere,  // Assumes content elevation lives in [-π/2, +π/2] (bottom → top). Useful what starting with non-atmos formats
 };
+#endif
 
 // Render configuration options
 struct RenderConfig {
@@ -114,6 +124,31 @@ struct RenderConfig {
     // Range: 0.0 (immediate dispersion) to 1.0 (no dispersion, discontinuity at poles)
     // Default: 0.5
     float lbapDispersion = 0.5f;
+
+    // Chunked streaming (renderToFile() with a ChunkedSourceReader):
+    // seconds of audio rendered and written per chunk. Rounded to a whole
+    // number of blocks. 0 = whole-file render (sources fully in memory).
+    double chunkSec = 0.0;
+
+    // Offline worker threads (time-sliced; see SpatialRenderer::renderPerBlock()).
+    // Output is bit-identical for any value. 1 = serial.
+    int numThreads = 1;
+
+    // Incremental re-render (renderToFile() only): directory of per-source
+    // speaker-bus stems cached per chunk (see StemCache.hpp). Only sources and
+    // chunks whose audio, keyframes or render settings changed are rendered;
+    // the rest are re-summed from the cache, bit-identical to a full render.
+    // Chunks are config.chunkSec long (kDefaultStemChunkSec when 0) and the
+    // worker threads render stale stems in parallel. Empty = off.
+    std::string stemCacheDir = "";
+
+    // Binary diagnostics trace (see RenderTrace.hpp): one 32-byte record per
+    // source block that sub-stepped, retargeted or fell back, written by a
+    // background thread; progress lines are printed from it too. Convert
+    // with spatialroot_trace_convert. traceAllBlocks records every rendered
+    // source block instead (sources x blocks x 32 B). Empty = off.
+    std::string traceFile = "";
+    bool traceAllBlocks = false;
 };
 
 // Render statistics for diagnostics
@@ -138,11 +173,24 @@ public:
                     const SpatialData &spatial,
                     const std::map<std::string, MonoWavData> &sources);
 
+    // Chunked streaming: audio is pulled from reader one chunk at a time
+    // instead of from a fully decoded source map. Use with renderToFile().
+    SpatialRenderer(const SpeakerLayoutData &layout,
+                    const SpatialData &spatial,
+                    ChunkedSourceReader &reader);
+
     // Main render with default config
     MultiWavData render();
     
     // Render with custom configuration
     MultiWavData render(const RenderConfig &config);
+
+    // Render straight to a WAV file (RF64 when > 4 GB). With a chunked reader
+    // only config.chunkSec of source and output audio is resident at a time;
+    // output is sample-identical to render() + writeMultichannelWav().
+    // With config.stemCacheDir set, renders incrementally from cached stems
+    // (either construction).
+    void renderToFile(const RenderConfig &config, const std::string &outPath);
     
     // Get statistics from last render (call after render())
     RenderStats getLastRenderStats() const { return mLastStats; }
@@ -151,6 +199,13 @@ private:
     SpeakerLayoutData mLayout;
     SpatialData mSpatial;
     const std::map<std::string, MonoWavData> &mSources;
+    ChunkedSourceReader *mReader = nullptr;   // non-null in chunked mode
+
+    // Digital-silence runs per in-memory source (built in the constructor);
+    // chunked mode asks the reader instead. Blocks they cover are skipped
+    // before the source buffer is filled — see silenceFor().
+    std::map<std::string, SilenceRuns> mSilence;
+    const SilenceRuns *silenceFor(const std::string &name) const;
     
     // AlloLib speaker layout (shared by all spatializers)
     al::Speakers mSpeakers;
@@ -177,6 +232,19 @@ private:
     
     // Statistics from last render
     RenderStats mLastStats;
+    std::vector<double> mStatsSumSq;   // per-channel running sum of squares
+    int mStatsSampleRate = 0;
+    
+    // force2D override is undone from this at the end of every render
+    bool mSavedLayoutIs2D = false;
+    
+    // Resolved render window (shared by render() and renderToFile())
+    struct RenderRange {
+        size_t startSample = 0;
+        size_t endSample = 0;
+        size_t renderSamples = 0;
+        double durationSec = 0.0;
+    };
     
     // Layout-derived elevation constraints (computed from speaker positions)
     float mLayoutMinElRad = -1.5707963f;   // min elevation in radians (default: -pi/2)
@@ -194,7 +262,7 @@ private:
         uint64_t rescaledFullSphere = 0; // increments when RescaleFullSphere remaps elevation
         uint64_t flattened2D = 0;    // directions flattened to plane (2D mode)
         uint64_t invalidDir = 0;     // degenerate directions that needed fallback
-    } mDirDiag;
+    };
     
     // Spatializer rendering diagnostics (per-render, reset at start)
     // Zero-block detection runs for all panners to catch unexpected failures.
@@ -205,7 +273,7 @@ private:
         uint64_t totalZeroBlocks = 0;
         uint64_t totalRetargets = 0;
         uint64_t totalSubsteps = 0;
-    } mPannerDiag;
+    };
     
     // Precomputed speaker unit directions (for nearest-speaker fallback)
     std::vector<al::Vec3f> mSpeakerDirs;
@@ -217,11 +285,27 @@ private:
     static constexpr float kFastMoverAngleRad = 0.25f;      // ~14 degrees - triggers sub-stepping
     static constexpr int kSubStepHop = 16;                  // sub-step size for fast movers
     
-    // Per-source direction tracking for safe fallback
-    // These are reset at start of each render
-    std::unordered_map<std::string, al::Vec3f> mLastGoodDir;
-    std::unordered_set<std::string> mWarnedDegenerate;
-    std::unordered_map<std::string, int> mFallbackCount;
+    // Per-render mutable state: per-source direction tracking for safe
+    // fallback plus the diagnostics above. Reset at start of each render.
+    // Grouped so each parallel time slice can own a private copy that is
+    // merged back in time order (see renderPerBlock()).
+    struct RenderState {
+        std::unordered_map<std::string, al::Vec3f> lastGoodDir;
+        std::unordered_set<std::string> warnedDegenerate;
+        std::unordered_map<std::string, int> fallbackCount;
+        uint64_t totalFallbacks = 0;   // sum of fallbackCount (per-block trace flags)
+        // Per-source keyframe segment cursor (see findKeyframeSegment()):
+        // blocks advance monotonically, so lookups are O(1) amortized.
+        std::unordered_map<std::string, size_t> keyframeCursor;
+        // Sources that fell back with no last-good direction available
+        std::unordered_set<std::string> coldFallback;
+        DirDiag dirDiag;
+        PannerDiag pannerDiag;
+    } mState;
+    
+    // Diagnostics trace of the current render (RenderConfig::traceFile);
+    // lane k belongs to time slice / stem worker k.
+    RenderTrace mTrace;
 
     // Helper: check if all components are finite
     static bool finite3(const al::Vec3f& v) {
@@ -235,7 +319,7 @@ private:
     // - 2D layouts: flatten elevation to z=0
     // - 3D layouts: clamp or rescale (RescaleAtmosUp / RescaleFullSphere) elevation to [mLayoutMinElRad, mLayoutMaxElRad]
     // This prevents sources from becoming inaudible due to out-of-range directions
-    al::Vec3f sanitizeDirForLayout(const al::Vec3f& unitDir, ElevationMode mode);
+    al::Vec3f sanitizeDirForLayout(const al::Vec3f& unitDir, ElevationMode mode, DirDiag& diag);
     
     // Convert direction to position for DBAP
     // DBAP uses distance-based attenuation, so we need a position not just direction
@@ -245,14 +329,31 @@ private:
     
     // Get safe direction for a source, using last-good or fallback if invalid
     // This is the main entry point for direction computation in the render loop
-    al::Vec3f safeDirForSource(const std::string& name, const std::vector<Keyframe>& kfs, double t);
+    al::Vec3f safeDirForSource(const std::string& name, const std::vector<Keyframe>& kfs, double t,
+                               RenderState& st);
 
     // linear interpolation between spatial keyframes (raw, may return invalid)
-    al::Vec3f interpolateDirRaw(const std::vector<Keyframe> &kfs, double t);
+    // cursor: per-source segment hint, updated in place
+    al::Vec3f interpolateDirRaw(const std::vector<Keyframe> &kfs, double t, size_t &cursor);
     
     // Compute statistics on rendered output
     void computeRenderStats(const MultiWavData &output);
     
+    // Incremental form of computeRenderStats() for chunked renders
+    void beginRenderStats(int channels, int sampleRate);
+    void accumulateRenderStats(const MultiWavData &chunk, size_t numFrames);
+    void finishRenderStats();
+    
+    // Render prologue / epilogue shared by render() and renderToFile()
+    RenderRange beginRender(const RenderConfig &config);
+    void endRender(const RenderConfig &config, const RenderRange &range);
+    
+    // Output channel count (speakers plus out-of-range subwoofer channels)
+    int outputChannelCount() const;
+    
+    // False (with an error message) for disabled render resolutions
+    bool checkRenderResolution(const RenderConfig &config) const;
+    
     // Detect and fix keyframe time units (samples vs seconds)
     void normalizeKeyframeTimes(double durationSec, size_t totalSamples, int sr);
     
@@ -279,8 +380,79 @@ private:
     al::Vec3f nearestSpeakerDir(const al::Vec3f& dir);
 
     // Render implementations
+    // out holds [startSample, endSample) at index 0; called once per chunk
+    // in chunked mode.
     void renderPerBlock(MultiWavData &out, const RenderConfig &config,
-                        size_t startSample, size_t endSample);
+                        size_t startSample, size_t endSample,
+                        bool logProgress = true);
+    
+    // Serial block loop over [startSample, endSample) using state st and
+    // panner; out index 0 is sample outBase. Thread-safe for disjoint ranges
+    // with distinct st / panner.
+    void renderBlockRange(MultiWavData &out, const RenderConfig &config,
+                          size_t outBase, size_t startSample, size_t endSample,
+                          RenderState &st, al::Spatializer *panner, bool logProgress,
+                          const TraceContext &trace);
+    
+    // Fold a later time slice's state into the running state (time order).
+    static void mergeSliceState(RenderState &into, const RenderState &slice);
+    
+    // Per-block source steps shared by renderBlockRange() and the stem
+    // render: fill buf with a source block (false if it is silence-mapped,
+    // missing or below the energy gate), then pan it onto audioIO (+=).
+    // With rec (tracing), panSourceBlock() also fills its flags and the
+    // block-center direction.
+    bool fillSourceBlock(const std::string &name, size_t blockStart, size_t blockLen,
+                         std::vector<float> &buf);
+    void panSourceBlock(const std::string &name, const std::vector<Keyframe> &kfs,
+                        const RenderConfig &config, size_t blockStart, size_t blockLen,
+                        const float *src, RenderState &st, al::Spatializer *panner,
+                        al::AudioIOData &audioIO, al::AudioIOData &audioTemp,
+                        TraceRecord *rec);
+    
+    // Panner of the selected type for a helper thread (owned by dbap / lbap)
+    al::Spatializer *makeWorkerPanner(const RenderConfig &config,
+                                      std::unique_ptr<al::Dbap> &dbap,
+                                      std::unique_ptr<al::Lbap> &lbap);
+    
+    // ── Incremental re-render (RenderConfig::stemCacheDir) ──────────────────
+    static constexpr double kDefaultStemChunkSec = 10.0;
+    
+    // rows: one pointer per stem channel, blockLen samples each
+    using StemBlockFn = std::function<void(size_t blockIndex, const float *const *rows,
+                                           size_t blockLen)>;
+    
+    void renderIncremental(const RenderConfig &config, const std::string &outPath);
+    
+    // One source's contribution to [c0, c1): per block the energy gate lets
+    // through, its speaker-bus rows before master gain (LFE: the gated input).
+    void renderSourceChunk(const std::string &name, const std::vector<Keyframe> &kfs,
+                           const RenderConfig &config, size_t c0, size_t c1,
+                           RenderState &st, al::Spatializer *panner, const StemBlockFn &onBlock,
+                           const TraceContext &trace);
+    
+    // Key of everything a stem depends on besides its source and chunk
+    uint64_t stemSettingsKey(const RenderConfig &config, size_t gridStart, size_t chunkFrames) const;
+    
+    // Key of one source's stem for [c0, c1); audio holds its c1 - c0 input frames
+    uint64_t stemKey(uint64_t settingsKey, const std::string &name, const std::vector<Keyframe> &kfs,
+                     size_t c0, size_t c1, const float *audio) const;
+    
+    // Copy a source's [start, start + n) into dst (zeros past its end)
+    void readSourceRange(const std::string &name, size_t start, size_t n, float *dst);
+    
+    // State a stale stem renders from: the running state of its source only
+    RenderState chunkStartState(const std::string &name) const;
+    
+    // Header of a just-rendered stem from the chunk state it left
+    StemInfo stemInfoFor(uint64_t key, const std::string &name, const RenderState &st) const;
+    
+    // A cached stem is valid if its key matches and, when a direction
+    // fallback made it depend on the incoming direction, that matches too
+    bool incomingMatches(const StemInfo &info, const std::string &name) const;
+    
+    // Replay a cached stem's continuity state and diagnostics onto mState
+    void applyStemInfo(const std::string &name, const StemInfo &info);
     
     void renderSmooth(MultiWavData &out, const RenderConfig &config,
                       size_t startSample, size_t endSample);
@@ -0,0 +1,233 @@
+#include "StemCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "../src/SceneCache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char     kMagic[8] = {'S', 'R', 'S', 'T', 'E', 'M', '\0', '\0'};
+constexpr uint32_t kVersion  = 1;
+
+struct StemFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;          // StemInfo::k*
+    uint64_t key;
+    uint64_t frames;
+    uint32_t channels;
+    uint32_t blockFrames;
+    uint64_t records;
+    float    incoming[3];
+    float    outgoing[3];
+    StemDiag diag;
+};
+
+static_assert(sizeof(StemDiag) == 72, "StemDiag layout changed — bump kVersion");
+static_assert(sizeof(StemFileHeader) == 144, "StemFileHeader layout changed — bump kVersion");
+
+// Source keys become directory names: keep [A-Za-z0-9._-], never "." / "..".
+// Two keys that map to the same name only cost cache misses (the key differs).
+std::string safeName(const std::string& name) {
+    std::string out = name;
+    for (char& c : out) {
+        const bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                        (c >= '0' && c <= '9') || c == '.' || c == '_' || c == '-';
+        if (!ok) c = '_';
+    }
+    if (out.find_first_not_of('.') == std::string::npos) out.assign(out.size() + 1, '_');
+    return out;
+}
+
+bool readHeader(std::ifstream& f, const StemShape& shape, StemFileHeader& hdr) {
+    if (!f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))) return false;
+    return std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) == 0 && hdr.version == kVersion &&
+           hdr.channels == shape.channels && hdr.blockFrames == shape.blockFrames &&
+           hdr.frames == shape.frames && shape.blockFrames > 0;
+}
+
+} // namespace
+
+// ============================================================================
+// StemInfo / StemKey
+// ============================================================================
+
+uint64_t StemInfo::effectiveKey() const {
+    if (!(flags & kUsesIncoming)) return key;
+    StemKey k;
+    k.add(key).add(flags & kHasIncoming);
+    if (flags & kHasIncoming) k.add(incoming);
+    return k.digest();
+}
+
+uint64_t StemKey::digest() const {
+    return SceneCache::hashBytes(mBytes.data(), mBytes.size());
+}
+
+// ============================================================================
+// StemCache
+// ============================================================================
+
+bool StemCache::open(const std::string& dir) {
+    std::error_code ec;
+    fs::create_directories(fs::path(dir) / "sources", ec);
+    if (ec) return false;
+    fs::create_directories(fs::path(dir) / "mix", ec);
+    if (ec) return false;
+    mDir = dir;
+    return true;
+}
+
+std::string StemCache::stemPath(const std::string& source, uint64_t chunkStart) const {
+    return (fs::path(mDir) / "sources" / safeName(source) /
+            (std::to_string(chunkStart) + ".srstem")).string();
+}
+
+std::string StemCache::mixPath(uint64_t chunkStart) const {
+    return (fs::path(mDir) / "mix" / (std::to_string(chunkStart) + ".srstem")).string();
+}
+
+bool StemCache::probe(const std::string& path, const StemShape& shape, StemInfo& info) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good()) return false;
+
+    StemFileHeader hdr;
+    if (!readHeader(f, shape, hdr)) return false;
+    info.key   = hdr.key;
+    info.flags = hdr.flags;
+    std::memcpy(info.incoming, hdr.incoming, sizeof(info.incoming));
+    std::memcpy(info.outgoing, hdr.outgoing, sizeof(info.outgoing));
+    info.diag = hdr.diag;
+    return true;
+}
+
+bool StemCache::accumulate(const std::string& path, uint64_t key, const StemShape& shape,
+                           float* const* dst) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f.good()) return false;
+    const std::streamoff fileSize = f.tellg();
+    f.seekg(0);
+
+    StemFileHeader hdr;
+    if (!readHeader(f, shape, hdr) || hdr.key != key) return false;
+    if (fileSize < static_cast<std::streamoff>(sizeof(hdr))) return false;
+
+    std::vector<char> body(static_cast<size_t>(fileSize) - sizeof(hdr));
+    if (!f.read(body.data(), static_cast<std::streamsize>(body.size()))) return false;
+
+    // Pass 1: every record in range, in order, and the body exactly consumed
+    const uint64_t numBlocks = (shape.frames + shape.blockFrames - 1) / shape.blockFrames;
+    auto blockLen = [&](uint64_t b) {
+        return static_cast<size_t>(std::min<uint64_t>(shape.blockFrames,
+                                                       shape.frames - b * shape.blockFrames));
+    };
+    size_t at = 0;
+    uint64_t records = 0, next = 0;
+    while (at < body.size()) {
+        uint64_t b = 0;
+        if (body.size() - at < sizeof(b)) return false;
+        std::memcpy(&b, body.data() + at, sizeof(b));
+        if (b < next || b >= numBlocks) return false;
+        const size_t bytes = sizeof(b) + size_t(shape.channels) * blockLen(b) * sizeof(float);
+        if (body.size() - at < bytes) return false;
+        at += bytes;
+        next = b + 1;
+        ++records;
+    }
+    if (records != hdr.records) return false;
+
+    // Pass 2: add
+    at = 0;
+    while (at < body.size()) {
+        uint64_t b = 0;
+        std::memcpy(&b, body.data() + at, sizeof(b));
+        at += sizeof(b);
+        const size_t len = blockLen(b);
+        const size_t off = static_cast<size_t>(b * shape.blockFrames);
+        for (uint32_t ch = 0; ch < shape.channels; ++ch) {
+            const float* src = reinterpret_cast<const float*>(body.data() + at);
+            float* out = dst[ch] + off;
+            for (size_t i = 0; i < len; ++i) out[i] += src[i];
+            at += len * sizeof(float);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// StemCache::Writer
+// ============================================================================
+
+StemCache::Writer::~Writer() {
+    if (mOpen) abort();
+}
+
+bool StemCache::Writer::open(const std::string& path, const StemShape& shape) {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    mPath = path;
+    mTmpPath = path + ".tmp";
+    mShape = shape;
+    mRecords = 0;
+    mFile.open(mTmpPath, std::ios::binary | std::ios::trunc);
+    if (!mFile.good()) return false;
+
+    const StemFileHeader placeholder{};
+    mFile.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+    mOpen = true;
+    return true;
+}
+
+void StemCache::Writer::addBlock(uint64_t blockIndex, const float* const* rows, size_t blockLen) {
+    if (!mOpen) return;
+    mFile.write(reinterpret_cast<const char*>(&blockIndex), sizeof(blockIndex));
+    for (uint32_t ch = 0; ch < mShape.channels; ++ch) {
+        mFile.write(reinterpret_cast<const char*>(rows[ch]),
+                    static_cast<std::streamsize>(blockLen * sizeof(float)));
+    }
+    ++mRecords;
+}
+
+bool StemCache::Writer::close(const StemInfo& info) {
+    if (!mOpen) return false;
+
+    StemFileHeader hdr{};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version     = kVersion;
+    hdr.flags       = info.flags;
+    hdr.key         = info.key;
+    hdr.frames      = mShape.frames;
+    hdr.channels    = mShape.channels;
+    hdr.blockFrames = mShape.blockFrames;
+    hdr.records     = mRecords;
+    std::memcpy(hdr.incoming, info.incoming, sizeof(hdr.incoming));
+    std::memcpy(hdr.outgoing, info.outgoing, sizeof(hdr.outgoing));
+    hdr.diag = info.diag;
+
+    mFile.seekp(0);
+    mFile.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    mFile.close();
+    mOpen = false;
+    if (!mFile) {
+        std::remove(mTmpPath.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    fs::rename(mTmpPath, mPath, ec);
+    if (ec) {
+        std::remove(mTmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StemCache::Writer::abort() {
+    mFile.close();
+    mOpen = false;
+    std::remove(mTmpPath.c_str());
+}
@@ -0,0 +1,147 @@
+// StemCache.hpp — On-disk per-source speaker-bus stems for incremental offline renders
+//
+// Every offline render used to re-render every source for the whole program,
+// even when a mix note touched one trajectory. The speaker bus is a plain sum
+// of per-source contributions, so SpatialRenderer::renderToFile() with
+// RenderConfig::stemCacheDir set keeps each source's contribution to each
+// render chunk on disk and only re-renders the (source, chunk) pairs whose
+// inputs changed:
+//
+//   <dir>/sources/<name>/<c0>.srstem   one source's pre-gain bus contribution
+//                                      (raw gated input for LFE), chunk at c0
+//   <dir>/mix/<c0>.srstem              the summed bus of that chunk
+//                                      (speakers + one LFE row)
+//
+// KEYS: a stem's key hashes the render settings (layout, panner and its
+// focus / dispersion, elevation mode, block size, chunk grid), the source's
+// audio in the chunk, and the keyframes that can influence a direction
+// evaluated inside the chunk (see SpatialRenderer::stemKey()). A mix's key
+// hashes the effective keys of the stems it sums. Master gain is not part of
+// any key — it is applied after the re-sum.
+//
+// BIT-IDENTICAL: a stem holds exactly the values renderBlockRange() adds to
+// the bus for that source, and the re-sum adds them in the same source order
+// starting from zero, so the output matches a full render sample for sample.
+//
+// CONTINUITY: the only cross-chunk dependency of a source is the last-good
+// direction used when interpolation degenerates. A stem records whether any
+// such fallback ran in the chunk (then the incoming direction becomes part of
+// its identity) and the direction it hands on, plus its diagnostics deltas,
+// so a cached chunk advances the render state like a rendered one.
+//
+// FILE LAYOUT (little-endian):
+//   StemFileHeader       144 bytes  magic "SRSTEM\0\0", version, key, shape,
+//                                   continuity state, diagnostics
+//   records[]            per block the energy gate let through:
+//                        uint64_t block index, float[channels][blockLen]
+//
+// Blocks with no record are silent, so sparse sources cost little disk.
+// Files are written via a temp file + rename like SceneCache; a failed
+// write is a warning and the caller renders that stem directly instead.
+//
+// THREADING: open() once; probe() / accumulate() / Writer may then be used
+// from any thread on distinct paths.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Geometry every reader must agree on (a mismatch is a cache miss)
+struct StemShape {
+    uint32_t channels = 0;      // speakers, 1 for LFE, speakers + 1 for a mix
+    uint32_t blockFrames = 0;   // render block size (whole chunk for a mix)
+    uint64_t frames = 0;        // chunk length
+};
+
+// Per-chunk diagnostics of one source, replayed on a cache hit so the
+// end-of-render summaries match a full render.
+struct StemDiag {
+    uint64_t fallbacks = 0;          // RenderState::fallbackCount
+    uint64_t zeroBlocks = 0;         // PannerDiag::zeroBlocks
+    uint64_t retargets = 0;          // PannerDiag::retargetBlocks
+    uint64_t substeps = 0;           // PannerDiag::substeppedBlocks
+    uint64_t clampedEl = 0;          // DirDiag counters
+    uint64_t rescaledAtmosUp = 0;
+    uint64_t rescaledFullSphere = 0;
+    uint64_t flattened2D = 0;
+    uint64_t invalidDir = 0;
+};
+
+struct StemInfo {
+    static constexpr uint32_t kUsesIncoming = 1;  // a fallback read the direction entering the chunk
+    static constexpr uint32_t kHasIncoming  = 2;  // ...and there was one (incoming is valid)
+    static constexpr uint32_t kSetsOutgoing = 4;  // the chunk changed the last-good direction
+
+    uint64_t key = 0;
+    uint32_t flags = 0;
+    float    incoming[3] = {0.0f, 0.0f, 0.0f};
+    float    outgoing[3] = {0.0f, 0.0f, 0.0f};
+    StemDiag diag;
+
+    /// Key including the incoming direction when the stem depends on it.
+    uint64_t effectiveKey() const;
+};
+
+// Hash builder for stem and mix keys (SceneCache::hashBytes() over the
+// appended bytes).
+class StemKey {
+public:
+    template <typename T>
+    StemKey& add(const T& v) {
+        mBytes.append(reinterpret_cast<const char*>(&v), sizeof(T));
+        return *this;
+    }
+    StemKey& add(const std::string& s) {
+        add(static_cast<uint64_t>(s.size()));
+        mBytes.append(s);
+        return *this;
+    }
+    uint64_t digest() const;
+
+private:
+    std::string mBytes;
+};
+
+class StemCache {
+public:
+    /// Create the cache directory. False if it cannot be created.
+    bool open(const std::string& dir);
+
+    std::string stemPath(const std::string& source, uint64_t chunkStart) const;
+    std::string mixPath(uint64_t chunkStart) const;
+
+    /// Read the header of path into info. False if missing, corrupt or of
+    /// another shape (the caller compares the key).
+    static bool probe(const std::string& path, const StemShape& shape, StemInfo& info);
+
+    /// Add every record of path onto dst[ch][0..shape.frames). The file is
+    /// validated in full first, so on false dst is untouched.
+    static bool accumulate(const std::string& path, uint64_t key, const StemShape& shape,
+                           float* const* dst);
+
+    /// Streams one stem to a temp file; close() publishes it.
+    class Writer {
+    public:
+        ~Writer();
+        bool open(const std::string& path, const StemShape& shape);
+        /// Rows of blockLen samples, one per channel, for block blockIndex
+        /// (blocks in increasing order).
+        void addBlock(uint64_t blockIndex, const float* const* rows, size_t blockLen);
+        bool close(const StemInfo& info);
+
+    private:
+        void abort();
+
+        std::ofstream mFile;
+        std::string   mPath, mTmpPath;
+        StemShape     mShape;
+        uint64_t      mRecords = 0;
+        bool          mOpen = false;
+    };
+
+private:
+    std::string mDir;
+};
@@ -18,9 +18,13 @@
 #include <string>
 #include <filesystem>
 #include <cstdlib>
+#include <algorithm>
+#include <thread>
 
 #include "SpatialRenderer.hpp"
+#include "ChunkedSourceReader.hpp"
 #include "../src/JSONLoader.hpp"
+#include "../src/SceneCache.hpp"
 #include "../src/LayoutLoader.hpp"
 #include "../src/WavUtils.hpp"
 
@@ -57,6 +61,15 @@ void printUsage() {
               << "  --vertical-compensation [fullsphere]  Vertical compensation mode (default: enabled, AtmosUp)\n"
               << "  --force_2d            Force 2D mode (flatten all elevations)\n"
               << "  --debug_dir DIR       Output debug diagnostics to directory\n"
+              << "  --chunk_sec SECONDS   Stream sources and output in chunks of this length\n"
+              << "                        (bounded memory for long programs; default: 0 = whole file)\n"
+              << "  --threads N           Render time slices on N threads, bit-identical output\n"
+              << "                        (default: 1, 0 = all hardware threads)\n"
+              << "  --stem_cache DIR      Incremental render: cache per-source stems in DIR and\n"
+              << "                        re-render only sources/chunks whose inputs changed\n"
+              << "  --trace FILE          Write a binary per-block diagnostics trace (events only;\n"
+              << "                        convert with spatialroot_trace_convert)\n"
+              << "  --trace_blocks        With --trace: record every rendered source block\n"
               << "  --help                Show this help message\n\n";
     std::cout << "Spatializers:\n"
               << "  dbap   - Distance-Based Amplitude Panning (DEFAULT)\n"
@@ -194,6 +207,27 @@ int main(int argc, char *argv[]) {
             }
         } else if (arg == "--force_2d") {
             config.force2D = true;
+        } else if (arg == "--threads") {
+            config.numThreads = std::stoi(argv[++i]);
+            if (config.numThreads < 0) {
+                std::cerr << "Error: threads must be >= 0\n";
+                return 1;
+            }
+            if (config.numThreads == 0) {
+                config.numThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+        } else if (arg == "--stem_cache") {
+            config.stemCacheDir = argv[++i];
+        } else if (arg == "--trace") {
+            config.traceFile = argv[++i];
+        } else if (arg == "--trace_blocks") {
+            config.traceAllBlocks = true;
+        } else if (arg == "--chunk_sec") {
+            config.chunkSec = std::stod(argv[++i]);
+            if (config.chunkSec < 0.0) {
+                std::cerr << "Error: chunk_sec must be >= 0\n";
+                return 1;
+            }
         }
     }
 
@@ -228,7 +262,34 @@ int main(int argc, char *argv[]) {
 
     // spatial trajectories from LUSID scene (frames/nodes format)
     std::cout << "Loading LUSID scene...\n";
-    SpatialData spatial = JSONLoader::loadLusidScene(positionsFile.string());
+    SpatialData spatial = SceneCache::loadLusidScene(positionsFile.string());
+
+    if (config.chunkSec > 0.0) {
+        // Chunked streaming: sources are read and output is written one chunk
+        // at a time, so memory stays bounded regardless of program length.
+        // Reader window = render chunk, rounded up to a whole number of blocks.
+        const uint64_t blockSize = (uint64_t)config.blockSize;
+        uint64_t chunkFrames = (uint64_t)(config.chunkSec * spatial.sampleRate);
+        chunkFrames = std::max<uint64_t>(blockSize,
+                                         ((chunkFrames + blockSize - 1) / blockSize) * blockSize);
+        config.chunkSec = (double)chunkFrames / spatial.sampleRate;
+
+        std::cout << "Opening source WAVs (chunked, " << config.chunkSec << " s)...\n";
+        ChunkedSourceReader reader;
+        if (useADM) {
+            std::cout << "  ADM file: " << admFile << " (direct channel streaming)\n";
+            reader.openADM(admFile.string(), spatial.sources, spatial.sampleRate, chunkFrames);
+        } else {
+            reader.openFolder(sourcesFolder.string(), spatial.sources, spatial.sampleRate, chunkFrames);
+        }
+
+        std::cout << "Rendering (streaming to " << outFile << ")...\n";
+        SpatialRenderer renderer(layout, spatial, reader);
+        renderer.renderToFile(config, outFile.string());
+
+        std::cout << "Done.\n";
+        return 0;
+    }
 
     // load all mono source files
     std::cout << "Loading source WAVs...\n";
@@ -244,6 +305,12 @@ int main(int argc, char *argv[]) {
     // this is where the degrees conversion and channel mapping fixes are critical
     std::cout << "Rendering...\n";
     SpatialRenderer renderer(layout, spatial, sources);
+    if (!config.stemCacheDir.empty()) {
+        // Incremental: stems are summed chunk by chunk straight into the file
+        renderer.renderToFile(config, outFile.string());
+        std::cout << "Done.\n";
+        return 0;
+    }
     MultiWavData output = renderer.render(config);
 
     // output has consecutive channels 0 to numSpeakers
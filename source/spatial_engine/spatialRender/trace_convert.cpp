@@ -0,0 +1,212 @@
+// spatialroot trace converter
+//
+// Turns a binary render trace (spatialroot_spatial_render --trace FILE, see
+// RenderTrace.hpp) into JSON or CSV. Records of discarded passes are dropped
+// and the rest are ordered by frame, then source, so the output reads like a
+// serial render however many threads wrote the trace.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "RenderTrace.hpp"
+
+namespace {
+
+void printUsage() {
+    std::cout << "spatialroot trace converter\n\n";
+    std::cout << "Usage:\n"
+              << "  spatialroot_trace_convert TRACE [OPTIONS]\n\n";
+    std::cout << "Options:\n"
+              << "  --csv          Write CSV (default: JSON)\n"
+              << "  --out FILE     Output file (default: stdout)\n"
+              << "  --progress     Include progress records\n"
+              << "  --help         Show this help message\n";
+}
+
+std::string flagList(uint16_t flags, char sep) {
+    std::string out;
+    for (uint16_t bit = 1; bit != 0 && bit <= kTraceLfe; bit <<= 1) {
+        if (!(flags & bit)) continue;
+        if (!out.empty()) out += sep;
+        out += traceFlagName(bit);
+    }
+    return out;
+}
+
+std::string jsonEscape(const std::string &s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Source names may contain the CSV separator or quotes
+std::string csvField(const std::string &s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string sourceName(const TraceFileInfo &info, const TraceRecord &r) {
+    if (r.type != TraceRecordType::Block) return "";
+    return (r.index < info.sources.size()) ? info.sources[r.index] : "?";
+}
+
+void writeJson(std::ostream &os, const TraceFileInfo &info, const std::vector<TraceRecord> &recs) {
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"sampleRate\": " << info.sampleRate << ",\n";
+    os << "  \"blockSize\": " << info.blockSize << ",\n";
+    os << "  \"allBlocks\": " << (info.allBlocks ? "true" : "false") << ",\n";
+    os << "  \"stalls\": " << info.stalls << ",\n";
+    os << "  \"sources\": [";
+    for (size_t i = 0; i < info.sources.size(); ++i) {
+        os << (i ? ", " : "") << "\"" << jsonEscape(info.sources[i]) << "\"";
+    }
+    os << "],\n";
+    os << "  \"records\": [\n";
+    for (size_t i = 0; i < recs.size(); ++i) {
+        const TraceRecord &r = recs[i];
+        const double t = info.sampleRate ? (double)r.frame / info.sampleRate : 0.0;
+        os << "    {\"type\": \"" << traceRecordTypeName(r.type) << "\", \"frame\": " << r.frame
+           << ", \"time\": " << t;
+        if (r.type == TraceRecordType::Block) {
+            os << ", \"source\": \"" << jsonEscape(sourceName(info, r)) << "\", \"flags\": [";
+            bool first = true;
+            for (uint16_t bit = 1; bit != 0 && bit <= kTraceLfe; bit <<= 1) {
+                if (!(r.flags & bit)) continue;
+                os << (first ? "" : ", ") << "\"" << traceFlagName(bit) << "\"";
+                first = false;
+            }
+            os << "]";
+            if (!(r.flags & kTraceLfe)) {
+                os << ", \"az\": " << r.az << ", \"el\": " << r.el << ", \"deltaRad\": " << r.value;
+            }
+        } else {
+            os << ", \"blocks\": " << r.index << ", \"fraction\": " << r.value
+               << ", \"elapsedSec\": " << r.az;
+        }
+        os << "}" << (i + 1 < recs.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n";
+    os << "}\n";
+}
+
+void writeCsv(std::ostream &os, const TraceFileInfo &info, const std::vector<TraceRecord> &recs) {
+    os << std::setprecision(9);
+    os << "type,frame,time,source,flags,az,el,value\n";
+    for (const TraceRecord &r : recs) {
+        const double t = info.sampleRate ? (double)r.frame / info.sampleRate : 0.0;
+        os << traceRecordTypeName(r.type) << "," << r.frame << "," << t << ","
+           << csvField(sourceName(info, r)) << "," << flagList(r.flags, '|') << ",";
+        if (r.type == TraceRecordType::Block && !(r.flags & kTraceLfe)) {
+            os << r.az << "," << r.el << "," << r.value;
+        } else if (r.type == TraceRecordType::Progress) {
+            os << ",," << r.value;
+        } else {
+            os << ",,";
+        }
+        os << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string tracePath, outPath;
+    bool csv = false, withProgress = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else if (arg == "--csv") {
+            csv = true;
+        } else if (arg == "--json") {
+            csv = false;
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--progress") {
+            withProgress = true;
+        } else if (tracePath.empty() && arg.rfind("--", 0) != 0) {
+            tracePath = arg;
+        } else {
+            std::cerr << "Error: unknown argument '" << arg << "'\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (tracePath.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    TraceFileInfo info;
+    std::vector<TraceRecord> records;
+    try {
+        RenderTrace::read(tracePath, info, records);
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    // Drop discarded passes, then order as a serial render would emit
+    std::unordered_set<uint32_t> discarded;
+    for (const TraceRecord &r : records) {
+        if (r.type == TraceRecordType::Discard) discarded.insert(r.pass);
+    }
+    std::vector<TraceRecord> out;
+    out.reserve(records.size());
+    for (const TraceRecord &r : records) {
+        if (r.type == TraceRecordType::Discard || discarded.count(r.pass)) continue;
+        if (r.type == TraceRecordType::Progress && !withProgress) continue;
+        out.push_back(r);
+    }
+    std::stable_sort(out.begin(), out.end(), [](const TraceRecord &a, const TraceRecord &b) {
+        if (a.frame != b.frame) return a.frame < b.frame;
+        if (a.type != b.type) return a.type < b.type;
+        return a.index < b.index;
+    });
+
+    std::ofstream file;
+    if (!outPath.empty()) {
+        file.open(outPath);
+        if (!file.good()) {
+            std::cerr << "Error: cannot write " << outPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream &os = outPath.empty() ? std::cout : file;
+    if (csv) writeCsv(os, info, out);
+    else     writeJson(os, info, out);
+
+    if (!outPath.empty()) {
+        std::cerr << "Wrote " << out.size() << " records to " << outPath << "\n";
+    }
+    return 0;
+}
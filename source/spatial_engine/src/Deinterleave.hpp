@@ -0,0 +1,126 @@
+#pragma once
+
+// Deinterleave.hpp — shared interleaved → planar channel extraction kernel
+//
+// Used by WavUtils::loadSourcesFromADM() (offline, whole-file ADM load) and
+// MultichannelReader::fillTargets() (realtime ADM streaming). Both hold
+// an interleaved float block [f0c0, f0c1, …, f0cN-1, f1c0, …] and want a
+// subset of its channels as contiguous per-channel arrays.
+//
+// KERNEL:
+//   - Cache-blocked: frames are processed in kTileFrames tiles; every target
+//     channel is extracted from a tile before moving on, so each tile of the
+//     source (kTileFrames × numChannels floats) is pulled through cache once
+//     instead of once per channel.
+//   - SIMD transpose: runs of 4 consecutive target channels (c, c+1, c+2,
+//     c+3) are extracted 4 frames at a time with a 4×4 in-register transpose
+//     (SSE _MM_TRANSPOSE4_PS / NEON vtrn). Other targets use a scalar strided
+//     copy. Output is bit-identical either way (pure copies).
+//
+// deinterleaveTargets() is a pure function on caller-owned memory (no
+// allocation, no locks), so callers may split one block across threads by
+// frame range — see the offline loader.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <xmmintrin.h>
+#  define SR_DEINTERLEAVE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define SR_DEINTERLEAVE_NEON 1
+#endif
+
+struct DeinterleaveTarget {
+    int    channel;   // 0-based channel in the interleaved block
+    float* dst;       // receives frames [0, numFrames) of that channel
+};
+
+namespace deinterleave_detail {
+
+constexpr uint64_t kTileFrames = 256;
+
+// Four consecutive channels c..c+3, frames [f0, f1): 4×4 transposes + scalar tail.
+inline void quad(const float* src, size_t stride, int c,
+                 float* d0, float* d1, float* d2, float* d3,
+                 uint64_t f0, uint64_t f1) {
+    uint64_t f = f0;
+#if defined(SR_DEINTERLEAVE_SSE)
+    for (; f + 4 <= f1; f += 4) {
+        const float* p = src + f * stride + c;
+        __m128 r0 = _mm_loadu_ps(p);
+        __m128 r1 = _mm_loadu_ps(p + stride);
+        __m128 r2 = _mm_loadu_ps(p + 2 * stride);
+        __m128 r3 = _mm_loadu_ps(p + 3 * stride);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(d0 + f, r0);
+        _mm_storeu_ps(d1 + f, r1);
+        _mm_storeu_ps(d2 + f, r2);
+        _mm_storeu_ps(d3 + f, r3);
+    }
+#elif defined(SR_DEINTERLEAVE_NEON)
+    for (; f + 4 <= f1; f += 4) {
+        const float* p = src + f * stride + c;
+        float32x4x2_t t01 = vtrnq_f32(vld1q_f32(p),              vld1q_f32(p + stride));
+        float32x4x2_t t23 = vtrnq_f32(vld1q_f32(p + 2 * stride), vld1q_f32(p + 3 * stride));
+        vst1q_f32(d0 + f, vcombine_f32(vget_low_f32(t01.val[0]),  vget_low_f32(t23.val[0])));
+        vst1q_f32(d1 + f, vcombine_f32(vget_low_f32(t01.val[1]),  vget_low_f32(t23.val[1])));
+        vst1q_f32(d2 + f, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+        vst1q_f32(d3 + f, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+    }
+#endif
+    for (; f < f1; ++f) {
+        const float* p = src + f * stride + c;
+        d0[f] = p[0];
+        d1[f] = p[1];
+        d2[f] = p[2];
+        d3[f] = p[3];
+    }
+}
+
+inline void single(const float* src, size_t stride, int c, float* d,
+                   uint64_t f0, uint64_t f1) {
+    const float* p = src + f0 * stride + c;
+    for (uint64_t f = f0; f < f1; ++f, p += stride) d[f] = *p;
+}
+
+} // namespace deinterleave_detail
+
+/// Extract frames [frameBegin, frameEnd) of every target channel from an
+/// interleaved block with numChannels channels per frame. Frame indices are
+/// relative to src and to each target's dst. Targets should be sorted by
+/// channel so consecutive-channel runs hit the SIMD path (any order is
+/// correct, just slower).
+inline void deinterleaveTargets(const float* src, int numChannels,
+                                const DeinterleaveTarget* targets, size_t numTargets,
+                                uint64_t frameBegin, uint64_t frameEnd) {
+    using namespace deinterleave_detail;
+    const size_t stride = static_cast<size_t>(numChannels);
+
+    for (uint64_t t = frameBegin; t < frameEnd; t += kTileFrames) {
+        const uint64_t tEnd = std::min(frameEnd, t + kTileFrames);
+        size_t k = 0;
+        while (k < numTargets) {
+            const int c = targets[k].channel;
+            if (k + 3 < numTargets && c + 3 < numChannels
+                && targets[k + 1].channel == c + 1
+                && targets[k + 2].channel == c + 2
+                && targets[k + 3].channel == c + 3) {
+                quad(src, stride, c, targets[k].dst, targets[k + 1].dst,
+                     targets[k + 2].dst, targets[k + 3].dst, t, tEnd);
+                k += 4;
+            } else {
+                single(src, stride, c, targets[k].dst, t, tEnd);
+                k += 1;
+            }
+        }
+    }
+}
+
+/// Whole-block convenience: frames [0, numFrames).
+inline void deinterleaveTargets(const float* src, int numChannels, uint64_t numFrames,
+                                const DeinterleaveTarget* targets, size_t numTargets) {
+    deinterleaveTargets(src, numChannels, targets, numTargets, 0, numFrames);
+}
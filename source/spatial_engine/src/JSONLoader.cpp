@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -47,137 +51,280 @@ static std::pair<TimeUnit, double> parseTimeUnit(const std::string& timeUnitStr,
 // ============================================================================
 // NEW: Load LUSID scene format (v0.5+)
 // ============================================================================
+//
+// Streaming (SAX) parse: no json DOM is built. LusidSaxHandler tracks its
+// position in the document by nesting depth and appends raw keyframes to
+// per-source vectors as each frame object closes, so peak memory is the
+// output plus one frame's worth of nodes. Keys may appear in any order
+// (a frame's "time" after its "nodes", "timeUnit" after "frames"), so node
+// data is held until its frame closes and times are converted to seconds
+// after the parse. Validation and post-processing match the former DOM walk.
+//
+// Document depth (depth counts open containers):
+//   1 root object   2 "frames" array   3 frame object   4 "nodes" array
+//   5 node object   6 "cart" array
+
+namespace {
+
+class LusidSaxHandler : public json::json_sax_t {
+public:
+    // Top-level fields
+    bool        hasSampleRate = false;
+    int         sampleRate    = 48000;
+    std::string timeUnitStr   = "seconds";
+    bool        hasDuration   = false;
+    double      duration      = -1.0;
+    std::string version       = "0.5";
+    bool        sawFrames     = false;
+
+    int framesMissingTime = 0;
+    int droppedNoCart     = 0;
+
+    // Sources in first-seen order; keyframe times are still in file units.
+    std::vector<std::pair<std::string, std::vector<Keyframe>>> sources;
+    bool hasLFE = false;
+
+    // ── Scalars ──────────────────────────────────────────────────────────
+    bool null() override                          { return value(Kind::Other, 0.0, nullptr); }
+    bool boolean(bool) override                   { return value(Kind::Other, 0.0, nullptr); }
+    bool number_integer(number_integer_t v) override   { return value(Kind::Number, static_cast<double>(v), nullptr); }
+    bool number_unsigned(number_unsigned_t v) override { return value(Kind::Number, static_cast<double>(v), nullptr); }
+    bool number_float(number_float_t v, const string_t&) override { return value(Kind::Number, v, nullptr); }
+    bool string(string_t& s) override             { return value(Kind::String, 0.0, &s); }
+    bool binary(binary_t&) override               { return value(Kind::Other, 0.0, nullptr); }
+
+    // ── Containers ───────────────────────────────────────────────────────
+    bool start_object(std::size_t) override {
+        if (mInCart) cartElement(false, 0.0);
+        ++mDepth;
+        if (mDepth == 3 && mInFrames) {
+            mInFrame = true;
+            mFrameHasTime = false;
+            mPending.clear();
+        } else if (mDepth == 5 && mInNodes) {
+            mInNode = true;
+            mNodeId.clear();
+            mNodeType.clear();
+            mHasId = mHasType = mHasCart = false;
+        }
+        mKey.clear();
+        return true;
+    }
+
+    bool end_object() override {
+        if (mDepth == 5 && mInNode) {
+            endNode();
+            mInNode = false;
+        } else if (mDepth == 3 && mInFrame) {
+            endFrame();
+            mInFrame = false;
+        }
+        --mDepth;
+        mKey.clear();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (mInCart) cartElement(false, 0.0);
+        ++mDepth;
+        if (mDepth == 2 && mKey == "frames") {
+            mInFrames = sawFrames = true;
+        } else if (mDepth == 4 && mInFrame && mKey == "nodes") {
+            mInNodes = true;
+        } else if (mDepth == 6 && mInNode && mKey == "cart") {
+            mInCart = true;
+            mCartN = 0;
+            mCartOk = true;
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (mDepth == 6 && mInCart) {
+            mInCart  = false;
+            mHasCart = mCartOk && mCartN >= 3;
+        } else if (mDepth == 4 && mInNodes) {
+            mInNodes = false;
+        } else if (mDepth == 2 && mInFrames) {
+            mInFrames = false;
+        }
+        --mDepth;
+        return true;
+    }
+
+    bool key(string_t& k) override {
+        mKey = k;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&,
+                     const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error("LUSID scene JSON parse error at byte "
+                                 + std::to_string(position) + ": " + ex.what());
+    }
+
+private:
+    enum class Kind { Number, String, Other };
+
+    struct PendingNode {
+        size_t source;     // index into sources
+        float  x, y, z;
+        bool   isLFE;
+    };
+
+    bool value(Kind kind, double num, const std::string* str) {
+        if (mInCart && mDepth == 6) {
+            cartElement(kind == Kind::Number, num);
+        } else if (mDepth == 1) {
+            if (mKey == "sampleRate" && kind == Kind::Number) {
+                sampleRate = static_cast<int>(num);
+                hasSampleRate = true;
+            } else if (mKey == "timeUnit" && kind == Kind::String) {
+                timeUnitStr = *str;
+            } else if (mKey == "duration" && kind == Kind::Number) {
+                duration = num;
+                hasDuration = true;
+            } else if (mKey == "version" && kind == Kind::String) {
+                version = *str;
+            }
+        } else if (mDepth == 3 && mInFrame) {
+            if (mKey == "time" && kind == Kind::Number) {
+                mFrameTime = num;
+                mFrameHasTime = true;
+            }
+        } else if (mDepth == 5 && mInNode) {
+            if (mKey == "id" && kind == Kind::String) {
+                mNodeId = *str;
+                mHasId = true;
+            } else if (mKey == "type" && kind == Kind::String) {
+                mNodeType = *str;
+                mHasType = true;
+            }
+        }
+        return true;
+    }
+
+    void cartElement(bool isNumber, double v) {
+        if (mCartN < 3) {
+            if (isNumber) mCart[mCartN] = static_cast<float>(v);
+            else          mCartOk = false;
+        }
+        ++mCartN;
+    }
+
+    size_t sourceIndex(const std::string& id) {
+        auto it = mIndex.find(id);
+        if (it != mIndex.end()) return it->second;
+        mIndex.emplace(id, sources.size());
+        sources.emplace_back(id, std::vector<Keyframe>());
+        return sources.size() - 1;
+    }
+
+    void endNode() {
+        if (!mHasId || !mHasType) return;
+        if (mNodeType == "audio_object" || mNodeType == "direct_speaker") {
+            if (!mHasCart) {
+                droppedNoCart++;
+                return;
+            }
+            mPending.push_back({sourceIndex(mNodeId), mCart[0], mCart[1], mCart[2], false});
+        } else if (mNodeType == "LFE") {
+            mPending.push_back({0, 0.0f, 0.0f, 0.0f, true});
+        }
+        // spectral_features, agent_state → ignored by renderer
+    }
+
+    void endFrame() {
+        if (!mFrameHasTime) {
+            framesMissingTime++;
+            return;
+        }
+        for (const PendingNode& p : mPending) {
+            if (p.isLFE) {
+                // Only add LFE once (first occurrence)
+                if (!hasLFE) {
+                    sources[sourceIndex("LFE")].second.push_back(Keyframe{0.0, 0.0f, 0.0f, 0.0f});
+                    hasLFE = true;
+                }
+                continue;
+            }
+            sources[p.source].second.push_back(Keyframe{mFrameTime, p.x, p.y, p.z});
+        }
+    }
+
+    int         mDepth = 0;
+    std::string mKey;
+
+    bool mInFrames = false, mInFrame = false, mInNodes = false, mInNode = false;
+
+    double                   mFrameTime    = 0.0;
+    bool                     mFrameHasTime = false;
+    std::vector<PendingNode> mPending;
+
+    std::string mNodeId, mNodeType;
+    bool        mHasId = false, mHasType = false, mHasCart = false;
+
+    bool  mInCart = false, mCartOk = true;
+    int   mCartN  = 0;
+    float mCart[3] = {0.0f, 0.0f, 0.0f};
+
+    std::unordered_map<std::string, size_t> mIndex;
+};
+
+} // namespace
 
 SpatialData JSONLoader::loadLusidScene(const std::string &path) {
-    std::ifstream f(path);
+    std::ifstream f(path, std::ios::binary);
     if (!f.good()) throw std::runtime_error("Cannot open LUSID scene JSON: " + path);
 
-    json j;
-    f >> j;
+    LusidSaxHandler h;
+    json::sax_parse(f, &h);
 
     SpatialData d;
 
     // Parse top-level fields
-    d.sampleRate = j.value("sampleRate", 48000);
+    d.sampleRate = h.sampleRate;
 
-    std::string timeUnitStr = j.value("timeUnit", "seconds");
-    auto [timeUnit, timeMultiplier] = parseTimeUnit(timeUnitStr, d.sampleRate);
+    auto [timeUnit, timeMultiplier] = parseTimeUnit(h.timeUnitStr, d.sampleRate);
     d.timeUnit = timeUnit;
 
     // Parse duration field if present (LUSID v0.5.2+)
-    if (j.contains("duration") && j["duration"].is_number()) {
-        d.duration = j["duration"].get<double>();
+    if (h.hasDuration) {
+        d.duration = h.duration;
         std::cout << "LUSID scene duration: " << d.duration << " seconds\n";
     } else {
         d.duration = -1.0; // Not specified, will fall back to WAV file length
     }
 
-    std::string version = j.value("version", "0.5");
-    std::cout << "Loading LUSID scene v" << version << "\n";
+    std::cout << "Loading LUSID scene v" << h.version << "\n";
 
-    if (!j.contains("frames") || !j["frames"].is_array()) {
+    if (!h.sawFrames) {
         std::cerr << "Warning: LUSID scene has no 'frames' array\n";
         return d;
     }
+    if (h.framesMissingTime > 0) {
+        std::cerr << "Warning: " << h.framesMissingTime << " frame(s) missing 'time', skipped\n";
+    }
 
     int totalSources = 0;
-    int totalDropped = 0;
-
-    // Iterate over frames
-    for (auto &frame : j["frames"]) {
-        if (!frame.contains("time") || !frame["time"].is_number()) {
-            std::cerr << "Warning: frame missing 'time', skipping\n";
-            continue;
-        }
-        double frameTime = frame["time"].get<double>() * timeMultiplier;
+    int totalDropped = h.droppedNoCart;
 
-        if (!frame.contains("nodes") || !frame["nodes"].is_array()) {
+    // Convert times and move each source into the sorted map
+    for (auto &[name, raw] : h.sources) {
+        if (name == "LFE") {
+            d.sources["LFE"] = std::move(raw);
             continue;
         }
-
-        for (auto &node : frame["nodes"]) {
-            if (!node.contains("id") || !node.contains("type")) {
-                continue;
-            }
-
-            std::string nodeId = node["id"].get<std::string>();
-            std::string nodeType = node["type"].get<std::string>();
-
-            // audio_object and direct_speaker → spatial sources
-            if (nodeType == "audio_object" || nodeType == "direct_speaker") {
-                if (!node.contains("cart") || !node["cart"].is_array() || node["cart"].size() < 3) {
-                    totalDropped++;
-                    continue;
-                }
-
-                Keyframe kf;
-                kf.time = frameTime;
-                kf.x = node["cart"][0].get<float>();
-                kf.y = node["cart"][1].get<float>();
-                kf.z = node["cart"][2].get<float>();
-
-                if (!isValidKeyframe(kf)) {
-                    totalDropped++;
-                    continue;
-                }
-
-                // Check for zero-length direction vector
-                float mag = std::sqrt(kf.x*kf.x + kf.y*kf.y + kf.z*kf.z);
-                if (mag < 1e-8f) {
-                    std::cerr << "Warning: node '" << nodeId << "' at t=" << kf.time 
-                              << " has zero direction, setting to front (0,1,0)\n";
-                    kf.x = 0.0f;
-                    kf.y = 1.0f;
-                    kf.z = 0.0f;
-                }
-
-                // Use node ID as source key (e.g., "1.1", "11.1")
-                d.sources[nodeId].push_back(kf);
-            }
-            // LFE → special source with no cart
-            else if (nodeType == "LFE") {
-                // Only add LFE once (first occurrence)
-                if (d.sources.find("LFE") == d.sources.end()) {
-                    Keyframe kf;
-                    kf.time = 0.0;
-                    kf.x = 0.0f;
-                    kf.y = 0.0f;
-                    kf.z = 0.0f;
-                    d.sources["LFE"].push_back(kf);
-                }
-            }
-            // spectral_features, agent_state → ignored by renderer
-        }
+        for (Keyframe &kf : raw) kf.time *= timeMultiplier;
+        d.sources[name] = std::move(raw);
     }
 
-    // Post-process: sort and deduplicate keyframes per source
+    // Post-process: validate, sort and deduplicate keyframes per source
     for (auto &[name, frames] : d.sources) {
         if (name == "LFE") continue;  // LFE only has one keyframe
 
         totalSources++;
-
-        // Sort by time
-        std::sort(frames.begin(), frames.end(),
-                  [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
-
-        // Remove duplicate times (keep last occurrence within epsilon)
-        const double timeEpsilon = 1e-6;
-        std::vector<Keyframe> deduped;
-        for (size_t i = 0; i < frames.size(); i++) {
-            if (i + 1 < frames.size() && 
-                std::abs(frames[i+1].time - frames[i].time) < timeEpsilon) {
-                continue;  // Skip, keep later one
-            }
-            deduped.push_back(frames[i]);
-        }
-
-        if (deduped.size() < frames.size()) {
-            std::cerr << "Warning: source '" << name << "' had " 
-                      << (frames.size() - deduped.size()) 
-                      << " duplicate-time keyframes collapsed\n";
-        }
-
-        frames = deduped;
+        totalDropped += sanitizeKeyframes(name, frames);
     }
 
     if (totalDropped > 0) {
@@ -191,6 +338,59 @@ SpatialData JSONLoader::loadLusidScene(const std::string &path) {
     return d;
 }
 
+// Drop non-finite keyframes, point zero-length directions to the front,
+// sort by time and collapse duplicate times (the later keyframe wins).
+int JSONLoader::sanitizeKeyframes(const std::string &name, std::vector<Keyframe> &frames) {
+    int dropped = 0;
+    size_t valid = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        Keyframe kf = frames[i];
+        if (!isValidKeyframe(kf)) {
+            dropped++;
+            continue;
+        }
+
+        // Check for zero-length direction vector
+        float mag = std::sqrt(kf.x*kf.x + kf.y*kf.y + kf.z*kf.z);
+        if (mag < 1e-8f) {
+            std::cerr << "Warning: node '" << name << "' at t=" << kf.time
+                      << " has zero direction, setting to front (0,1,0)\n";
+            kf.x = 0.0f;
+            kf.y = 1.0f;
+            kf.z = 0.0f;
+        }
+        frames[valid++] = kf;
+    }
+    frames.resize(valid);
+
+    // Sort by time (already sorted when the file lists frames in order)
+    if (!std::is_sorted(frames.begin(), frames.end(),
+                        [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; })) {
+        std::stable_sort(frames.begin(), frames.end(),
+                         [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    }
+
+    // Remove duplicate times (keep last occurrence within epsilon)
+    const double timeEpsilon = 1e-6;
+    size_t kept = 0;
+    const size_t before = frames.size();
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (i + 1 < frames.size() &&
+            std::abs(frames[i+1].time - frames[i].time) < timeEpsilon) {
+            continue;  // Skip, keep later one
+        }
+        frames[kept++] = frames[i];
+    }
+    frames.resize(kept);
+
+    if (kept < before) {
+        std::cerr << "Warning: source '" << name << "' had "
+                  << (before - kept)
+                  << " duplicate-time keyframes collapsed\n";
+    }
+    return dropped;
+}
+
 // ============================================================================
 // DEPRECATED: Load old renderInstructions.json format
 // Kept for backwards compatibility. Implementation in old_schema_loader/.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <map>
 #include <vector>
@@ -9,6 +10,41 @@ struct Keyframe {
     float x, y, z;
 };
 
+// Find the keyframe segment [kfs[i], kfs[i+1]] containing time t.
+// Shared by Pose::interpolateDirRaw() (realtime) and
+// SpatialRenderer::interpolateDirRaw() (offline).
+//
+// Preconditions: kfs sorted by time (loadLusidScene() sorts and dedups),
+// kfs.size() >= 2, and kfs.front().time < t < kfs.back().time — callers
+// clamp to the first/last keyframe before calling. Returns the same segment
+// as a linear scan from 0: the FIRST i with kfs[i].time <= t <= kfs[i+1].time.
+//
+// cursor is a per-source hint holding the previous result. Playback moves
+// at most a few segments per block, so the hint is checked first and walked
+// up to kMaxWalk segments in either direction; anything farther (seek, loop,
+// first call) falls back to a binary search. O(1) amortized during playback,
+// O(log n) on a jump. No allocation — safe on the audio thread.
+inline size_t findKeyframeSegment(const std::vector<Keyframe>& kfs, double t, size_t& cursor) {
+    constexpr int kMaxWalk = 8;
+    const size_t last = kfs.size() - 2;  // highest valid segment index
+    size_t i = std::min(cursor, last);
+    for (int step = 0; step < kMaxWalk; ++step) {
+        if (kfs[i + 1].time < t && i < last) {
+            ++i;                          // segment ends before t
+        } else if (i > 0 && kfs[i].time >= t) {
+            --i;                          // an earlier segment also contains t
+        } else {
+            cursor = i;
+            return i;
+        }
+    }
+    auto it = std::lower_bound(kfs.begin() + 1, kfs.end(), t,
+                               [](const Keyframe& k, double tt) { return k.time < tt; });
+    i = (it == kfs.end()) ? last : static_cast<size_t>(it - kfs.begin()) - 1;
+    cursor = i;
+    return i;
+}
+
 // Time unit for keyframe timestamps
 // Used to convert all times to seconds during loading
 enum class TimeUnit {
@@ -32,6 +68,14 @@ public:
     /// Source keys use node ID format ("1.1", "11.1") not old "src_N" format.
     static SpatialData loadLusidScene(const std::string &path);
 
+    /// The keyframe cleanup loadLusidScene() applies to every spatial
+    /// source (times already in seconds): drops non-finite keyframes, points
+    /// zero-length directions to the front, sorts by time and collapses
+    /// duplicate times. Also used for scenes handed over in memory
+    /// (EngineSession::loadScene(SceneInput, SpatialData)). Returns the number
+    /// of keyframes dropped.
+    static int sanitizeKeyframes(const std::string &name, std::vector<Keyframe> &frames);
+
     /// DEPRECATED: Load old renderInstructions.json format.
     /// Kept for backwards compatibility. Use loadLusidScene() for new pipeline.
     /// Old implementation moved to old_schema_loader/JSONLoader.cpp
@@ -0,0 +1,349 @@
+#include "SceneCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define SR_SCENECACHE_MMAP 1
+#endif
+
+namespace {
+
+constexpr char     kMagic[8] = {'S', 'R', 'S', 'C', 'E', 'N', 'E', '\0'};
+constexpr uint32_t kVersion  = 1;
+
+struct CacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t numSources;
+    uint64_t jsonSize;
+    uint64_t jsonHash;
+    int32_t  sampleRate;
+    int32_t  timeUnit;
+    double   duration;
+    uint64_t nameBytes;      // name pool size, including padding
+    uint64_t numKeyframes;
+};
+
+struct CacheSourceEntry {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint64_t firstKeyframe;
+    uint64_t keyframeCount;
+};
+
+struct CacheKeyframe {
+    double time;
+    float  x, y, z;
+    float  pad;
+};
+
+static_assert(sizeof(CacheHeader) == 64, "CacheHeader layout changed — bump kVersion");
+static_assert(sizeof(CacheSourceEntry) == 24, "CacheSourceEntry layout changed — bump kVersion");
+static_assert(sizeof(CacheKeyframe) == 24, "CacheKeyframe layout changed — bump kVersion");
+
+uint64_t pad8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+// ── Content hash ────────────────────────────────────────────────────────────
+// Four independent multiply-rotate lanes over 32-byte blocks (several GB/s,
+// so hashing stays well under the cost of reading the file), folded with the
+// length and a splitmix64 finalizer. Not cryptographic — it only has to catch
+// an edited or replaced scene.
+
+constexpr uint64_t kP1 = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kP2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline uint64_t rotl(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+inline uint64_t lane(uint64_t h, uint64_t w) { return rotl(h ^ (w * kP1), 31) * kP2; }
+inline uint64_t fmix(uint64_t h) {
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+struct ContentHasher {
+    uint64_t h[4] = {kP1, kP2, ~kP1, ~kP2};
+    uint64_t total = 0;
+
+    // n must be a multiple of 32 except on the final call.
+    void update(const uint8_t* p, size_t n) {
+        total += n;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            uint64_t w[4];
+            std::memcpy(w, p + i, 32);
+            h[0] = lane(h[0], w[0]);
+            h[1] = lane(h[1], w[1]);
+            h[2] = lane(h[2], w[2]);
+            h[3] = lane(h[3], w[3]);
+        }
+        for (int k = 0; i < n; i += 8, ++k) {      // tail: zero-padded words
+            uint64_t w = 0;
+            std::memcpy(&w, p + i, std::min<size_t>(8, n - i));
+            h[k] = lane(h[k], w);
+        }
+    }
+
+    uint64_t digest() const {
+        uint64_t r = total * kP1;
+        for (uint64_t v : h) r = fmix(r ^ v);
+        return r;
+    }
+};
+
+// ── Read-only view of a whole file (mmap, or a heap copy without mmap) ──────
+
+class FileView {
+public:
+    ~FileView() {
+#if defined(SR_SCENECACHE_MMAP)
+        if (mMapped) ::munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+    }
+
+    bool open(const std::string& path) {
+#if defined(SR_SCENECACHE_MMAP)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+        mSize = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { mSize = 0; return false; }
+        mData = static_cast<const uint8_t*>(p);
+        mMapped = true;
+        return true;
+#else
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        if (!f.good()) return false;
+        mHeap.resize(static_cast<size_t>(f.tellg()));
+        f.seekg(0);
+        if (!f.read(reinterpret_cast<char*>(mHeap.data()),
+                    static_cast<std::streamsize>(mHeap.size()))) return false;
+        mData = mHeap.data();
+        mSize = mHeap.size();
+        return true;
+#endif
+    }
+
+    const uint8_t* data() const { return mData; }
+    size_t         size() const { return mSize; }
+
+private:
+    const uint8_t*       mData = nullptr;
+    size_t               mSize = 0;
+    bool                 mMapped = false;
+    std::vector<uint8_t> mHeap;
+};
+
+// JSON byte size recorded in cacheFile's header. False if the cache is
+// missing, short, or of another format / version.
+bool cachedJsonSize(const std::string& cacheFile, uint64_t& jsonSize) {
+    std::ifstream f(cacheFile, std::ios::binary);
+    CacheHeader hdr;
+    if (!f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))) return false;
+    if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 || hdr.version != kVersion)
+        return false;
+    jsonSize = hdr.jsonSize;
+    return true;
+}
+
+// Cheap pre-check before hashFile(): the cache header's JSON size matches
+// the JSON on disk (one stat and a 64-byte read).
+bool sizeMatches(const std::string& jsonPath, const std::string& cacheFile) {
+    std::error_code ec;
+    const uint64_t onDisk = std::filesystem::file_size(jsonPath, ec);
+    uint64_t cached = 0;
+    return !ec && cachedJsonSize(cacheFile, cached) && cached == onDisk;
+}
+
+bool readCache(const std::string& cacheFile, uint64_t jsonSize, uint64_t jsonHash,
+               SpatialData& out) {
+    FileView view;
+    if (!view.open(cacheFile) || view.size() < sizeof(CacheHeader)) return false;
+
+    CacheHeader hdr;
+    std::memcpy(&hdr, view.data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 || hdr.version != kVersion)
+        return false;
+    if (hdr.jsonSize != jsonSize || hdr.jsonHash != jsonHash) return false;
+
+    if (hdr.nameBytes > view.size()) return false;
+    const uint64_t entriesOff = sizeof(CacheHeader);
+    const uint64_t namesOff   = entriesOff + uint64_t(hdr.numSources) * sizeof(CacheSourceEntry);
+    const uint64_t kfOff      = namesOff + hdr.nameBytes;
+    if (hdr.numKeyframes > (UINT64_MAX - kfOff) / sizeof(CacheKeyframe)) return false;
+    if (view.size() != kfOff + hdr.numKeyframes * sizeof(CacheKeyframe)) return false;
+
+    const auto* entries = reinterpret_cast<const CacheSourceEntry*>(view.data() + entriesOff);
+    const char* names   = reinterpret_cast<const char*>(view.data() + namesOff);
+    const auto* kfs     = reinterpret_cast<const CacheKeyframe*>(view.data() + kfOff);
+
+    SpatialData d;
+    d.sampleRate = hdr.sampleRate;
+    d.timeUnit   = static_cast<TimeUnit>(hdr.timeUnit);
+    d.duration   = hdr.duration;
+
+    for (uint32_t s = 0; s < hdr.numSources; ++s) {
+        const CacheSourceEntry& e = entries[s];
+        if (uint64_t(e.nameOffset) + e.nameLength > hdr.nameBytes) return false;
+        if (e.firstKeyframe > hdr.numKeyframes ||
+            e.keyframeCount > hdr.numKeyframes - e.firstKeyframe) return false;
+
+        std::vector<Keyframe>& frames =
+            d.sources[std::string(names + e.nameOffset, e.nameLength)];
+        frames.resize(static_cast<size_t>(e.keyframeCount));
+        for (uint64_t k = 0; k < e.keyframeCount; ++k) {
+            const CacheKeyframe& c = kfs[e.firstKeyframe + k];
+            frames[k] = Keyframe{c.time, c.x, c.y, c.z};
+        }
+    }
+    if (d.sources.size() != hdr.numSources) return false;   // duplicate names
+
+    out = std::move(d);
+    std::cout << "Loaded LUSID scene from cache: " << hdr.numSources << " sources, "
+              << hdr.numKeyframes << " keyframes (" << cacheFile << ")\n";
+    return true;
+}
+
+bool writeCache(const std::string& cacheFile, uint64_t jsonSize, uint64_t jsonHash,
+                const SpatialData& scene) {
+    CacheHeader hdr{};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version    = kVersion;
+    hdr.numSources = static_cast<uint32_t>(scene.sources.size());
+    hdr.jsonSize   = jsonSize;
+    hdr.jsonHash   = jsonHash;
+    hdr.sampleRate = scene.sampleRate;
+    hdr.timeUnit   = static_cast<int32_t>(scene.timeUnit);
+    hdr.duration   = scene.duration;
+
+    std::vector<CacheSourceEntry> entries;
+    entries.reserve(scene.sources.size());
+    std::string names;
+    uint64_t numKeyframes = 0;
+    for (const auto& [name, frames] : scene.sources) {
+        CacheSourceEntry e{};
+        e.nameOffset    = static_cast<uint32_t>(names.size());
+        e.nameLength    = static_cast<uint32_t>(name.size());
+        e.firstKeyframe = numKeyframes;
+        e.keyframeCount = frames.size();
+        entries.push_back(e);
+        names += name;
+        numKeyframes += frames.size();
+    }
+    names.resize(static_cast<size_t>(pad8(names.size())), '\0');
+    hdr.nameBytes    = names.size();
+    hdr.numKeyframes = numKeyframes;
+
+    const std::string tmpFile = cacheFile + ".tmp";
+    {
+        std::ofstream f(tmpFile, std::ios::binary | std::ios::trunc);
+        if (!f.good()) return false;
+        f.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        f.write(reinterpret_cast<const char*>(entries.data()),
+                static_cast<std::streamsize>(entries.size() * sizeof(CacheSourceEntry)));
+        f.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        std::vector<CacheKeyframe> buf;
+        for (const auto& [name, frames] : scene.sources) {
+            buf.resize(frames.size());
+            for (size_t k = 0; k < frames.size(); ++k)
+                buf[k] = CacheKeyframe{frames[k].time, frames[k].x, frames[k].y, frames[k].z, 0.0f};
+            f.write(reinterpret_cast<const char*>(buf.data()),
+                    static_cast<std::streamsize>(buf.size() * sizeof(CacheKeyframe)));
+        }
+        if (!f.good()) {
+            f.close();
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpFile, cacheFile, ec);
+    if (ec) {
+        std::remove(tmpFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// SceneCache
+// ============================================================================
+
+bool SceneCache::hashFile(const std::string &path, uint64_t &size, uint64_t &hash) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good()) return false;
+
+    ContentHasher hasher;
+    std::vector<uint8_t> buf(size_t(1) << 20);   // multiple of 32
+    while (f) {
+        f.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+        const size_t got = static_cast<size_t>(f.gcount());
+        if (got == 0) break;
+        hasher.update(buf.data(), got);
+    }
+    if (f.bad()) return false;
+
+    size = hasher.total;
+    hash = hasher.digest();
+    return true;
+}
+
+uint64_t SceneCache::hashBytes(const void *data, size_t size) {
+    ContentHasher hasher;
+    hasher.update(static_cast<const uint8_t*>(data), size);
+    return hasher.digest();
+}
+
+bool SceneCache::read(const std::string &jsonPath, SpatialData &out) {
+    if (!sizeMatches(jsonPath, cachePath(jsonPath))) return false;
+    uint64_t size = 0, hash = 0;
+    if (!hashFile(jsonPath, size, hash)) return false;
+    return readCache(cachePath(jsonPath), size, hash, out);
+}
+
+bool SceneCache::write(const std::string &jsonPath, const SpatialData &scene) {
+    uint64_t size = 0, hash = 0;
+    if (!hashFile(jsonPath, size, hash)) return false;
+    return writeCache(cachePath(jsonPath), size, hash, scene);
+}
+
+SpatialData SceneCache::loadLusidScene(const std::string &jsonPath) {
+    // A size mismatch (or no cache) skips straight to the parse; the hash
+    // is then only computed for the rewrite.
+    uint64_t size = 0, hash = 0;
+    bool hashed = false;
+    SpatialData d;
+    if (sizeMatches(jsonPath, cachePath(jsonPath))) {
+        hashed = hashFile(jsonPath, size, hash);
+        if (hashed && readCache(cachePath(jsonPath), size, hash, d)) return d;
+    }
+
+    // Missing or stale cache: parse the JSON (throws if it cannot be read).
+    d = JSONLoader::loadLusidScene(jsonPath);
+    if (!hashed) hashed = hashFile(jsonPath, size, hash);
+
+    if (hashed) {
+        if (writeCache(cachePath(jsonPath), size, hash, d)) {
+            std::cout << "Wrote scene cache: " << cachePath(jsonPath) << "\n";
+        } else {
+            std::cerr << "Warning: could not write scene cache " << cachePath(jsonPath)
+                      << " (continuing without it)\n";
+        }
+    }
+    return d;
+}
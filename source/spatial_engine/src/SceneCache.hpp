@@ -0,0 +1,52 @@
+#pragma once
+
+// SceneCache — binary sidecar for parsed LUSID scenes
+//
+// JSONLoader::loadLusidScene() streams the scene through a SAX handler, but
+// multi-hour ADM transcodes are still hundreds of MB of JSON and seconds of
+// tokenizing. The parsed result is small and flat, so it is written next to
+// the scene as "<scene>.srcache" and reloaded from there on the next start.
+//
+// FILE LAYOUT (little-endian, every section 8-byte aligned, mmap-friendly):
+//   CacheHeader          64 bytes  magic "SRSCENE\0", version, JSON size + hash,
+//                                  sampleRate / timeUnit / duration, counts
+//   CacheSourceEntry[]   24 bytes  per source, in scene.sources (sorted) order:
+//                                  name offset/length, first keyframe, count
+//   name pool            bytes     source keys back to back, padded to 8
+//   CacheKeyframe[]      24 bytes  per keyframe, all sources contiguous
+//
+// VALIDATION: the header stores the byte size and a 64-bit content hash of
+// the JSON it was built from. The JSON's size on disk (stat) is compared
+// first, and a mismatch rejects without hashing; otherwise the JSON is
+// hashed (one sequential read, no parsing) and must match. A rejected cache
+// is rewritten, so loadLusidScene() still hashes the JSON once for it. Any mismatch, version change or truncation → the JSON path runs and
+// the cache is rewritten (via a temp file + rename, so a concurrent reader
+// never sees a partial file). Failure to write is a warning, never an error.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "JSONLoader.hpp"
+
+class SceneCache {
+public:
+    /// Load a LUSID scene, from the sidecar cache when it is valid, else via
+    /// JSONLoader::loadLusidScene() and regenerate the cache. Throws like
+    /// loadLusidScene() when the JSON itself cannot be read.
+    static SpatialData loadLusidScene(const std::string &jsonPath);
+
+    /// Read the cache for jsonPath into out. False if missing, stale or corrupt.
+    static bool read(const std::string &jsonPath, SpatialData &out);
+
+    /// Write the cache for jsonPath from an already-parsed scene.
+    static bool write(const std::string &jsonPath, const SpatialData &scene);
+
+    static std::string cachePath(const std::string &jsonPath) { return jsonPath + ".srcache"; }
+
+    /// Byte size and content hash of a file. False if it cannot be read.
+    static bool hashFile(const std::string &path, uint64_t &size, uint64_t &hash);
+
+    /// The same content hash over an in-memory buffer.
+    static uint64_t hashBytes(const void *data, size_t size);
+};
@@ -0,0 +1,224 @@
+#include "SilenceMap.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <sndfile.h>
+
+namespace {
+
+constexpr char     kMagic[8] = {'S', 'R', 'S', 'I', 'L', 'N', 'C', '\0'};
+constexpr uint32_t kVersion  = 1;
+
+struct SilenceHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t numChannels;
+    uint64_t audioSize;
+    int64_t  audioMtime;     // file_time_type ticks — same platform only, which a sidecar is
+    uint64_t totalFrames;
+    uint64_t minRunFrames;   // kMinRunFrames the index was built with
+    uint64_t numRuns;
+    uint64_t reserved;
+};
+
+struct SilenceRun {
+    uint64_t start;
+    uint64_t end;
+};
+
+static_assert(sizeof(SilenceHeader) == 64, "SilenceHeader layout changed — bump kVersion");
+static_assert(sizeof(SilenceRun) == 16, "SilenceRun layout changed — bump kVersion");
+
+// Scan block: 64 K frames of interleaved floats (1 MB at 4 channels)
+constexpr sf_count_t kScanFrames = 65536;
+
+bool audioStamp(const std::string& audioPath, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    const auto sz = std::filesystem::file_size(audioPath, ec);
+    if (ec) return false;
+    const auto t = std::filesystem::last_write_time(audioPath, ec);
+    if (ec) return false;
+    size  = static_cast<uint64_t>(sz);
+    mtime = static_cast<int64_t>(t.time_since_epoch().count());
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// SilenceMap::Builder
+// ============================================================================
+
+void SilenceMap::Builder::append(const float* x, uint64_t n, size_t stride) {
+    for (uint64_t i = 0; i < n; ++i, ++mPos) {
+        if (x[i * stride] == 0.0f) {
+            if (!mInRun) {
+                mInRun = true;
+                mRunStart = mPos;
+            }
+        } else if (mInRun) {
+            mInRun = false;
+            if (mPos - mRunStart >= kMinRunFrames) mOut.runs.emplace_back(mRunStart, mPos);
+        }
+    }
+}
+
+SilenceRuns SilenceMap::Builder::finish() {
+    if (mInRun && mPos - mRunStart >= kMinRunFrames) mOut.runs.emplace_back(mRunStart, mPos);
+    mInRun = false;
+    mOut.totalFrames = mPos;
+    return std::move(mOut);
+}
+
+// ============================================================================
+// SilenceMap
+// ============================================================================
+
+SilenceRuns SilenceMap::fromSamples(const float* samples, uint64_t numFrames) {
+    Builder b;
+    b.append(samples, numFrames);
+    return b.finish();
+}
+
+bool SilenceMap::scanFile(const std::string& audioPath, std::vector<SilenceRuns>& perChannel,
+                          const std::atomic<bool>* cancel) {
+    SF_INFO info{};
+    SNDFILE* f = sf_open(audioPath.c_str(), SFM_READ, &info);
+    if (!f) return false;
+
+    const int channels = std::max(1, info.channels);
+    std::vector<Builder> builders(static_cast<size_t>(channels));
+    std::vector<float> buf(static_cast<size_t>(kScanFrames) * channels);
+    bool ok = true;
+    for (;;) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) { ok = false; break; }
+        const sf_count_t n = sf_readf_float(f, buf.data(), kScanFrames);
+        if (n <= 0) break;
+        for (int ch = 0; ch < channels; ++ch) {
+            builders[ch].append(buf.data() + ch, static_cast<uint64_t>(n),
+                                static_cast<size_t>(channels));
+        }
+    }
+    sf_close(f);
+    if (!ok) return false;
+
+    perChannel.clear();
+    perChannel.reserve(builders.size());
+    for (auto& b : builders) perChannel.push_back(b.finish());
+    return true;
+}
+
+bool SilenceMap::read(const std::string& audioPath, std::vector<SilenceRuns>& perChannel) {
+    uint64_t size = 0;
+    int64_t  mtime = 0;
+    if (!audioStamp(audioPath, size, mtime)) return false;
+
+    std::ifstream f(cachePath(audioPath), std::ios::binary);
+    if (!f.good()) return false;
+
+    SilenceHeader hdr;
+    if (!f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))) return false;
+    if (std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 || hdr.version != kVersion)
+        return false;
+    if (hdr.audioSize != size || hdr.audioMtime != mtime) return false;
+    if (hdr.minRunFrames != kMinRunFrames || hdr.numChannels == 0) return false;
+
+    std::vector<uint64_t> counts(hdr.numChannels);
+    if (!f.read(reinterpret_cast<char*>(counts.data()),
+                static_cast<std::streamsize>(counts.size() * sizeof(uint64_t)))) return false;
+    uint64_t total = 0;
+    for (uint64_t c : counts) {
+        if (c > hdr.numRuns - total) return false;
+        total += c;
+    }
+    if (total != hdr.numRuns) return false;
+
+    std::vector<SilenceRuns> out(hdr.numChannels);
+    std::vector<SilenceRun> runs;
+    for (uint32_t ch = 0; ch < hdr.numChannels; ++ch) {
+        runs.resize(static_cast<size_t>(counts[ch]));
+        if (!f.read(reinterpret_cast<char*>(runs.data()),
+                    static_cast<std::streamsize>(runs.size() * sizeof(SilenceRun)))) return false;
+        SilenceRuns& r = out[ch];
+        r.totalFrames = hdr.totalFrames;
+        r.runs.reserve(runs.size());
+        uint64_t prevEnd = 0;
+        for (const SilenceRun& run : runs) {
+            // Sorted, disjoint, inside the file — anything else is corrupt
+            if (run.start < prevEnd || run.end <= run.start || run.end > hdr.totalFrames)
+                return false;
+            r.runs.emplace_back(run.start, run.end);
+            prevEnd = run.end;
+        }
+    }
+    if (f.peek() != std::char_traits<char>::eof()) return false;   // trailing bytes
+
+    perChannel = std::move(out);
+    return true;
+}
+
+bool SilenceMap::write(const std::string& audioPath, const std::vector<SilenceRuns>& perChannel) {
+    uint64_t size = 0;
+    int64_t  mtime = 0;
+    if (perChannel.empty() || !audioStamp(audioPath, size, mtime)) return false;
+
+    SilenceHeader hdr{};
+    std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+    hdr.version      = kVersion;
+    hdr.numChannels  = static_cast<uint32_t>(perChannel.size());
+    hdr.audioSize    = size;
+    hdr.audioMtime   = mtime;
+    hdr.totalFrames  = perChannel.front().totalFrames;
+    hdr.minRunFrames = kMinRunFrames;
+
+    std::vector<uint64_t> counts;
+    counts.reserve(perChannel.size());
+    for (const SilenceRuns& r : perChannel) {
+        counts.push_back(r.runs.size());
+        hdr.numRuns += r.runs.size();
+    }
+
+    const std::string cacheFile = cachePath(audioPath);
+    const std::string tmpFile   = cacheFile + ".tmp";
+    {
+        std::ofstream f(tmpFile, std::ios::binary | std::ios::trunc);
+        if (!f.good()) return false;
+        f.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        f.write(reinterpret_cast<const char*>(counts.data()),
+                static_cast<std::streamsize>(counts.size() * sizeof(uint64_t)));
+        std::vector<SilenceRun> buf;
+        for (const SilenceRuns& r : perChannel) {
+            buf.clear();
+            for (const auto& [s, e] : r.runs) buf.push_back(SilenceRun{s, e});
+            f.write(reinterpret_cast<const char*>(buf.data()),
+                    static_cast<std::streamsize>(buf.size() * sizeof(SilenceRun)));
+        }
+        if (!f.good()) {
+            f.close();
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpFile, cacheFile, ec);
+    if (ec) {
+        std::remove(tmpFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SilenceMap::load(const std::string& audioPath, std::vector<SilenceRuns>& perChannel,
+                      const std::atomic<bool>* cancel) {
+    if (read(audioPath, perChannel)) return true;
+    if (!scanFile(audioPath, perChannel, cancel)) return false;
+    if (!write(audioPath, perChannel)) {
+        std::cerr << "Warning: could not write silence map " << cachePath(audioPath)
+                  << " (continuing without it)\n";
+    }
+    return true;
+}
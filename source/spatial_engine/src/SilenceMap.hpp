@@ -0,0 +1,127 @@
+#pragma once
+
+// SilenceMap — per-channel run-length index of digital silence in source audio
+//
+// ADM object stems are mostly exact zeros between cues, yet every frame of
+// them used to be read from disk, converted, copied into the render and
+// energy-summed just to find out it was silent. A SilenceRuns lists the long
+// runs of exact 0.0f samples in one channel, so the realtime loader, the
+// Spatializer and the offline renderer can skip whole chunks and blocks that
+// are known to be silent without touching a sample.
+//
+// SILENCE = EXACT ZERO. A run is silent only if every sample compares equal
+// to 0.0f, so skipping it is bit-identical to rendering it (the energy gates
+// in Spatializer / SpatialRenderer treat an all-zero block as silent anyway).
+// Runs shorter than kMinRunFrames are not recorded: they rarely cover a whole
+// block, and dropping them keeps the index a few KB even for dense material.
+//
+// SIDECAR: an index is cached next to the audio file it describes as
+// "<audio>.srsilence" (for a package: inside the scene's sources folder, or
+// beside the ADM WAV). It is validated against the audio file's byte size
+// and modification time — hashing would mean reading the whole file, which
+// is exactly the scan the cache saves. Written via a temp file + rename like
+// SceneCache, so a concurrent reader never sees a partial file; failure to
+// write is a warning, never an error.
+//
+// FILE LAYOUT (little-endian, 8-byte aligned):
+//   SilenceHeader        64 bytes  magic "SRSILNC\0", version, channel count,
+//                                  audio size + mtime, frames, run threshold
+//   uint64_t[channels]             runs per channel
+//   SilenceRun[]         16 bytes  [start, end) per run, all channels back to back
+//
+// THREADING: all methods are reentrant; SilenceRuns is immutable once built
+// and may be read from any thread (the realtime audio thread included —
+// covers() is a binary search, no allocation).
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct SilenceRuns {
+    uint64_t totalFrames = 0;                             // channel length
+    std::vector<std::pair<uint64_t, uint64_t>> runs;      // [start, end), sorted, disjoint
+
+    /// True when [start, end) is entirely silent. Frames at or past
+    /// totalFrames count as silent (the streams read zeros there).
+    bool covers(uint64_t start, uint64_t end) const {
+        if (start >= end) return true;
+        if (start >= totalFrames) return true;
+        // First run ending after start
+        size_t lo = 0, hi = runs.size();
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (runs[mid].second <= start) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == runs.size() || runs[lo].first > start) return false;
+        return runs[lo].second >= std::min(end, totalFrames);
+    }
+
+    /// Call f(a, b) for every maximal non-silent sub-range [a, b) of
+    /// [start, end), clipped to totalFrames, in order.
+    template <typename F>
+    void forEachAudible(uint64_t start, uint64_t end, F&& f) const {
+        if (end > totalFrames) end = totalFrames;
+        if (start >= end) return;
+        size_t lo = 0, hi = runs.size();
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (runs[mid].second <= start) lo = mid + 1;
+            else hi = mid;
+        }
+        uint64_t at = start;
+        for (size_t i = lo; i < runs.size() && at < end; ++i) {
+            if (runs[i].first > at) f(at, std::min(runs[i].first, end));
+            at = std::max(at, runs[i].second);
+        }
+        if (at < end) f(at, end);
+    }
+
+    uint64_t silentFrames() const {
+        uint64_t n = 0;
+        for (const auto& r : runs) n += r.second - r.first;
+        return n;
+    }
+};
+
+class SilenceMap {
+public:
+    static constexpr uint64_t kMinRunFrames = 4096;  // ~85 ms at 48 kHz
+
+    /// Incremental run finder for one channel, fed sample blocks in order.
+    class Builder {
+    public:
+        void append(const float* x, uint64_t n, size_t stride = 1);
+        SilenceRuns finish();
+
+    private:
+        SilenceRuns mOut;
+        uint64_t    mPos = 0;
+        uint64_t    mRunStart = 0;
+        bool        mInRun = false;
+    };
+
+    /// Index a whole in-memory channel.
+    static SilenceRuns fromSamples(const float* samples, uint64_t numFrames);
+
+    /// Index every channel of an audio file (WAV / RF64) in one
+    /// sequential pass. Returns false if the file cannot be read or cancel
+    /// became true mid-scan.
+    static bool scanFile(const std::string& audioPath, std::vector<SilenceRuns>& perChannel,
+                         const std::atomic<bool>* cancel = nullptr);
+
+    /// Sidecar for audioPath, if it is present and matches the file.
+    static bool read(const std::string& audioPath, std::vector<SilenceRuns>& perChannel);
+
+    /// Write the sidecar for audioPath.
+    static bool write(const std::string& audioPath, const std::vector<SilenceRuns>& perChannel);
+
+    /// read(), else scanFile() and write() (a write failure only warns).
+    static bool load(const std::string& audioPath, std::vector<SilenceRuns>& perChannel,
+                     const std::atomic<bool>* cancel = nullptr);
+
+    static std::string cachePath(const std::string& audioPath) { return audioPath + ".srsilence"; }
+};
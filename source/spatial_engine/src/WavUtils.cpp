@@ -1,7 +1,10 @@
 #include "WavUtils.hpp"
+#include "Deinterleave.hpp"
 #include <sndfile.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <stdexcept>
 
 namespace fs = std::filesystem;
 
@@ -31,16 +34,17 @@ WavUtils::loadSources(const std::string &folder,
     std::map<std::string, MonoWavData> out;
 
     for (auto &[name, kf] : sourceKeys) {
-        fs::path p = fs::path(folder) / (name + ".wav");
+        const std::string path = sourceFilePath(folder, name);
 
-        if (!fs::exists(p)) {
-            throw std::runtime_error("Missing source WAV: " + p.string());
+        if (path.empty()) {
+            throw std::runtime_error("Missing source file: " +
+                                     (fs::path(folder) / (name + ".wav")).string());
         }
 
-        MonoWavData d = loadMonoFile(p);
+        MonoWavData d = loadMonoFile(path);
 
         if (d.sampleRate != expectedSR) {
-            throw std::runtime_error("Sample rate mismatch in: " + p.string());
+            throw std::runtime_error("Sample rate mismatch in: " + path);
         }
 
         out[name] = d;
@@ -100,95 +104,326 @@ WavUtils::loadSourcesFromADM(const std::string &admFile,
         throw std::runtime_error("ADM file must have at least 2 channels: " + admFile);
     }
 
-    // Read all frames from the multichannel file
-    std::vector<float> interleavedBuffer(info.frames * info.channels);
-    sf_count_t framesRead = sf_readf_float(snd, interleavedBuffer.data(), info.frames);
-    sf_close(snd);
-
-    if (framesRead != info.frames) {
-        throw std::runtime_error("Failed to read all frames from ADM file: " + admFile);
-    }
-
-    // Extract channels for each source
+    // Materialize only the channels the scene references; one target per
+    // source, sorted by channel for the kernel's SIMD runs.
+    std::vector<std::pair<int, std::string>> wanted;
     for (auto &[name, kf] : sourceKeys) {
         int channelIndex = parseChannelIndex(name, info.channels);
         if (channelIndex < 0) {
             std::cerr << "Warning: Cannot map source '" << name << "' to ADM channel — skipping\n";
             continue;
         }
+        wanted.emplace_back(channelIndex, name);
+    }
+    std::stable_sort(wanted.begin(), wanted.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
 
-        MonoWavData d;
+    std::vector<DeinterleaveTarget> targets;
+    targets.reserve(wanted.size());
+    for (auto &[channelIndex, name] : wanted) {
+        MonoWavData &d = out[name];
         d.sampleRate = info.samplerate;
         d.samples.resize(info.frames);
+        targets.push_back({channelIndex, d.samples.data()});
+    }
 
-        // De-interleave: extract the specific channel
-        for (sf_count_t frame = 0; frame < info.frames; ++frame) {
-            d.samples[frame] = interleavedBuffer[frame * info.channels + channelIndex];
+    // Chunked read, double-buffered: the next chunk is read on a reader
+    // thread while the current one is de-interleaved by up to kMaxThreads
+    // workers, each taking a frame range of the chunk. The interleaved
+    // footprint is two ~32 MB chunks instead of the whole file.
+    constexpr size_t kChunkBytes = size_t(32) << 20;
+    constexpr unsigned kMaxThreads = 8;
+    const sf_count_t chunkFrames =
+        std::max<sf_count_t>(4096, (sf_count_t)(kChunkBytes / (sizeof(float) * info.channels)));
+    const unsigned numThreads = std::max(1u, std::min(kMaxThreads, std::thread::hardware_concurrency()));
+
+    std::vector<float> buf[2];
+    buf[0].resize((size_t)chunkFrames * info.channels);
+    buf[1].resize((size_t)chunkFrames * info.channels);
+
+    auto readChunk = [&](int b, sf_count_t frames) {
+        return sf_readf_float(snd, buf[b].data(), frames);
+    };
+
+    std::vector<DeinterleaveTarget> shifted(targets.size());
+    sf_count_t pos = 0;
+    sf_count_t got = readChunk(0, std::min(chunkFrames, (sf_count_t)info.frames));
+    int cur = 0;
+    bool ok = true;
+
+    while (pos < info.frames) {
+        if (got <= 0) { ok = false; break; }
+
+        // Start reading the next chunk into the other buffer
+        const sf_count_t nextPos = pos + got;
+        sf_count_t nextGot = 0;
+        std::thread reader;
+        if (nextPos < info.frames) {
+            const sf_count_t want = std::min(chunkFrames, (sf_count_t)info.frames - nextPos);
+            reader = std::thread([&, want] { nextGot = readChunk(1 - cur, want); });
         }
 
-        out[name] = d;
+        // De-interleave this chunk into every target at output offset pos
+        for (size_t k = 0; k < targets.size(); ++k)
+            shifted[k] = {targets[k].channel, targets[k].dst + pos};
+
+        const float *src = buf[cur].data();
+        const uint64_t frames = (uint64_t)got;
+        const unsigned workers = (frames >= 16384) ? numThreads : 1u;
+        const uint64_t span = (frames + workers - 1) / workers;
+        std::vector<std::thread> pool;
+        for (unsigned w = 1; w < workers; ++w) {
+            const uint64_t f0 = std::min(frames, w * span);
+            const uint64_t f1 = std::min(frames, f0 + span);
+            pool.emplace_back([&, f0, f1] {
+                deinterleaveTargets(src, info.channels, shifted.data(), shifted.size(), f0, f1);
+            });
+        }
+        deinterleaveTargets(src, info.channels, shifted.data(), shifted.size(),
+                            0, std::min(frames, span));
+        for (auto &t : pool) t.join();
+
+        if (reader.joinable()) reader.join();
+        pos = nextPos;
+        got = nextGot;
+        cur = 1 - cur;
+    }
+    sf_close(snd);
+
+    if (!ok) {
+        throw std::runtime_error("Failed to read all frames from ADM file: " + admFile);
+    }
+
+    for (auto &[channelIndex, name] : wanted) {
         std::cout << "  ✓ " << name << " → ADM ch " << (channelIndex + 1) << "\n";
     }
+    std::cout << "  ADM extraction: " << wanted.size() << " of " << info.channels
+              << " channels, " << numThreads << " thread(s)\n";
 
     return out;
 }
 
+int WavUtils::admChannelIndex(const std::string &sourceName, int numChannels) {
+    return parseChannelIndex(sourceName, numChannels);
+}
+
+std::string WavUtils::sourceFilePath(const std::string &folder, const std::string &name) {
+    fs::path p = fs::path(folder) / (name + ".wav");
+    return fs::exists(p) ? p.string() : std::string();
+}
+
 void WavUtils::writeMultichannelWav(const std::string &path,
                                     const MultiWavData &mw)
 {
+    const size_t totalSamples = mw.samples.empty() ? 0 : mw.samples[0].size();
+
+    MultichannelWavWriter writer;
+    writer.open(path, mw.channels, mw.sampleRate, totalSamples);
+
+    std::cout << "Writing to file...\n";
+    writer.append(mw, totalSamples);
+    std::cout << "Wrote " << writer.framesWritten() * mw.channels
+              << " samples (expected " << totalSamples * mw.channels << ")\n";
+
+    writer.close();
+    std::cout << "File closed\n";
+}
+
+MultichannelWavWriter::~MultichannelWavWriter()
+{
+    try {
+        close();
+    } catch (const std::exception &e) {
+        std::cerr << "MultichannelWavWriter: " << e.what() << "\n";
+    }
+}
+
+void MultichannelWavWriter::open(const std::string &path, int channels,
+                                 int sampleRate, size_t expectedFrames,
+                                 size_t queueSlabs)
+{
+    close();
+
     SF_INFO info = {};
-    info.channels = mw.channels;
-    info.samplerate = mw.sampleRate;
-
-    // Auto-select RF64 when audio data exceeds the standard WAV 4 GB limit.
-    // Standard WAV uses unsigned 32-bit data-chunk sizes (max ~4.29 GB).
-    // RF64 (EBU Tech 3306) is the broadcast-standard extension with 64-bit sizes.
-    // libsndfile supports RF64 natively — readers that support RF64 include
-    // libsndfile, ffmpeg, SoX, Audacity, Reaper, and most DAWs.
-    size_t dataSizeBytes = (size_t)mw.samples[0].size() * mw.channels * sizeof(float);
-    constexpr size_t kWavMaxBytes = 0xFFFFFFFF;  // ~4.29 GB unsigned 32-bit limit
-
-    if (dataSizeBytes > kWavMaxBytes) {
-        info.format = SF_FORMAT_RF64 | SF_FORMAT_FLOAT;
-        std::cout << "NOTE: Using RF64 format (data size "
-                  << dataSizeBytes / (1024 * 1024) << " MB exceeds WAV 4 GB limit)\n";
-    } else {
-        info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
-    }
-
-    double durationSec = (double)mw.samples[0].size() / mw.sampleRate;
-    std::cout << "Writing " << (dataSizeBytes > kWavMaxBytes ? "RF64" : "WAV")
-              << ": " << mw.channels << " channels, "
-              << mw.sampleRate << " Hz, "
+    info.channels = channels;
+    info.samplerate = sampleRate;
+
+    // Always RF64 with auto-downgrade: libsndfile writes a standard WAV header
+    // at close if the data fits the unsigned 32-bit WAV size (max ~4.29 GB),
+    // and an RF64 (EBU Tech 3306) ds64 header otherwise. The choice is made on
+    // the final size, so an unknown or underestimated length can never
+    // produce a truncated WAV. Readers that support RF64 include libsndfile,
+    // ffmpeg, SoX, Audacity, Reaper, and most DAWs.
+    info.format = SF_FORMAT_RF64 | SF_FORMAT_FLOAT;
+
+    size_t dataSizeBytes = expectedFrames * channels * sizeof(float);
+    double durationSec = (double)expectedFrames / sampleRate;
+    std::cout << "Writing WAV/RF64 (auto): " << channels << " channels, "
+              << sampleRate << " Hz, ~"
               << durationSec << " seconds ("
-              << mw.samples[0].size() << " samples/ch, "
-              << dataSizeBytes / (1024 * 1024) << " MB)\n";
+              << expectedFrames << " samples/ch, "
+              << dataSizeBytes / (1024 * 1024) << " MB"
+              << (queueSlabs > 0 ? ", writer thread" : "") << ")\n";
 
-    SNDFILE *snd = sf_open(path.c_str(), SFM_WRITE, &info);
-    if (!snd) {
+    mSnd = sf_open(path.c_str(), SFM_WRITE, &info);
+    if (!mSnd) {
         std::cerr << "Error opening file for write: " << sf_strerror(nullptr) << "\n";
         throw std::runtime_error("Cannot create WAV file");
     }
+    sf_command(mSnd, SFC_RF64_AUTO_DOWNGRADE, nullptr, SF_TRUE);
+
+    mChannels = channels;
+    mSampleRate = sampleRate;
+    mFramesWritten = 0;
+    mRF64 = false;
+
+    mSlabs.assign(std::max<size_t>(queueSlabs, 1), Slab());
+    for (auto &slab : mSlabs) slab.data.assign(kSlabFrames * channels, 0.0f);
+
+    if (queueSlabs > 0) {
+        mFree.clear();
+        mFull.clear();
+        for (size_t i = 0; i < mSlabs.size(); i++) mFree.push_back(i);
+        mStopWriter = false;
+        mWriterError.clear();
+        mWriter = std::thread([this] { writerLoop(); });
+    }
+}
 
-    size_t totalSamples = mw.samples[0].size();
-    std::vector<float> interleaved(totalSamples * mw.channels);
+// Cache-tiled planar → interleaved copy: each tile reads kTileFrames
+// contiguous samples per channel and fills a kTileFrames × channels block
+// of dst, so the strided writes land in lines that are still cached.
+void MultichannelWavWriter::interleave(const MultiWavData &chunk, size_t base,
+                                       size_t n, float *dst) const
+{
+    const size_t stride = (size_t)mChannels;
+    for (size_t t = 0; t < n; t += kTileFrames) {
+        const size_t tn = std::min(kTileFrames, n - t);
+        float *tile = dst + t * stride;
+        for (int ch = 0; ch < mChannels; ch++) {
+            const float *src = chunk.samples[ch].data() + base + t;
+            float *out = tile + ch;
+            for (size_t i = 0; i < tn; i++) {
+                out[i * stride] = src[i];
+            }
+        }
+    }
+}
 
-    std::cout << "Interleaving " << interleaved.size() << " total samples...\n";
+void MultichannelWavWriter::writeSlab(const Slab &slab)
+{
+    const sf_count_t want = (sf_count_t)(slab.frames * mChannels);
+    sf_count_t written = sf_write_float(mSnd, slab.data.data(), want);
+    if (written != want) {
+        throw std::runtime_error(std::string("MultichannelWavWriter: short write: ")
+                                 + sf_strerror(mSnd));
+    }
+}
 
-    for (size_t i = 0; i < totalSamples; i++) {
-        for (int ch = 0; ch < mw.channels; ch++) {
-            interleaved[i * mw.channels + ch] = mw.samples[ch][i];
+void MultichannelWavWriter::append(const MultiWavData &chunk, size_t numFrames)
+{
+    if (!mSnd) throw std::runtime_error("MultichannelWavWriter: append() before open()");
+    if (chunk.channels != mChannels) {
+        throw std::runtime_error("MultichannelWavWriter: channel count mismatch");
+    }
+
+    const bool async = mWriter.joinable();
+    for (size_t base = 0; base < numFrames; base += kSlabFrames) {
+        const size_t n = std::min(kSlabFrames, numFrames - base);
+
+        if (!async) {
+            Slab &slab = mSlabs[0];
+            interleave(chunk, base, n, slab.data.data());
+            slab.frames = n;
+            writeSlab(slab);
+        } else {
+            size_t idx;
+            {
+                std::unique_lock<std::mutex> lk(mQueueMutex);
+                mSlabFree.wait(lk, [this] { return !mFree.empty() || !mWriterError.empty(); });
+                if (!mWriterError.empty()) throw std::runtime_error(mWriterError);
+                idx = mFree.front();
+                mFree.pop_front();
+            }
+            interleave(chunk, base, n, mSlabs[idx].data.data());
+            mSlabs[idx].frames = n;
+            {
+                std::lock_guard<std::mutex> lk(mQueueMutex);
+                mFull.push_back(idx);
+            }
+            mSlabFull.notify_one();
+        }
+
+        mFramesWritten += n;
+        constexpr size_t kWavMaxBytes = 0xFFFFFFFF;  // ~4.29 GB unsigned 32-bit limit
+        if (!mRF64 && mFramesWritten * mChannels * sizeof(float) > kWavMaxBytes) {
+            mRF64 = true;
+            std::cout << "NOTE: output crossed the WAV 4 GB limit — finalizing as RF64\n";
         }
     }
+}
 
-    std::cout << "Writing to file...\n";
-    sf_count_t written = sf_write_float(snd, interleaved.data(), interleaved.size());
-    std::cout << "Wrote " << written << " samples (expected " << interleaved.size() << ")\n";
-    
-    if (written != (sf_count_t)interleaved.size()) {
-        std::cerr << "Write error: " << sf_strerror(snd) << "\n";
+// Writer thread: write full slabs in order, recycle them. After a failure it
+// keeps recycling without writing so the caller never blocks forever.
+void MultichannelWavWriter::writerLoop()
+{
+    for (;;) {
+        size_t idx;
+        bool failed;
+        {
+            std::unique_lock<std::mutex> lk(mQueueMutex);
+            mSlabFull.wait(lk, [this] { return !mFull.empty() || mStopWriter; });
+            if (mFull.empty()) return;   // stopped and drained
+            idx = mFull.front();
+            mFull.pop_front();
+            failed = !mWriterError.empty();
+        }
+        if (!failed) {
+            try {
+                writeSlab(mSlabs[idx]);
+            } catch (const std::exception &e) {
+                std::lock_guard<std::mutex> lk(mQueueMutex);
+                mWriterError = e.what();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lk(mQueueMutex);
+            mFree.push_back(idx);
+        }
+        mSlabFree.notify_one();
     }
-    
-    sf_close(snd);
-    std::cout << "File closed\n";
+}
+
+void MultichannelWavWriter::stopWriter()
+{
+    if (!mWriter.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lk(mQueueMutex);
+        mStopWriter = true;
+    }
+    mSlabFull.notify_one();
+    mWriter.join();
+}
+
+void MultichannelWavWriter::closeFile()
+{
+    if (mSnd) {
+        sf_close(mSnd);
+        mSnd = nullptr;
+    }
+    mSlabs.clear();
+    mSlabs.shrink_to_fit();
+}
+
+void MultichannelWavWriter::close()
+{
+    stopWriter();
+    closeFile();
+
+    std::string err;
+    {
+        std::lock_guard<std::mutex> lk(mQueueMutex);
+        err.swap(mWriterError);
+    }
+    if (!err.empty()) throw std::runtime_error(err);
 }
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
-#include <map>
+
+#include <sndfile.h>
 
 struct MonoWavData {
     int sampleRate;
@@ -29,4 +36,87 @@ public:
 
     static void writeMultichannelWav(const std::string &path,
                                      const MultiWavData &mw);
+
+    /// Path of a source's audio file in a package folder: <name>.wav.
+    /// Empty if it does not exist.
+    static std::string sourceFilePath(const std::string &folder, const std::string &name);
+
+    /// Map a LUSID source key to a 0-based ADM channel index.
+    /// "N.1" → N-1, "LFE" → 3 (if the file has >= 4 channels), else -1.
+    static int admChannelIndex(const std::string &sourceName, int numChannels);
+};
+
+// Incremental multichannel WAV/RF64 writer.
+// open() once, append() any number of planar chunks, close() to finalize the
+// header. Interleaving goes through small reusable slabs, so peak memory is
+// independent of both chunk length and program length.
+//
+// FORMAT: the file is opened as RF64 with libsndfile's auto-downgrade, so it
+// is finalized as a plain WAV if the data stays under the 4 GB WAV limit and
+// as RF64 once the running size crosses it — expectedFrames is only a hint
+// for the log line and may be 0 or wrong.
+//
+// WRITER THREAD: open(..., queueSlabs > 0) starts a writer thread fed by a
+// bounded queue of queueSlabs interleaved slabs. append() interleaves on the
+// caller's thread (the copy the caller needs anyway, since it reuses its
+// chunk buffer) and returns as soon as every slab is queued, blocking only
+// when the queue is full — so the caller's next DSP chunk overlaps this
+// chunk's disk I/O. A write error on the writer thread is rethrown by the
+// next append() or by close().
+//
+// Errors throw std::runtime_error (same contract as the loaders above).
+class MultichannelWavWriter {
+public:
+    MultichannelWavWriter() = default;
+    ~MultichannelWavWriter();
+
+    MultichannelWavWriter(const MultichannelWavWriter &) = delete;
+    MultichannelWavWriter &operator=(const MultichannelWavWriter &) = delete;
+
+    void open(const std::string &path, int channels, int sampleRate,
+              size_t expectedFrames, size_t queueSlabs = 0);
+
+    /// Append the first numFrames samples of every channel in chunk.
+    void append(const MultiWavData &chunk, size_t numFrames);
+
+    /// Drain the writer queue and finalize the header. Throws if any write failed.
+    void close();
+
+    /// Frames accepted by append() (all of them are on disk after close()).
+    size_t framesWritten() const { return mFramesWritten; }
+    /// True once the data outgrew the WAV limit (file finalizes as RF64).
+    bool isRF64() const { return mRF64; }
+
+    static constexpr size_t kSlabFrames = 4096;  // frames per interleaved slab
+
+private:
+    static constexpr size_t kTileFrames = 64;    // interleave tile (64 frames × channels stays in L1)
+
+    struct Slab {
+        std::vector<float> data;   // kSlabFrames × channels interleaved
+        size_t frames = 0;
+    };
+
+    void interleave(const MultiWavData &chunk, size_t base, size_t n, float *dst) const;
+    void writeSlab(const Slab &slab);   // sf_write_float; throws on a short write
+    void writerLoop();
+    void stopWriter();
+    void closeFile();
+
+    SNDFILE *mSnd = nullptr;
+    int mChannels = 0;
+    int mSampleRate = 0;
+    bool mRF64 = false;
+    size_t mFramesWritten = 0;
+
+    std::vector<Slab> mSlabs;           // sync: one slab; async: the queue pool
+
+    // Writer thread (queueSlabs > 0)
+    std::thread mWriter;
+    std::mutex mQueueMutex;
+    std::condition_variable mSlabFree;  // writer → caller
+    std::condition_variable mSlabFull;  // caller → writer
+    std::deque<size_t> mFree, mFull;    // indices into mSlabs
+    bool mStopWriter = false;
+    std::string mWriterError;           // first write error, guarded by mQueueMutex
 };